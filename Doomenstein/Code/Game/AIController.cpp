@@ -9,6 +9,7 @@
 #include "Game/Actor.hpp"
 #include "Game/Weapon.hpp"
 #include "Game/PlayerController.hpp"
+#include "Game/AIPerception.hpp"
 
 AIController::AIController()
 {
@@ -31,12 +32,7 @@ void AIController::Update(float deltaseconds)
 		return;
 	}
 
-	Actor* target = nullptr;
-
-	//if (!target)
-	{
-		target = GetActorWithinSight(self->m_definition.m_sightRadius, self->m_definition.m_sightAngle);
-	}
+	Actor* target = m_canSeeTarget ? m_targetUID.GetActor() : nullptr;
 
 	if (target)
 	{
@@ -45,11 +41,6 @@ void AIController::Update(float deltaseconds)
 			g_theAudio->SetSoundPosition(m_map->m_game->m_allSoundPlaybackIDs[GAME_DEMON_HURT], self->m_position);
 		}
 
-		for(int i = 0; i < m_map->m_game->m_numOfPlayers; i++)
-		{
-			g_theAudio->UpdateListener(i, target->m_position, target->m_orientation.GetAsMatrix_XFwd_YLeft_ZUp().GetIBasis3D(), target->m_orientation.GetAsMatrix_XFwd_YLeft_ZUp().GetKBasis3D());
-		}
-
 		Vec3 directionToTarget = (target->m_position - self->m_position).GetNormalized();
 
 		self->TurnInDirection(directionToTarget.GetAngleAboutZDegrees(), 180.0f * deltaseconds);
@@ -67,11 +58,11 @@ void AIController::Update(float deltaseconds)
 				m_actorUID.GetActor()->m_velocity = Vec3::ZERO;
 			}
 
-			if (m_actorUID.GetActor()->m_animName == "Hurt")
+			if (m_actorUID.GetActor()->m_anim == ActorAnim::HURT)
 			{
-				if (m_actorUID.GetActor()->m_animTime >= m_actorUID.GetActor()->m_animDuration)
+				if (m_actorUID.GetActor()->m_animTime >= m_actorUID.GetActor()->GetAnimDuration())
 				{
-					m_actorUID.GetActor()->m_animName = "Attack";
+					m_actorUID.GetActor()->m_anim = ActorAnim::ATTACK;
 				}
 			}
 
@@ -90,21 +81,11 @@ void AIController::Update(float deltaseconds)
 					g_theAudio->SetSoundPosition(m_map->m_game->m_allSoundPlaybackIDs[GAME_DEMON_ATTACK], self->m_position);
 				}
 
-				for (int i = 0; i < m_map->m_game->m_numOfPlayers; i++)
-				{
-					g_theAudio->UpdateListener(i, self->m_position, self->m_orientation.GetAsMatrix_XFwd_YLeft_ZUp().GetIBasis3D(), self->m_orientation.GetAsMatrix_XFwd_YLeft_ZUp().GetKBasis3D());
-				}
-
 				if (g_theAudio->IsPlaying(m_map->m_game->m_allSoundPlaybackIDs[GAME_PLAYER_HURT]))
 				{
 					g_theAudio->SetSoundPosition(m_map->m_game->m_allSoundPlaybackIDs[GAME_PLAYER_HURT], target->m_position);
 				}
 
-				for (int i = 0; i < m_map->m_game->m_numOfPlayers; i++)
-				{
-					g_theAudio->UpdateListener(i, target->m_position, target->m_orientation.GetAsMatrix_XFwd_YLeft_ZUp().GetIBasis3D(), target->m_orientation.GetAsMatrix_XFwd_YLeft_ZUp().GetKBasis3D());
-				}
-
 				Vec3 impulseDirection = (m_targetUID.GetActor()->m_position - self->m_position).GetNormalized();
 
 				target = m_targetUID.GetActor();
@@ -121,11 +102,11 @@ void AIController::Update(float deltaseconds)
 		{
 			m_isInAttackingRange = false;
 
-			if (m_actorUID.GetActor()->m_animName == "Hurt")
+			if (m_actorUID.GetActor()->m_anim == ActorAnim::HURT)
 			{
-				if (m_actorUID.GetActor()->m_animTime >= m_actorUID.GetActor()->m_animDuration)
+				if (m_actorUID.GetActor()->m_animTime >= m_actorUID.GetActor()->GetAnimDuration())
 				{
-					m_actorUID.GetActor()->m_animName = "Walk";
+					m_actorUID.GetActor()->m_anim = ActorAnim::WALK;
 				}
 			}
 		}
@@ -151,7 +132,7 @@ void AIController::Update(float deltaseconds)
 					m_actorUID.GetActor()->m_velocity = Vec3::ZERO;
 				}
 
-				m_actorUID.GetActor()->m_animName = "Attack";
+				m_actorUID.GetActor()->m_anim = ActorAnim::ATTACK;
 
 				m_isInAttackingRange = true;
 
@@ -177,11 +158,11 @@ void AIController::Update(float deltaseconds)
 			{
 				m_isInAttackingRange = false;
 
-				if (m_actorUID.GetActor()->m_animName == "Hurt")
+				if (m_actorUID.GetActor()->m_anim == ActorAnim::HURT)
 				{
-					if (m_actorUID.GetActor()->m_animTime >= m_actorUID.GetActor()->m_animDuration)
+					if (m_actorUID.GetActor()->m_animTime >= m_actorUID.GetActor()->GetAnimDuration())
 					{
-						m_actorUID.GetActor()->m_animName = "Walk";
+						m_actorUID.GetActor()->m_anim = ActorAnim::WALK;
 					}
 				}
 			}
@@ -217,37 +198,44 @@ void AIController::Update(float deltaseconds)
 	}
 }
 
+void AIController::Reset()
+{
+	m_goalDegrees = 0.0f;
+	m_turnTimer = 0.0f;
+	m_isInAttackingRange = false;
+	m_isTurning = false;
+	m_nextAttackTimer = 0.0f;
+	m_targetUID = ActorUID::INVALID;
+	m_canSeeTarget = false;
+	m_lod = AILevelOfDetail::FULL;
+	m_lodAccumulatedSeconds = 0.0f;
+	m_lodTickSeconds = 0.0f;
+	m_secondsSinceEngaged = 0.0f;
+}
+
 void AIController::DamagedBy(Actor* attacker)
 {
-	if (attacker->m_definition.m_name == "Marine")
+	if (attacker->m_definition.m_name == "Marine" && m_targetUID != attacker->m_UID)
 	{
+		// Sight of the previous target says nothing about the attacker; wait for perception to confirm it.
 		m_targetUID = attacker->m_UID;
+		m_canSeeTarget = false;
 	}
+
+	m_secondsSinceEngaged = 0.0f;
 }
 
-Actor* AIController::GetActorWithinSight(float radius, float angle)
+void AIController::OnPerceptionEvent(PerceptionEvent const& event)
 {
-	Actor* self = m_actorUID.GetActor();
-
-	Actor* target = nullptr;
-
-	for (size_t index = 0; index < m_map->m_actorList.size(); index++)
+	if (event.m_isSeen)
 	{
-		if (m_map->m_actorList[index])
-		{
-			if (m_map->m_actorList[index]->m_definition.m_name == "Marine")
-			{
-				if (IsPointInsideOrientedSector2D(Vec2(m_map->m_actorList[index]->m_position.x, m_map->m_actorList[index]->m_position.y), Vec2(self->m_position.x, self->m_position.y), self->m_orientation.GetYaw(), angle, radius))
-				{
-					target = m_map->m_actorList[index];
-
-					m_targetUID = target->m_UID;
-				}
-			}
-		}
+		m_targetUID = event.m_target;
+		m_canSeeTarget = true;
+	}
+	else if (event.m_target == m_targetUID)
+	{
+		m_canSeeTarget = false;
 	}
-
-	return target;
 }
 
 bool AIController::IsTargetInAttackRange()
@@ -4,11 +4,13 @@
 #include "Game/ActorUID.hpp"
 #include "Game/Controller.hpp"
 #include "Game/Map.hpp"
+#include "Game/AIScheduler.hpp"
 
 #include <string>
 
 class Weapon;
 class Actor;
+struct PerceptionEvent;
 
 //------------------------------------------------------------------------------------------------
 class AIController : public Controller
@@ -20,9 +22,10 @@ public:
 	virtual						~AIController();
 
 	virtual void				Update(float deltaseconds);
+	void						Reset();
 
 	void						DamagedBy(Actor* attacker);
-	Actor*						GetActorWithinSight(float radius, float angle);
+	void						OnPerceptionEvent(PerceptionEvent const& event);
 	bool						IsTargetInAttackRange();
 public:
 	std::string					m_animName;
@@ -34,4 +37,9 @@ public:
 	float						m_nextAttackTimer		= 0.0f;
 	Weapon*						m_meleeWeapon			= nullptr;
 	ActorUID					m_targetUID				= ActorUID::INVALID;
+	bool						m_canSeeTarget			= false;
+	AILevelOfDetail				m_lod					= AILevelOfDetail::FULL;
+	float						m_lodAccumulatedSeconds	= 0.0f;
+	float						m_lodTickSeconds		= 0.0f;
+	float						m_secondsSinceEngaged	= 0.0f;
 };
\ No newline at end of file
@@ -0,0 +1,310 @@
+#include "Game/AIPerception.hpp"
+
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include "Game/Map.hpp"
+#include "Game/Actor.hpp"
+#include "Game/AIController.hpp"
+
+#include <algorithm>
+
+AIPerception::AIPerception(Map* map)
+	: m_map(map)
+{
+	m_gridDimensions.x = RoundDownToInt(static_cast<float>(m_map->m_dimensions.x) / m_cellSize) + 1;
+	m_gridDimensions.y = RoundDownToInt(static_cast<float>(m_map->m_dimensions.y) / m_cellSize) + 1;
+
+	m_cellStart.resize(static_cast<size_t>(m_gridDimensions.x * m_gridDimensions.y) + 1);
+}
+
+AIPerception::~AIPerception()
+{
+}
+
+void AIPerception::Update()
+{
+	PROFILE_SCOPE("AIPerception::Update");
+	ScopedMemoryTag memoryTag(MemoryTag::AI);
+
+	m_queries.clear();
+	m_slices.clear();
+	m_events.clear();
+
+	BuildTargetGrid();
+	GatherObservers();
+	ExpireLostTargets();
+	DispatchEvents(0);
+
+	size_t firstSliceEvent = m_events.size();
+
+	GatherQueries();
+	ResolveQueries();
+	PublishEvents();
+	DispatchEvents(firstSliceEvent);
+
+	m_numObserversLastFrame = static_cast<int>(m_slices.size());
+	m_numLOSChecksLastFrame = static_cast<int>(m_queries.size());
+	PROFILE_COUNTER("AIPerception::LOSChecks", m_numLOSChecksLastFrame);
+	m_numEventsLastFrame = static_cast<int>(m_events.size());
+}
+
+//------------------------------------------------------------------------------------------------
+// Counting sort of all live targets into grid cells, so a cell's targets are contiguous in m_cellTargets
+//------------------------------------------------------------------------------------------------
+void AIPerception::BuildTargetGrid()
+{
+	std::vector<Actor*> const& actors = m_map->m_actorList;
+
+	int numCells = m_gridDimensions.x * m_gridDimensions.y;
+
+	m_targetCells.assign(actors.size(), -1);
+	std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+
+	int numTargets = 0;
+
+	for (size_t index = 0; index < actors.size(); index++)
+	{
+		if (IsValidTarget(actors[index]))
+		{
+			int cell = GetCellIndex(Vec2(actors[index]->m_position.x, actors[index]->m_position.y));
+
+			m_targetCells[index] = cell;
+			m_cellStart[cell + 1]++;
+			numTargets++;
+		}
+	}
+
+	for (int cell = 0; cell < numCells; cell++)
+	{
+		m_cellStart[cell + 1] += m_cellStart[cell];
+	}
+
+	m_cellTargets.resize(numTargets);
+
+	std::vector<int> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+
+	for (size_t index = 0; index < actors.size(); index++)
+	{
+		if (m_targetCells[index] != -1)
+		{
+			m_cellTargets[cursor[m_targetCells[index]]++] = static_cast<int>(index);
+		}
+	}
+
+	m_numTargetsLastFrame = numTargets;
+}
+
+void AIPerception::GatherObservers()
+{
+	std::vector<Actor*> const& actors = m_map->m_actorList;
+
+	m_observers.clear();
+
+	for (size_t index = 0; index < actors.size(); index++)
+	{
+		if (actors[index] && actors[index]->m_aiController && !actors[index]->m_isDead && actors[index]->m_aiController->m_lod != AILevelOfDetail::FROZEN)
+		{
+			m_observers.push_back(static_cast<int>(index));
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// A target that died or was destroyed is lost immediately, without waiting for the observer's slice
+//------------------------------------------------------------------------------------------------
+void AIPerception::ExpireLostTargets()
+{
+	for (size_t index = 0; index < m_observers.size(); index++)
+	{
+		Actor* observer = m_map->m_actorList[m_observers[index]];
+		AIController* controller = observer->m_aiController;
+
+		if (controller->m_canSeeTarget && !IsValidTarget(controller->m_targetUID.GetActor()))
+		{
+			PerceptionEvent lost;
+			lost.m_observer = observer->m_UID;
+			lost.m_target = controller->m_targetUID;
+			lost.m_isSeen = false;
+
+			m_events.push_back(lost);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Visits observers round-robin, collecting sector-filtered candidates from nearby grid cells until
+// the LOS budget is spent. An observer's candidates are always gathered as a whole.
+//------------------------------------------------------------------------------------------------
+void AIPerception::GatherQueries()
+{
+	if (m_observers.empty())
+		return;
+
+	std::vector<Actor*> const& actors = m_map->m_actorList;
+
+	for (size_t visited = 0; visited < m_observers.size(); visited++)
+	{
+		m_observerCursor = m_observerCursor % m_observers.size();
+
+		int observerIndex = m_observers[m_observerCursor];
+		Actor const* observer = actors[observerIndex];
+
+		Vec2 observerPos = Vec2(observer->m_position.x, observer->m_position.y);
+		float sightRadius = observer->m_definition.m_sightRadius;
+		float sightAngle = observer->m_definition.m_sightAngle;
+		float observerYaw = observer->m_orientation.GetYaw();
+
+		int minCellX = RoundDownToInt((observerPos.x - sightRadius) / m_cellSize);
+		int minCellY = RoundDownToInt((observerPos.y - sightRadius) / m_cellSize);
+		int maxCellX = RoundDownToInt((observerPos.x + sightRadius) / m_cellSize);
+		int maxCellY = RoundDownToInt((observerPos.y + sightRadius) / m_cellSize);
+
+		minCellX = (minCellX < 0) ? 0 : minCellX;
+		minCellY = (minCellY < 0) ? 0 : minCellY;
+		maxCellX = (maxCellX >= m_gridDimensions.x) ? m_gridDimensions.x - 1 : maxCellX;
+		maxCellY = (maxCellY >= m_gridDimensions.y) ? m_gridDimensions.y - 1 : maxCellY;
+
+		PerceptionSlice slice;
+		slice.m_observerIndex = observerIndex;
+		slice.m_firstQuery = static_cast<int>(m_queries.size());
+
+		for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+		{
+			for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+			{
+				int cell = cellX + (cellY * m_gridDimensions.x);
+
+				for (int slot = m_cellStart[cell]; slot < m_cellStart[cell + 1]; slot++)
+				{
+					int targetIndex = m_cellTargets[slot];
+					Vec2 targetPos = Vec2(actors[targetIndex]->m_position.x, actors[targetIndex]->m_position.y);
+
+					if (IsPointInsideOrientedSector2D(targetPos, observerPos, observerYaw, sightAngle, sightRadius))
+					{
+						PerceptionQuery query;
+						query.m_observerIndex = observerIndex;
+						query.m_targetIndex = targetIndex;
+						query.m_distanceSquared = GetDistanceSquared2D(observerPos, targetPos);
+
+						m_queries.push_back(query);
+					}
+				}
+			}
+		}
+
+		slice.m_numQueries = static_cast<int>(m_queries.size()) - slice.m_firstQuery;
+
+		// Over budget, leave this observer for next frame unless it is the only one this frame
+		if (!m_slices.empty() && static_cast<int>(m_queries.size()) > m_maxLOSChecksPerFrame)
+		{
+			m_queries.resize(slice.m_firstQuery);
+			break;
+		}
+
+		m_slices.push_back(slice);
+		m_observerCursor++;
+
+		if (static_cast<int>(m_queries.size()) >= m_maxLOSChecksPerFrame)
+			break;
+	}
+}
+
+void AIPerception::ResolveQueries()
+{
+	std::vector<Actor*> const& actors = m_map->m_actorList;
+
+	for (size_t index = 0; index < m_queries.size(); index++)
+	{
+		PerceptionQuery& query = m_queries[index];
+
+		Vec3 const& start = actors[query.m_observerIndex]->m_position;
+		Vec3 const& end = actors[query.m_targetIndex]->m_position;
+
+		query.m_isVisible = m_map->HasLineOfSightXY(Vec2(start.x, start.y), Vec2(end.x, end.y));
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Compares each visited observer's nearest visible target against what it last saw, and only emits on change
+//------------------------------------------------------------------------------------------------
+void AIPerception::PublishEvents()
+{
+	std::vector<Actor*> const& actors = m_map->m_actorList;
+
+	for (size_t sliceIndex = 0; sliceIndex < m_slices.size(); sliceIndex++)
+	{
+		PerceptionSlice const& slice = m_slices[sliceIndex];
+
+		Actor const* observer = actors[slice.m_observerIndex];
+		AIController const* controller = observer->m_aiController;
+
+		int nearestTarget = -1;
+		float nearestDistanceSquared = 0.0f;
+
+		for (int queryIndex = slice.m_firstQuery; queryIndex < slice.m_firstQuery + slice.m_numQueries; queryIndex++)
+		{
+			PerceptionQuery const& query = m_queries[queryIndex];
+
+			if (query.m_isVisible && (nearestTarget == -1 || query.m_distanceSquared < nearestDistanceSquared))
+			{
+				nearestTarget = query.m_targetIndex;
+				nearestDistanceSquared = query.m_distanceSquared;
+			}
+		}
+
+		PerceptionEvent event;
+		event.m_observer = observer->m_UID;
+
+		if (nearestTarget != -1)
+		{
+			event.m_target = actors[nearestTarget]->m_UID;
+			event.m_isSeen = true;
+
+			if (!controller->m_canSeeTarget || controller->m_targetUID != event.m_target)
+			{
+				m_events.push_back(event);
+			}
+		}
+		else if (controller->m_canSeeTarget)
+		{
+			event.m_target = controller->m_targetUID;
+			event.m_isSeen = false;
+
+			m_events.push_back(event);
+		}
+	}
+}
+
+void AIPerception::DispatchEvents(size_t firstEvent)
+{
+	for (size_t index = firstEvent; index < m_events.size(); index++)
+	{
+		Actor* observer = m_events[index].m_observer.GetActor();
+
+		if (observer && observer->m_aiController)
+		{
+			observer->m_aiController->OnPerceptionEvent(m_events[index]);
+		}
+	}
+}
+
+bool AIPerception::IsValidTarget(Actor const* actor) const
+{
+	if (actor == nullptr || actor->m_isDead)
+		return false;
+
+	return actor->m_definition.m_name == "Marine";
+}
+
+int AIPerception::GetCellIndex(Vec2 const& position) const
+{
+	int cellX = RoundDownToInt(position.x / m_cellSize);
+	int cellY = RoundDownToInt(position.y / m_cellSize);
+
+	cellX = (cellX < 0) ? 0 : ((cellX >= m_gridDimensions.x) ? m_gridDimensions.x - 1 : cellX);
+	cellY = (cellY < 0) ? 0 : ((cellY >= m_gridDimensions.y) ? m_gridDimensions.y - 1 : cellY);
+
+	return cellX + (cellY * m_gridDimensions.x);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include "Game/ActorUID.hpp"
+
+#include <vector>
+
+class Map;
+class Actor;
+
+//------------------------------------------------------------------------------------------------
+struct PerceptionEvent
+{
+	ActorUID					m_observer				= ActorUID::INVALID;
+	ActorUID					m_target				= ActorUID::INVALID;
+	bool						m_isSeen				= false;
+};
+
+//------------------------------------------------------------------------------------------------
+struct PerceptionQuery
+{
+	int							m_observerIndex			= -1;
+	int							m_targetIndex			= -1;
+	float						m_distanceSquared		= 0.0f;
+	bool						m_isVisible				= false;
+};
+
+//------------------------------------------------------------------------------------------------
+struct PerceptionSlice
+{
+	int							m_observerIndex			= -1;
+	int							m_firstQuery			= 0;
+	int							m_numQueries			= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Runs once per map tick on behalf of every AIController.
+// Targets are bucketed into a uniform grid, observers are visited round-robin
+// until the per-frame LOS budget is spent, and the resulting seen/lost
+// transitions are delivered to the controllers as events.
+//------------------------------------------------------------------------------------------------
+class AIPerception
+{
+public:
+	Map*							m_map						= nullptr;
+
+	float							m_cellSize					= 4.0f;
+	IntVec2							m_gridDimensions			= IntVec2::ZERO;
+	std::vector<int>				m_cellStart;
+	std::vector<int>				m_cellTargets;
+	std::vector<int>				m_targetCells;
+
+	std::vector<int>				m_observers;
+	size_t							m_observerCursor			= 0;
+	int								m_maxLOSChecksPerFrame		= 32;
+
+	std::vector<PerceptionQuery>	m_queries;
+	std::vector<PerceptionSlice>	m_slices;
+	std::vector<PerceptionEvent>	m_events;
+
+	int								m_numTargetsLastFrame		= 0;
+	int								m_numObserversLastFrame		= 0;
+	int								m_numLOSChecksLastFrame		= 0;
+	int								m_numEventsLastFrame		= 0;
+public:
+									AIPerception(Map* map);
+									~AIPerception();
+
+	void							Update();
+
+	void							BuildTargetGrid();
+	void							GatherObservers();
+	void							ExpireLostTargets();
+	void							GatherQueries();
+	void							ResolveQueries();
+	void							PublishEvents();
+	void							DispatchEvents(size_t firstEvent);
+
+	bool							IsValidTarget(Actor const* actor) const;
+	int								GetCellIndex(Vec2 const& position) const;
+};
@@ -0,0 +1,135 @@
+#include "Game/AIScheduler.hpp"
+
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include "Game/Map.hpp"
+#include "Game/Game.hpp"
+#include "Game/Actor.hpp"
+#include "Game/AIController.hpp"
+#include "Game/PlayerController.hpp"
+
+AIScheduler::AIScheduler(Map* map)
+	: m_map(map)
+{
+}
+
+AIScheduler::~AIScheduler()
+{
+}
+
+void AIScheduler::Update(float deltaseconds)
+{
+	PROFILE_SCOPE("AIScheduler::Update");
+	ScopedMemoryTag memoryTag(MemoryTag::AI);
+
+	m_frameNumber++;
+
+	for (int lod = 0; lod < (int)AILevelOfDetail::COUNT; lod++)
+	{
+		m_numAIPerLOD[lod] = 0;
+		m_numTicksPerLOD[lod] = 0;
+	}
+
+	m_playerPositions.clear();
+
+	for (int i = 0; i < m_map->m_game->m_numOfPlayers; i++)
+	{
+		if (m_map->m_game->m_playerController[i])
+		{
+			m_playerPositions.push_back(Vec2(m_map->m_game->m_playerController[i]->m_position.x, m_map->m_game->m_playerController[i]->m_position.y));
+		}
+	}
+
+	std::vector<Actor*> const& actors = m_map->m_actorList;
+
+	for (size_t index = 0; index < actors.size(); index++)
+	{
+		if (actors[index] == nullptr || actors[index]->m_aiController == nullptr)
+			continue;
+
+		AIController* controller = actors[index]->m_aiController;
+
+		if (controller->m_canSeeTarget || controller->m_isInAttackingRange)
+		{
+			controller->m_secondsSinceEngaged = 0.0f;
+		}
+		else
+		{
+			controller->m_secondsSinceEngaged += deltaseconds;
+		}
+
+		AILevelOfDetail lod = ClassifyAI(*actors[index]);
+
+		controller->m_lod = lod;
+		controller->m_lodTickSeconds = 0.0f;
+
+		switch (lod)
+		{
+		case AILevelOfDetail::FULL:
+			controller->m_lodTickSeconds = controller->m_lodAccumulatedSeconds + deltaseconds;
+			controller->m_lodAccumulatedSeconds = 0.0f;
+			break;
+		case AILevelOfDetail::REDUCED:
+			controller->m_lodAccumulatedSeconds += deltaseconds;
+
+			// Stagger by slot so reduced AIs spread across frames instead of all ticking together
+			if ((m_frameNumber + static_cast<unsigned int>(index)) % static_cast<unsigned int>(m_reducedTickInterval) == 0)
+			{
+				controller->m_lodTickSeconds = controller->m_lodAccumulatedSeconds;
+				controller->m_lodAccumulatedSeconds = 0.0f;
+			}
+			break;
+		default:
+			controller->m_lodAccumulatedSeconds = 0.0f;
+			break;
+		}
+
+		m_numAIPerLOD[(int)lod]++;
+
+		if (controller->m_lodTickSeconds > 0.0f)
+		{
+			m_numTicksPerLOD[(int)lod]++;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// An AI that sees its target runs at FULL. One that lost sight recently, or that could still
+// perceive a player, stays at REDUCED; a remembered target alone does not keep it awake.
+//------------------------------------------------------------------------------------------------
+AILevelOfDetail AIScheduler::ClassifyAI(Actor const& actor) const
+{
+	AIController const* controller = actor.m_aiController;
+
+	if (controller->m_canSeeTarget || controller->m_isInAttackingRange)
+		return AILevelOfDetail::FULL;
+
+	Vec2 position = Vec2(actor.m_position.x, actor.m_position.y);
+
+	float nearestDistanceSquared = -1.0f;
+
+	for (size_t i = 0; i < m_playerPositions.size(); i++)
+	{
+		float distanceSquared = GetDistanceSquared2D(position, m_playerPositions[i]);
+
+		if (nearestDistanceSquared < 0.0f || distanceSquared < nearestDistanceSquared)
+		{
+			nearestDistanceSquared = distanceSquared;
+		}
+	}
+
+	if (nearestDistanceSquared < 0.0f)
+		return AILevelOfDetail::FROZEN;
+
+	if (nearestDistanceSquared <= m_fullRadius * m_fullRadius)
+		return AILevelOfDetail::FULL;
+
+	float sightRadius = actor.m_definition.m_sightRadius;
+
+	if (nearestDistanceSquared <= sightRadius * sightRadius || controller->m_secondsSinceEngaged < m_engagedTimeoutSeconds)
+		return AILevelOfDetail::REDUCED;
+
+	return AILevelOfDetail::FROZEN;
+}
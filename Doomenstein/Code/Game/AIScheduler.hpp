@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Engine/Math/Vec2.hpp"
+
+#include <vector>
+
+class Map;
+class Actor;
+
+//------------------------------------------------------------------------------------------------
+enum class AILevelOfDetail : unsigned char
+{
+	FULL,
+	REDUCED,
+	FROZEN,
+	COUNT
+};
+
+//------------------------------------------------------------------------------------------------
+// Decides once per map tick how much simulation every AIController gets, based on what it can
+// see and its distance to the nearest player. FULL ticks every frame, REDUCED ticks every
+// m_reducedTickInterval frames with the skipped time accumulated, FROZEN does not tick at all.
+// Physics follows the same ticks.
+//------------------------------------------------------------------------------------------------
+class AIScheduler
+{
+public:
+	Map*							m_map						= nullptr;
+
+	float							m_fullRadius				= 12.0f;
+	float							m_engagedTimeoutSeconds		= 5.0f;
+	int								m_reducedTickInterval		= 4;
+	unsigned int					m_frameNumber				= 0;
+
+	std::vector<Vec2>				m_playerPositions;
+
+	int								m_numAIPerLOD[(int)AILevelOfDetail::COUNT]		= {};
+	int								m_numTicksPerLOD[(int)AILevelOfDetail::COUNT]	= {};
+public:
+									AIScheduler(Map* map);
+									~AIScheduler();
+
+	void							Update(float deltaseconds);
+
+	AILevelOfDetail					ClassifyAI(Actor const& actor) const;
+};
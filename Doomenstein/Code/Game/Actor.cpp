@@ -11,7 +11,6 @@
 #include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Shader.hpp"
-#include "Engine/Renderer/SpriteAnimDefinition.hpp"
 
 #include "Game/GameCommon.hpp"
 #include "Game/Map.hpp"
@@ -25,90 +24,66 @@
 
 ActorDefinition ActorDefinition::s_actorDefinitions[7];
 
-Actor::Actor()
-{
-}
+static char const* const ACTOR_ANIM_NAMES[(int)ActorAnim::COUNT] = { "Walk", "Attack", "Hurt", "Death" };
 
-void Actor::PlayAnimation(Camera cameraPosition)
+void Actor::PlayAnimation()
 {
-	for (int i = 0; i < m_map->m_game->m_numOfPlayers; i++)
+	float animDuration = GetAnimDuration();
+
+	if (m_isActorProjectile)
 	{
-		if (m_map->m_game->m_playerController[i] != nullptr)
+		if (!m_isProjectileDead)
 		{
-			Vec3 direction = (m_position - cameraPosition.m_position).GetNormalized();
-			int desiredDirIndex = 0;
-			float maxDot = 0.0f;
-	
-			Mat44 transform = GetModelMatrix().GetOrthonormalInverse();
-	
-			Vec3 localDir = transform.TransformVectorQuantity3D(direction) * -1.0f;
-	
-			for (size_t j = 0; j < m_currentAnimGrp->m_spriteDirection.size(); j++)
-			{
-				if (DotProduct3D(localDir.GetNormalized(), m_currentAnimGrp->m_spriteDirection[j]) > maxDot)
-				{
-					maxDot = DotProduct3D(localDir.GetNormalized(), m_currentAnimGrp->m_spriteDirection[j]);
-					desiredDirIndex = (int)j;
-				}
-			}
-	
-			m_animDuration = m_currentAnimGrp->m_spriteAnimDefs[desiredDirIndex]->GetDuration();
-	
-			if (m_isActorProjectile)
-			{
-				if (!m_isProjectileDead)
-				{
-					if (m_animTime >= m_animDuration)
-						m_animTime = 0.0f;
-				}
-			}
-			else
-			{
-				if (!m_isActorCorpse)
-				{
-					if (m_animTime >= m_animDuration)
-						m_animTime = 0.0f;
-				}
-			}
+			if (m_animTime >= animDuration)
+				m_animTime = 0.0f;
+		}
+	}
+	else
+	{
+		if (!m_isActorCorpse)
+		{
+			if (m_animTime >= animDuration)
+				m_animTime = 0.0f;
 		}
 	}
 }
 
-void Actor::RenderAnimation(Camera cameraPosition) const
+float Actor::GetAnimDuration() const
 {
-	Vec3 direction = (cameraPosition.m_position - m_position).GetNormalized();
-	Vec2 uvMins, uvMaxs;
-	//int desiredDirIndex = 0;
-	//float maxDot = -1.0f;
+	SpriteAnimGroupDefinition const* animGroup = m_definition.GetAnimGroup(m_anim);
 
-	//Mat44 transformDir = GetModelMatrix().GetOrthonormalInverse();
-	//
-	//Vec3 localDir = transformDir.TransformVectorQuantity3D(direction) * -1.0f;
-	//
-	//for (size_t j = 0; j < m_currentAnimGrp->m_spriteDirection.size(); j++)
-	//{
-	//	if (DotProduct3D(localDir.GetNormalized(), m_currentAnimGrp->m_spriteDirection[j]) > maxDot)
-	//	{
-	//		maxDot = DotProduct3D(localDir.GetNormalized(), m_currentAnimGrp->m_spriteDirection[j]);
-	//		desiredDirIndex = (int)j;
-	//	}
-	//}
-	//
-	//m_currentAnimGrp->m_spriteAnimDefs[desiredDirIndex]->GetSpriteDefAtTime(m_animTime).GetUVs(uvMins, uvMaxs);
-	//
-	//if (m_definition.m_name == "Marine" || m_definition.m_name == "Demon")
-	//{
-	//	Vec2 tempUVMin = uvMins;
-	//	Vec2 tempUVMax = uvMaxs;
-	//
-	//	uvMins.y = 1.0f - tempUVMax.y;
-	//	uvMaxs.y = 1.0f - tempUVMin.y;
-	//}
+	if (animGroup == nullptr)
+		return 0.0f;
+
+	return animGroup->GetDuration();
+}
+
+void Actor::RenderAnimation(Camera cameraPosition, unsigned char viewOctant) const
+{
+	AABB2 uvs = AABB2::ZERO_TO_ONE;
+	SpriteAnimGroupDefinition const* animGroup = m_definition.GetAnimGroup(m_anim);
+
+	if (animGroup && m_definition.m_spriteSheetData)
+	{
+		int spriteIndex = animGroup->GetSpriteIndexAtTime(animGroup->GetDirectionIndexForOctant(viewOctant), m_animTime);
+		uvs = m_definition.m_spriteSheetData->GetSpriteUVs(spriteIndex);
+
+		if (m_definition.m_name == "Marine" || m_definition.m_name == "Demon")
+		{
+			float tempUVMinY = uvs.m_mins.y;
+
+			uvs.m_mins.y = 1.0f - uvs.m_maxs.y;
+			uvs.m_maxs.y = 1.0f - tempUVMinY;
+		}
+	}
 	
-	std::vector<Vertex_PCUTBN> actorVerts;
-	std::vector<unsigned int> actorIndices;
+	FrameVector<Vertex_PCUTBN> actorVerts;
+	FrameVector<unsigned int> actorIndices;
 
-	AddQuadVertsAndIndices(actorVerts, actorIndices);
+	actorVerts.reserve(6);
+	actorIndices.reserve(12);
+
+	AddQuadVertsAndIndices(actorVerts, actorIndices, uvs);
 
 	Mat44 transform;
 
@@ -141,7 +116,7 @@ void Actor::RenderAnimation(Camera cameraPosition) const
 
 	if (!m_isWeak)
 	{
-		g_theRenderer->BindTexture(&m_spriteSheet->GetTexture());
+		g_theRenderer->BindTexture(&m_definition.m_spriteSheetData->GetTexture());
 	}
 	else
 	{
@@ -149,12 +124,12 @@ void Actor::RenderAnimation(Camera cameraPosition) const
 		g_theRenderer->BindTexture(texture);
 	}
 
-	g_theRenderer->DrawVertexArrayIndexed((int)actorVerts.size(), actorVerts.data(), actorIndices);
+	g_theRenderer->DrawVertexArrayIndexed((int)actorVerts.size(), actorVerts.data(), (int)actorIndices.size(), actorIndices.data());
 }
 
-Actor::Actor(ActorDefinition definition, Map* owner, Vec3 position, EulerAngles orientation, Rgba8 color)
+Actor::Actor(ActorDefinition const& definition, Map* owner, Vec3 position, EulerAngles orientation, Rgba8 color)
+	: m_definition(definition)
 {
-	m_definition = definition;
 	m_position = position;
 	m_orientation = orientation;
 	m_color = color;
@@ -191,24 +166,6 @@ Actor::Actor(ActorDefinition definition, Map* owner, Vec3 position, EulerAngles
 	if(!m_definition.m_shader.empty())
 		m_shader = g_theRenderer->CreateShader(m_definition.m_shader.c_str(), VertexType::PCUTBN);
 
-	if (!m_definition.m_spriteSheet.empty())
-	{
-		Texture* texture = g_theRenderer->CreateOrGetTextureFromFile(m_definition.m_spriteSheet.c_str());
-		m_spriteSheet = new SpriteSheet(*texture, m_definition.m_cellCount);
-	}
-
-	if (m_definition.m_name != "SpawnPoint" && m_definition.m_name != "PlasmaProjectile")
-	{
-		//m_currentAnimGrp = &m_definition.m_spriteAnimGrpDefs[0];
-		//m_animDuration = m_currentAnimGrp->m_spriteAnimDefs[0]->GetDuration();
-	}
-
-	if (m_definition.m_name == "PlasmaProjectile")
-	{
-		m_currentAnimGrp = &m_definition.m_spriteAnimGrpDefs[0];
-		m_animDuration = m_currentAnimGrp->m_spriteAnimDefs[0]->GetDuration();
-	}
-
 	m_quadVBO = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN));
 	m_quadIBO = g_theRenderer->CreateIndexBuffer(sizeof(unsigned int));
 }
@@ -218,10 +175,32 @@ Actor::~Actor()
 	DELETE_PTR(m_quadVBO);
 	DELETE_PTR(m_quadIBO);
 	DELETE_PTR(m_shader);
-	DELETE_PTR(m_spriteSheet);
 }
 
-void Actor::Update(float deltaseconds, Camera cameraPosition)
+void Actor::Respawn(Vec3 position, EulerAngles orientation)
+{
+	m_position = position;
+	m_orientation = orientation;
+	m_velocity = Vec3::ZERO;
+	m_accelaration = Vec3::ZERO;
+	m_health = m_definition.m_health;
+	m_projectileOwner = nullptr;
+	m_actorLifetime = 0.0f;
+	m_projectileLifetime = 0.0f;
+	m_isActorCorpse = false;
+	m_isProjectileDead = false;
+	m_isWeak = false;
+	m_isDead = false;
+	m_anim = ActorAnim::WALK;
+	m_animTime = 0.0f;
+
+	if (m_aiController)
+	{
+		m_aiController->Reset();
+	}
+}
+
+void Actor::Update(float deltaseconds)
 {
 	if (m_isActorProjectile)
 	{
@@ -229,7 +208,7 @@ void Actor::Update(float deltaseconds, Camera cameraPosition)
 		{
 			if (m_isProjectileDead)
 			{
-				m_animName = "Death";
+				m_anim = ActorAnim::DEATH;
 
 				static int flag = 0;
 
@@ -239,9 +218,7 @@ void Actor::Update(float deltaseconds, Camera cameraPosition)
 					flag++;
 				}
 
-				m_currentAnimGrp = &m_definition.m_spriteAnimGrpDefs[1];
-
-				if (m_animTime >= m_currentAnimGrp->m_spriteAnimDefs[0]->GetDuration())
+				if (m_animTime >= GetAnimDuration())
 				{
 					m_isDead = true;
 					flag = 0;
@@ -270,7 +247,7 @@ void Actor::Update(float deltaseconds, Camera cameraPosition)
 				m_position += m_velocity * deltaseconds;
 			}
 
-			PlayAnimation(cameraPosition);
+			PlayAnimation();
 		}
 	}
 	else if(m_definition.m_name == "Marine" || m_definition.m_name == "RedGhost" || m_definition.m_name == "GreenGhost" || m_definition.m_name == "BlueGhost")
@@ -373,9 +350,12 @@ void Actor::Update(float deltaseconds, Camera cameraPosition)
 				{
 					//m_aiController->GetActor()->m_animTime += deltaseconds;
 
-					m_aiController->Update(deltaseconds);
-
-					UpdatePhysics(deltaseconds);
+					// Physics steps with the controller, so REDUCED actors integrate their skipped frames in one step
+					if (m_aiController->m_lodTickSeconds > 0.0f)
+					{
+						m_aiController->Update(m_aiController->m_lodTickSeconds);
+						UpdatePhysics(m_aiController->m_lodTickSeconds);
+					}
 
 					//if (m_aiController->m_targetUID == ActorUID::INVALID)
 					//	m_animTime = 0.0f;
@@ -410,18 +390,18 @@ void Actor::Update(float deltaseconds, Camera cameraPosition)
 	//}
 }
 
-void Actor::Render(Camera cameraPosition) const
+void Actor::Render(Camera cameraPosition, unsigned char viewOctant) const
 {
 	if (!m_isDead)
 	{
 		if (m_definition.m_name != "SpawnPoint")
 		{
-			RenderBillBoardQuad(cameraPosition);
+			RenderBillBoardQuad(cameraPosition, viewOctant);
 		}
 	}
 }
 
-void Actor::AddQuadVertsAndIndices(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indices, AABB2 const& uvs) const
+void Actor::AddQuadVertsAndIndices(FrameVector<Vertex_PCUTBN>& verts, FrameVector<unsigned int>& indices, AABB2 const& uvs) const
 {
 	Vec2 dims = Vec2(m_definition.m_size.x * 0.5f, m_definition.m_size.y);
 
@@ -457,18 +437,9 @@ void Actor::AddQuadVertsAndIndices(std::vector<Vertex_PCUTBN>& verts, std::vecto
 	indices.push_back(1);
 }
 
-void Actor::RenderBillBoardQuad(Camera cameraPosition) const
+void Actor::RenderBillBoardQuad(Camera cameraPosition, unsigned char viewOctant) const
 {
-	if (this != nullptr)
-	{
-		for (int i = 0; i < m_map->m_game->m_numOfPlayers; i++)
-		{
-			if ((m_map->m_game->m_playerController[i]))
-			{
-				RenderAnimation(cameraPosition);
-			}
-		}
-	}
+	RenderAnimation(cameraPosition, viewOctant);
 }
 
 Mat44 Actor::GetModelMatrix() const
@@ -505,7 +476,7 @@ void ActorDefinition::InitializeDefs()
 {
 	XmlDocument tileDoc;
 
-	XmlError result = tileDoc.LoadFile("Data/Definitions/ActorDefinitions.xml");
+	XmlError result = LoadXmlDocument(tileDoc, "Data/Definitions/ActorDefinitions.xml");
 
 	if (result != tinyxml2::XML_SUCCESS)
 		GUARANTEE_OR_DIE(false, "COULD NOT LOAD XML");
@@ -700,67 +671,7 @@ void ActorDefinition::InitializeDefs()
 			s_actorDefinitions[index].m_spriteSheet = ParseXmlAttribute(*visualsElement, "spriteSheet", s_actorDefinitions[index].m_spriteSheet);
 			s_actorDefinitions[index].m_cellCount = ParseXmlAttribute(*visualsElement, "cellCount", s_actorDefinitions[index].m_cellCount);
 
-			XmlElement* animGrp = visualsElement->FirstChildElement();
-
-			while (animGrp)
-			{
-				std::string name = std::string(animGrp->Name());
-				SpriteAnimGroupDefinition* spriteAnimGrp = new SpriteAnimGroupDefinition();
-
-				if (name == "AnimationGroup")
-				{
-					s_actorDefinitions[index].m_animGrpName		= ParseXmlAttribute(*animGrp, "name", s_actorDefinitions[index].m_animGrpName);
-					s_actorDefinitions[index].m_scaleBySpeed = ParseXmlAttribute(*animGrp, "scaleBySpeed", s_actorDefinitions[index].m_scaleBySpeed);
-					s_actorDefinitions[index].m_secondsPerFrame = ParseXmlAttribute(*animGrp, "secondsPerFrame", s_actorDefinitions[index].m_secondsPerFrame);
-					s_actorDefinitions[index].m_playbackMode = ParseXmlAttribute(*animGrp, "playbackMode", s_actorDefinitions[index].m_playbackMode);
-
-					spriteAnimGrp->m_name = s_actorDefinitions[index].m_animGrpName;
-					spriteAnimGrp->m_scaleBySpeed = s_actorDefinitions[index].m_scaleBySpeed;
-					spriteAnimGrp->m_secondsPerFrame = s_actorDefinitions[index].m_secondsPerFrame;
-					spriteAnimGrp->m_playbackMode = s_actorDefinitions[index].m_playbackMode;
-
-					XmlElement* animGrpDir = animGrp->FirstChildElement();
-
-					while (animGrpDir)
-					{
-						name = std::string(animGrp->FirstChildElement()->Name());
-
-						if (name == "Direction")
-						{
-							Vec3 direction = ParseXmlAttribute(*animGrpDir, "vector", Vec3::ZERO);
-
-							spriteAnimGrp->m_spriteDirection.push_back(direction.GetNormalized());
-						}
-
-						if (animGrpDir->FirstChildElement())
-						{
-							name = std::string(animGrpDir->FirstChildElement()->Name());
-
-							if (name == "Animation")
-							{
-								Texture* spriteTexture = g_theRenderer->CreateOrGetTextureFromFile(s_actorDefinitions[index].m_spriteSheet.c_str());
-								SpriteSheet* spriteSheet = new SpriteSheet(*spriteTexture, s_actorDefinitions[index].m_cellCount);
-								spriteSheet->CalculateUVsOfSpriteSheet();
-
-								int startIndex = ParseXmlAttribute(*animGrpDir->FirstChildElement(), "startFrame", -1);
-								int endIndex  = ParseXmlAttribute(*animGrpDir->FirstChildElement(), "endFrame", -1);
-
-								float duration = (endIndex - startIndex + 1) * s_actorDefinitions[index].m_secondsPerFrame;
-
-								SpriteAnimDefinition* spriteAnim = new SpriteAnimDefinition(*spriteSheet, startIndex, endIndex, duration);
-								 
-								spriteAnimGrp->m_spriteAnimDefs.push_back(spriteAnim);
-							}
-						}
-
-						animGrpDir = animGrpDir->NextSiblingElement();
-					}
-
-					s_actorDefinitions[index].m_spriteAnimGrpDefs.push_back(*spriteAnimGrp);
-				}
-
-				animGrp = animGrp->NextSiblingElement();
-			}
+			s_actorDefinitions[index].LoadAnimationGroups(*visualsElement);
 
 			if (visualsElement->NextSiblingElement())
 			{
@@ -812,14 +723,17 @@ ActorDefinition* ActorDefinition::GetDefByName(std::string actorName)
 		}
 	}
 
-	return new ActorDefinition();  
-}   
+	// A shared placeholder, so an unknown name no longer leaks a fresh definition on every lookup
+	static ActorDefinition s_unknownDefinition;
+
+	return &s_unknownDefinition;
+}
 
 void ActorDefinition::InitializeProjectileDefs()
 {
 	XmlDocument tileDoc;
 
-	XmlError result = tileDoc.LoadFile("Data/Definitions/ProjectileActorDefinitions.xml");
+	XmlError result = LoadXmlDocument(tileDoc, "Data/Definitions/ProjectileActorDefinitions.xml");
 
 	if (result != tinyxml2::XML_SUCCESS)
 		GUARANTEE_OR_DIE(false, "COULD NOT LOAD XML");
@@ -859,69 +773,69 @@ void ActorDefinition::InitializeProjectileDefs()
 	s_actorDefinitions[5].m_spriteSheet = ParseXmlAttribute(*visualsElement, "spriteSheet", s_actorDefinitions[5].m_spriteSheet);
 	s_actorDefinitions[5].m_cellCount = ParseXmlAttribute(*visualsElement, "cellCount", s_actorDefinitions[5].m_cellCount);
 
-	XmlElement* animGrp = visualsElement->FirstChildElement();
+	s_actorDefinitions[5].LoadAnimationGroups(*visualsElement);
+}
 
-	while (animGrp)
+void ActorDefinition::ClearDefs()
+{
+	for (int index = 0; index < 7; index++)
 	{
-		std::string name = std::string(animGrp->Name());
-		SpriteAnimGroupDefinition* spriteAnimGrp = new SpriteAnimGroupDefinition();
-
-		if (name == "AnimationGroup")
-		{
-			s_actorDefinitions[5].m_animGrpName = ParseXmlAttribute(*animGrp, "name", s_actorDefinitions[5].m_animGrpName);
-			s_actorDefinitions[5].m_scaleBySpeed = ParseXmlAttribute(*animGrp, "scaleBySpeed", s_actorDefinitions[5].m_scaleBySpeed);
-			s_actorDefinitions[5].m_secondsPerFrame = ParseXmlAttribute(*animGrp, "secondsPerFrame", s_actorDefinitions[5].m_secondsPerFrame);
-			s_actorDefinitions[5].m_playbackMode = ParseXmlAttribute(*animGrp, "playbackMode", s_actorDefinitions[5].m_playbackMode);
-
-			spriteAnimGrp->m_name = s_actorDefinitions[5].m_animGrpName;
-			spriteAnimGrp->m_scaleBySpeed = s_actorDefinitions[5].m_scaleBySpeed;
-			spriteAnimGrp->m_secondsPerFrame = s_actorDefinitions[5].m_secondsPerFrame;
-			spriteAnimGrp->m_playbackMode = s_actorDefinitions[5].m_playbackMode;
-
-			XmlElement* animGrpDir = animGrp->FirstChildElement();
-
-			while (animGrpDir)
-			{
-				name = std::string(animGrp->FirstChildElement()->Name());
+		DELETE_PTR(s_actorDefinitions[index].m_spriteSheetData);
+		s_actorDefinitions[index].m_spriteAnimGrpDefs.clear();
+	}
+}
 
-				if (name == "Direction")
-				{
-					Vec3 direction = ParseXmlAttribute(*animGrpDir, "vector", Vec3::ZERO);
+void ActorDefinition::LoadAnimationGroups(XmlElement const& visualsElement)
+{
+	m_spriteAnimGrpDefs.clear();
 
-					spriteAnimGrp->m_spriteDirection.push_back(direction.GetNormalized());
-				}
+	DELETE_PTR(m_spriteSheetData);
 
-				if (animGrpDir->FirstChildElement())
-				{
-					name = std::string(animGrpDir->FirstChildElement()->Name());
+	if (!m_spriteSheet.empty())
+	{
+		Texture* spriteTexture = g_theRenderer->CreateOrGetTextureFromFile(m_spriteSheet.c_str());
+		m_spriteSheetData = new SpriteSheet(*spriteTexture, m_cellCount);
+	}
 
-					if (name == "Animation")
-					{
-						Texture* spriteTexture = g_theRenderer->CreateOrGetTextureFromFile(s_actorDefinitions[5].m_spriteSheet.c_str());
-						SpriteSheet* spriteSheet = new SpriteSheet(*spriteTexture, s_actorDefinitions[5].m_cellCount);
-						spriteSheet->CalculateUVsOfSpriteSheet();
+	XmlElement const* animGrp = visualsElement.FirstChildElement("AnimationGroup");
 
-						int startIndex = ParseXmlAttribute(*animGrpDir->FirstChildElement(), "startFrame", -1);
-						int endIndex = ParseXmlAttribute(*animGrpDir->FirstChildElement(), "endFrame", -1);
+	while (animGrp)
+	{
+		SpriteAnimGroupDefinition spriteAnimGrp;
 
-						float duration = (endIndex - startIndex + 1) * s_actorDefinitions[5].m_secondsPerFrame;
+		if (spriteAnimGrp.LoadFromXmlElement(*animGrp))
+		{
+			m_spriteAnimGrpDefs.push_back(spriteAnimGrp);
+		}
 
-						SpriteAnimDefinition* spriteAnim = new SpriteAnimDefinition(*spriteSheet, startIndex, endIndex, duration);
+		animGrp = animGrp->NextSiblingElement("AnimationGroup");
+	}
 
-						spriteAnimGrp->m_spriteAnimDefs.push_back(spriteAnim);
-					}
-				}
+	for (int animIndex = 0; animIndex < (int)ActorAnim::COUNT; animIndex++)
+	{
+		m_animGroupIndex[animIndex] = -1;
 
-				animGrpDir = animGrpDir->NextSiblingElement();
+		for (size_t i = 0; i < m_spriteAnimGrpDefs.size(); i++)
+		{
+			if (m_spriteAnimGrpDefs[i].m_name == ACTOR_ANIM_NAMES[animIndex])
+			{
+				m_animGroupIndex[animIndex] = (int)i;
+				break;
 			}
-
-			s_actorDefinitions[5].m_spriteAnimGrpDefs.push_back(*spriteAnimGrp);
 		}
-
-		animGrp = animGrp->NextSiblingElement();
 	}
 }
 
+SpriteAnimGroupDefinition const* ActorDefinition::GetAnimGroup(ActorAnim anim) const
+{
+	int groupIndex = m_animGroupIndex[(int)anim];
+
+	if (groupIndex < 0)
+		return nullptr;
+
+	return &m_spriteAnimGrpDefs[groupIndex];
+}
+
 void Actor::UpdatePhysics(float deltaseconds)
 {
 	AddForce(m_velocity * -1.0f * m_definition.m_drag);
@@ -935,7 +849,7 @@ void Actor::UpdatePhysics(float deltaseconds)
 void Actor::Damage(float damage)
 {
 	m_health -= damage;
-	m_animName = "Hurt";
+	m_anim = ActorAnim::HURT;
 }
 
 void Actor::AddForce(Vec3 forceValue)
@@ -9,6 +9,7 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Core/LinearAllocator.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/SpriteAnimGroupDefinition.hpp"
 
@@ -25,10 +26,18 @@ class AIController;
 class Timer;
 class Shader;
 class SpriteSheet;
-class SpriteAnimDefinition;
 class VertexBuffer;
 class IndexBuffer;
 
+enum class ActorAnim : unsigned char
+{
+	WALK,
+	ATTACK,
+	HURT,
+	DEATH,
+	COUNT
+};
+
 struct ActorDefinition
 {
 	std::string								m_name;
@@ -73,12 +82,10 @@ struct ActorDefinition
 	std::string								m_shader;
 	std::string								m_spriteSheet;
 	IntVec2									m_cellCount;
+	SpriteSheet*							m_spriteSheetData = nullptr;
 		//AnimationGroup
-	std::string								m_animGrpName;
-	bool									m_scaleBySpeed = false;
-	float									m_secondsPerFrame;
-	std::string								m_playbackMode;	
 	std::vector<SpriteAnimGroupDefinition>	m_spriteAnimGrpDefs;
+	int										m_animGroupIndex[(int)ActorAnim::COUNT] = {-1, -1, -1, -1};
 
 	//Sound
 	std::string								m_sound;
@@ -90,16 +97,20 @@ struct ActorDefinition
 
 	static ActorDefinition					s_actorDefinitions[7];
 
+	SpriteAnimGroupDefinition const*		GetAnimGroup(ActorAnim anim) const;
+	void									LoadAnimationGroups(XmlElement const& visualsElement);
+
 	static ActorDefinition*					GetDefByName(std::string actorName);
 	static void								InitializeProjectileDefs();
 	static void								InitializeDefs();
+	static void								ClearDefs();
 };
 
 class Actor
 {
 public:
 	ActorUID					m_UID;
-	ActorDefinition				m_definition;
+	ActorDefinition const&		m_definition;
 	Map*						m_map					= nullptr;
 	Vec3						m_position;
 	Vec3						m_velocity;
@@ -113,7 +124,6 @@ public:
 	bool						m_isActorCorpse			= false;
 	Rgba8						m_color;
 	float						m_physicsHeight			= 0.0f;
-	SpriteAnimGroupDefinition*	m_currentAnimGrp		= nullptr;
 	float						m_physicsRadius			= 0.0f;
 	bool						m_isMovable				= false;
 	float						m_projectileLifetime	= 0.0f;
@@ -123,28 +133,27 @@ public:
 	bool						m_isWeak				= false;
 	bool						m_isDead				= false;
 	float						m_health;
-	std::string					m_animName				= "Walk";
+	ActorAnim					m_anim					= ActorAnim::WALK;
 	float						m_animTime				= 0.0f;
-	float						m_animDuration			= 0.0f;
 	VertexBuffer*				m_quadVBO				= nullptr;
 	IndexBuffer*				m_quadIBO				= nullptr;
 	Shader*						m_shader				= nullptr;
-	SpriteSheet*				m_spriteSheet			= nullptr;
-	SpriteAnimDefinition*		m_actorAnim				= nullptr;
 public:
-								Actor();
-								Actor(ActorDefinition definition, Map* owner, Vec3 position, EulerAngles orientation, Rgba8 color);
+								Actor(ActorDefinition const& definition, Map* owner, Vec3 position, EulerAngles orientation, Rgba8 color);
 								~Actor();
 
-	void						AddQuadVertsAndIndices(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indices, AABB2 const& uvs = AABB2::ZERO_TO_ONE) const;
+	void						AddQuadVertsAndIndices(FrameVector<Vertex_PCUTBN>& verts, FrameVector<unsigned int>& indices, AABB2 const& uvs = AABB2::ZERO_TO_ONE) const;
+
+	void						Respawn(Vec3 position, EulerAngles orientation);
 
-	void						Update(float deltaseconds, Camera cameraPosition);
-	void						Render(Camera cameraPosition) const;
+	void						Update(float deltaseconds);
+	void						Render(Camera cameraPosition, unsigned char viewOctant = 0) const;
 
-	void						PlayAnimation(Camera cameraPosition);
-	void						RenderAnimation(Camera cameraPosition) const;
+	void						PlayAnimation();
+	void						RenderAnimation(Camera cameraPosition, unsigned char viewOctant) const;
+	float						GetAnimDuration() const;
 
-	void						RenderBillBoardQuad(Camera cameraPosition) const;
+	void						RenderBillBoardQuad(Camera cameraPosition, unsigned char viewOctant) const;
 
 	Mat44						GetModelMatrix() const;
 	bool						IsMovable();
@@ -44,5 +44,16 @@ Actor* ActorUID::operator->() const
 
 Actor* ActorUID::GetActor() const
 {
-	return g_currentMap->m_actorList[GetIndex()];
+	unsigned int index = GetIndex();
+
+	if (index >= g_currentMap->m_actorList.size())
+		return nullptr;
+
+	Actor* actor = g_currentMap->m_actorList[index];
+
+	// Slots are reused, so a stale handle must not resolve to whoever lives there now
+	if (actor == nullptr || actor->m_UID != *this)
+		return nullptr;
+
+	return actor;
 }
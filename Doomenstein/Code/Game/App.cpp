@@ -6,8 +6,15 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/DebugRender.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Core/CoreBenchmarks.hpp"
+#include "Engine/Core/LinearAllocator.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
@@ -41,11 +48,28 @@ App::~App()
 
 void App::StartUp()
 {
+	ScopedMemoryTag memoryTag(MemoryTag::ENGINE);
+
+	FileMountArchive("Data.pak");
+
 	InitializeGameConfigurations("Data/GameConfig.xml");
 
 	EventSystemConfig eventSystemConfig;
 	g_theEventSystem = new EventSystem(eventSystemConfig);
 
+#if !defined(ENGINE_DISABLE_PROFILER)
+	ProfilerConfig profilerConfig;
+	g_theProfiler = new Profiler(profilerConfig);
+#endif
+
+	JobSystemConfig jobSystemConfig;
+	jobSystemConfig.m_numOfWorkerThreads = (int)std::thread::hardware_concurrency() - 1;
+	if (jobSystemConfig.m_numOfWorkerThreads < 1)
+	{
+		jobSystemConfig.m_numOfWorkerThreads = 1;
+	}
+	g_theJobSystem = new JobSystem(jobSystemConfig);
+
 	DevConsoleConfig consoleConfig;
 	consoleConfig.m_fontFilePath = "Data/Fonts/SquirrelFixedFont.png";
 	g_theConsole = new DevConsole(consoleConfig);
@@ -70,6 +94,12 @@ void App::StartUp()
 
 	g_theEventSystem->StartUp();
 	g_theConsole->StartUp();
+#if !defined(ENGINE_DISABLE_PROFILER)
+	g_theProfiler->StartUp();
+#endif
+	MemoryTrackerStartup();
+	CoreBenchmarksStartup();
+	g_theJobSystem->StartUp();
 	g_theInputSystem->StartUp();
 	g_theWindow->StartUp();
 	g_theRenderer->StartUp();
@@ -96,12 +126,17 @@ void App::Run()
 void App::ShutDown()
 {
 	g_theGame->Shutdown();
+	FileUtilsShutdown();
 	g_theAudio->Shutdown();
 	g_theRenderer->ShutDown();
 	g_theWindow->ShutDown();
 	g_theInputSystem->ShutDown();
 	g_theConsole->ShutDown();
 	g_theEventSystem->ShutDown();
+	g_theJobSystem->ShutDown();
+#if !defined(ENGINE_DISABLE_PROFILER)
+	g_theProfiler->ShutDown();
+#endif
 
 	DELETE_PTR(g_theGame);
 	DELETE_PTR(g_theConsole);
@@ -110,6 +145,14 @@ void App::ShutDown()
 	DELETE_PTR(g_theAudio);
 	DELETE_PTR(g_theWindow);
 	DELETE_PTR(g_theInputSystem);
+	DELETE_PTR(g_theJobSystem);
+#if !defined(ENGINE_DISABLE_PROFILER)
+	DELETE_PTR(g_theProfiler);
+#endif
+
+	FileUnmountArchives();
+
+	MemoryTrackerShutdown();
 }
 
 void App::RunFrame()
@@ -124,6 +167,16 @@ void App::RunFrame()
 
 void App::BeginFrame()
 {
+#if !defined(ENGINE_DISABLE_PROFILER)
+	g_theProfiler->BeginFrame();
+#endif
+
+	PROFILE_SCOPE("App::BeginFrame");
+
+	MemoryTrackerBeginFrame();
+	FrameAllocatorBeginFrame();
+	FileUtilsBeginFrame();
+
 	g_theEventSystem->BeginFrame();
 	g_theConsole->BeginFrame();
 	g_theWindow->BeginFrame();
@@ -136,6 +189,8 @@ void App::BeginFrame()
 
 void App::Update(float deltaseconds)
 {
+	PROFILE_SCOPE("App::Update");
+
 	if (g_theConsole->IsOpen())
 	{
 		g_theInputSystem->SetCursorMode(false, false);
@@ -209,6 +264,8 @@ void App::Update(float deltaseconds)
 
 void App::Render() const
 {
+	PROFILE_SCOPE("App::Render");
+
 	g_theRenderer->ClearScreen(Rgba8(25, 25, 25, 255));
 	g_theGame->Render();
 
@@ -224,14 +281,22 @@ void App::Render() const
 
 void App::EndFrame()
 {
-	g_theAudio->EndFrame();
-	g_theRenderer->EndFrame();
-	g_theWindow->EndFrame();
-	g_theInputSystem->EndFrame();
-	g_theConsole->EndFrame();
-	g_theEventSystem->EndFrame();
-
-	DebugRenderEndFrame();
+	{
+		PROFILE_SCOPE("App::EndFrame");
+
+		g_theAudio->EndFrame();
+		g_theRenderer->EndFrame();
+		g_theWindow->EndFrame();
+		g_theInputSystem->EndFrame();
+		g_theConsole->EndFrame();
+		g_theEventSystem->EndFrame();
+
+		DebugRenderEndFrame();
+	}
+
+#if !defined(ENGINE_DISABLE_PROFILER)
+	g_theProfiler->EndFrame();
+#endif
 }
 
 void App::HandleKeyPressed(unsigned char keyCode)
@@ -254,7 +319,7 @@ void App::InitializeGameConfigurations(char const* dataFilePath)
 {
 	XmlDocument gameConfigFile;
 
-	XmlError result = gameConfigFile.LoadFile(dataFilePath);
+	XmlError result = LoadXmlDocument(gameConfigFile, dataFilePath);
 
 	if (result != tinyxml2::XML_SUCCESS)
 		GUARANTEE_OR_DIE(false, "COULD NOT LOAD XML");
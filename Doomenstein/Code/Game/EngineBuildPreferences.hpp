@@ -9,6 +9,9 @@
 //
 
 //#define ENGINE_DISABLE_AUDIO	// (If uncommented) Disables AudioSystem code and fmod linkage.
+//#define ENGINE_DISABLE_PROFILER	// (If uncommented) Compiles out the Profiler and every PROFILE_ macro.
+//#define ENGINE_MEMORY_LEAK_REPORT	// (If uncommented) Links every heap block into a list and reports tagged leaks at shutdown.
+//#define ENGINE_DISABLE_MEMORY_TRACKER	// (If uncommented) Keeps the CRT operator new/delete, so heap blocks carry no tracking header.
 
 #if defined(_DEBUG)
 #define ENGINE_DEBUG_RENDER
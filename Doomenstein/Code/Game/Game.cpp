@@ -5,6 +5,9 @@
 #include "Game/Actor.hpp"
 #include "Game/Weapon.hpp"
 #include "Game/Map.hpp"
+#include "Game/AIScheduler.hpp"
+#include "Game/AIPerception.hpp"
+#include "Game/WaveSpawner.hpp"
 
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -16,6 +19,8 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Texture.hpp"
 
@@ -52,23 +57,35 @@ void Game::StartUp()
 
 	g_theAudio->SetNumListeners(2);
 
-	WeaponDefinition::InitializeDefs();
-	ActorDefinition::InitializeDefs();
-	MapDefinition::InitializeDef();
+	{
+		ScopedMemoryTag memoryTag(MemoryTag::ASSETS);
+
+		WeaponDefinition::InitializeDefs();
+		ActorDefinition::InitializeDefs();
+		MapDefinition::InitializeDef();
+	}
 
 	EnterAttract();
 	AttractScreenBloom();
 	ConsoleControls();
+
+	SubscribeEventCallbackFunction("AISTATS", Game::Command_AIStats);
+	SubscribeEventCallbackFunction("SPAWNSTRESS", Game::Command_SpawnStress);
 }
 
 void Game::Shutdown()
 {
 	DELETE_PTR(g_currentMap);
 	DELETE_PTR(m_screenCamera);
+
+	ActorDefinition::ClearDefs();
+	WeaponDefinition::ClearDefs();
 }
 
 void Game::Update(float deltaseconds)
 {
+	PROFILE_SCOPE("Game::Update");
+
 	static float rate = 0.0f;
 	rate += 100.0f * deltaseconds;
 	m_thickness = 5.0f * fabsf(SinDegrees(rate));
@@ -90,6 +107,8 @@ void Game::Update(float deltaseconds)
 
 void Game::Render() const
 {
+	PROFILE_SCOPE("Game::Render");
+
 	if (m_currentState == GameState::ATTRACT)
 	{
 		g_theRenderer->BeginCamera(*m_screenCamera);
@@ -154,6 +173,7 @@ void Game::EnterAttract()
 
 	if(g_currentMap == nullptr)
 	{
+		ScopedMemoryTag memoryTag(MemoryTag::MAP);
 		g_currentMap = new Map(this, &MapDefinition::s_definitions[2]);
 	}
 }
@@ -295,7 +315,7 @@ void Game::RenderPlaying() const
 		{
 			g_theRenderer->BeginCamera(*m_playerController[i]->m_worldCamera);
 
-			g_currentMap->Render(*m_playerController[i]->m_worldCamera);
+			g_currentMap->Render(*m_playerController[i]->m_worldCamera, i);
 
 			g_theRenderer->EndCamera(*m_playerController[i]->m_worldCamera);
 
@@ -837,3 +857,64 @@ void Game::ConsoleControls()
 	line = DevConsoleLine("----------------------------------------", DevConsole::INFO_MAJOR);
 	g_theConsole->m_lines.push_back(line);
 }
+
+bool Game::Command_AIStats(EventArgs& args)
+{
+	UNUSED(args);
+
+	if (g_currentMap == nullptr)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, "AIStats: no map loaded");
+		return false;
+	}
+
+	AIScheduler const* scheduler = g_currentMap->m_aiScheduler;
+	AIPerception const* perception = g_currentMap->m_perception;
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("AI LOD  full: %d/%d ticked  reduced: %d/%d ticked  frozen: %d",
+		scheduler->m_numTicksPerLOD[(int)AILevelOfDetail::FULL], scheduler->m_numAIPerLOD[(int)AILevelOfDetail::FULL],
+		scheduler->m_numTicksPerLOD[(int)AILevelOfDetail::REDUCED], scheduler->m_numAIPerLOD[(int)AILevelOfDetail::REDUCED],
+		scheduler->m_numAIPerLOD[(int)AILevelOfDetail::FROZEN]));
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("AI perception  targets: %d  observers: %d  LOS checks: %d/%d  events: %d",
+		perception->m_numTargetsLastFrame, perception->m_numObserversLastFrame,
+		perception->m_numLOSChecksLastFrame, perception->m_maxLOSChecksPerFrame, perception->m_numEventsLastFrame));
+
+	WaveSpawner const* spawner = g_currentMap->m_spawner;
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("AI spawner  alive: %d/%d  spawned: %d (%d reused)  last frame: %d (%d reused)%s",
+		spawner->m_numAlive, spawner->GetMaxAlive(), spawner->m_numSpawnedTotal, spawner->m_numReusedTotal,
+		spawner->m_numSpawnedLastFrame, spawner->m_numReusedLastFrame, spawner->m_isStressMode ? "  [stress]" : ""));
+
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+// SpawnStress enabled=true maxAlive=2000 rate=200
+//----------------------------------------------------------------------------------------------------------------------------------------
+bool Game::Command_SpawnStress(EventArgs& args)
+{
+	if (g_currentMap == nullptr)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, "SpawnStress: no map loaded");
+		return false;
+	}
+
+	WaveSpawner* spawner = g_currentMap->m_spawner;
+
+	bool isEnabled = args.GetValue("enabled", !spawner->m_isStressMode);
+	int maxAlive = args.GetValue("maxAlive", spawner->m_definition.m_stressMaxAlive);
+	float rate = args.GetValue("rate", spawner->m_definition.m_stressSpawnsPerSecond);
+
+	spawner->SetStressMode(isEnabled, maxAlive, rate);
+
+	if (isEnabled)
+	{
+		g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("SpawnStress: ramping to %d actors at %.0f per second", maxAlive, rate));
+	}
+	else
+	{
+		g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("SpawnStress: off, back to %d alive", spawner->GetMaxAlive()));
+	}
+
+	return true;
+}
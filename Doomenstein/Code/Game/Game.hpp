@@ -111,4 +111,7 @@ public:
 	void				RenderAttract() const;
 	void				RenderPlaying() const;
 
+	static bool			Command_AIStats(EventArgs& args);
+	static bool			Command_SpawnStress(EventArgs& args);
+
 };
\ No newline at end of file
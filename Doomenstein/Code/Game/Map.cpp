@@ -8,6 +8,9 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/DebugRender.hpp"
 #include "Engine/Core/Timer.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/LinearAllocator.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Shader.hpp"
@@ -21,11 +24,16 @@
 #include "Game/Player.hpp"
 #include "Game/PlayerController.hpp"
 #include "Game/AIController.hpp"
+#include "Game/AIPerception.hpp"
+#include "Game/AIScheduler.hpp"
+#include "Game/WaveSpawner.hpp"
 #include "Game/Weapon.hpp"
 #include "Game/Game.hpp"
 #include "Game/GameCommon.hpp"
 
 #include <algorithm>
+#include <cfloat>
+#include <cstring>
 
 extern Map* g_currentMap;
 
@@ -38,6 +46,8 @@ Map::Map()
 Map::Map(Game* owner, MapDefinition* definition)
 	: m_definition(*definition)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::MAP);
+
 	m_actorSalt = 0x00000000u;
 
 	m_game = owner;
@@ -59,6 +69,16 @@ Map::Map(Game* owner, MapDefinition* definition)
 		m_pointLightColor.push_back(Rgba8::BLACK);
 	}
 
+	m_spotLightPos.resize(2, Vec3::ZERO);
+	m_spotLightCutOff.resize(2, 0.0f);
+	m_spotLightDirection.resize(2, Vec3::ZERO);
+	m_spotLightColor.resize(2, Rgba8::BLACK);
+
+	AddVertsForQuad3D(m_moonVerts, Vec3(0.0f, -50.0f, -50.0f), Vec3(0.0f, 50.0f, -50.0f), Vec3(0.0, 50.0f, 50.0f), Vec3(0.0f, -50.0f, 50.0f), Rgba8::WHITE, Rgba8::WHITE);
+	AddVertsForAABB3D(m_skyBoxVerts, AABB3(-500.0f, -500.0f, -0.5f, 500.0f, 500.0f, 500.0f));
+
+	m_skyBoxTexture = g_theRenderer->CreateOrGetTextureFromFile("Data/Textures/Background.png");
+
 	InitializeTiles();
 
 	int indicess = 0;
@@ -88,8 +108,13 @@ Map::Map(Game* owner, MapDefinition* definition)
 		}
 	}
 
+	m_spawner = new WaveSpawner(this, m_definition.m_spawner);
+
 	SpawnActors();
 	SpawnPlayer();
+
+	m_perception = new AIPerception(this);
+	m_aiScheduler = new AIScheduler(this);
 }
 
 Map::~Map()
@@ -104,6 +129,9 @@ Map::~Map()
 
 	m_actorList.clear();
 
+	DELETE_PTR(m_spawner);
+	DELETE_PTR(m_perception);
+	DELETE_PTR(m_aiScheduler);
 	DELETE_PTR(m_mapTerrainSpriteSheet);
 	DELETE_PTR(m_mapInfo);
 	DELETE_PTR(m_shader);
@@ -516,54 +544,15 @@ void Map::AddVertsForTile(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigne
 
 void Map::Update(float deltaseconds)
 {
+	PROFILE_SCOPE("Map::Update");
+	ScopedMemoryTag memoryTag(MemoryTag::MAP);
+
 	for (int i = 0; i < m_game->m_numOfPlayers; i++)
 	{
 		m_game->m_playerController[i]->m_isShooting = false;
 	}
 	
-	if (m_currentNumOfAI <= m_maxAI)
-	{
-		m_spawnTimer += deltaseconds;
-
-		if (m_spawnTimer > m_spawnDuration)
-		{
-			RandomNumberGenerator random = RandomNumberGenerator();
-
-			int flag = random.RollRandomIntInRange(0, 2);
-
-			if (flag == 0)
-			{
-				SpawnInfo redEnemy;
-				redEnemy.m_actorDef = &ActorDefinition::s_actorDefinitions[4];
-				redEnemy.m_pos = MapDefinition::s_definitions[2].m_spawnInfo[flag].m_pos;
-
-				SpawnActor(redEnemy);
-				m_currentNumOfAI++;
-			}
-			else if (flag == 1)
-			{
-				SpawnInfo greenEnemy;
-				greenEnemy.m_actorDef = &ActorDefinition::s_actorDefinitions[5];
-				greenEnemy.m_pos = MapDefinition::s_definitions[2].m_spawnInfo[flag].m_pos;
-
-				SpawnActor(greenEnemy);
-				m_currentNumOfAI++;
-			}
-			else if (flag == 2)
-			{
-				SpawnInfo blueEnemy;
-				blueEnemy.m_actorDef = &ActorDefinition::s_actorDefinitions[6];
-				blueEnemy.m_pos = MapDefinition::s_definitions[2].m_spawnInfo[flag].m_pos;
-
-				SpawnActor(blueEnemy);
-				m_currentNumOfAI++;
-			}
-
-			AttachAIControllers();
-
-			m_spawnTimer = 0.0f;
-		}
-	}
+	m_spawner->Update(deltaseconds);
 
 	if (g_theInputSystem->WasKeyJustPressed('N'))
 	{
@@ -598,11 +587,11 @@ void Map::Update(float deltaseconds)
 					if (g_theInputSystem->IsKeyDown(KEYCODE_LEFT_MOUSE))
 					{
 						m_game->m_playerController[i]->m_isShooting = true;
-						m_game->m_playerController[i]->GetActor()->m_animName = "Attack";
+						m_game->m_playerController[i]->GetActor()->m_anim = ActorAnim::ATTACK;
 					}
 					else
 					{
-						m_game->m_playerController[i]->GetActor()->m_animName = "Walk";
+						m_game->m_playerController[i]->GetActor()->m_anim = ActorAnim::WALK;
 					}
 				}
 			}
@@ -730,17 +719,32 @@ void Map::Update(float deltaseconds)
 		}
 	}
 
-	for (size_t index = 0; index < m_actorList.size(); index++)
+	m_aiScheduler->Update(deltaseconds);
+	m_perception->Update();
+
 	{
-		for (int i = 0; i < m_game->m_numOfPlayers; i++)
+		PROFILE_SCOPE("Map::UpdateActors");
+
+		for (size_t index = 0; index < m_actorList.size(); index++)
 		{
-			if (m_game->m_playerController[i] != nullptr && m_game->m_playerController[i]->m_actorUID != ActorUID::INVALID && m_actorList[index] != nullptr)
+			if (m_actorList[index] == nullptr)
+				continue;
+
+			bool isPlayerActor = false;
+
+			for (int i = 0; i < m_game->m_numOfPlayers; i++)
 			{
-				if (m_actorList[index] != m_game->m_playerController[i]->GetActor())
+				if (m_game->m_playerController[i] != nullptr && m_game->m_playerController[i]->m_actorUID != ActorUID::INVALID && m_actorList[index] == m_game->m_playerController[i]->GetActor())
 				{
-					m_actorList[index]->Update(deltaseconds, *m_game->m_playerController[i]->m_worldCamera);
+					isPlayerActor = true;
+					break;
 				}
 			}
+
+			if (!isPlayerActor)
+			{
+				m_actorList[index]->Update(deltaseconds);
+			}
 		}
 	}
 
@@ -767,13 +771,52 @@ void Map::Update(float deltaseconds)
 	CollideActorsWithMap();
 
 	DeleteDestroyedActors();
+
+	ComputeActorViewOctants();
+
+	UpdateSpotLights();
 }
 
-void Map::Render(Camera cameraPosition) const
+//------------------------------------------------------------------------------------------------
+// Refills the persistent spot light arrays in place so Render uploads them without allocating
+//------------------------------------------------------------------------------------------------
+void Map::UpdateSpotLights()
 {
-	std::vector<Vertex_PCU> moonVerts;
+	PlayerController const* player = m_game->m_playerController[0];
 
-	AddVertsForQuad3D(moonVerts, Vec3(0.0f, -50.0f, -50.0f), Vec3(0.0f, 50.0f, -50.0f), Vec3(0.0, 50.0f, 50.0f), Vec3(0.0f, -50.0f, 50.0f), Rgba8::WHITE, Rgba8::WHITE);
+	if (player->m_batteryLife > 0.0f)
+	{
+		m_spotLightPos[0] = player->m_torchPosition;
+		m_spotLightPos[1] = player->m_torchPosition;
+
+		m_spotLightCutOff[0] = player->m_torchCutoff;
+		m_spotLightCutOff[1] = 0.5f;
+
+		m_spotLightDirection[0] = player->m_torchForward;
+		m_spotLightDirection[1] = player->m_torchForward;
+
+		m_spotLightColor[0] = player->m_torchColor;
+		m_spotLightColor[1] = Rgba8::WHITE;
+	}
+	else
+	{
+		m_spotLightPos[0] = Vec3::ZERO;
+		m_spotLightPos[1] = Vec3::ZERO;
+
+		m_spotLightCutOff[0] = 0.0f;
+		m_spotLightCutOff[1] = 0.0f;
+
+		m_spotLightDirection[0] = Vec3::ZERO;
+		m_spotLightDirection[1] = Vec3::ZERO;
+
+		m_spotLightColor[0] = Rgba8::BLACK;
+		m_spotLightColor[1] = Rgba8::BLACK;
+	}
+}
+
+void Map::Render(Camera cameraPosition, int viewIndex) const
+{
+	PROFILE_SCOPE("Map::Render");
 
 	Mat44 transform = GetBillboardMatrix(BillboardType::FULL_CAMERA_FACING, m_game->m_playerController[0]->m_worldCamera->GetModelMatrix(), Vec3(400.0f, 400.0f, 400.0f));
 
@@ -784,68 +827,21 @@ void Map::Render(Camera cameraPosition) const
 	g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
 	g_theRenderer->BindTexture(m_game->m_compositeTexture);
 	g_theRenderer->BindShader();
-	g_theRenderer->DrawVertexArray((int)moonVerts.size(), moonVerts.data());
+	g_theRenderer->DrawVertexArray((int)m_moonVerts.size(), m_moonVerts.data());
 
-	std::vector<Vertex_PCU> skyBoxVerts;
-	
-	Texture* skyBox = g_theRenderer->CreateOrGetTextureFromFile("Data/Textures/Background.png");
-	
-	AddVertsForAABB3D(skyBoxVerts, AABB3(-500.0f, -500.0f, -0.5f, 500.0f, 500.0f, 500.0f));
-	
 	g_theRenderer->SetModelConstants(Mat44(), Rgba8(100, 100, 100, 255));
 	
 	g_theRenderer->SetBlendMode(BlendMode::ALPHA);
 	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
 	g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_NONE);
-	g_theRenderer->BindTexture(skyBox);
+	g_theRenderer->BindTexture(m_skyBoxTexture);
 	g_theRenderer->BindShader();
-	g_theRenderer->DrawVertexArray((int)skyBoxVerts.size(), skyBoxVerts.data());
+	g_theRenderer->DrawVertexArray((int)m_skyBoxVerts.size(), m_skyBoxVerts.data());
 
 	g_theRenderer->SetModelConstants();
 	g_theRenderer->SetPointLightConstants(m_pointLightPos, m_pointLightColor);
 
-	if (m_game->m_playerController[0]->m_batteryLife > 0.0f)
-	{
-		std::vector<Vec3> lightPos;
-		std::vector<float> lightCutOff;
-		std::vector<Vec3> lightDirection;
-		std::vector<Rgba8> lightColor;
-
-		lightPos.push_back(m_game->m_playerController[0]->m_torchPosition);
-		lightPos.push_back(m_game->m_playerController[0]->m_torchPosition);
-
-		lightCutOff.push_back(m_game->m_playerController[0]->m_torchCutoff);
-		lightCutOff.push_back(0.5f);
-
-		lightDirection.push_back(m_game->m_playerController[0]->m_torchForward);
-		lightDirection.push_back(m_game->m_playerController[0]->m_torchForward);
-
-		lightColor.push_back(m_game->m_playerController[0]->m_torchColor);
-		lightColor.push_back(Rgba8::WHITE);
-
-		g_theRenderer->SetSpotLightConstants(lightPos, lightCutOff, lightDirection, lightColor);
-	}
-	else
-	{
-		std::vector<Vec3> lightPos;
-		std::vector<float> lightCutOff;
-		std::vector<Vec3> lightDirection;
-		std::vector<Rgba8> lightColor;
-
-		lightPos.push_back(Vec3::ZERO);
-		lightPos.push_back(Vec3::ZERO);
-
-		lightCutOff.push_back(0.0f);
-		lightCutOff.push_back(0.0f);
-
-		lightDirection.push_back(Vec3::ZERO);
-		lightDirection.push_back(Vec3::ZERO);
-
-		lightColor.push_back(Rgba8::BLACK);
-		lightColor.push_back(Rgba8::BLACK);
-
-		g_theRenderer->SetSpotLightConstants(lightPos, lightCutOff, lightDirection, lightColor);
-	}
+	g_theRenderer->SetSpotLightConstants(m_spotLightPos, m_spotLightCutOff, m_spotLightDirection, m_spotLightColor);
 
 	g_theRenderer->SetDirectionalLightConstants(m_sunDirection, m_sunIntensity, m_ambientIntensity);
 
@@ -856,10 +852,10 @@ void Map::Render(Camera cameraPosition) const
 	g_theRenderer->BindShader(m_shader);
 	g_theRenderer->DrawVertexBufferIndexed(m_vbo, m_ibo, 60);
 
-	RenderActors(cameraPosition);
+	RenderActors(cameraPosition, viewIndex);
 }
 
-void Map::RenderActors(Camera cameraPosition) const
+void Map::RenderActors(Camera cameraPosition, int viewIndex) const
 {
 	for (size_t index = 0; index < m_actorList.size(); index++)
 	{
@@ -867,17 +863,73 @@ void Map::RenderActors(Camera cameraPosition) const
 		{
 			if (m_actorList[index] && m_actorList[index] != m_game->m_playerController[0]->GetActor())
 			{
-				m_actorList[index]->Render(cameraPosition);
+				m_actorList[index]->Render(cameraPosition, GetActorViewOctant(viewIndex, index));
 			}
 		}
 	}
 }
 
+void Map::ComputeActorViewOctants()
+{
+	m_numActorViewActors = (int)m_actorList.size();
+
+	m_actorViewPosX.resize(m_numActorViewActors);
+	m_actorViewPosY.resize(m_numActorViewActors);
+	m_actorViewYawCos.resize(m_numActorViewActors);
+	m_actorViewYawSin.resize(m_numActorViewActors);
+
+	for (int index = 0; index < m_numActorViewActors; index++)
+	{
+		Actor const* actor = m_actorList[index];
+
+		if (actor)
+		{
+			m_actorViewPosX[index] = actor->m_position.x;
+			m_actorViewPosY[index] = actor->m_position.y;
+			m_actorViewYawCos[index] = CosDegrees(actor->m_orientation.m_yawDegrees);
+			m_actorViewYawSin[index] = SinDegrees(actor->m_orientation.m_yawDegrees);
+		}
+		else
+		{
+			m_actorViewPosX[index] = 0.0f;
+			m_actorViewPosY[index] = 0.0f;
+			m_actorViewYawCos[index] = 1.0f;
+			m_actorViewYawSin[index] = 0.0f;
+		}
+	}
+
+	m_numActorViews = m_game->m_numOfPlayers;
+	m_actorViewOctants.resize((size_t)m_numActorViews * m_numActorViewActors);
+
+	for (int viewIndex = 0; viewIndex < m_numActorViews; viewIndex++)
+	{
+		unsigned char* viewOctants = m_actorViewOctants.data() + (size_t)viewIndex * m_numActorViewActors;
+
+		if (m_game->m_playerController[viewIndex] == nullptr || m_game->m_playerController[viewIndex]->m_worldCamera == nullptr)
+		{
+			memset(viewOctants, 0, m_numActorViewActors);
+			continue;
+		}
+
+		Vec3 viewPosition = m_game->m_playerController[viewIndex]->m_worldCamera->m_position;
+
+		ComputeViewOctants(m_actorViewPosX.data(), m_actorViewPosY.data(), m_actorViewYawCos.data(), m_actorViewYawSin.data(), m_numActorViewActors, Vec2(viewPosition.x, viewPosition.y), viewOctants);
+	}
+}
+
+unsigned char Map::GetActorViewOctant(int viewIndex, size_t actorIndex) const
+{
+	if (viewIndex >= m_numActorViews || actorIndex >= (size_t)m_numActorViewActors)
+		return 0;
+
+	return m_actorViewOctants[(size_t)viewIndex * m_numActorViewActors + actorIndex];
+}
+
 void MapDefinition::InitializeDef()
 {
 	XmlDocument tileDoc;
 
-	XmlError result = tileDoc.LoadFile("Data/Definitions/MapDefinitions.xml");
+	XmlError result = LoadXmlDocument(tileDoc, "Data/Definitions/MapDefinitions.xml");
 
 	if (result != tinyxml2::XML_SUCCESS)
 		GUARANTEE_OR_DIE(false, "COULD NOT LOAD XML");
@@ -892,7 +944,7 @@ void MapDefinition::InitializeDef()
 		s_definitions[index].m_spriteSheetTexture = ParseXmlAttribute(*element, "spriteSheetTexture", s_definitions[index].m_spriteSheetTexture);
 		s_definitions[index].m_spriteSheetCellCount = ParseXmlAttribute(*element, "spriteSheetCellCount", s_definitions[index].m_spriteSheetCellCount);
 
-		XmlElement* spawnElement = element->FirstChildElement()->FirstChildElement();
+		XmlElement* spawnElement = element->FirstChildElement("SpawnInfos")->FirstChildElement();
 
 		while (spawnElement)
 		{
@@ -909,6 +961,13 @@ void MapDefinition::InitializeDef()
 			spawnElement = spawnElement->NextSiblingElement();
 		}
 
+		XmlElement* spawnerElement = element->FirstChildElement("Spawner");
+
+		if (spawnerElement)
+		{
+			s_definitions[index].m_spawner.LoadFromXmlElement(*spawnerElement);
+		}
+
 		element = element->NextSiblingElement();
 	}
 }
@@ -997,8 +1056,10 @@ void Map::PossessPlayer(int playerIndex)
 	}
 }
 
-void Map::SpawnActor(SpawnInfo info)
+Actor* Map::SpawnActor(SpawnInfo info)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::ACTORS);
+
 	Actor* actor = new Actor(*info.m_actorDef, this, info.m_pos, info.m_orientation, Rgba8::WHITE);
 
 	if (info.m_actorDef->m_name == "RedGhost")
@@ -1014,6 +1075,13 @@ void Map::SpawnActor(SpawnInfo info)
 		actor->m_color = Rgba8::BLUE;
 	}
 
+	AddActor(actor);
+
+	return actor;
+}
+
+void Map::AddActor(Actor* actor)
+{
 	for (size_t i = 0; i < m_actorList.size(); i++)
 	{
 		if (m_actorList[i] == nullptr)
@@ -1035,40 +1103,7 @@ void Map::SpawnActor(SpawnInfo info)
 
 void Map::SpawnActors()
 {
-	for (size_t index = 0; index < MapDefinition::s_definitions[2].m_spawnInfo.size(); index++)
-	{
-		RandomNumberGenerator random = RandomNumberGenerator();
-
-		int flag = random.RollRandomIntInRange(0, 2);
-
-		if (flag == 0)
-		{
-			SpawnInfo redEnemy;
-			redEnemy.m_actorDef = &ActorDefinition::s_actorDefinitions[4];
-			redEnemy.m_pos = MapDefinition::s_definitions[2].m_spawnInfo[index].m_pos;
-
-			SpawnActor(redEnemy);
-			m_currentNumOfAI++;
-		}
-		else if (flag == 1)
-		{
-			SpawnInfo greenEnemy;
-			greenEnemy.m_actorDef = &ActorDefinition::s_actorDefinitions[5];
-			greenEnemy.m_pos = MapDefinition::s_definitions[2].m_spawnInfo[index].m_pos;
-
-			SpawnActor(greenEnemy);
-			m_currentNumOfAI++;
-		}
-		else if (flag == 2)
-		{
-			SpawnInfo blueEnemy;
-			blueEnemy.m_actorDef = &ActorDefinition::s_actorDefinitions[6];
-			blueEnemy.m_pos = MapDefinition::s_definitions[2].m_spawnInfo[index].m_pos;
-
-			SpawnActor(blueEnemy);
-			m_currentNumOfAI++;
-		}
-	}
+	m_spawner->SpawnInitial();
 }
 
 //void Map::SpawnProjectile()
@@ -1102,18 +1137,31 @@ void Map::SpawnActors()
 //	}
 //}
 
+void Map::AttachAIController(Actor& actor)
+{
+	ScopedMemoryTag memoryTag(MemoryTag::AI);
+
+	if (actor.m_aiController)
+	{
+		actor.m_aiController->m_actorUID = actor.m_UID;
+		return;
+	}
+
+	if (actor.m_definition.m_name == "RedGhost" || actor.m_definition.m_name == "GreenGhost" || actor.m_definition.m_name == "BlueGhost" || actor.m_definition.m_aiEnabled)
+	{
+		actor.m_aiController = new AIController();
+		actor.m_aiController->m_actorUID = actor.m_UID;
+		actor.m_aiController->m_map = this;
+	}
+}
+
 void Map::AttachAIControllers()
 {
 	for (size_t index = 0; index < m_actorList.size(); index++)
 	{
 		if (m_actorList[index] && m_actorList[index]->m_aiController == nullptr)
 		{
-			if (m_actorList[index]->m_definition.m_name == "RedGhost" || m_actorList[index]->m_definition.m_name == "GreenGhost" || m_actorList[index]->m_definition.m_name == "BlueGhost" || m_actorList[index]->m_definition.m_aiEnabled)
-			{
-				m_actorList[index]->m_aiController = new AIController();
-				m_actorList[index]->m_aiController->m_actorUID = m_actorList[index]->m_UID;
-				m_actorList[index]->m_aiController->m_map = this;
-			}
+			AttachAIController(*m_actorList[index]);
 		}
 	}
 }
@@ -1125,6 +1173,8 @@ Actor* Map::GetActorByUID(ActorUID const actorUID) const
 
 void Map::CollideActors()
 {
+	PROFILE_SCOPE("Map::CollideActors");
+
 	for (size_t i = 0; i < m_actorList.size(); i++)
 	{
 		if (m_actorList[i] != nullptr)
@@ -1356,6 +1406,8 @@ void Map::CollideActors(Actor& actorA, Actor& actorB)
 
 void Map::CollideActorsWithMap()
 {
+	PROFILE_SCOPE("Map::CollideActorsWithMap");
+
 	for (size_t index = 0; index < m_actorList.size(); index++)
 	{
 		if (m_actorList[index] != nullptr)
@@ -1628,8 +1680,14 @@ void Map::DeleteDestroyedActors()
 	{
 		if (m_actorList[index] != nullptr && m_actorList[index]->m_isDead)
 		{
-			DELETE_PTR(m_actorList[index]);
-			m_currentNumOfAI--;
+			if (m_spawner->ReleaseActor(m_actorList[index]))
+			{
+				m_actorList[index] = nullptr;
+			}
+			else
+			{
+				DELETE_PTR(m_actorList[index]);
+			}
 		}
 	}
 }
@@ -1644,7 +1702,8 @@ RaycastResultDoomenstein Map::RaycastAll(Vec3 const& start, Vec3 const& directio
 	float rayXYDist = GetDistance3D(mapRaycastXY.m_raycast.m_impactPos, start);
 	float rayActorDist = GetDistance3D(mapRaycastActor.m_raycast.m_impactPos, start);
 
-	std::vector<float> rayImpactLengths;
+	FrameVector<float> rayImpactLengths;
+	rayImpactLengths.reserve(3);
 
 	rayImpactLengths.push_back(rayZDist);
 	rayImpactLengths.push_back(rayXYDist);
@@ -1792,6 +1851,74 @@ RaycastResultDoomenstein Map::RaycastWorldXY(Vec3 const& start, Vec3 const& dire
 	return RaycastResultDoomenstein();
 }
 
+bool Map::HasLineOfSightXY(Vec2 const& start, Vec2 const& end) const
+{
+	Vec2 displacement = end - start;
+	float distance = displacement.GetLength();
+
+	if (distance <= 0.0f)
+		return true;
+
+	Vec2 direction = displacement / distance;
+
+	int tileX = RoundDownToInt(start.x);
+	int tileY = RoundDownToInt(start.y);
+	int endTileX = RoundDownToInt(end.x);
+	int endTileY = RoundDownToInt(end.y);
+
+	int tileStepDirectionX = (direction.x < 0.0f) ? -1 : 1;
+	int tileStepDirectionY = (direction.y < 0.0f) ? -1 : 1;
+
+	// A ray parallel to an axis never crosses that axis' tile lines, so skip it rather than
+	// multiplying 0 by 1/0 and feeding NaN into the crossing comparisons below.
+	float fwdDistPerXCrossing = FLT_MAX;
+	float fwdDistPerYCrossing = FLT_MAX;
+	float fwdDistAtNextXCrossing = FLT_MAX;
+	float fwdDistAtNextYCrossing = FLT_MAX;
+
+	if (direction.x != 0.0f)
+	{
+		float xAtFirstXCrossing = float(tileX + ((tileStepDirectionX + 1) / 2));
+		fwdDistPerXCrossing = 1.0f / fabsf(direction.x);
+		fwdDistAtNextXCrossing = fabsf(xAtFirstXCrossing - start.x) * fwdDistPerXCrossing;
+	}
+
+	if (direction.y != 0.0f)
+	{
+		float yAtFirstYCrossing = float(tileY + ((tileStepDirectionY + 1) / 2));
+		fwdDistPerYCrossing = 1.0f / fabsf(direction.y);
+		fwdDistAtNextYCrossing = fabsf(yAtFirstYCrossing - start.y) * fwdDistPerYCrossing;
+	}
+
+	while (tileX != endTileX || tileY != endTileY)
+	{
+		if (fwdDistAtNextXCrossing < fwdDistAtNextYCrossing)
+		{
+			if (fwdDistAtNextXCrossing > distance)
+				return true;
+
+			tileX += tileStepDirectionX;
+			fwdDistAtNextXCrossing += fwdDistPerXCrossing;
+		}
+		else
+		{
+			if (fwdDistAtNextYCrossing > distance)
+				return true;
+
+			tileY += tileStepDirectionY;
+			fwdDistAtNextYCrossing += fwdDistPerYCrossing;
+		}
+
+		if (tileX < 0 || tileX >= m_dimensions.x || tileY < 0 || tileY >= m_dimensions.y)
+			return false;
+
+		if (m_tiles[tileX + (tileY * m_dimensions.x)].m_definition->m_isSolid)
+			return false;
+	}
+
+	return true;
+}
+
 RaycastResultDoomenstein Map::RaycastWorldZ(Vec3 const& start, Vec3 const& direction, float distance) const
 {
 	RaycastResultDoomenstein raycast;
@@ -1843,7 +1970,8 @@ RaycastResultDoomenstein Map::RaycastWorldZ(Vec3 const& start, Vec3 const& direc
 
 RaycastResultDoomenstein Map::RaycastWorldActors(Vec3 const& start, Vec3 const& direction, float distance) const
 {
-	std::vector<float> rayImpactLengths;
+	FrameVector<float> rayImpactLengths;
+	rayImpactLengths.reserve(m_actorList.size() * m_game->m_numOfPlayers);
 
 	for (size_t index = 0; index < m_actorList.size(); index++)
 	{
@@ -3,6 +3,7 @@
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 #include "Engine/Renderer/Camera.hpp"
@@ -11,6 +12,7 @@
 #include "Game/Tile.hpp"
 #include "Game/SpawnInfo.hpp"
 #include "Game/ActorUID.hpp"
+#include "Game/WaveSpawner.hpp"
 
 #include <string>
 #include <vector>
@@ -22,6 +24,8 @@ class Game;
 class VertexBuffer;
 class IndexBuffer;
 class Actor;
+class AIPerception;
+class AIScheduler;
 
 struct RaycastResultDoomenstein
 {
@@ -39,6 +43,7 @@ struct MapDefinition
 
 	// SPAWN INFO
 	std::vector<SpawnInfo>		m_spawnInfo;
+	WaveSpawnerDefinition		m_spawner;
 
 	static MapDefinition		s_definitions[3];
 
@@ -64,12 +69,27 @@ public:
 	std::vector<Actor*>			m_actorList;
 	std::vector<Vec3>			m_pointLightPos;
 	std::vector<Rgba8>			m_pointLightColor;
+	std::vector<Vec3>			m_spotLightPos;
+	std::vector<float>			m_spotLightCutOff;
+	std::vector<Vec3>			m_spotLightDirection;
+	std::vector<Rgba8>			m_spotLightColor;
+	std::vector<Vertex_PCU>		m_moonVerts;
+	std::vector<Vertex_PCU>		m_skyBoxVerts;
+	Texture*					m_skyBoxTexture				= nullptr;
 	static unsigned int const	MAX_ACTOR_SALT				= 0x0000fffeu;
 	unsigned int				m_actorSalt					= MAX_ACTOR_SALT;
-	float						m_spawnTimer				= 0.0f;
-	float						m_spawnDuration				= 2.0f;
-	int							m_maxAI						= 6;
-	int							m_currentNumOfAI			= 0;
+	WaveSpawner*				m_spawner					= nullptr;
+	AIPerception*				m_perception				= nullptr;
+	AIScheduler*				m_aiScheduler				= nullptr;
+
+	// View-relative octant of every actor for every player camera, rebuilt once per frame
+	std::vector<float>			m_actorViewPosX;
+	std::vector<float>			m_actorViewPosY;
+	std::vector<float>			m_actorViewYawCos;
+	std::vector<float>			m_actorViewYawSin;
+	std::vector<unsigned char>	m_actorViewOctants;
+	int							m_numActorViews				= 0;
+	int							m_numActorViewActors		= 0;
 
 	Vec3						m_sunDirection;
 	float						m_sunIntensity;
@@ -83,8 +103,12 @@ public:
 	void						AddVertsForTile(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indices, int tileIndex, int& indicess, SpriteSheet const& spriteSheet) const;
 
 	void						Update(float deltaseconds);
-	void						Render(Camera cameraPosition) const;
-	void						RenderActors(Camera cameraPosition) const;
+	void						UpdateSpotLights();
+	void						Render(Camera cameraPosition, int viewIndex = 0) const;
+	void						RenderActors(Camera cameraPosition, int viewIndex = 0) const;
+
+	void						ComputeActorViewOctants();
+	unsigned char				GetActorViewOctant(int viewIndex, size_t actorIndex) const;
 
 	bool						IsPositionInBounds(Vec3 position, float const tolerance = 0.0f) const;
 	bool						AreCoordsInBounds(int x, int y) const;
@@ -92,8 +116,10 @@ public:
 
 	void						SpawnPlayer();
 	void						PossessPlayer(int playerIndex);
-	void						SpawnActor(SpawnInfo info);
+	Actor*						SpawnActor(SpawnInfo info);
+	void						AddActor(Actor* actor);
 	void						SpawnActors();
+	void						AttachAIController(Actor& actor);
 	void						AttachAIControllers();
 	Actor*						GetActorByUID(ActorUID const actorUID) const;
 
@@ -109,4 +135,5 @@ public:
 	RaycastResultDoomenstein	RaycastWorldXY(Vec3 const& start, Vec3 const& direction, float distance) const;
 	RaycastResultDoomenstein	RaycastWorldZ(Vec3 const& start, Vec3 const& direction, float distance) const;
 	RaycastResultDoomenstein	RaycastWorldActors(Vec3 const& start, Vec3 const& direction, float distance) const;
+	bool						HasLineOfSightXY(Vec2 const& start, Vec2 const& end) const;
 };
\ No newline at end of file
@@ -621,7 +621,7 @@ void PlayerController::UpdateInput(float deltaseconds)
 
 				m_actorUID.GetActor()->m_velocity = m_velocity;
 
-				m_actorUID.GetActor()->Update(deltaseconds, *m_worldCamera);
+				m_actorUID.GetActor()->Update(deltaseconds);
 
 				m_orientationDegrees.m_pitchDegrees = GetClamped(m_orientationDegrees.m_pitchDegrees, -85.0f, 85.0f);
 				m_orientationDegrees.m_rollDegrees = GetClamped(m_orientationDegrees.m_rollDegrees, -45.0f, 45.0f);
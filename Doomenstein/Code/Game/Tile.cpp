@@ -10,7 +10,7 @@ void TileDefinition::InitializeDef()
 {
 	XmlDocument tileDoc;
 
-	XmlError result = tileDoc.LoadFile("Data/Definitions/TileDefinitions.xml");
+	XmlError result = LoadXmlDocument(tileDoc, "Data/Definitions/TileDefinitions.xml");
 
 	if (result != tinyxml2::XML_SUCCESS)
 		GUARANTEE_OR_DIE(false, "COULD NOT LOAD XML");
@@ -0,0 +1,306 @@
+#include "Game/WaveSpawner.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include "Game/Map.hpp"
+#include "Game/Game.hpp"
+#include "Game/Actor.hpp"
+#include "Game/AIController.hpp"
+#include "Game/PlayerController.hpp"
+
+bool WaveSpawnerDefinition::LoadFromXmlElement(XmlElement const& element)
+{
+	m_initialSpawns = ParseXmlAttribute(element, "initialSpawns", m_initialSpawns);
+	m_maxAlive = ParseXmlAttribute(element, "maxAlive", m_maxAlive);
+	m_spawnInterval = ParseXmlAttribute(element, "spawnInterval", m_spawnInterval);
+	m_maxSpawnsPerFrame = ParseXmlAttribute(element, "maxSpawnsPerFrame", m_maxSpawnsPerFrame);
+	m_stressMaxAlive = ParseXmlAttribute(element, "stressMaxAlive", m_stressMaxAlive);
+	m_stressSpawnsPerSecond = ParseXmlAttribute(element, "stressSpawnsPerSecond", m_stressSpawnsPerSecond);
+	m_stressSpawnsPerFrame = ParseXmlAttribute(element, "stressSpawnsPerFrame", m_stressSpawnsPerFrame);
+
+	std::string selection = ParseXmlAttribute(element, "spawnPointSelection", "Random");
+
+	if (selection == "Sequential")
+	{
+		m_spawnPointSelection = SpawnPointSelection::SEQUENTIAL;
+	}
+	else if (selection == "FarthestFromPlayers")
+	{
+		m_spawnPointSelection = SpawnPointSelection::FARTHEST_FROM_PLAYERS;
+	}
+	else
+	{
+		m_spawnPointSelection = SpawnPointSelection::RANDOM;
+	}
+
+	m_entries.clear();
+	m_totalWeight = 0.0f;
+
+	XmlElement const* entryElement = element.FirstChildElement("SpawnEntry");
+
+	while (entryElement)
+	{
+		std::string actorName = ParseXmlAttribute(*entryElement, "actor", "");
+
+		SpawnTableEntry entry;
+		entry.m_actorDef = ActorDefinition::GetDefByName(actorName);
+		entry.m_weight = ParseXmlAttribute(*entryElement, "weight", entry.m_weight);
+
+		// GetDefByName hands back an empty placeholder for unknown names, which would spawn invisible actors
+		GUARANTEE_OR_DIE(!actorName.empty() && entry.m_actorDef->m_name == actorName, Stringf("SPAWN ENTRY ACTOR \"%s\" IS NOT A KNOWN ACTOR DEFINITION", actorName.c_str()));
+		GUARANTEE_OR_DIE(entry.m_weight > 0.0f, "SPAWN ENTRY WEIGHT MUST BE POSITIVE");
+
+		m_entries.push_back(entry);
+		m_totalWeight += entry.m_weight;
+
+		entryElement = entryElement->NextSiblingElement("SpawnEntry");
+	}
+
+	return !m_entries.empty();
+}
+
+WaveSpawner::WaveSpawner(Map* map, WaveSpawnerDefinition const& definition)
+	: m_map(map)
+	, m_definition(definition)
+{
+	for (size_t index = 0; index < m_map->m_definition.m_spawnInfo.size(); index++)
+	{
+		SpawnInfo const& info = m_map->m_definition.m_spawnInfo[index];
+
+		if (info.m_actorDef && info.m_actorDef->m_name == "SpawnPoint")
+		{
+			m_spawnPositions.push_back(info.m_pos);
+			m_spawnOrientations.push_back(info.m_orientation);
+		}
+	}
+
+	m_pools.resize(m_definition.m_entries.size());
+}
+
+WaveSpawner::~WaveSpawner()
+{
+	for (size_t entry = 0; entry < m_pools.size(); entry++)
+	{
+		for (size_t index = 0; index < m_pools[entry].size(); index++)
+		{
+			DELETE_PTR(m_pools[entry][index]);
+		}
+	}
+
+	m_pools.clear();
+}
+
+void WaveSpawner::Update(float deltaseconds)
+{
+	PROFILE_SCOPE("WaveSpawner::Update");
+	ScopedMemoryTag memoryTag(MemoryTag::ACTORS);
+
+	m_numSpawnedLastFrame = 0;
+	m_numReusedLastFrame = 0;
+
+	if (m_definition.m_entries.empty() || m_spawnPositions.empty())
+		return;
+
+	int maxAlive = GetMaxAlive();
+	int maxSpawnsThisFrame = m_definition.m_maxSpawnsPerFrame;
+
+	if (m_isStressMode)
+	{
+		m_pendingSpawns += m_stressSpawnsPerSecond * deltaseconds;
+		maxSpawnsThisFrame = m_definition.m_stressSpawnsPerFrame;
+	}
+	else if (m_numAlive < maxAlive)
+	{
+		m_spawnTimer += deltaseconds;
+
+		if (m_spawnTimer > m_definition.m_spawnInterval)
+		{
+			m_pendingSpawns += 1.0f;
+			m_spawnTimer = 0.0f;
+		}
+	}
+
+	// Never bank more requests than there is room for, or a full map would burst when actors die
+	float room = static_cast<float>(maxAlive - m_numAlive);
+	m_pendingSpawns = GetClamped(m_pendingSpawns, 0.0f, room > 0.0f ? room : 0.0f);
+
+	while (m_pendingSpawns >= 1.0f && m_numSpawnedLastFrame < maxSpawnsThisFrame && m_numAlive < maxAlive)
+	{
+		if (!SpawnOne())
+			break;
+
+		m_pendingSpawns -= 1.0f;
+	}
+}
+
+void WaveSpawner::SpawnInitial()
+{
+	for (int index = 0; index < m_definition.m_initialSpawns; index++)
+	{
+		if (!SpawnOne())
+			break;
+	}
+}
+
+void WaveSpawner::SetStressMode(bool isEnabled, int maxAlive, float spawnsPerSecond)
+{
+	m_isStressMode = isEnabled;
+	m_stressMaxAlive = maxAlive;
+	m_stressSpawnsPerSecond = spawnsPerSecond;
+	m_pendingSpawns = 0.0f;
+	m_spawnTimer = 0.0f;
+}
+
+bool WaveSpawner::SpawnOne()
+{
+	if (m_definition.m_entries.empty() || m_spawnPositions.empty())
+		return false;
+
+	int entry = ChooseEntry();
+	int spawnPoint = ChooseSpawnPoint();
+
+	Vec3 position = m_spawnPositions[spawnPoint];
+	EulerAngles orientation = m_spawnOrientations[spawnPoint];
+
+	// Thousands of actors on a handful of spawn points would start fully overlapped
+	if (m_isStressMode)
+	{
+		position.x += m_random.RollRandomFloatInRange(-0.4f, 0.4f);
+		position.y += m_random.RollRandomFloatInRange(-0.4f, 0.4f);
+	}
+
+	Actor* actor = nullptr;
+
+	if (!m_pools[entry].empty())
+	{
+		actor = m_pools[entry].back();
+		m_pools[entry].pop_back();
+
+		actor->Respawn(position, orientation);
+		m_map->AddActor(actor);
+
+		m_numReusedLastFrame++;
+		m_numReusedTotal++;
+	}
+	else
+	{
+		SpawnInfo info;
+		info.m_actorDef = m_definition.m_entries[entry].m_actorDef;
+		info.m_pos = position;
+		info.m_orientation = orientation;
+
+		actor = m_map->SpawnActor(info);
+	}
+
+	m_map->AttachAIController(*actor);
+
+	m_numAlive++;
+	m_numSpawnedLastFrame++;
+	m_numSpawnedTotal++;
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+// Takes ownership of a dead actor from the actor list if this spawner produced it
+//------------------------------------------------------------------------------------------------
+bool WaveSpawner::ReleaseActor(Actor* actor)
+{
+	if (actor == nullptr || actor->m_aiController == nullptr)
+		return false;
+
+	int entry = GetEntryIndex(&actor->m_definition);
+
+	if (entry == -1)
+		return false;
+
+	m_pools[entry].push_back(actor);
+	m_numAlive--;
+
+	return true;
+}
+
+int WaveSpawner::ChooseEntry()
+{
+	float roll = m_random.RollRandomFloatInRange(0.0f, m_definition.m_totalWeight);
+
+	for (size_t entry = 0; entry < m_definition.m_entries.size(); entry++)
+	{
+		roll -= m_definition.m_entries[entry].m_weight;
+
+		if (roll <= 0.0f)
+			return static_cast<int>(entry);
+	}
+
+	return static_cast<int>(m_definition.m_entries.size()) - 1;
+}
+
+int WaveSpawner::ChooseSpawnPoint()
+{
+	int numSpawnPoints = static_cast<int>(m_spawnPositions.size());
+
+	switch (m_definition.m_spawnPointSelection)
+	{
+	case SpawnPointSelection::SEQUENTIAL:
+	{
+		int spawnPoint = m_nextSpawnPoint % numSpawnPoints;
+		m_nextSpawnPoint = spawnPoint + 1;
+		return spawnPoint;
+	}
+	case SpawnPointSelection::FARTHEST_FROM_PLAYERS:
+	{
+		int farthest = 0;
+		float farthestDistanceSquared = -1.0f;
+
+		for (int spawnPoint = 0; spawnPoint < numSpawnPoints; spawnPoint++)
+		{
+			Vec2 spawnPos = Vec2(m_spawnPositions[spawnPoint].x, m_spawnPositions[spawnPoint].y);
+			float nearestPlayerDistanceSquared = -1.0f;
+
+			for (int i = 0; i < m_map->m_game->m_numOfPlayers; i++)
+			{
+				if (m_map->m_game->m_playerController[i] == nullptr)
+					continue;
+
+				Vec2 playerPos = Vec2(m_map->m_game->m_playerController[i]->m_position.x, m_map->m_game->m_playerController[i]->m_position.y);
+				float distanceSquared = GetDistanceSquared2D(spawnPos, playerPos);
+
+				if (nearestPlayerDistanceSquared < 0.0f || distanceSquared < nearestPlayerDistanceSquared)
+				{
+					nearestPlayerDistanceSquared = distanceSquared;
+				}
+			}
+
+			if (nearestPlayerDistanceSquared > farthestDistanceSquared)
+			{
+				farthest = spawnPoint;
+				farthestDistanceSquared = nearestPlayerDistanceSquared;
+			}
+		}
+
+		return farthest;
+	}
+	default:
+		return m_random.RollRandomIntLessThan(numSpawnPoints);
+	}
+}
+
+int WaveSpawner::GetEntryIndex(ActorDefinition const* actorDef) const
+{
+	for (size_t entry = 0; entry < m_definition.m_entries.size(); entry++)
+	{
+		if (m_definition.m_entries[entry].m_actorDef == actorDef)
+			return static_cast<int>(entry);
+	}
+
+	return -1;
+}
+
+int WaveSpawner::GetMaxAlive() const
+{
+	return m_isStressMode ? m_stressMaxAlive : m_definition.m_maxAlive;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+
+#include <vector>
+
+class Map;
+class Actor;
+struct ActorDefinition;
+
+//------------------------------------------------------------------------------------------------
+enum class SpawnPointSelection
+{
+	RANDOM,
+	SEQUENTIAL,
+	FARTHEST_FROM_PLAYERS
+};
+
+//------------------------------------------------------------------------------------------------
+struct SpawnTableEntry
+{
+	ActorDefinition*			m_actorDef				= nullptr;
+	float						m_weight				= 1.0f;
+};
+
+//------------------------------------------------------------------------------------------------
+struct WaveSpawnerDefinition
+{
+	std::vector<SpawnTableEntry>	m_entries;
+	float							m_totalWeight			= 0.0f;
+	int								m_initialSpawns			= 0;
+	int								m_maxAlive				= 0;
+	float							m_spawnInterval			= 2.0f;
+	int								m_maxSpawnsPerFrame		= 1;
+	SpawnPointSelection				m_spawnPointSelection	= SpawnPointSelection::RANDOM;
+	int								m_stressMaxAlive		= 2000;
+	float							m_stressSpawnsPerSecond	= 200.0f;
+	int								m_stressSpawnsPerFrame	= 16;
+
+	bool							LoadFromXmlElement(XmlElement const& element);
+};
+
+//------------------------------------------------------------------------------------------------
+// Spawns AI actors for a map from its WaveSpawnerDefinition. Requests accumulate on a timer and
+// are drained a few per frame. Dead spawned actors are parked in a pool per definition and
+// respawned in place of allocating a new actor, weapons and GPU buffers.
+//------------------------------------------------------------------------------------------------
+class WaveSpawner
+{
+public:
+	Map*							m_map					= nullptr;
+	WaveSpawnerDefinition const&	m_definition;
+	RandomNumberGenerator			m_random;
+
+	std::vector<Vec3>				m_spawnPositions;
+	std::vector<EulerAngles>		m_spawnOrientations;
+	int								m_nextSpawnPoint		= 0;
+
+	std::vector<std::vector<Actor*>>	m_pools;
+	float							m_spawnTimer			= 0.0f;
+	float							m_pendingSpawns			= 0.0f;
+	int								m_numAlive				= 0;
+
+	bool							m_isStressMode			= false;
+	int								m_stressMaxAlive		= 0;
+	float							m_stressSpawnsPerSecond	= 0.0f;
+
+	int								m_numSpawnedLastFrame	= 0;
+	int								m_numReusedLastFrame	= 0;
+	int								m_numSpawnedTotal		= 0;
+	int								m_numReusedTotal		= 0;
+public:
+									WaveSpawner(Map* map, WaveSpawnerDefinition const& definition);
+									~WaveSpawner();
+
+	void							Update(float deltaseconds);
+	void							SpawnInitial();
+	void							SetStressMode(bool isEnabled, int maxAlive, float spawnsPerSecond);
+
+	bool							SpawnOne();
+	bool							ReleaseActor(Actor* actor);
+
+	int								ChooseEntry();
+	int								ChooseSpawnPoint();
+	int								GetEntryIndex(ActorDefinition const* actorDef) const;
+	int								GetMaxAlive() const;
+};
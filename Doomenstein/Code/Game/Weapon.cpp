@@ -19,7 +19,7 @@ void WeaponDefinition::InitializeDefs()
 {
 	XmlDocument tileDoc;
 
-	XmlError result = tileDoc.LoadFile("Data/Definitions/WeaponDefinitions.xml");
+	XmlError result = LoadXmlDocument(tileDoc, "Data/Definitions/WeaponDefinitions.xml");
 
 	if (result != tinyxml2::XML_SUCCESS)
 		GUARANTEE_OR_DIE(false, "COULD NOT LOAD XML");
@@ -112,6 +112,7 @@ void WeaponDefinition::InitializeDefs()
 					SpriteAnimDefinition* spriteAnim = new SpriteAnimDefinition(*sprite, s_weaponDefinitions[index].m_startFrame[animElementIndex], s_weaponDefinitions[index].m_endFrame[animElementIndex], (s_weaponDefinitions[index].m_endFrame[animElementIndex] - s_weaponDefinitions[index].m_startFrame[animElementIndex] + 1) * s_weaponDefinitions[index].m_secondsPerFrame[animElementIndex]);
 
 					s_weaponDefinitions[index].m_weaponAnimDef.push_back(spriteAnim);
+					s_weaponDefinitions[index].m_weaponSpriteSheets.push_back(sprite);
 
 					animElementIndex++;
 
@@ -139,6 +140,25 @@ void WeaponDefinition::InitializeDefs()
 	}
 }
 
+void WeaponDefinition::ClearDefs()
+{
+	for (int index = 0; index < 3; index++)
+	{
+		for (size_t animIndex = 0; animIndex < s_weaponDefinitions[index].m_weaponAnimDef.size(); animIndex++)
+		{
+			DELETE_PTR(s_weaponDefinitions[index].m_weaponAnimDef[animIndex]);
+		}
+
+		for (size_t sheetIndex = 0; sheetIndex < s_weaponDefinitions[index].m_weaponSpriteSheets.size(); sheetIndex++)
+		{
+			DELETE_PTR(s_weaponDefinitions[index].m_weaponSpriteSheets[sheetIndex]);
+		}
+
+		s_weaponDefinitions[index].m_weaponAnimDef.clear();
+		s_weaponDefinitions[index].m_weaponSpriteSheets.clear();
+	}
+}
+
 Weapon::Weapon()
 {
 
@@ -14,6 +14,7 @@
 struct Vec3;
 class Actor;
 class Timer;
+class SpriteSheet;
 class SpriteAnimDefinition;
 
 struct WeaponDefinition
@@ -55,6 +56,7 @@ struct WeaponDefinition
 	int							m_endFrame[2]			= {-1, -1};
 
 	std::vector<SpriteAnimDefinition*> m_weaponAnimDef;
+	std::vector<SpriteSheet*>	m_weaponSpriteSheets;
 
 	// Sounds
 	std::string					m_sound;
@@ -63,6 +65,7 @@ struct WeaponDefinition
 	static WeaponDefinition		s_weaponDefinitions[3];
 
 	static void					InitializeDefs();
+	static void					ClearDefs();
 };
 
 class Weapon
@@ -1,6 +1,8 @@
 #include "Engine/Audio/AudioSystem.hpp"
 //#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
 #include "Engine/Core/StringUtils.hpp"
 
 //-----------------------------------------------------------------------------------------------
@@ -49,6 +51,8 @@ AudioSystem::AudioSystem(AudioConfig const& config)
 //------------------------------------------------------------------------------------------------
 void AudioSystem::Startup()
 {
+	ScopedMemoryTag memoryTag(MemoryTag::AUDIO);
+
 	FMOD_RESULT result;
 	result = FMOD::System_Create( &m_fmodSystem );
 	ValidateResult( result );
@@ -89,9 +93,32 @@ void AudioSystem::EndFrame()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sounds open from memory so they resolve through mounted archives; FMOD copies the bytes.
+//-----------------------------------------------------------------------------------------------
+static FMOD::Sound* CreateSoundFromFile( FMOD::System* fmodSystem, std::string const& soundFilePath, FMOD_MODE mode )
+{
+	MappedFile soundFile;
+	if( !soundFile.Open( soundFilePath ) || soundFile.GetSize() == 0 )
+	{
+		return nullptr;
+	}
+
+	FMOD_CREATESOUNDEXINFO soundInfo = {};
+	soundInfo.cbsize = sizeof( soundInfo );
+	soundInfo.length = (unsigned int) soundFile.GetSize();
+
+	FMOD::Sound* newSound = nullptr;
+	fmodSystem->createSound( (char const*) soundFile.GetData(), mode | FMOD_OPENMEMORY, &soundInfo, &newSound );
+	return newSound;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath )
 {
+	ScopedMemoryTag memoryTag(MemoryTag::AUDIO);
+
 	std::map< std::string, SoundID >::iterator found = m_registeredSoundIDs.find( soundFilePath );
 	if( found != m_registeredSoundIDs.end() )
 	{
@@ -99,8 +126,7 @@ SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath )
 	}
 	else
 	{
-		FMOD::Sound* newSound = nullptr;
-		m_fmodSystem->createSound( soundFilePath.c_str(), FMOD_DEFAULT, nullptr, &newSound );
+		FMOD::Sound* newSound = CreateSoundFromFile( m_fmodSystem, soundFilePath, FMOD_DEFAULT );
 		if( newSound )
 		{
 			SoundID newSoundID = m_registeredSounds.size();
@@ -115,6 +141,8 @@ SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath )
 
 SoundID AudioSystem::CreateOrGetSound3D(const std::string& soundFilePath)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::AUDIO);
+
 	std::map< std::string, SoundID >::iterator found = m_registeredSoundIDs.find(soundFilePath);
 	if (found != m_registeredSoundIDs.end())
 	{
@@ -122,8 +150,7 @@ SoundID AudioSystem::CreateOrGetSound3D(const std::string& soundFilePath)
 	}
 	else
 	{
-		FMOD::Sound* newSound = nullptr;
-		m_fmodSystem->createSound(soundFilePath.c_str(), FMOD_3D, nullptr, &newSound);
+		FMOD::Sound* newSound = CreateSoundFromFile(m_fmodSystem, soundFilePath, FMOD_3D);
 		if (newSound)
 		{
 			SoundID newSoundID = m_registeredSounds.size();
@@ -0,0 +1,329 @@
+#include "Engine/Core/AssetArchive.hpp"
+
+#include "Engine/Core/Compression.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <string.h>
+
+constexpr uint64_t ASSET_PATH_HASH_OFFSET	= 14695981039346656037ull;
+constexpr uint64_t ASSET_PATH_HASH_PRIME	= 1099511628211ull;
+
+//------------------------------------------------------------------------------------------------
+// Compressed data must save at least this fraction to be kept, so already-compressed formats
+// (PNG, MP3) stay raw and remain directly mappable.
+//------------------------------------------------------------------------------------------------
+constexpr double ASSET_ARCHIVE_MIN_COMPRESSION_SAVING = 0.1;
+
+//------------------------------------------------------------------------------------------------
+static char NormalizeAssetPathCharacter(char c)
+{
+	if (c == '\\')
+	{
+		return '/';
+	}
+
+	if (c >= 'A' && c <= 'Z')
+	{
+		return (char)(c - 'A' + 'a');
+	}
+
+	return c;
+}
+
+static std::string_view TrimAssetPath(std::string_view filePath)
+{
+	while (filePath.size() >= 2 && filePath[0] == '.' && (filePath[1] == '/' || filePath[1] == '\\'))
+	{
+		filePath.remove_prefix(2);
+	}
+
+	return filePath;
+}
+
+static bool AreAssetPathsEqual(std::string_view pathA, std::string_view pathB)
+{
+	if (pathA.size() != pathB.size())
+	{
+		return false;
+	}
+
+	for (size_t index = 0; index < pathA.size(); index++)
+	{
+		if (NormalizeAssetPathCharacter(pathA[index]) != NormalizeAssetPathCharacter(pathB[index]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint64_t HashAssetPath(std::string_view filePath)
+{
+	filePath = TrimAssetPath(filePath);
+
+	uint64_t hash = ASSET_PATH_HASH_OFFSET;
+
+	for (char c : filePath)
+	{
+		hash ^= (unsigned char)NormalizeAssetPathCharacter(c);
+		hash *= ASSET_PATH_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------
+bool AssetArchive::Open(std::string const& archivePath)
+{
+	Close();
+
+	if (!m_file.OpenLooseFile(archivePath))
+	{
+		return false;
+	}
+
+	unsigned char const* data = m_file.GetData();
+	uint64_t fileSize = (uint64_t)m_file.GetSize();
+
+	if (fileSize < sizeof(AssetArchiveHeader))
+	{
+		m_file.Close();
+		return false;
+	}
+
+	AssetArchiveHeader const* header = (AssetArchiveHeader const*)data;
+
+	bool isValid = header->m_magic == ASSET_ARCHIVE_MAGIC && header->m_version == ASSET_ARCHIVE_VERSION;
+	isValid = isValid && header->m_tocOffset <= fileSize && (uint64_t)header->m_numEntries * sizeof(AssetArchiveEntry) <= fileSize - header->m_tocOffset;
+	isValid = isValid && header->m_namesOffset <= fileSize && (uint64_t)header->m_namesSize <= fileSize - header->m_namesOffset;
+
+	AssetArchiveEntry const* entries = (AssetArchiveEntry const*)(data + header->m_tocOffset);
+
+	for (uint32_t entryIndex = 0; isValid && entryIndex < header->m_numEntries; entryIndex++)
+	{
+		AssetArchiveEntry const& entry = entries[entryIndex];
+
+		isValid = entry.m_dataOffset <= fileSize && entry.m_storedSize <= fileSize - entry.m_dataOffset;
+		isValid = isValid && (uint64_t)entry.m_nameOffset + entry.m_nameLength <= header->m_namesSize;
+		isValid = isValid && (entry.m_compression == AssetCompression::LZ4 || (entry.m_compression == AssetCompression::NONE && entry.m_storedSize == entry.m_originalSize));
+	}
+
+	if (!isValid)
+	{
+		m_file.Close();
+		return false;
+	}
+
+	m_archivePath = archivePath;
+	m_header = header;
+	m_entries = entries;
+	m_names = (char const*)(data + header->m_namesOffset);
+
+	return true;
+}
+
+void AssetArchive::Close()
+{
+	m_file.Close();
+	m_archivePath.clear();
+	m_header = nullptr;
+	m_entries = nullptr;
+	m_names = nullptr;
+}
+
+bool AssetArchive::IsOpen() const
+{
+	return m_header != nullptr;
+}
+
+std::string const& AssetArchive::GetArchivePath() const
+{
+	return m_archivePath;
+}
+
+int AssetArchive::GetNumEntries() const
+{
+	return m_header ? (int)m_header->m_numEntries : 0;
+}
+
+AssetArchiveEntry const& AssetArchive::GetEntry(int entryIndex) const
+{
+	return m_entries[entryIndex];
+}
+
+AssetArchiveEntry const* AssetArchive::FindEntry(std::string_view filePath) const
+{
+	if (m_header == nullptr)
+	{
+		return nullptr;
+	}
+
+	filePath = TrimAssetPath(filePath);
+
+	uint64_t pathHash = HashAssetPath(filePath);
+
+	AssetArchiveEntry const* entriesEnd = m_entries + m_header->m_numEntries;
+	AssetArchiveEntry const* entry = std::lower_bound(m_entries, entriesEnd, pathHash, [](AssetArchiveEntry const& entry, uint64_t hash) { return entry.m_pathHash < hash; });
+
+	for (; entry != entriesEnd && entry->m_pathHash == pathHash; entry++)
+	{
+		if (AreAssetPathsEqual(GetEntryName(*entry), filePath))
+		{
+			return entry;
+		}
+	}
+
+	return nullptr;
+}
+
+std::string_view AssetArchive::GetEntryName(AssetArchiveEntry const& entry) const
+{
+	return std::string_view(m_names + entry.m_nameOffset, entry.m_nameLength);
+}
+
+unsigned char const* AssetArchive::GetStoredData(AssetArchiveEntry const& entry) const
+{
+	return m_file.GetData() + entry.m_dataOffset;
+}
+
+//------------------------------------------------------------------------------------------------
+// destination must hold entry.m_originalSize bytes.
+//------------------------------------------------------------------------------------------------
+bool AssetArchive::ReadEntry(AssetArchiveEntry const& entry, unsigned char* destination) const
+{
+	if (entry.m_compression == AssetCompression::LZ4)
+	{
+		return DecompressLZ4(GetStoredData(entry), (size_t)entry.m_storedSize, destination, (size_t)entry.m_originalSize);
+	}
+
+	if (entry.m_originalSize > 0)
+	{
+		memcpy(destination, GetStoredData(entry), (size_t)entry.m_originalSize);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+static void AppendPadding(std::vector<unsigned char>& archive, uint64_t alignment)
+{
+	archive.resize((size_t)((archive.size() + alignment - 1) / alignment * alignment), 0);
+}
+
+//------------------------------------------------------------------------------------------------
+// Entry names are sourceDirectory-relative paths prefixed with sourceDirectory itself, matching
+// how the game already spells them ("Data/Textures/...").
+//------------------------------------------------------------------------------------------------
+bool BuildAssetArchive(std::string const& sourceDirectory, std::string const& archivePath, bool compress, int& outNumFiles, uint64_t& outOriginalBytes, uint64_t& outArchiveBytes)
+{
+	outNumFiles = 0;
+	outOriginalBytes = 0;
+	outArchiveBytes = 0;
+
+	std::error_code errorCode;
+	std::filesystem::path sourcePath(sourceDirectory);
+
+	if (!std::filesystem::is_directory(sourcePath, errorCode))
+	{
+		return false;
+	}
+
+	std::filesystem::path archiveFilePath = std::filesystem::absolute(archivePath, errorCode);
+	std::vector<std::string> filePaths;
+
+	for (std::filesystem::recursive_directory_iterator fileIter(sourcePath, errorCode), endIter; fileIter != endIter; fileIter.increment(errorCode))
+	{
+		if (errorCode)
+		{
+			return false;
+		}
+
+		if (!fileIter->is_regular_file() || std::filesystem::absolute(fileIter->path(), errorCode) == archiveFilePath)
+		{
+			continue;
+		}
+
+		filePaths.push_back((sourcePath / std::filesystem::relative(fileIter->path(), sourcePath)).generic_string());
+	}
+
+	std::sort(filePaths.begin(), filePaths.end());
+
+	std::vector<unsigned char> archive(sizeof(AssetArchiveHeader), 0);
+	std::vector<AssetArchiveEntry> entries;
+	std::string names;
+	std::vector<unsigned char> compressedData;
+
+	for (std::string const& filePath : filePaths)
+	{
+		MappedFile sourceFile;
+
+		if (!sourceFile.OpenLooseFile(filePath))
+		{
+			return false;
+		}
+
+		AssetArchiveEntry entry;
+		entry.m_pathHash = HashAssetPath(filePath);
+		entry.m_originalSize = sourceFile.GetSize();
+		entry.m_nameOffset = (uint32_t)names.size();
+		entry.m_nameLength = (uint16_t)filePath.size();
+
+		unsigned char const* storedData = sourceFile.GetData();
+		size_t storedSize = sourceFile.GetSize();
+
+		if (compress && storedSize > 0)
+		{
+			compressedData.resize(GetLZ4CompressBound(storedSize));
+
+			size_t compressedSize = CompressLZ4(sourceFile.GetData(), storedSize, compressedData.data(), compressedData.size());
+
+			if (compressedSize > 0 && (double)compressedSize <= (double)storedSize * (1.0 - ASSET_ARCHIVE_MIN_COMPRESSION_SAVING))
+			{
+				entry.m_compression = AssetCompression::LZ4;
+				storedData = compressedData.data();
+				storedSize = compressedSize;
+			}
+		}
+
+		AppendPadding(archive, ASSET_ARCHIVE_ALIGNMENT);
+
+		entry.m_dataOffset = archive.size();
+		entry.m_storedSize = storedSize;
+
+		archive.insert(archive.end(), storedData, storedData + storedSize);
+		names += filePath;
+		entries.push_back(entry);
+
+		outOriginalBytes += entry.m_originalSize;
+	}
+
+	std::stable_sort(entries.begin(), entries.end(), [](AssetArchiveEntry const& entryA, AssetArchiveEntry const& entryB) { return entryA.m_pathHash < entryB.m_pathHash; });
+
+	AppendPadding(archive, ASSET_ARCHIVE_ALIGNMENT);
+
+	AssetArchiveHeader header;
+	header.m_numEntries = (uint32_t)entries.size();
+	header.m_tocOffset = archive.size();
+
+	unsigned char const* tocData = (unsigned char const*)entries.data();
+	archive.insert(archive.end(), tocData, tocData + entries.size() * sizeof(AssetArchiveEntry));
+
+	header.m_namesOffset = archive.size();
+	header.m_namesSize = (uint32_t)names.size();
+	archive.insert(archive.end(), names.begin(), names.end());
+
+	memcpy(archive.data(), &header, sizeof(header));
+
+	std::string outputPath = archivePath;
+	WriteBufferToFile(archive, outputPath);
+
+	outNumFiles = (int)entries.size();
+	outArchiveBytes = archive.size();
+
+	// A mounted archive cannot be overwritten on every platform, so confirm the bytes landed.
+	MappedFile writtenFile;
+	return writtenFile.OpenLooseFile(archivePath) && writtenFile.GetSize() == archive.size() && memcmp(writtenFile.GetData(), archive.data(), archive.size()) == 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Engine/Core/FileUtils.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+constexpr uint32_t ASSET_ARCHIVE_MAGIC		= 0x4B415044; // "DPAK"
+constexpr uint32_t ASSET_ARCHIVE_VERSION	= 1;
+constexpr uint64_t ASSET_ARCHIVE_ALIGNMENT	= 64;
+
+//------------------------------------------------------------------------------------------------
+enum class AssetCompression : uint8_t
+{
+	NONE,
+	LZ4
+};
+
+//------------------------------------------------------------------------------------------------
+// On-disk layout: header, entry data (each entry aligned to ASSET_ARCHIVE_ALIGNMENT), the table of
+// contents sorted by path hash, then the path names. All offsets are from the start of the file.
+//------------------------------------------------------------------------------------------------
+struct AssetArchiveHeader
+{
+	uint32_t						m_magic					= ASSET_ARCHIVE_MAGIC;
+	uint32_t						m_version				= ASSET_ARCHIVE_VERSION;
+	uint32_t						m_numEntries			= 0;
+	uint32_t						m_namesSize				= 0;
+	uint64_t						m_tocOffset				= 0;
+	uint64_t						m_namesOffset			= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+struct AssetArchiveEntry
+{
+	uint64_t						m_pathHash				= 0;
+	uint64_t						m_dataOffset			= 0;
+	uint64_t						m_storedSize			= 0;
+	uint64_t						m_originalSize			= 0;
+	uint32_t						m_nameOffset			= 0;
+	uint16_t						m_nameLength			= 0;
+	AssetCompression				m_compression			= AssetCompression::NONE;
+	uint8_t							m_reserved				= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Read-only view of a packed archive. The whole file is one mapping; lookups binary-search the
+// table of contents by hash and confirm the stored path, so colliding hashes are harmless.
+// Paths match case-insensitively with either slash direction.
+//------------------------------------------------------------------------------------------------
+class AssetArchive
+{
+	MappedFile						m_file;
+	std::string						m_archivePath;
+	AssetArchiveHeader const*		m_header				= nullptr;
+	AssetArchiveEntry const*		m_entries				= nullptr;
+	char const*						m_names					= nullptr;
+public:
+									AssetArchive() = default;
+									~AssetArchive() = default;
+
+	bool							Open(std::string const& archivePath);
+	void							Close();
+
+	bool							IsOpen() const;
+	std::string const&				GetArchivePath() const;
+	int								GetNumEntries() const;
+	AssetArchiveEntry const&		GetEntry(int entryIndex) const;
+	AssetArchiveEntry const*		FindEntry(std::string_view filePath) const;
+	std::string_view				GetEntryName(AssetArchiveEntry const& entry) const;
+	unsigned char const*			GetStoredData(AssetArchiveEntry const& entry) const;
+	bool							ReadEntry(AssetArchiveEntry const& entry, unsigned char* destination) const;
+};
+
+uint64_t	HashAssetPath(std::string_view filePath);
+bool		BuildAssetArchive(std::string const& sourceDirectory, std::string const& archivePath, bool compress, int& outNumFiles, uint64_t& outOriginalBytes, uint64_t& outArchiveBytes);
@@ -0,0 +1,235 @@
+#include "Engine/Core/Compression.hpp"
+
+#include <string.h>
+
+constexpr size_t LZ4_MIN_MATCH			= 4;
+constexpr size_t LZ4_LAST_LITERALS		= 5;
+constexpr size_t LZ4_MATCH_FIND_LIMIT	= 12;
+constexpr size_t LZ4_MAX_OFFSET			= 65535;
+constexpr int	 LZ4_HASH_BITS			= 12;
+
+//------------------------------------------------------------------------------------------------
+static uint32_t ReadUInt32(uint8_t const* source)
+{
+	uint32_t value;
+	memcpy(&value, source, sizeof(value));
+	return value;
+}
+
+static uint32_t HashSequence(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+// Lengths of 15 or more spill into extra bytes of 255 terminated by a smaller byte.
+static uint8_t* WriteLengthExtension(uint8_t* output, size_t length)
+{
+	while (length >= 255)
+	{
+		*output++ = 255;
+		length -= 255;
+	}
+
+	*output++ = (uint8_t)length;
+
+	return output;
+}
+
+static bool ReadLengthExtension(uint8_t const*& input, uint8_t const* inputEnd, size_t& length)
+{
+	uint8_t byte = 255;
+
+	while (byte == 255)
+	{
+		if (input >= inputEnd)
+		{
+			return false;
+		}
+
+		byte = *input++;
+		length += byte;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+size_t GetLZ4CompressBound(size_t sourceSize)
+{
+	return sourceSize + (sourceSize / 255) + 16;
+}
+
+//------------------------------------------------------------------------------------------------
+// Greedy single-probe matcher. Returns the compressed size, or 0 if destinationCapacity is
+// smaller than GetLZ4CompressBound(sourceSize).
+//------------------------------------------------------------------------------------------------
+size_t CompressLZ4(uint8_t const* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity)
+{
+	if (destinationCapacity < GetLZ4CompressBound(sourceSize))
+	{
+		return 0;
+	}
+
+	uint32_t hashTable[1 << LZ4_HASH_BITS] = {};
+
+	uint8_t const* input = source;
+	uint8_t const* literalStart = source;
+	uint8_t const* sourceEnd = source + sourceSize;
+	uint8_t* output = destination;
+
+	if (sourceSize > LZ4_MATCH_FIND_LIMIT)
+	{
+		uint8_t const* matchFindLimit = sourceEnd - LZ4_MATCH_FIND_LIMIT;
+		uint8_t const* matchLengthLimit = sourceEnd - LZ4_LAST_LITERALS;
+
+		// Position 0 doubles as the empty marker, which only costs a missed match at the start.
+		input++;
+
+		while (input < matchFindLimit)
+		{
+			uint32_t sequence = ReadUInt32(input);
+			uint32_t hash = HashSequence(sequence);
+			uint8_t const* candidate = source + hashTable[hash];
+			hashTable[hash] = (uint32_t)(input - source);
+
+			if (candidate == source || (size_t)(input - candidate) > LZ4_MAX_OFFSET || ReadUInt32(candidate) != sequence)
+			{
+				input++;
+				continue;
+			}
+
+			while (input > literalStart && candidate > source && input[-1] == candidate[-1])
+			{
+				input--;
+				candidate--;
+			}
+
+			uint8_t const* matchEnd = input + LZ4_MIN_MATCH;
+			uint8_t const* candidateEnd = candidate + LZ4_MIN_MATCH;
+
+			while (matchEnd < matchLengthLimit && *matchEnd == *candidateEnd)
+			{
+				matchEnd++;
+				candidateEnd++;
+			}
+
+			size_t literalLength = (size_t)(input - literalStart);
+			size_t matchLength = (size_t)(matchEnd - input) - LZ4_MIN_MATCH;
+			uint8_t* token = output++;
+
+			*token = (uint8_t)((literalLength >= 15 ? 15 : literalLength) << 4);
+			if (literalLength >= 15)
+			{
+				output = WriteLengthExtension(output, literalLength - 15);
+			}
+
+			memcpy(output, literalStart, literalLength);
+			output += literalLength;
+
+			uint16_t offset = (uint16_t)(input - candidate);
+			*output++ = (uint8_t)(offset & 0xFF);
+			*output++ = (uint8_t)(offset >> 8);
+
+			*token |= (uint8_t)(matchLength >= 15 ? 15 : matchLength);
+			if (matchLength >= 15)
+			{
+				output = WriteLengthExtension(output, matchLength - 15);
+			}
+
+			input = matchEnd;
+			literalStart = input;
+
+			if (input < matchFindLimit)
+			{
+				hashTable[HashSequence(ReadUInt32(input - 2))] = (uint32_t)(input - 2 - source);
+			}
+		}
+	}
+
+	size_t lastLiteralLength = (size_t)(sourceEnd - literalStart);
+
+	*output++ = (uint8_t)((lastLiteralLength >= 15 ? 15 : lastLiteralLength) << 4);
+	if (lastLiteralLength >= 15)
+	{
+		output = WriteLengthExtension(output, lastLiteralLength - 15);
+	}
+
+	memcpy(output, literalStart, lastLiteralLength);
+	output += lastLiteralLength;
+
+	return (size_t)(output - destination);
+}
+
+//------------------------------------------------------------------------------------------------
+// Bounds-checked on both sides; returns false for malformed input or a size mismatch.
+//------------------------------------------------------------------------------------------------
+bool DecompressLZ4(uint8_t const* source, size_t sourceSize, uint8_t* destination, size_t destinationSize)
+{
+	uint8_t const* input = source;
+	uint8_t const* inputEnd = source + sourceSize;
+	uint8_t* output = destination;
+	uint8_t* outputEnd = destination + destinationSize;
+
+	while (input < inputEnd)
+	{
+		uint8_t token = *input++;
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLengthExtension(input, inputEnd, literalLength))
+		{
+			return false;
+		}
+
+		if (literalLength > (size_t)(inputEnd - input) || literalLength > (size_t)(outputEnd - output))
+		{
+			return false;
+		}
+
+		memcpy(output, input, literalLength);
+		input += literalLength;
+		output += literalLength;
+
+		if (input == inputEnd)
+		{
+			break;
+		}
+
+		if (inputEnd - input < 2)
+		{
+			return false;
+		}
+
+		size_t offset = (size_t)input[0] | ((size_t)input[1] << 8);
+		input += 2;
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLengthExtension(input, inputEnd, matchLength))
+		{
+			return false;
+		}
+		matchLength += LZ4_MIN_MATCH;
+
+		if (offset == 0 || offset > (size_t)(output - destination) || matchLength > (size_t)(outputEnd - output))
+		{
+			return false;
+		}
+
+		// Overlapping copies are how LZ4 encodes runs, so this stays byte by byte when they overlap.
+		uint8_t const* match = output - offset;
+
+		if (offset >= matchLength)
+		{
+			memcpy(output, match, matchLength);
+			output += matchLength;
+		}
+		else
+		{
+			for (size_t index = 0; index < matchLength; index++)
+			{
+				*output++ = match[index];
+			}
+		}
+	}
+
+	return output == outputEnd;
+}
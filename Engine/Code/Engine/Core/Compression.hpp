@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+//------------------------------------------------------------------------------------------------
+// Raw LZ4 block format (no frame header), so blocks written here decode with any LZ4 library
+// and vice versa. Sizes travel alongside the block; the caller stores the original size.
+//------------------------------------------------------------------------------------------------
+size_t	GetLZ4CompressBound(size_t sourceSize);
+size_t	CompressLZ4(uint8_t const* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity);
+bool	DecompressLZ4(uint8_t const* source, size_t sourceSize, uint8_t* destination, size_t destinationSize);
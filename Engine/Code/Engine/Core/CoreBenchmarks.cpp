@@ -0,0 +1,316 @@
+#include "Engine/Core/CoreBenchmarks.hpp"
+
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include "ThirdParty/stb_image/stb_image.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <string_view>
+
+extern DevConsole* g_theConsole;
+
+void CoreBenchmarksStartup()
+{
+	SubscribeEventCallbackFunction("NamedStringsBenchmark", Command_NamedStringsBenchmark);
+	SubscribeEventCallbackFunction("TokenizerBenchmark", Command_TokenizerBenchmark);
+	SubscribeEventCallbackFunction("BuildAssetArchive", Command_BuildAssetArchive);
+	SubscribeEventCallbackFunction("ImageDecodeBenchmark", Command_ImageDecodeBenchmark);
+}
+
+//------------------------------------------------------------------------------------------------
+// NamedStringsBenchmark count=1000000
+// Times the same lookups and conversions against the std::map<std::string, std::string> storage
+// NamedStrings used to have, which parsed the text on every call.
+//------------------------------------------------------------------------------------------------
+bool Command_NamedStringsBenchmark(EventArgs& args)
+{
+	int count = args.GetValue("count", 1000000);
+
+	if (count <= 0)
+		return false;
+
+	static char const* const KEYS[] = { "KeyCode", "speed", "color", "position", "dimensions", "enabled" };
+	static char const* const VALUES[] = { "65", "3.5", "255,128,0,255", "12.5,-4.25", "64,32", "true" };
+
+	std::map<std::string, std::string> baseline;
+	NamedStrings flat;
+
+	for (int index = 0; index < 6; index++)
+	{
+		baseline[KEYS[index]] = VALUES[index];
+		flat.SetValue(KEYS[index], VALUES[index]);
+	}
+
+	std::string const keyCode = "KeyCode";
+	std::string const speed = "speed";
+	std::string const color = "color";
+	std::string const position = "position";
+
+	double checksum = 0.0;
+	double startSeconds = GetCurrentTimeSeconds();
+
+	for (int index = 0; index < count; index++)
+	{
+		checksum += std::atoi(baseline.find(keyCode)->second.c_str());
+		checksum += std::atof(baseline.find(speed)->second.c_str());
+
+		Rgba8 rgba;
+		rgba.SetFromText(baseline.find(color)->second.c_str());
+		checksum += rgba.g;
+
+		Vec2 vec;
+		vec.SetFromText(baseline.find(position)->second.c_str());
+		checksum += vec.x;
+	}
+
+	double mapSeconds = GetCurrentTimeSeconds() - startSeconds;
+	startSeconds = GetCurrentTimeSeconds();
+
+	for (int index = 0; index < count; index++)
+	{
+		checksum += flat.GetValue(keyCode, 0);
+		checksum += flat.GetValue(speed, 0.f);
+		checksum += flat.GetValue(color, Rgba8()).g;
+		checksum += flat.GetValue(position, Vec2()).x;
+	}
+
+	double flatSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	if (g_theConsole)
+	{
+		g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("NamedStringsBenchmark: %d iterations of 4 typed lookups (checksum %.0f)", count, checksum));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  std::map + parse every call: %.2f ms", mapSeconds * 1000.0));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Flat + cached typed values: %.2f ms", flatSeconds * 1000.0));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+// TokenizerBenchmark sizeMB=100
+// Tokenises generated OBJ-like text with the Strings-returning splits and with the view API
+//------------------------------------------------------------------------------------------------
+bool Command_TokenizerBenchmark(EventArgs& args)
+{
+	int sizeMB = args.GetValue("sizeMB", 100);
+
+	if (sizeMB <= 0)
+		return false;
+
+	size_t targetSize = (size_t)sizeMB * 1024 * 1024;
+
+	std::string text;
+	text.reserve(targetSize + 128);
+
+	for (int lineIndex = 0; text.size() < targetSize; lineIndex++)
+	{
+		switch (lineIndex % 4)
+		{
+		case 0:	text += Stringf("v %.6f %.6f %.6f\r\n", lineIndex * 0.001f, lineIndex * -0.002f, lineIndex * 0.003f);	break;
+		case 1:	text += Stringf("vt %.6f %.6f\r\n", lineIndex * 0.0001f, 1.f - lineIndex * 0.0001f);					break;
+		case 2:	text += Stringf("vn %.6f %.6f %.6f\r\n", 0.267261f, 0.534522f, 0.801784f);								break;
+		default: text += Stringf("f %d/%d/%d %d/%d/%d %d/%d/%d\r\n", lineIndex, lineIndex, lineIndex, lineIndex + 1, lineIndex + 1, lineIndex + 1, lineIndex + 2, lineIndex + 2, lineIndex + 2); break;
+		}
+	}
+
+	double checksum = 0.0;
+	size_t numTokens = 0;
+
+	double startSeconds = GetCurrentTimeSeconds();
+	{
+		Strings lines;
+		SplitStringOnDelimiter(lines, text, "\r\n");
+
+		for (size_t lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+		{
+			Strings tokens = SplitStringOnDelimiter(lines[lineIndex], ' ');
+
+			for (size_t tokenIndex = 1; tokenIndex < tokens.size(); tokenIndex++)
+			{
+				checksum += std::atof(tokens[tokenIndex].c_str());
+				numTokens++;
+			}
+		}
+	}
+	double splitSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	startSeconds = GetCurrentTimeSeconds();
+	{
+		std::string_view remaining = text;
+		std::string_view line;
+
+		while (GetNextLine(remaining, line))
+		{
+			StringTokenizer tokenizer(line, ' ');
+			std::string_view token;
+
+			tokenizer.GetNextToken(token);
+
+			while (tokenizer.GetNextToken(token))
+			{
+				float value = 0.f;
+				ParseFloat(token, value);
+
+				checksum += value;
+				numTokens++;
+			}
+		}
+	}
+	double viewSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	if (g_theConsole)
+	{
+		double megabytes = (double)text.size() / (1024.0 * 1024.0);
+
+		g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("TokenizerBenchmark: %.1f MB, %llu tokens (checksum %.0f)", megabytes, (unsigned long long)numTokens, checksum));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Split into Strings + atof: %.1f ms (%.0f MB/s)", splitSeconds * 1000.0, megabytes / splitSeconds));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  string_view + from_chars: %.1f ms (%.0f MB/s)", viewSeconds * 1000.0, megabytes / viewSeconds));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+// BuildAssetArchive source=Data archive=Data.pak compress=true
+//------------------------------------------------------------------------------------------------
+bool Command_BuildAssetArchive(EventArgs& args)
+{
+	std::string sourceDirectory = args.GetValue("source", std::string("Data"));
+	std::string archivePath = args.GetValue("archive", std::string("Data.pak"));
+	bool compress = args.GetValue("compress", true);
+
+	int numFiles = 0;
+	uint64_t originalBytes = 0;
+	uint64_t archiveBytes = 0;
+
+	double startTime = GetCurrentTimeSeconds();
+	bool succeeded = BuildAssetArchive(sourceDirectory, archivePath, compress, numFiles, originalBytes, archiveBytes);
+	double elapsedMS = (GetCurrentTimeSeconds() - startTime) * 1000.0;
+
+	if (!succeeded)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, Stringf("Could not build \"%s\" from \"%s\"", archivePath.c_str(), sourceDirectory.c_str()));
+		return false;
+	}
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Packed %d files from \"%s\" into \"%s\" in %.1f ms", numFiles, sourceDirectory.c_str(), archivePath.c_str(), elapsedMS));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %.2f MB -> %.2f MB; mount on next launch", (double)originalBytes / (1024.0 * 1024.0), (double)archiveBytes / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+// The Image(char const*) decode as it was: native channels, one push_back per texel, and the stb
+// buffer left for the caller (freed here so the benchmark does not leak).
+//------------------------------------------------------------------------------------------------
+static void DecodeImagePerTexel(unsigned char const* encodedData, int encodedSize, std::vector<Rgba8>& outTexels)
+{
+	IntVec2 dimensions;
+	int bytesPerTexel = 0;
+
+	stbi_set_flip_vertically_on_load(1);
+	unsigned char* texelData = stbi_load_from_memory(encodedData, encodedSize, &dimensions.x, &dimensions.y, &bytesPerTexel, 0);
+
+	int totaltexels = dimensions.x * dimensions.y;
+
+	for (int index = 0; index < totaltexels * bytesPerTexel; index += bytesPerTexel)
+	{
+		if (bytesPerTexel == 3)
+		{
+			outTexels.push_back(Rgba8(texelData[index], texelData[index + 1], texelData[index + 2], 255));
+		}
+		else if (bytesPerTexel == 4)
+		{
+			outTexels.push_back(Rgba8(texelData[index], texelData[index + 1], texelData[index + 2], texelData[index + 3]));
+		}
+	}
+
+	stbi_image_free(texelData);
+}
+
+//------------------------------------------------------------------------------------------------
+// ImageDecodeBenchmark directory=Data/Textures iterations=5
+// Files are read up front so both paths time decoding only.
+//------------------------------------------------------------------------------------------------
+bool Command_ImageDecodeBenchmark(EventArgs& args)
+{
+	std::string directory = args.GetValue("directory", std::string("Data/Textures"));
+	int iterations = args.GetValue("iterations", 5);
+
+	if (iterations < 1)
+	{
+		iterations = 1;
+	}
+
+	std::vector<std::vector<uint8_t>> encodedImages;
+	std::error_code errorCode;
+
+	for (std::filesystem::directory_iterator fileIter(directory, errorCode), endIter; fileIter != endIter; fileIter.increment(errorCode))
+	{
+		if (errorCode)
+		{
+			break;
+		}
+
+		if (fileIter->is_regular_file())
+		{
+			std::string filePath = fileIter->path().generic_string();
+			std::vector<uint8_t> encodedImage;
+
+			if (FileReadToBuffer(encodedImage, filePath) == 0 && !encodedImage.empty())
+			{
+				encodedImages.push_back(std::move(encodedImage));
+			}
+		}
+	}
+
+	if (encodedImages.empty())
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, Stringf("No images found in \"%s\"", directory.c_str()));
+		return false;
+	}
+
+	size_t numTexels = 0;
+	double perTexelSeconds = 0.0;
+	double directSeconds = 0.0;
+
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		for (std::vector<uint8_t> const& encodedImage : encodedImages)
+		{
+			std::vector<Rgba8> texels;
+
+			double startTime = GetCurrentTimeSeconds();
+			DecodeImagePerTexel(encodedImage.data(), (int)encodedImage.size(), texels);
+			perTexelSeconds += GetCurrentTimeSeconds() - startTime;
+
+			Image image;
+
+			startTime = GetCurrentTimeSeconds();
+			image.DecodeFromMemory(encodedImage.data(), encodedImage.size());
+			directSeconds += GetCurrentTimeSeconds() - startTime;
+
+			numTexels += image.m_rgbaTexels.size();
+		}
+	}
+
+	double megaTexels = (double)numTexels / 1000000.0;
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Decoded %d images x %d from \"%s\" (%.2f MTexels)", (int)encodedImages.size(), iterations, directory.c_str(), megaTexels));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  push_back per texel: %8.2f ms  %7.1f MTexels/s", perTexelSeconds * 1000.0, megaTexels / perTexelSeconds));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  direct to buffer:    %8.2f ms  %7.1f MTexels/s  (%.2fx)", directSeconds * 1000.0, megaTexels / directSeconds, perTexelSeconds / directSeconds));
+
+	return true;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+class NamedStrings;
+
+typedef NamedStrings EventArgs;
+
+//------------------------------------------------------------------------------------------------
+// Console benchmarks and tools for Core. They report through the DevConsole, so they live here
+// rather than next to the code they drive, which keeps its original dependencies.
+//------------------------------------------------------------------------------------------------
+void		CoreBenchmarksStartup();
+
+bool		Command_NamedStringsBenchmark(EventArgs& args);
+bool		Command_TokenizerBenchmark(EventArgs& args);
+bool		Command_BuildAssetArchive(EventArgs& args);
+bool		Command_ImageDecodeBenchmark(EventArgs& args);
@@ -1,4 +1,5 @@
 #include "Engine/Core/DebugRender.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
 
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/Vec3.hpp"
@@ -8,6 +9,7 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Profiler.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
@@ -23,7 +25,7 @@ struct ModelConstants
 
 struct DebugRenderGeometry
 {
-	std::vector<Vertex_PCU>		m_vertices;
+	int							m_numVertices				= 0;
 	VertexBuffer*				m_gpuMesh					= nullptr;
 	ConstantBuffer*				m_modelCBO					= nullptr;
 	Timer*						m_timer						= nullptr;
@@ -43,7 +45,7 @@ struct DebugRenderGeometry
 
 struct ScreenRenderGeometry
 {
-	std::vector<Vertex_PCU>		m_vertices;
+	int							m_numVertices				= 0;
 	VertexBuffer*				m_gpuMesh					= nullptr;
 	Timer*						m_timer						= nullptr;
 	ConstantBuffer*				m_modelCBO					= nullptr;
@@ -67,6 +69,7 @@ public:
 	std::vector<ScreenRenderGeometry*>		m_screenPrimitives;
 	std::vector<ScreenRenderGeometry*>		m_infiniteMsgsPrimitives;
 	std::vector<ScreenRenderGeometry*>		m_finiteMsgsPrimitives;
+	std::vector<Vertex_PCU>					m_scratchVertices;
 	DebugRenderConfig						m_config;
 	BitmapFont*								m_font			= nullptr;
 	bool									m_isVisible		= true;
@@ -80,6 +83,8 @@ DebugRender* g_theDebugRender = nullptr;
 
 void DebugRenderSystemStartup(DebugRenderConfig const& config)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	g_theDebugRender = new DebugRender();
 	g_theDebugRender->m_config = config;
 
@@ -172,6 +177,8 @@ void DebugRenderBeginFrame()
 
 void DebugRenderWorld(Camera& camera)
 {
+	PROFILE_SCOPE("DebugRenderWorld");
+
 	g_theDebugRender->m_config.m_renderer->BeginCamera(camera, RootSig::DEFAULT_PIPELINE);
 
 	if (g_theDebugRender->m_isVisible)
@@ -202,7 +209,7 @@ void DebugRenderWorld(Camera& camera)
 					g_theDebugRender->m_config.m_renderer->SetRasterizerMode(g_theDebugRender->m_debugPrimitives[index]->m_rasterizerMode);
 					g_theDebugRender->m_config.m_renderer->BindShader();
 					g_theDebugRender->m_config.m_renderer->BindTexture(0, g_theDebugRender->m_debugPrimitives[index]->m_texture);
-					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, (int)g_theDebugRender->m_debugPrimitives[index]->m_vertices.size(), sizeof(Vertex_PCU));
+					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, g_theDebugRender->m_debugPrimitives[index]->m_numVertices, sizeof(Vertex_PCU));
 				}
 				else if (g_theDebugRender->m_debugPrimitives[index]->m_mode == DebugRenderMode::USE_DEPTH)
 				{
@@ -214,7 +221,7 @@ void DebugRenderWorld(Camera& camera)
 					g_theDebugRender->m_config.m_renderer->SetRasterizerMode(g_theDebugRender->m_debugPrimitives[index]->m_rasterizerMode);
 					g_theDebugRender->m_config.m_renderer->BindShader();
 					g_theDebugRender->m_config.m_renderer->BindTexture(0, g_theDebugRender->m_debugPrimitives[index]->m_texture);
-					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, (int)g_theDebugRender->m_debugPrimitives[index]->m_vertices.size(), sizeof(Vertex_PCU));
+					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, g_theDebugRender->m_debugPrimitives[index]->m_numVertices, sizeof(Vertex_PCU));
 				}
 			}
 		}
@@ -242,7 +249,7 @@ void DebugRenderWorld(Camera& camera)
 					g_theDebugRender->m_config.m_renderer->SetRasterizerMode(g_theDebugRender->m_debugPrimitives[index]->m_rasterizerMode);
 					g_theDebugRender->m_config.m_renderer->BindShader();
 					g_theDebugRender->m_config.m_renderer->BindTexture(0, g_theDebugRender->m_debugPrimitives[index]->m_texture);
-					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, (int)g_theDebugRender->m_debugPrimitives[index]->m_vertices.size(), sizeof(Vertex_PCU));
+					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, g_theDebugRender->m_debugPrimitives[index]->m_numVertices, sizeof(Vertex_PCU));
 
 					debugPrimitiveColor = g_theDebugRender->m_debugPrimitives[index]->m_startColor;
 
@@ -254,7 +261,7 @@ void DebugRenderWorld(Camera& camera)
 					g_theDebugRender->m_config.m_renderer->SetRasterizerMode(g_theDebugRender->m_debugPrimitives[index]->m_rasterizerMode);
 					g_theDebugRender->m_config.m_renderer->BindShader();
 					g_theDebugRender->m_config.m_renderer->BindTexture(0, g_theDebugRender->m_debugPrimitives[index]->m_texture);
-					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, (int)g_theDebugRender->m_debugPrimitives[index]->m_vertices.size(), sizeof(Vertex_PCU));
+					g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_debugPrimitives[index]->m_gpuMesh, g_theDebugRender->m_debugPrimitives[index]->m_numVertices, sizeof(Vertex_PCU));
 				}
 			}
 		}
@@ -265,6 +272,8 @@ void DebugRenderWorld(Camera& camera)
 
 void DebugRenderScreen(Camera& camera)
 {
+	PROFILE_SCOPE("DebugRenderScreen");
+
 	g_theDebugRender->m_config.m_renderer->BeginCamera(camera, RootSig::DEFAULT_PIPELINE);
 
 	for (size_t index = 0; index < g_theDebugRender->m_screenPrimitives.size(); index++)
@@ -279,7 +288,7 @@ void DebugRenderScreen(Camera& camera)
 			g_theDebugRender->m_config.m_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
 			g_theDebugRender->m_config.m_renderer->SetRasterizerMode(g_theDebugRender->m_screenPrimitives[index]->m_rasterizerMode);
 			g_theDebugRender->m_config.m_renderer->BindTexture(0, g_theDebugRender->m_screenPrimitives[index]->m_texture);
-			g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_screenPrimitives[index]->m_gpuMesh, (int)g_theDebugRender->m_screenPrimitives[index]->m_vertices.size(), sizeof(Vertex_PCU));
+			g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_screenPrimitives[index]->m_gpuMesh, g_theDebugRender->m_screenPrimitives[index]->m_numVertices, sizeof(Vertex_PCU));
 		}
 	}
 
@@ -302,7 +311,7 @@ void DebugRenderScreen(Camera& camera)
 			g_theDebugRender->m_config.m_renderer->SetRasterizerMode(g_theDebugRender->m_infiniteMsgsPrimitives[index]->m_rasterizerMode);
 			g_theDebugRender->m_config.m_renderer->BindShader();
 			g_theDebugRender->m_config.m_renderer->BindTexture(0, g_theDebugRender->m_infiniteMsgsPrimitives[index]->m_texture);
-			g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_screenPrimitives[index]->m_gpuMesh, (int)g_theDebugRender->m_screenPrimitives[index]->m_vertices.size(), sizeof(Vertex_PCU));
+			g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_screenPrimitives[index]->m_gpuMesh, g_theDebugRender->m_screenPrimitives[index]->m_numVertices, sizeof(Vertex_PCU));
 		}
 	}
 
@@ -325,7 +334,7 @@ void DebugRenderScreen(Camera& camera)
 			g_theDebugRender->m_config.m_renderer->SetRasterizerMode(g_theDebugRender->m_finiteMsgsPrimitives[index]->m_rasterizerMode);
 			g_theDebugRender->m_config.m_renderer->BindShader();
 			g_theDebugRender->m_config.m_renderer->BindTexture(0, g_theDebugRender->m_finiteMsgsPrimitives[index]->m_texture);
-			g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_screenPrimitives[index]->m_gpuMesh, (int)g_theDebugRender->m_screenPrimitives[index]->m_vertices.size(), sizeof(Vertex_PCU));
+			g_theDebugRender->m_config.m_renderer->DrawVertexBuffer(g_theDebugRender->m_screenPrimitives[index]->m_gpuMesh, g_theDebugRender->m_screenPrimitives[index]->m_numVertices, sizeof(Vertex_PCU));
 		}
 	}
 
@@ -386,11 +395,17 @@ void DebugRenderEndFrame()
 
 void DebugAddWorldPoint(Vec3 const& pos, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
-	AddVertsForSphere3D(primitive->m_vertices, pos, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	AddVertsForSphere3D(verts, pos, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -415,11 +430,17 @@ void DebugAddWorldPoint(Vec3 const& pos, float radius, float duration, Rgba8 con
 
 void DebugAddWorldLine(Vec3 const& start, Vec3 const& end, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
-	AddVertsForCylinder3D(primitive->m_vertices, start, end, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
+	AddVertsForCylinder3D(verts, start, end, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -444,11 +465,17 @@ void DebugAddWorldLine(Vec3 const& start, Vec3 const& end, float radius, float d
 
 void DebugAddWorldWireCylinder(Vec3 const& base, Vec3 const& top, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
-	AddVertsForCylinder3D(primitive->m_vertices, base, top, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
+	AddVertsForCylinder3D(verts, base, top, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -473,11 +500,17 @@ void DebugAddWorldWireCylinder(Vec3 const& base, Vec3 const& top, float radius,
 
 void DebugAddWorldWireSphere(Vec3 const& center, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
-	AddVertsForSphere3D(primitive->m_vertices, center, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE);
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	AddVertsForSphere3D(verts, center, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE);
+
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -502,14 +535,20 @@ void DebugAddWorldWireSphere(Vec3 const& center, float radius, float duration, R
 
 void DebugAddWorldArrow(Vec3 const& start, Vec3 const& end, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
 	Vec3 cylinderEnd = start + (0.7f * (end - start));
 
-	AddVertsForCylinder3D(primitive->m_vertices, start, cylinderEnd, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
-	AddVertsForCone3D(primitive->m_vertices, cylinderEnd, end, radius + (radius * 0.5f), Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	AddVertsForCylinder3D(verts, start, cylinderEnd, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	AddVertsForCone3D(verts, cylinderEnd, end, radius + (radius * 0.5f), Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -534,14 +573,20 @@ void DebugAddWorldArrow(Vec3 const& start, Vec3 const& end, float radius, float
 
 void DebugAddWorldWireArrow(Vec3 const& start, Vec3 const& end, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
 	Vec3 cylinderEnd = start + (0.7f * (end - start));
 
-	AddVertsForCylinder3D(primitive->m_vertices, start, cylinderEnd, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
-	AddVertsForCone3D(primitive->m_vertices, cylinderEnd, end, radius + (radius * 0.5f), Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	AddVertsForCylinder3D(verts, start, cylinderEnd, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	AddVertsForCone3D(verts, cylinderEnd, end, radius + (radius * 0.5f), Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -566,20 +611,26 @@ void DebugAddWorldWireArrow(Vec3 const& start, Vec3 const& end, float radius, fl
 
 void DebugAddWorldBasis(Mat44 const& transform, float duration, float length, float radius, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
-	AddVertsForCylinder3D(primitive->m_vertices, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.7f * length, 0.0f, 0.0f), radius, Rgba8::RED, AABB2::ZERO_TO_ONE, 32);
-	AddVertsForCone3D(primitive->m_vertices, Vec3(0.7f * length, 0.0f, 0.0f), Vec3(length, 0.0f, 0.0f), radius + (radius * 0.3f), Rgba8::RED, AABB2::ZERO_TO_ONE, 32);
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
 
-	AddVertsForCylinder3D(primitive->m_vertices, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.7f * length, 0.0f), radius, Rgba8::GREEN, AABB2::ZERO_TO_ONE, 32);
-	AddVertsForCone3D(primitive->m_vertices, Vec3(0.0f, 0.7f * length, 0.0f), Vec3(0.0f, length, 0.0f), radius + (radius * 0.3f), Rgba8::GREEN, AABB2::ZERO_TO_ONE, 32);
+	AddVertsForCylinder3D(verts, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.7f * length, 0.0f, 0.0f), radius, Rgba8::RED, AABB2::ZERO_TO_ONE, 32);
+	AddVertsForCone3D(verts, Vec3(0.7f * length, 0.0f, 0.0f), Vec3(length, 0.0f, 0.0f), radius + (radius * 0.3f), Rgba8::RED, AABB2::ZERO_TO_ONE, 32);
 
-	AddVertsForCylinder3D(primitive->m_vertices, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, 0.7f * length), radius, Rgba8::BLUE, AABB2::ZERO_TO_ONE, 32);
-	AddVertsForCone3D(primitive->m_vertices, Vec3(0.0f, 0.0f, 0.7f * length), Vec3(0.0f, 0.0f, length), radius + (radius * 0.3f), Rgba8::BLUE, AABB2::ZERO_TO_ONE, 32);
+	AddVertsForCylinder3D(verts, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.7f * length, 0.0f), radius, Rgba8::GREEN, AABB2::ZERO_TO_ONE, 32);
+	AddVertsForCone3D(verts, Vec3(0.0f, 0.7f * length, 0.0f), Vec3(0.0f, length, 0.0f), radius + (radius * 0.3f), Rgba8::GREEN, AABB2::ZERO_TO_ONE, 32);
 
-	AddVertsForSphere3D(primitive->m_vertices, Vec3(0.0f, 0.0f, 0.0f), radius + (radius * 0.7f), Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+	AddVertsForCylinder3D(verts, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, 0.7f * length), radius, Rgba8::BLUE, AABB2::ZERO_TO_ONE, 32);
+	AddVertsForCone3D(verts, Vec3(0.0f, 0.0f, 0.7f * length), Vec3(0.0f, 0.0f, length), radius + (radius * 0.3f), Rgba8::BLUE, AABB2::ZERO_TO_ONE, 32);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	AddVertsForSphere3D(verts, Vec3(0.0f, 0.0f, 0.0f), radius + (radius * 0.7f), Rgba8::WHITE, AABB2::ZERO_TO_ONE, 16);
+
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -605,13 +656,19 @@ void DebugAddWorldBasis(Mat44 const& transform, float duration, float length, fl
 
 void DebugAddWorldText(std::string const& text, Mat44 const& transform, float textHeight, Vec2 const& alignment, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	UNUSED(alignment);
 
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
-	g_theDebugRender->m_font->AddVertsForText3DAtOriginXForward(primitive->m_vertices, textHeight, text);
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
+	g_theDebugRender->m_font->AddVertsForText3DAtOriginXForward(verts, textHeight, text);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_duration = duration;
@@ -638,6 +695,8 @@ void DebugAddWorldText(std::string const& text, Mat44 const& transform, float te
 
 void DebugAddWorldBillboardText(std::string const& text, Mat44 const& transform, float textHeight, Vec2 const& alignment, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	UNUSED(alignment);
 	UNUSED(mode);
 
@@ -647,9 +706,13 @@ void DebugAddWorldBillboardText(std::string const& text, Mat44 const& transform,
 	
 	DebugRenderGeometry* primitive = new DebugRenderGeometry();
 
-	g_theDebugRender->m_font->AddVertsForText3DAtOriginXForward(primitive->m_vertices, textHeight, text);
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
+	g_theDebugRender->m_font->AddVertsForText3DAtOriginXForward(verts, textHeight, text);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(primitive->m_vertices.data(), (int)primitive->m_vertices.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), primitive->m_gpuMesh);
+	primitive->m_numVertices = (int)verts.size();
 
 	primitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	primitive->m_billboardPos = billboardPos;
@@ -678,18 +741,24 @@ void DebugAddWorldBillboardText(std::string const& text, Mat44 const& transform,
 
 void DebugAddScreenText(std::string const& text, Mat44 const& transform, float textHeight, Vec2 const& alignment, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	UNUSED(alignment);
 	UNUSED(mode);
 
 	ScreenRenderGeometry* screenPrimitive = new ScreenRenderGeometry();
 
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
 	float textWidth = text.size() * textHeight;
 
 	AABB2 bounds = AABB2(textWidth * -0.5f, textHeight * -0.5f, textWidth * 0.5f, textHeight * 0.5f);
 
-	g_theDebugRender->m_font->AddVertsForTextInBox2D(screenPrimitive->m_vertices, bounds, textHeight, text, Rgba8::WHITE, 1.0f, alignment);
+	g_theDebugRender->m_font->AddVertsForTextInBox2D(verts, bounds, textHeight, text, Rgba8::WHITE, 1.0f, alignment);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(screenPrimitive->m_vertices.data(), (int)screenPrimitive->m_vertices.size() * sizeof(Vertex_PCU), screenPrimitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), screenPrimitive->m_gpuMesh);
+	screenPrimitive->m_numVertices = (int)verts.size();
 
 	screenPrimitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	screenPrimitive->m_duration = duration;
@@ -716,18 +785,24 @@ void DebugAddScreenText(std::string const& text, Mat44 const& transform, float t
 
 void DebugAddMessage(std::string const& text, Vec3 const& screenPosition, float textHeight, Vec2 const& alignment, float duration, Rgba8 const& startColor, Rgba8 const& endColor, DebugRenderMode mode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::DEBUG);
+
 	UNUSED(alignment);
 	UNUSED(mode);
 
 	ScreenRenderGeometry* screenPrimitive = new ScreenRenderGeometry();
 
+	std::vector<Vertex_PCU>& verts = g_theDebugRender->m_scratchVertices;
+	verts.clear();
+
 	float textWidth = text.size() * textHeight;
 
 	AABB2 bounds = AABB2(textWidth * -0.5f, textHeight * -0.5f, textWidth * 0.5f, textHeight * 0.5f);
 
-	g_theDebugRender->m_font->AddVertsForTextInBox2D(screenPrimitive->m_vertices, bounds, textHeight, text);
+	g_theDebugRender->m_font->AddVertsForTextInBox2D(verts, bounds, textHeight, text);
 
-	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(screenPrimitive->m_vertices.data(), (int)screenPrimitive->m_vertices.size() * sizeof(Vertex_PCU), screenPrimitive->m_gpuMesh);
+	g_theDebugRender->m_config.m_renderer->CopyCPUToGPU(verts.data(), (int)verts.size() * sizeof(Vertex_PCU), screenPrimitive->m_gpuMesh);
+	screenPrimitive->m_numVertices = (int)verts.size();
 
 	screenPrimitive->m_timer = new Timer(duration, &Clock::GetSystemClock());
 	screenPrimitive->m_duration = duration;
@@ -22,6 +22,29 @@ Rgba8 const DevConsole::INPUT_TEXT = Rgba8(255, 223, 0, 255);
 Rgba8 const DevConsole::COMMAND_ECHO = Rgba8(255, 255, 255, 255);
 Rgba8 const DevConsole::COMMAND_REMOTE_ECHO = Rgba8(255, 0, 255, 255);
 
+//------------------------------------------------------------------------------------------------
+// A key=value argument has exactly one '=' outside quotes; a quoted value may contain more
+//------------------------------------------------------------------------------------------------
+static bool IsValidArgumentPair(std::string const& argumentText)
+{
+	int numEquals = 0;
+	bool isInsideQuotes = false;
+
+	for (char c : argumentText)
+	{
+		if (c == '"')
+		{
+			isInsideQuotes = !isInsideQuotes;
+		}
+		else if (c == '=' && !isInsideQuotes)
+		{
+			numEquals++;
+		}
+	}
+
+	return numEquals == 1;
+}
+
 DevConsole::DevConsole(DevConsoleConfig const& config)
 	: m_config(config)
 {
@@ -67,11 +90,11 @@ void DevConsole::EndFrame()
 
 void DevConsole::Execute(std::string const& consoleCommandText, bool echoCommand)
 {
-	// Split text into individual lines
-	std::vector<std::string> commandLines = SplitStringOnDelimiter(consoleCommandText, '\n');
+	// Walk the text line by line, process each argument first and then fire 
+	std::string_view remainingText = consoleCommandText;
+	std::string_view commandLine;
 
-	// Loop through each command line, process each argument first and then fire 
-	for (const std::string& commandLine : commandLines)
+	while (GetNextLine(remainingText, commandLine))
 	{
 		// Split quotes & command name and parts 
 		std::vector<std::string> commandQuotes = SplitStringWithQuotes(commandLine, ' ');
@@ -89,24 +112,24 @@ void DevConsole::Execute(std::string const& consoleCommandText, bool echoCommand
 					if (commandName == "ECHO")
 					{
 						std::vector<std::string> argPairs = SplitStringWithQuotes(commandQuotes[argumentIndex], '=');
-						if (argPairs.size() < 2)
+						if (argPairs.size() != 2 || !IsValidArgumentPair(commandQuotes[argumentIndex]))
 						{
-							AddLine(ERROR, "Arguments expect a name value that has a '=' sign to it ");
+							AddLine(ERROR, "Arguments expect a name value pair with exactly one '=' sign in it ");
 							return;
 						}
 
 						std::transform(argPairs[0].begin(), argPairs[0].end(), argPairs[0].begin(), [](unsigned char c) -> unsigned char { return (unsigned char)std::toupper(c); });
-						args.SetValue(argPairs[0], argPairs[argumentIndex]);
+						args.SetValue(argPairs[0], argPairs[1]);
 					}
 					else
 					{
 						std::vector<std::string> argPairs = SplitStringWithQuotes(commandQuotes[argumentIndex], '=');
-						if (argPairs.size() < 2)
+						if (argPairs.size() != 2 || !IsValidArgumentPair(commandQuotes[argumentIndex]))
 						{
-							AddLine(ERROR, "Arguments expect a name value that has a '=' sign to it ");
+							AddLine(ERROR, "Arguments expect a name value pair with exactly one '=' sign in it ");
 							return;
 						}
-						args.SetValue(argPairs[0], argPairs[argumentIndex]);
+						args.SetValue(argPairs[0], argPairs[1]);
 					}
 				}
 				FireEvent(commandName, args);
@@ -119,7 +142,7 @@ void DevConsole::Execute(std::string const& consoleCommandText, bool echoCommand
 
 		if (echoCommand)
 		{
-			g_theConsole->AddLine(COMMAND_ECHO, commandLine);
+			g_theConsole->AddLine(COMMAND_ECHO, std::string(commandLine));
 		}
 	}
 }
@@ -190,9 +213,10 @@ bool DevConsole::Event_KeyPressed(EventArgs& args)
 		{
 			if (g_theConsole->m_inputText.size() > 0)
 			{
-				Strings text = SplitStringOnDelimiter(g_theConsole->m_inputText, ' ');
+				std::string_view firstWord;
+				StringTokenizer(g_theConsole->m_inputText, ' ', false).GetNextToken(firstWord);
 
-				if (text[0] == "ECHO")
+				if (firstWord == "ECHO")
 				{
 					g_theConsole->Execute(g_theConsole->m_inputText, true);
 					g_theConsole->m_commandHistory.push_back(g_theConsole->m_inputText);
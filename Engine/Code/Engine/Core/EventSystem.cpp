@@ -3,25 +3,92 @@
 #include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Core/Time.hpp"
 
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <cstring>
 
 extern DevConsole* g_theConsole;
 
 EventSystem* g_theEventSystem = nullptr;
 
+//------------------------------------------------------------------------------------------------
+// Handed to callbacks fired without arguments, so a bare FireEvent never constructs a map
+//------------------------------------------------------------------------------------------------
+thread_local EventArgs t_emptyEventArgs;
+
+static int s_benchmarkCallCount = 0;
+
+static bool Event_BenchmarkCallback(EventArgs& args)
+{
+	UNUSED(args);
+
+	s_benchmarkCallCount++;
+
+	return false;
+}
+
+static bool AreEventNamesEqual(std::string const& a, char const* b, size_t bLength)
+{
+	if (a.size() != bLength)
+		return false;
+
+	for (size_t index = 0; index < bLength; index++)
+	{
+		if (std::toupper((unsigned char)a[index]) != std::toupper((unsigned char)b[index]))
+			return false;
+	}
+
+	return true;
+}
+
 EventSystem::EventSystem(EventSystemConfig const& config)
 	: m_config(config)
 {
+	size_t capacity = 16;
+
+	while (capacity < (size_t)m_config.m_initialCapacity)
+	{
+		capacity *= 2;
+	}
+
+	m_slots.resize(capacity);
+	m_entries.reserve(capacity / 2);
+
+	size_t queueCapacity = 2;
+
+	while (queueCapacity < (size_t)m_config.m_queueCapacity)
+	{
+		queueCapacity *= 2;
+	}
+
+	m_queueCells = new QueuedEventCell[queueCapacity];
+	m_queueMask = queueCapacity - 1;
+
+	for (size_t index = 0; index < queueCapacity; index++)
+	{
+		m_queueCells[index].m_sequence.store(index, std::memory_order_relaxed);
+	}
+
+	m_drainArgs = new EventArgs();
 }
 
 EventSystem::~EventSystem()
 {
+	delete[] m_queueCells;
+	m_queueCells = nullptr;
+
+	DELETE_PTR(m_drainArgs);
 }
 
 void EventSystem::StartUp()
 {
+	SubscribeEventCallbackFunction("EventBenchmark", EventSystem::Command_EventBenchmark);
+	SubscribeEventCallbackFunction("EventQueueStats", EventSystem::Command_EventQueueStats);
 }
 
 void EventSystem::ShutDown()
@@ -30,119 +97,426 @@ void EventSystem::ShutDown()
 
 void EventSystem::BeginFrame()
 {
+	DrainQueuedEvents();
 }
 
 void EventSystem::EndFrame()
 {
 }
 
-void EventSystem::SubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr)
+void EventSystem::SubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr)
 {
-	for (size_t index = 0; index < m_subscriptionByEventName[eventName].size(); index++)
-	{
-		EventCallbackFunction& funcionCallback = m_subscriptionByEventName[eventName][index];
+	int entryIndex = FindOrAddEntryIndex(eventName);
 
-		if (funcionCallback == nullptr)
+	SubscriptionList& subscribers = m_entries[entryIndex].m_subscribers;
+
+	for (size_t index = 0; index < subscribers.size(); index++)
+	{
+		if (subscribers[index] == nullptr)
 		{
-			funcionCallback = functionPtr;
+			subscribers[index] = functionPtr;
 			return;
 		}
 	}
 
-	m_subscriptionByEventName[eventName].push_back(functionPtr);
+	subscribers.push_back(functionPtr);
 }
 
-void EventSystem::UnsubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr)
+void EventSystem::UnsubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr)
 {
-	for (size_t index = 0; index < m_subscriptionByEventName[eventName].size(); index++)
+	int entryIndex = FindEntryIndex(eventName.m_hash);
+
+	if (entryIndex < 0)
+		return;
+
+	SubscriptionList& subscribers = m_entries[entryIndex].m_subscribers;
+
+	for (size_t index = 0; index < subscribers.size(); index++)
 	{
-		if (m_subscriptionByEventName[eventName][index] == functionPtr)
+		if (subscribers[index] == functionPtr)
 		{
-			m_subscriptionByEventName[eventName][index] = nullptr;
+			subscribers[index] = nullptr;
 		}
 	}
 }
 
-bool EventSystem::FireEvent(std::string const& eventName, EventArgs& args)
+bool EventSystem::FireEvent(EventName const& eventName, EventArgs& args)
+{
+	return FireEventByHash(eventName.m_hash, args);
+}
+
+bool EventSystem::FireEvent(EventName const& eventName)
 {
-	std::string uppercaseEventName = eventName;
-	std::transform(uppercaseEventName.begin(), uppercaseEventName.end(), uppercaseEventName.begin(), [](unsigned char c) -> unsigned char { return (unsigned char)std::toupper(c); });
+	t_emptyEventArgs.Clear();
 
-	auto found = m_subscriptionByEventName.find(uppercaseEventName);
+	return FireEventByHash(eventName.m_hash, t_emptyEventArgs);
+}
 
-	if (found != m_subscriptionByEventName.end())
+//------------------------------------------------------------------------------------------------
+// Bounded multi-producer queue (Vyukov). A producer claims a cell by advancing the enqueue
+// position, then publishes it by bumping the cell's sequence; no locks are taken.
+//------------------------------------------------------------------------------------------------
+bool EventSystem::QueueEvent(EventName const& eventName, QueuedEventArgs const& args)
+{
+	size_t position = m_queueEnqueuePosition.load(std::memory_order_relaxed);
+	QueuedEventCell* cell = nullptr;
+
+	while (true)
 	{
-		for (size_t index = 0; index < m_subscriptionByEventName[uppercaseEventName].size(); index++)
-		{
-			EventCallbackFunction funcionCallback = found->second[index];
-			
-			bool callbackSuccess = funcionCallback(args);
+		cell = &m_queueCells[position & m_queueMask];
+
+		size_t sequence = cell->m_sequence.load(std::memory_order_acquire);
+		long long difference = (long long)sequence - (long long)position;
 
-			if(callbackSuccess)
+		if (difference == 0)
+		{
+			if (m_queueEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
 				break;
 		}
+		else if (difference < 0)
+		{
+			// Full: the consumer has not drained this cell since the last lap
+			m_numDropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			position = m_queueEnqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->m_event.m_hash = eventName.m_hash;
+	cell->m_event.m_args = args;
+	cell->m_sequence.store(position + 1, std::memory_order_release);
+
+	m_numQueued.fetch_add(1, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool EventSystem::QueueEvent(EventName const& eventName)
+{
+	QueuedEventArgs args;
+
+	return QueueEvent(eventName, args);
+}
 
-		return true;
+//------------------------------------------------------------------------------------------------
+// Fires at most one queue's worth, so events queued by the callbacks themselves wait a frame
+//------------------------------------------------------------------------------------------------
+void EventSystem::DrainQueuedEvents()
+{
+	size_t depth = m_queueEnqueuePosition.load(std::memory_order_relaxed) - m_queueDequeuePosition;
+
+	if (depth > m_peakQueueDepth)
+	{
+		m_peakQueueDepth = depth;
 	}
 
-	return false;
+	m_numDrainedLastFrame = 0;
+
+	QueuedEvent queuedEvent;
+
+	for (size_t count = 0; count <= m_queueMask && PopQueuedEvent(queuedEvent); count++)
+	{
+		m_drainArgs->Clear();
+		queuedEvent.m_args.UnpackTo(*m_drainArgs);
+
+		FireEventByHash(queuedEvent.m_hash, *m_drainArgs);
+
+		m_numDrainedLastFrame++;
+	}
+}
+
+EventQueueStats EventSystem::GetQueueStats() const
+{
+	EventQueueStats stats;
+	stats.m_numQueued = m_numQueued.load(std::memory_order_relaxed);
+	stats.m_numDropped = m_numDropped.load(std::memory_order_relaxed);
+	stats.m_numDrainedLastFrame = m_numDrainedLastFrame;
+	stats.m_peakDepth = m_peakQueueDepth;
+	stats.m_capacity = m_queueMask + 1;
+
+	return stats;
 }
 
-bool EventSystem::FireEvent(std::string const& eventName)
+bool EventSystem::PopQueuedEvent(QueuedEvent& out_event)
 {
-	std::string uppercaseEventName = eventName;
-	std::transform(uppercaseEventName.begin(), uppercaseEventName.end(), uppercaseEventName.begin(), [](unsigned char c) -> unsigned char { return (unsigned char)std::toupper(c); });
+	QueuedEventCell& cell = m_queueCells[m_queueDequeuePosition & m_queueMask];
+
+	// Empty, or a producer has claimed the cell but not published it yet
+	if (cell.m_sequence.load(std::memory_order_acquire) != m_queueDequeuePosition + 1)
+		return false;
+
+	out_event = cell.m_event;
+	cell.m_sequence.store(m_queueDequeuePosition + m_queueMask + 1, std::memory_order_release);
+	m_queueDequeuePosition++;
+
+	return true;
+}
 
-	auto found = m_subscriptionByEventName.find(uppercaseEventName);
+bool EventSystem::FireEventByHash(EventNameHash hash, EventArgs& args)
+{
+	int entryIndex = FindEntryIndex(hash);
 
-	EventArgs args;
+	if (entryIndex < 0)
+		return false;
 
-	if (found != m_subscriptionByEventName.end())
+	// Indexed every iteration, a callback may subscribe and grow m_entries
+	for (size_t index = 0; index < m_entries[entryIndex].m_subscribers.size(); index++)
 	{
-		for (size_t index = 0; index < m_subscriptionByEventName[uppercaseEventName].size(); index++)
-		{
-			EventCallbackFunction funcionCallback = found->second[index];
-			
-			bool callbackSuccess = funcionCallback(args);
+		EventCallbackFunction funcionCallback = m_entries[entryIndex].m_subscribers[index];
 
-			if (callbackSuccess)
-				break;
-		}
+		if (funcionCallback == nullptr)
+			continue;
+
+		bool callbackSuccess = funcionCallback(args);
 
-		return true;
+		if (callbackSuccess)
+			break;
 	}
 
-	return false;
+	return true;
 }
 
 Strings EventSystem::GetAllCommands() const
 {
 	Strings commands;
 
-	for (auto i : m_subscriptionByEventName)
+	for (size_t index = 0; index < m_entries.size(); index++)
 	{
-		commands.push_back(i.first);
+		SubscriptionList const& subscribers = m_entries[index].m_subscribers;
+
+		if (std::find_if(subscribers.begin(), subscribers.end(), [](EventCallbackFunction callback) { return callback != nullptr; }) != subscribers.end())
+		{
+			commands.push_back(m_entries[index].m_name);
+		}
 	}
 
+	std::sort(commands.begin(), commands.end());
+
 	return commands;
 }
 
-void SubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr)
+//------------------------------------------------------------------------------------------------
+// EventBenchmark count=1000000
+//------------------------------------------------------------------------------------------------
+bool EventSystem::Command_EventBenchmark(EventArgs& args)
+{
+	int count = args.GetValue("count", 1000000);
+
+	if (count <= 0 || g_theEventSystem == nullptr)
+		return false;
+
+	static constexpr EventName EVENT_BENCHMARK("EventBenchmarkTarget");
+
+	g_theEventSystem->SubscribeEventCallbackFunction(EVENT_BENCHMARK, Event_BenchmarkCallback);
+
+	std::string runtimeName = "eventbenchmarktarget";
+	EventArgs benchmarkArgs;
+
+	s_benchmarkCallCount = 0;
+
+	HeapAllocationStats heapBefore = GetHeapAllocationTotals();
+	double startSeconds = GetCurrentTimeSeconds();
+
+	for (int index = 0; index < count; index++)
+	{
+		g_theEventSystem->FireEvent(EVENT_BENCHMARK, benchmarkArgs);
+	}
+
+	double hashedSeconds = GetCurrentTimeSeconds() - startSeconds;
+	startSeconds = GetCurrentTimeSeconds();
+
+	for (int index = 0; index < count; index++)
+	{
+		g_theEventSystem->FireEvent(runtimeName, benchmarkArgs);
+	}
+
+	double stringSeconds = GetCurrentTimeSeconds() - startSeconds;
+	HeapAllocationStats heapAfter = GetHeapAllocationTotals();
+
+	g_theEventSystem->UnsubscribeEventCallbackFunction(EVENT_BENCHMARK, Event_BenchmarkCallback);
+
+	double hashedRate = hashedSeconds > 0.0 ? (double)count / hashedSeconds : 0.0;
+	double stringRate = stringSeconds > 0.0 ? (double)count / stringSeconds : 0.0;
+
+	if (g_theConsole)
+	{
+		g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("EventBenchmark: %d fires per path, %d callbacks", count, s_benchmarkCallCount));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Precomputed hash: %.2f ms, %.2f M fires/s", hashedSeconds * 1000.0, hashedRate / 1000000.0));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Runtime string:   %.2f ms, %.2f M fires/s", stringSeconds * 1000.0, stringRate / 1000000.0));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Heap allocations during dispatch: %llu", heapAfter.m_numAllocations - heapBefore.m_numAllocations));
+	}
+
+	return true;
+}
+
+bool EventSystem::Command_EventQueueStats(EventArgs& args)
+{
+	UNUSED(args);
+
+	if (g_theEventSystem == nullptr || g_theConsole == nullptr)
+		return false;
+
+	EventQueueStats stats = g_theEventSystem->GetQueueStats();
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Event queue: capacity %llu, peak depth %llu", stats.m_capacity, stats.m_peakDepth));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Queued %llu, drained last frame %llu", stats.m_numQueued, stats.m_numDrainedLastFrame));
+
+	if (stats.m_numDropped > 0)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, Stringf("  Dropped %llu events on a full queue", stats.m_numDropped));
+	}
+
+	return true;
+}
+
+int EventSystem::FindEntryIndex(EventNameHash hash) const
+{
+	size_t mask = m_slots.size() - 1;
+
+	for (size_t slotIndex = hash & mask; ; slotIndex = (slotIndex + 1) & mask)
+	{
+		EventSlot const& slot = m_slots[slotIndex];
+
+		if (slot.m_hash == hash)
+			return slot.m_entryIndex;
+
+		if (slot.m_hash == 0)
+			return -1;
+	}
+}
+
+int EventSystem::FindOrAddEntryIndex(EventName const& eventName)
+{
+	int entryIndex = FindEntryIndex(eventName.m_hash);
+
+	if (entryIndex >= 0)
+	{
+		GUARANTEE_OR_DIE(AreEventNamesEqual(m_entries[entryIndex].m_name, eventName.m_name, eventName.m_length), Stringf("EVENT NAME HASH COLLISION BETWEEN %s AND %s", m_entries[entryIndex].m_name.c_str(), std::string(eventName.m_name, eventName.m_length).c_str()));
+		return entryIndex;
+	}
+
+	// Keep the load factor at or below one half so probe chains stay short
+	if ((m_entries.size() + 1) * 2 > m_slots.size())
+	{
+		Rehash(m_slots.size() * 2);
+	}
+
+	EventEntry entry;
+	entry.m_hash = eventName.m_hash;
+	entry.m_name = std::string(eventName.m_name, eventName.m_length);
+
+	entryIndex = (int)m_entries.size();
+	m_entries.push_back(entry);
+
+	InsertSlot(eventName.m_hash, entryIndex);
+
+	return entryIndex;
+}
+
+void EventSystem::InsertSlot(EventNameHash hash, int entryIndex)
+{
+	size_t mask = m_slots.size() - 1;
+
+	for (size_t slotIndex = hash & mask; ; slotIndex = (slotIndex + 1) & mask)
+	{
+		if (m_slots[slotIndex].m_hash == 0)
+		{
+			m_slots[slotIndex].m_hash = hash;
+			m_slots[slotIndex].m_entryIndex = entryIndex;
+			return;
+		}
+	}
+}
+
+void EventSystem::Rehash(size_t newCapacity)
+{
+	m_slots.clear();
+	m_slots.resize(newCapacity);
+
+	for (size_t index = 0; index < m_entries.size(); index++)
+	{
+		InsertSlot(m_entries[index].m_hash, (int)index);
+	}
+}
+
+bool QueuedEventArgs::SetValue(char const* keyName, char const* value)
+{
+	size_t keyLength = strlen(keyName) + 1;
+	size_t valueLength = strlen(value) + 1;
+
+	if (m_size + keyLength + valueLength > QUEUED_EVENT_ARGS_BUFFER_SIZE)
+		return false;
+
+	memcpy(m_buffer + m_size, keyName, keyLength);
+	memcpy(m_buffer + m_size + keyLength, value, valueLength);
+
+	m_size = (unsigned char)(m_size + keyLength + valueLength);
+	m_numArgs++;
+
+	return true;
+}
+
+bool QueuedEventArgs::SetValue(char const* keyName, int value)
+{
+	char text[16];
+	snprintf(text, sizeof(text), "%d", value);
+
+	return SetValue(keyName, text);
+}
+
+bool QueuedEventArgs::SetValue(char const* keyName, float value)
+{
+	char text[32];
+	snprintf(text, sizeof(text), "%g", value);
+
+	return SetValue(keyName, text);
+}
+
+void QueuedEventArgs::UnpackTo(EventArgs& args) const
+{
+	char const* cursor = m_buffer;
+
+	for (int argIndex = 0; argIndex < m_numArgs; argIndex++)
+	{
+		char const* keyName = cursor;
+		cursor += strlen(cursor) + 1;
+
+		char const* value = cursor;
+		cursor += strlen(cursor) + 1;
+
+		args.SetValue(keyName, value);
+	}
+}
+
+void SubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr)
 {
 	g_theEventSystem->SubscribeEventCallbackFunction(eventName, functionPtr);
 }
 
-void UnsubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr)
+void UnsubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr)
 {
 	g_theEventSystem->UnsubscribeEventCallbackFunction(eventName, functionPtr);
 }
 
-bool FireEvent(std::string const& eventName, EventArgs& args)
+bool FireEvent(EventName const& eventName, EventArgs& args)
 {
 	return g_theEventSystem->FireEvent(eventName, args);
 }
 
-bool FireEvent(std::string const& eventName)
+bool FireEvent(EventName const& eventName)
 {
 	return g_theEventSystem->FireEvent(eventName);
 }
+
+bool QueueEvent(EventName const& eventName, QueuedEventArgs const& args)
+{
+	return g_theEventSystem->QueueEvent(eventName, args);
+}
+
+bool QueueEvent(EventName const& eventName)
+{
+	return g_theEventSystem->QueueEvent(eventName);
+}
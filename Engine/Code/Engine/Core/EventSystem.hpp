@@ -2,8 +2,8 @@
 
 #include "Engine/Core/StringUtils.hpp"
 
+#include <atomic>
 #include <vector>
-#include <map>
 #include <string>
 
 class NamedStrings;
@@ -11,23 +11,155 @@ class NamedStrings;
 typedef NamedStrings EventArgs;
 typedef bool(*EventCallbackFunction)(EventArgs&);
 
-struct EventSubscription
+typedef unsigned int EventNameHash;
+
+constexpr EventNameHash EVENT_NAME_HASH_OFFSET	= 2166136261u;
+constexpr EventNameHash EVENT_NAME_HASH_PRIME	= 16777619u;
+
+//------------------------------------------------------------------------------------------------
+// Case-insensitive FNV-1a. Zero marks an empty table slot, so it is never returned.
+//------------------------------------------------------------------------------------------------
+constexpr EventNameHash HashEventName(char const* name, size_t length)
 {
-	EventCallbackFunction m_functionPtr = nullptr;
+	EventNameHash hash = EVENT_NAME_HASH_OFFSET;
+
+	for (size_t index = 0; index < length; index++)
+	{
+		char c = name[index];
+
+		if (c >= 'a' && c <= 'z')
+		{
+			c = (char)(c - 'a' + 'A');
+		}
+
+		hash ^= (unsigned char)c;
+		hash *= EVENT_NAME_HASH_PRIME;
+	}
+
+	return hash != 0 ? hash : 1;
+}
+
+constexpr size_t GetEventNameLength(char const* name)
+{
+	size_t length = 0;
+
+	while (name[length] != '\0')
+	{
+		length++;
+	}
+
+	return length;
+}
+
+//------------------------------------------------------------------------------------------------
+// Literals hash at compile time when the EventName is constexpr, e.g.
+//     static constexpr EventName EVENT_KEYPRESSED("KEYPRESSED");
+// m_name is only valid for the duration of the call it is passed to.
+//------------------------------------------------------------------------------------------------
+struct EventName
+{
+	EventNameHash					m_hash					= 0;
+	char const*						m_name					= nullptr;
+	size_t							m_length				= 0;
+
+	constexpr						EventName(char const* name) : m_hash(HashEventName(name, GetEventNameLength(name))), m_name(name), m_length(GetEventNameLength(name)) {}
+									EventName(std::string const& name) : m_hash(HashEventName(name.c_str(), name.size())), m_name(name.c_str()), m_length(name.size()) {}
 };
 
 typedef std::vector<EventCallbackFunction> SubscriptionList;
 
-struct EventSystemConfig
+//------------------------------------------------------------------------------------------------
+struct EventEntry
+{
+	EventNameHash					m_hash					= 0;
+	std::string						m_name;
+	SubscriptionList				m_subscribers;
+};
+
+//------------------------------------------------------------------------------------------------
+// Open-addressing slot. Entries never move once added, so a callback may subscribe new events
+// (and grow the table) while its own event is being dispatched.
+//------------------------------------------------------------------------------------------------
+struct EventSlot
+{
+	EventNameHash					m_hash					= 0;
+	int								m_entryIndex			= -1;
+};
+
+constexpr int QUEUED_EVENT_ARGS_BUFFER_SIZE = 118;
+
+//------------------------------------------------------------------------------------------------
+// Fixed-size argument payload for queued events, packed as key\0value\0 pairs. SetValue returns
+// false and leaves the payload unchanged when the pair does not fit.
+//------------------------------------------------------------------------------------------------
+class QueuedEventArgs
 {
+public:
+	char							m_buffer[QUEUED_EVENT_ARGS_BUFFER_SIZE];
+	unsigned char					m_size					= 0;
+	unsigned char					m_numArgs				= 0;
+public:
+	bool							SetValue(char const* keyName, char const* value);
+	bool							SetValue(char const* keyName, int value);
+	bool							SetValue(char const* keyName, float value);
+
+	void							UnpackTo(EventArgs& args) const;
+};
 
+//------------------------------------------------------------------------------------------------
+struct QueuedEvent
+{
+	EventNameHash					m_hash					= 0;
+	QueuedEventArgs					m_args;
+};
+
+//------------------------------------------------------------------------------------------------
+// One ring cell of the bounded multi-producer queue. m_sequence tells producers and the consumer
+// whose turn the cell is.
+//------------------------------------------------------------------------------------------------
+struct QueuedEventCell
+{
+	std::atomic<size_t>				m_sequence				= 0;
+	QueuedEvent						m_event;
+};
+
+//------------------------------------------------------------------------------------------------
+struct EventQueueStats
+{
+	unsigned long long				m_numQueued				= 0;
+	unsigned long long				m_numDropped			= 0;
+	unsigned long long				m_numDrainedLastFrame	= 0;
+	unsigned long long				m_peakDepth				= 0;
+	unsigned long long				m_capacity				= 0;
 };
 
+struct EventSystemConfig
+{
+	int								m_initialCapacity		= 64;
+	int								m_queueCapacity			= 1024;
+};
+
+//------------------------------------------------------------------------------------------------
+// Subscribing and firing are main-thread only. Any thread may QueueEvent; queued events are
+// fired on the main thread in BeginFrame, in the order they were queued.
+//------------------------------------------------------------------------------------------------
 class EventSystem
 {
 protected:
-	EventSystemConfig m_config;
-	std::map<std::string, SubscriptionList> m_subscriptionByEventName;
+	EventSystemConfig				m_config;
+	std::vector<EventSlot>			m_slots;
+	std::vector<EventEntry>			m_entries;
+
+	QueuedEventCell*				m_queueCells			= nullptr;
+	size_t							m_queueMask				= 0;
+	alignas(64) std::atomic<size_t>	m_queueEnqueuePosition	= 0;
+	alignas(64) size_t				m_queueDequeuePosition	= 0;
+
+	std::atomic<unsigned long long>	m_numQueued				= 0;
+	std::atomic<unsigned long long>	m_numDropped			= 0;
+	unsigned long long				m_numDrainedLastFrame	= 0;
+	unsigned long long				m_peakQueueDepth		= 0;
+	EventArgs*						m_drainArgs				= nullptr;
 public:
 	EventSystem(EventSystemConfig const& config);
 	~EventSystem();
@@ -37,15 +169,33 @@ public:
 	void BeginFrame();
 	void EndFrame();
 
-	void SubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr);
-	void UnsubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr);
-	bool FireEvent(std::string const& eventName, EventArgs& args);
-	bool FireEvent(std::string const& eventName);
+	void SubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr);
+	void UnsubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr);
+	bool FireEvent(EventName const& eventName, EventArgs& args);
+	bool FireEvent(EventName const& eventName);
+
+	bool QueueEvent(EventName const& eventName, QueuedEventArgs const& args);
+	bool QueueEvent(EventName const& eventName);
+	void DrainQueuedEvents();
+	EventQueueStats GetQueueStats() const;
 
 	Strings GetAllCommands() const;
+
+	static bool Command_EventBenchmark(EventArgs& args);
+	static bool Command_EventQueueStats(EventArgs& args);
+protected:
+	bool	FireEventByHash(EventNameHash hash, EventArgs& args);
+	bool	PopQueuedEvent(QueuedEvent& out_event);
+
+	int		FindEntryIndex(EventNameHash hash) const;
+	int		FindOrAddEntryIndex(EventName const& eventName);
+	void	InsertSlot(EventNameHash hash, int entryIndex);
+	void	Rehash(size_t newCapacity);
 };
 
-void SubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr);
-void UnsubscribeEventCallbackFunction(std::string eventName, EventCallbackFunction functionPtr);
-bool FireEvent(std::string const& eventName, EventArgs& args);
-bool FireEvent(std::string const& eventName);
\ No newline at end of file
+void SubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr);
+void UnsubscribeEventCallbackFunction(EventName const& eventName, EventCallbackFunction functionPtr);
+bool FireEvent(EventName const& eventName, EventArgs& args);
+bool FireEvent(EventName const& eventName);
+bool QueueEvent(EventName const& eventName, QueuedEventArgs const& args);
+bool QueueEvent(EventName const& eventName);
@@ -2,8 +2,61 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 int FileReadToBuffer(std::vector<uint8_t>& outBuffer, std::string& fileName);
-int FileReadToString(std::string& outString, std::string& fileName);
+int FileReadToString(std::string& outString, std::string& fileName); // Size is the file's; c_str() supplies the terminator
 void WriteBufferToFile(std::vector<unsigned char>& inBuffer, std::string& fileName);
 bool CreateFolder(std::string const& folderPathName);
+
+//------------------------------------------------------------------------------------------------
+// Read-only view of a whole file. Open prefers mounted archives: raw entries point straight into
+// the archive mapping and compressed ones are decoded into memory the view owns. Loose files are
+// mapped and their OS handles released as soon as the view exists. The view stays valid until
+// Close or destruction; an empty file opens successfully with a null data pointer.
+//------------------------------------------------------------------------------------------------
+class MappedFile
+{
+	unsigned char const*			m_data					= nullptr;
+	size_t							m_size					= 0;
+	bool							m_isOpen				= false;
+	bool							m_ownsMapping			= false;
+	std::vector<unsigned char>		m_decodedData;
+public:
+									MappedFile() = default;
+									~MappedFile();
+									MappedFile(MappedFile const& copy) = delete;
+	MappedFile&						operator=(MappedFile const& copy) = delete;
+
+	bool							Open(std::string const& fileName);
+	bool							OpenLooseFile(std::string const& fileName);
+	void							Close();
+
+	bool							IsOpen() const;
+	unsigned char const*			GetData() const;
+	size_t							GetSize() const;
+	std::string_view				GetText() const;
+};
+
+//------------------------------------------------------------------------------------------------
+// FileReadToBuffer, FileReadToString, MappedFile::Open and FileReadAsync look in the mounted
+// archives first, newest mount first, then fall back to loose files. A loose file written after
+// the archive that holds it is read instead of the packed copy. Mount and unmount on the main
+// thread while no async reads are in flight.
+//------------------------------------------------------------------------------------------------
+bool FileMountArchive(std::string const& archivePath);
+void FileUnmountArchives();
+bool FileExists(std::string const& fileName);
+
+//------------------------------------------------------------------------------------------------
+// Async reads run on g_theJobSystem when it exists and are read synchronously otherwise. Either
+// way the callback fires on the main thread from FileUtilsBeginFrame or FileWaitForAsyncReads,
+// and may move out of the buffer.
+//------------------------------------------------------------------------------------------------
+typedef void(*FileReadCallback)(std::string const& fileName, std::vector<uint8_t>& buffer, bool succeeded, void* userData);
+
+bool FileReadAsync(std::string const& fileName, FileReadCallback callback, void* userData = nullptr);
+int  FileGetNumPendingReads();
+void FileWaitForAsyncReads();
+void FileUtilsBeginFrame();
+void FileUtilsShutdown();
@@ -1,60 +1,162 @@
 #include "Engine/Core/FileUtils.hpp"
 
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
 
+#include <filesystem>
+#include <stdio.h>
+
+#if defined(_WIN32)
 #include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
-int FileReadToBuffer(std::vector<uint8_t>& outBuffer, std::string& fileName)
+//------------------------------------------------------------------------------------------------
+struct MountedArchive
+{
+	AssetArchive*						m_archive			= nullptr;
+	std::filesystem::file_time_type		m_writeTime;
+};
+
+static std::vector<MountedArchive> s_mountedArchives;
+
+//------------------------------------------------------------------------------------------------
+// A loose file edited after the archive was packed wins over its packed copy, so iterating on
+// Data/ never needs a repack. Costs one stat per lookup that hits an archive.
+//------------------------------------------------------------------------------------------------
+static AssetArchiveEntry const* FindArchivedFile(std::string const& fileName, AssetArchive const*& outArchive)
+{
+	for (auto archiveIter = s_mountedArchives.rbegin(); archiveIter != s_mountedArchives.rend(); archiveIter++)
+	{
+		AssetArchiveEntry const* entry = archiveIter->m_archive->FindEntry(fileName);
+
+		if (entry)
+		{
+			std::error_code errorCode;
+			std::filesystem::file_time_type looseWriteTime = std::filesystem::last_write_time(fileName, errorCode);
+
+			if (!errorCode && looseWriteTime > archiveIter->m_writeTime)
+			{
+				return nullptr;
+			}
+
+			outArchive = archiveIter->m_archive;
+			return entry;
+		}
+	}
+
+	return nullptr;
+}
+
+//------------------------------------------------------------------------------------------------
+static FILE* OpenFile(char const* fileName, char const* mode)
 {
 	FILE* fileptr = nullptr;
 
-	fopen_s(&fileptr, fileName.c_str(), "rb");
+#if defined(_WIN32)
+	fopen_s(&fileptr, fileName, mode);
+#else
+	fileptr = fopen(fileName, mode);
+#endif
 
-	if (fileptr)
+	return fileptr;
+}
+
+//------------------------------------------------------------------------------------------------
+static bool GetOpenFileSize(FILE* fileptr, size_t& outSize)
+{
+	if (fseek(fileptr, 0, SEEK_END) != 0)
 	{
-		fseek(fileptr, 0, SEEK_END);
+		return false;
+	}
 
-		size_t fileSize = (size_t)ftell(fileptr);
+#if defined(_WIN32)
+	long long fileSize = _ftelli64(fileptr);
+#else
+	long long fileSize = (long long)ftello(fileptr);
+#endif
 
-		outBuffer.resize(fileSize);
+	if (fileSize < 0 || fseek(fileptr, 0, SEEK_SET) != 0)
+	{
+		return false;
+	}
 
-		fseek(fileptr, 0, SEEK_SET);
+	outSize = (size_t)fileSize;
 
-		fread(outBuffer.data(), fileSize, 1, fileptr);
+	return true;
+}
 
-		fclose(fileptr);
+//------------------------------------------------------------------------------------------------
+template<typename T_Container>
+static int FileReadToContainer(T_Container& outContainer, std::string const& fileName)
+{
+	AssetArchive const* archive = nullptr;
+	AssetArchiveEntry const* entry = FindArchivedFile(fileName, archive);
+
+	if (entry)
+	{
+		outContainer.resize((size_t)entry->m_originalSize);
+
+		if (entry->m_originalSize > 0 && !archive->ReadEntry(*entry, (unsigned char*)&outContainer[0]))
+		{
+			outContainer.clear();
+			return 1;
+		}
 
 		return 0;
 	}
-	else
+
+	FILE* fileptr = OpenFile(fileName.c_str(), "rb");
+
+	if (fileptr == nullptr)
 	{
 		return 1;
 	}
-}
 
-int FileReadToString(std::string& outString, std::string& fileName)
-{
-	std::vector<uint8_t> outBuffer;
+	size_t fileSize = 0;
 
-	int result = FileReadToBuffer(outBuffer, fileName);
+	if (!GetOpenFileSize(fileptr, fileSize))
+	{
+		fclose(fileptr);
+		return 1;
+	}
 
-	outBuffer.push_back('\0');
+	outContainer.resize(fileSize);
 
-	for (size_t index = 0; index < outBuffer.size(); index++)
+	size_t bytesRead = fileSize > 0 ? fread(&outContainer[0], 1, fileSize, fileptr) : 0;
+
+	fclose(fileptr);
+
+	if (bytesRead != fileSize)
 	{
-		outString.push_back(outBuffer[index]);
+		outContainer.resize(bytesRead);
+		return 1;
 	}
 
-	return result;
+	return 0;
 }
 
-void WriteBufferToFile(std::vector<unsigned char>& outBuffer, std::string& fileName)
+int FileReadToBuffer(std::vector<uint8_t>& outBuffer, std::string& fileName)
 {
-	FILE* fileptr = nullptr;
+	return FileReadToContainer(outBuffer, fileName);
+}
 
-	int error = fopen_s(&fileptr, fileName.c_str(), "wb");
+int FileReadToString(std::string& outString, std::string& fileName)
+{
+	return FileReadToContainer(outString, fileName);
+}
 
-	if (error == 0)
+void WriteBufferToFile(std::vector<unsigned char>& outBuffer, std::string& fileName)
+{
+	FILE* fileptr = OpenFile(fileName.c_str(), "wb");
+
+	if (fileptr)
 	{
 		fwrite(outBuffer.data(), sizeof(unsigned char), outBuffer.size(), fileptr);
 		fclose(fileptr);
@@ -63,5 +165,361 @@ void WriteBufferToFile(std::vector<unsigned char>& outBuffer, std::string& fileN
 
 bool CreateFolder(std::string const& folderPathName)
 {
+#if defined(_WIN32)
 	return CreateDirectoryA(folderPathName.c_str(), nullptr);
+#else
+	return mkdir(folderPathName.c_str(), 0755) == 0;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(std::string const& fileName)
+{
+	Close();
+
+	AssetArchive const* archive = nullptr;
+	AssetArchiveEntry const* entry = FindArchivedFile(fileName, archive);
+
+	if (entry == nullptr)
+	{
+		return OpenLooseFile(fileName);
+	}
+
+	if (entry->m_compression == AssetCompression::NONE)
+	{
+		m_data = archive->GetStoredData(*entry);
+	}
+	else
+	{
+		m_decodedData.resize((size_t)entry->m_originalSize);
+
+		if (!archive->ReadEntry(*entry, m_decodedData.data()))
+		{
+			m_decodedData.clear();
+			return false;
+		}
+
+		m_data = m_decodedData.data();
+	}
+
+	m_size = (size_t)entry->m_originalSize;
+	m_isOpen = true;
+
+	return true;
+}
+
+bool MappedFile::OpenLooseFile(std::string const& fileName)
+{
+	Close();
+
+#if defined(_WIN32)
+	HANDLE fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize = {};
+
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	if (fileSize.QuadPart > 0)
+	{
+		HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (mappingHandle == nullptr)
+		{
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		m_data = (unsigned char const*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+		CloseHandle(mappingHandle);
+
+		if (m_data == nullptr)
+		{
+			CloseHandle(fileHandle);
+			return false;
+		}
+	}
+
+	CloseHandle(fileHandle);
+
+	m_size = (size_t)fileSize.QuadPart;
+#else
+	int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat = {};
+
+	if (fstat(fileDescriptor, &fileStat) != 0)
+	{
+		close(fileDescriptor);
+		return false;
+	}
+
+	if (fileStat.st_size > 0)
+	{
+		void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+		if (view == MAP_FAILED)
+		{
+			close(fileDescriptor);
+			return false;
+		}
+
+		madvise(view, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+		m_data = (unsigned char const*)view;
+	}
+
+	close(fileDescriptor);
+
+	m_size = (size_t)fileStat.st_size;
+#endif
+
+	m_isOpen = true;
+	m_ownsMapping = m_data != nullptr;
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_ownsMapping)
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(m_data);
+#else
+		munmap((void*)m_data, m_size);
+#endif
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+	m_ownsMapping = false;
+	m_decodedData.clear();
+	m_decodedData.shrink_to_fit();
+}
+
+bool MappedFile::IsOpen() const
+{
+	return m_isOpen;
+}
+
+unsigned char const* MappedFile::GetData() const
+{
+	return m_data;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_size;
+}
+
+std::string_view MappedFile::GetText() const
+{
+	return std::string_view((char const*)m_data, m_size);
+}
+
+//------------------------------------------------------------------------------------------------
+bool FileMountArchive(std::string const& archivePath)
+{
+	AssetArchive* archive = new AssetArchive();
+
+	if (!archive->Open(archivePath))
+	{
+		delete archive;
+		return false;
+	}
+
+	MountedArchive mount;
+	mount.m_archive = archive;
+
+	std::error_code errorCode;
+	mount.m_writeTime = std::filesystem::last_write_time(archivePath, errorCode);
+
+	s_mountedArchives.push_back(mount);
+
+	return true;
+}
+
+void FileUnmountArchives()
+{
+	for (MountedArchive& mount : s_mountedArchives)
+	{
+		delete mount.m_archive;
+	}
+
+	s_mountedArchives.clear();
+}
+
+bool FileExists(std::string const& fileName)
+{
+	AssetArchive const* archive = nullptr;
+
+	if (FindArchivedFile(fileName, archive))
+	{
+		return true;
+	}
+
+	std::error_code errorCode;
+	return std::filesystem::is_regular_file(fileName, errorCode);
+}
+
+//------------------------------------------------------------------------------------------------
+class FileReadJob : public Job
+{
+public:
+	std::string						m_fileName;
+	std::vector<uint8_t>			m_buffer;
+	FileReadCallback				m_callback				= nullptr;
+	void*							m_userData				= nullptr;
+	bool							m_succeeded				= false;
+	bool							m_isOnJobSystem			= false;
+public:
+	FileReadJob(std::string const& fileName, FileReadCallback callback, void* userData);
+
+	virtual void Execute() override;
+};
+
+FileReadJob::FileReadJob(std::string const& fileName, FileReadCallback callback, void* userData)
+	: m_fileName(fileName)
+	, m_callback(callback)
+	, m_userData(userData)
+{
+}
+
+void FileReadJob::Execute()
+{
+	m_succeeded = FileReadToContainer(m_buffer, m_fileName) == 0;
+}
+
+//------------------------------------------------------------------------------------------------
+// Main thread only; workers touch nothing but the job they were handed.
+//------------------------------------------------------------------------------------------------
+static std::vector<FileReadJob*> s_pendingReads;
+
+bool FileReadAsync(std::string const& fileName, FileReadCallback callback, void* userData)
+{
+	GUARANTEE_OR_DIE(callback != nullptr, "FileReadAsync requires a completion callback");
+
+	FileReadJob* job = new FileReadJob(fileName, callback, userData);
+
+	s_pendingReads.push_back(job);
+
+	if (g_theJobSystem)
+	{
+		job->m_isOnJobSystem = true;
+		g_theJobSystem->AddJob(job);
+	}
+	else
+	{
+		job->Execute();
+		job->m_status = JobStatus::COMPLETED;
+	}
+
+	return true;
+}
+
+int FileGetNumPendingReads()
+{
+	return (int)s_pendingReads.size();
+}
+
+static bool RetrieveFinishedRead(FileReadJob* job)
+{
+	if (job->m_status != JobStatus::COMPLETED)
+	{
+		return false;
+	}
+
+	if (job->m_isOnJobSystem)
+	{
+		return g_theJobSystem->RetrieveJob(job);
+	}
+
+	job->m_status = JobStatus::RETIEVED;
+
+	return true;
+}
+
+void FileUtilsBeginFrame()
+{
+	if (s_pendingReads.empty())
+	{
+		return;
+	}
+
+	// Callbacks may start new reads, so finished jobs leave the pending list before any of them run.
+	std::vector<FileReadJob*> finishedReads;
+
+	for (size_t index = 0; index < s_pendingReads.size();)
+	{
+		FileReadJob* job = s_pendingReads[index];
+
+		if (RetrieveFinishedRead(job))
+		{
+			finishedReads.push_back(job);
+			s_pendingReads.erase(s_pendingReads.begin() + index);
+		}
+		else
+		{
+			index++;
+		}
+	}
+
+	for (FileReadJob* job : finishedReads)
+	{
+		job->m_callback(job->m_fileName, job->m_buffer, job->m_succeeded, job->m_userData);
+		delete job;
+	}
+}
+
+void FileWaitForAsyncReads()
+{
+	while (!s_pendingReads.empty())
+	{
+		FileUtilsBeginFrame();
+
+		if (!s_pendingReads.empty())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void FileUtilsShutdown()
+{
+	// Owners of the callbacks may already be gone, so outstanding reads finish without dispatch.
+	while (!s_pendingReads.empty())
+	{
+		FileReadJob* job = s_pendingReads.back();
+
+		if (RetrieveFinishedRead(job))
+		{
+			s_pendingReads.pop_back();
+			delete job;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
 }
@@ -4,42 +4,91 @@
 #include "ThirdParty/stb_image/stb_image.h"
 
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/FileUtils.hpp"
+
+#include <string.h>
+
+// MSVC exposes SSSE3 intrinsics without an /arch switch, so the CPU is checked before use;
+// elsewhere the switch itself has to be enabled.
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__SSSE3__)
+#define IMAGE_EXPAND_SSSE3
+#include <tmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+static_assert(sizeof(Rgba8) == 4, "Image texels are uploaded as tightly packed RGBA8");
 
 Image::Image(char const* imageFilePath)
 	: m_imageFilePath(imageFilePath)
 {
-	int bytesPerTexel = 0;
-	int numComponentsRequested = 0;
+	MappedFile imageFile;
+	imageFile.Open(m_imageFilePath);
 
-	stbi_set_flip_vertically_on_load(1);
-	unsigned char* texelData = stbi_load(m_imageFilePath.c_str(), &m_dimensions.x, &m_dimensions.y, &bytesPerTexel, numComponentsRequested);
+	DecodeFromMemory(imageFile.GetData(), imageFile.GetSize());
+}
+
+Image::Image(IntVec2 size, Rgba8 color)
+	: m_dimensions(size)
+{
+	m_rgbaTexels.assign((size_t)m_dimensions.x * (size_t)m_dimensions.y, color);
+}
 
-	int totaltexels = m_dimensions.x * m_dimensions.y;
+Image::Image(Image&& moved) noexcept
+	: m_imageFilePath(std::move(moved.m_imageFilePath))
+	, m_dimensions(moved.m_dimensions)
+	, m_rgbaTexels(std::move(moved.m_rgbaTexels))
+{
+	moved.m_dimensions = IntVec2(0, 0);
+}
 
-	for (int index = 0; index < totaltexels * bytesPerTexel; index += bytesPerTexel)
+Image& Image::operator=(Image&& moved) noexcept
+{
+	if (this != &moved)
 	{
-		if (bytesPerTexel == 3)
-		{
-			m_rgbaTexels.push_back(Rgba8(texelData[index], texelData[index + 1], texelData[index + 2], 255));
-		}
-		else if (bytesPerTexel == 4)
-		{
-			m_rgbaTexels.push_back(Rgba8(texelData[index], texelData[index + 1], texelData[index + 2], texelData[index + 3]));
-		}
+		m_imageFilePath = std::move(moved.m_imageFilePath);
+		m_dimensions = moved.m_dimensions;
+		m_rgbaTexels = std::move(moved.m_rgbaTexels);
+		moved.m_dimensions = IntVec2(0, 0);
 	}
+
+	return *this;
 }
 
-Image::Image(IntVec2 size, Rgba8 color)
-	: m_dimensions(size)
+//------------------------------------------------------------------------------------------------
+// stb decodes at the file's native channel count and the single copy into m_rgbaTexels does the
+// widening, instead of asking stb for 4 channels and copying its widened buffer again.
+//------------------------------------------------------------------------------------------------
+bool Image::DecodeFromMemory(unsigned char const* encodedData, size_t encodedSize)
 {
-	//int bytesPerTexel = 4;
+	m_dimensions = IntVec2(0, 0);
+	m_rgbaTexels.clear();
 
-	int totaltexels = m_dimensions.x * m_dimensions.y;
+	if (encodedData == nullptr || encodedSize == 0)
+	{
+		return false;
+	}
+
+	int bytesPerTexel = 0;
 
-	for (int index = 0; index < totaltexels; index ++)
+	stbi_set_flip_vertically_on_load(1);
+	unsigned char* texelData = stbi_load_from_memory(encodedData, (int)encodedSize, &m_dimensions.x, &m_dimensions.y, &bytesPerTexel, 0);
+
+	if (texelData == nullptr)
 	{
-		m_rgbaTexels.push_back(color);
+		m_dimensions = IntVec2(0, 0);
+		return false;
 	}
+
+	int numTexels = m_dimensions.x * m_dimensions.y;
+
+	m_rgbaTexels.resize((size_t)numTexels);
+	ExpandTexelsToRgba8(texelData, numTexels, bytesPerTexel, m_rgbaTexels.data());
+
+	stbi_image_free(texelData);
+
+	return true;
 }
 
 std::string const& Image::GetImageFilePath() const
@@ -81,3 +130,69 @@ void Image::SetTexelColor(IntVec2 const& texelCoords, Rgba8 const& newColor)
 
 	m_rgbaTexels[texelIndex] = newColor;
 }
+
+#if defined(IMAGE_EXPAND_SSSE3)
+//------------------------------------------------------------------------------------------------
+static bool IsSSSE3Supported()
+{
+#if defined(_MSC_VER)
+	int cpuInfo[4] = {};
+	__cpuid(cpuInfo, 1);
+
+	return (cpuInfo[2] & (1 << 9)) != 0;
+#else
+	return __builtin_cpu_supports("ssse3");
+#endif
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+// Widens 1 (grey), 2 (grey + alpha), 3 (RGB) or 4 (RGBA) channel texels to RGBA8.
+//------------------------------------------------------------------------------------------------
+void ExpandTexelsToRgba8(unsigned char const* sourceTexels, int numTexels, int bytesPerTexel, Rgba8* outTexels)
+{
+	if (bytesPerTexel == 4)
+	{
+		memcpy(outTexels, sourceTexels, (size_t)numTexels * 4);
+		return;
+	}
+
+	int index = 0;
+
+	if (bytesPerTexel == 3)
+	{
+#if defined(IMAGE_EXPAND_SSSE3)
+		static bool const s_isSSSE3Supported = IsSSSE3Supported();
+
+		if (s_isSSSE3Supported)
+		{
+			// Four texels per step; each 16-byte load reads 4 bytes past the texels it uses, so stop
+			// while a full load still fits inside the source.
+			__m128i const shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			__m128i const alpha = _mm_set1_epi32((int)0xFF000000);
+
+			for (; (index + 4) * 3 + 4 <= numTexels * 3; index += 4)
+			{
+				__m128i rgb = _mm_loadu_si128((__m128i const*)(sourceTexels + index * 3));
+				__m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha);
+				_mm_storeu_si128((__m128i*)(outTexels + index), rgba);
+			}
+		}
+#endif
+
+		for (; index < numTexels; index++)
+		{
+			unsigned char const* texel = sourceTexels + index * 3;
+			outTexels[index] = Rgba8(texel[0], texel[1], texel[2], 255);
+		}
+
+		return;
+	}
+
+	for (; index < numTexels; index++)
+	{
+		unsigned char const* texel = sourceTexels + index * bytesPerTexel;
+		unsigned char alphaByte = bytesPerTexel == 2 ? texel[1] : 255;
+		outTexels[index] = Rgba8(texel[0], texel[0], texel[0], alphaByte);
+	}
+}
@@ -10,11 +10,20 @@ class Image
 	IntVec2						m_dimensions = IntVec2(0, 0);
 public:
 	std::vector< Rgba8 >		m_rgbaTexels;
+								Image() = default;
 								Image(char const* imageFilePath);
 								Image(IntVec2 size, Rgba8 color);
+								Image(Image const& copy) = default;
+								Image(Image&& moved) noexcept;
+	Image&						operator=(Image const& copy) = default;
+	Image&						operator=(Image&& moved) noexcept;
+
+	bool						DecodeFromMemory(unsigned char const* encodedData, size_t encodedSize);
 	std::string const&			GetImageFilePath() const;
 	IntVec2						GetDimensions() const;
 	void const*					GetRawData() const;
 	Rgba8						GetTexelColor(IntVec2 const& texelCoords) const;
 	void						SetTexelColor(IntVec2 const& texelCoords, Rgba8 const& newColor);
-};
\ No newline at end of file
+};
+
+void ExpandTexelsToRgba8(unsigned char const* sourceTexels, int numTexels, int bytesPerTexel, Rgba8* outTexels);
@@ -1,6 +1,13 @@
 #include "JobSystem.hpp"
 
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/LinearAllocator.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <algorithm>
+
+JobSystem* g_theJobSystem = nullptr;
 
 JobWorkerThread::JobWorkerThread(JobSystem* owner, unsigned int id)
 {
@@ -12,22 +19,33 @@ JobWorkerThread::JobWorkerThread(JobSystem* owner, unsigned int id)
 
 JobWorkerThread::~JobWorkerThread()
 {
+	if (m_workerThread)
+	{
+		m_workerThread->join();
+		DELETE_PTR(m_workerThread);
+	}
 }
 
 void JobWorkerThread::ThreadMain()
 {
+	PROFILE_SET_THREAD_NAME(Stringf("JobWorker %u", m_ID).c_str());
+
 	while (!m_owner->m_isQuitting)
 	{
 		Job* claimedJob = m_owner->WorkerClaimAQueuedJob(this);
 
 		if (claimedJob)
 		{
-			claimedJob->Execute();
+			{
+				PROFILE_SCOPE("Job::Execute");
+				ScopedFrameAllocatorMarker frameAllocatorMarker;
+				claimedJob->Execute();
+			}
 			m_owner->WorkerCompleteAJob(this, claimedJob);
 		}
 		else
 		{
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
+			m_owner->WorkerWaitForQueuedJob(this);
 		}
 	}
 }
@@ -46,7 +64,10 @@ JobSystem::JobSystem(JobSystemConfig const& config)
 
 JobSystem::~JobSystem()
 {
-	for (int workerIndex = 0; m_config.m_numOfWorkerThreads; workerIndex++)
+	m_isQuitting = true;
+	WakeAllWorkers();
+
+	for (int workerIndex = 0; workerIndex < (int)m_workerThreads.size(); workerIndex++)
 	{
 		DELETE_PTR(m_workerThreads[workerIndex]);
 	}
@@ -61,6 +82,7 @@ void JobSystem::StartUp()
 void JobSystem::ShutDown()
 {
 	m_isQuitting = true;
+	WakeAllWorkers();
 }
 
 void JobSystem::AddJob(Job* jobToAdd)
@@ -69,6 +91,8 @@ void JobSystem::AddJob(Job* jobToAdd)
 	m_queuedJobsMutex.lock();
 	m_queuedJobs.push_back(jobToAdd);
 	m_queuedJobsMutex.unlock();
+
+	m_jobQueuedCondition.notify_one();
 }
 
 size_t JobSystem::GetNumOfQueuedJobs()
@@ -98,6 +122,29 @@ Job* JobSystem::WorkerClaimAQueuedJob(JobWorkerThread* workerThread)
 	return nullptr;
 }
 
+//------------------------------------------------------------------------------------------------
+// Idle workers sleep here until AddJob queues work or the system quits, instead of polling
+//------------------------------------------------------------------------------------------------
+void JobSystem::WorkerWaitForQueuedJob(JobWorkerThread* workerThread)
+{
+	UNUSED(workerThread);
+
+	std::unique_lock<std::mutex> lock(m_queuedJobsMutex);
+
+	m_jobQueuedCondition.wait(lock, [this]() { return !m_queuedJobs.empty() || m_isQuitting; });
+}
+
+//------------------------------------------------------------------------------------------------
+// Taking the queue lock orders the quit flag before any worker's next check, so none misses it
+//------------------------------------------------------------------------------------------------
+void JobSystem::WakeAllWorkers()
+{
+	m_queuedJobsMutex.lock();
+	m_queuedJobsMutex.unlock();
+
+	m_jobQueuedCondition.notify_all();
+}
+
 void JobSystem::WorkerCompleteAJob(JobWorkerThread* workerThread, Job* job)
 {
 	UNUSED(workerThread);
@@ -115,6 +162,8 @@ void JobSystem::WorkerCompleteAJob(JobWorkerThread* workerThread, Job* job)
 			m_completedJobsMutex.unlock();
 			m_claimedJobsMutex.unlock();
 
+			m_jobCompletedCondition.notify_all();
+
 			return;
 		}
 	}
@@ -157,6 +206,39 @@ Job* JobSystem::RetrieveJob()
 	return job;
 }
 
+//------------------------------------------------------------------------------------------------
+// Blocks until the job has run, then retrieves it. A job no worker has claimed yet runs on the
+// caller instead, so the waiting thread does useful work and a system with no workers still
+// finishes. The job must not be retrieved anywhere else.
+//------------------------------------------------------------------------------------------------
+void JobSystem::WaitForJob(Job* jobToWaitFor)
+{
+	m_queuedJobsMutex.lock();
+
+	auto queuedIter = std::find(m_queuedJobs.begin(), m_queuedJobs.end(), jobToWaitFor);
+
+	if (queuedIter != m_queuedJobs.end())
+	{
+		m_queuedJobs.erase(queuedIter);
+		m_queuedJobsMutex.unlock();
+
+		jobToWaitFor->m_status = JobStatus::EXECUTING;
+		jobToWaitFor->Execute();
+		jobToWaitFor->m_status = JobStatus::RETIEVED;
+
+		return;
+	}
+
+	m_queuedJobsMutex.unlock();
+
+	std::unique_lock<std::mutex> lock(m_completedJobsMutex);
+
+	m_jobCompletedCondition.wait(lock, [jobToWaitFor]() { return jobToWaitFor->m_status == JobStatus::COMPLETED; });
+
+	m_completedJobs.erase(std::find(m_completedJobs.begin(), m_completedJobs.end(), jobToWaitFor));
+	jobToWaitFor->m_status = JobStatus::RETIEVED;
+}
+
 void JobSystem::BeginFrame()
 {
 }
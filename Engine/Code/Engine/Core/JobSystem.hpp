@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <thread>
@@ -31,7 +33,7 @@ class JobWorkerThread
 {
 	unsigned int m_ID = 0;
 	JobSystem* m_owner = nullptr;
-	std::thread* m_workerThread;
+	std::thread* m_workerThread = nullptr;
 public:
 	JobWorkerThread(JobSystem* owner, unsigned int id);
 	~JobWorkerThread();
@@ -53,6 +55,8 @@ class JobSystem
 	std::mutex m_queuedJobsMutex;
 	std::mutex m_claimedJobsMutex;
 	std::mutex m_completedJobsMutex;
+	std::condition_variable m_jobQueuedCondition;
+	std::condition_variable m_jobCompletedCondition;
 
 	std::vector<JobWorkerThread*> m_workerThreads;
 
@@ -75,9 +79,15 @@ public:
 	size_t GetNumOfQueuedJobs();
 
 	Job* WorkerClaimAQueuedJob(JobWorkerThread* workerThread);
+	void WorkerWaitForQueuedJob(JobWorkerThread* workerThread);
 	void WorkerCompleteAJob(JobWorkerThread* workerThread, Job* job);
 	bool RetrieveJob(Job* jobToRetrieve);
 	Job* RetrieveJob();
+	void WaitForJob(Job* jobToWaitFor);
 private:
+	void WakeAllWorkers();
+
 	friend class JobWorkerThread;
-};
\ No newline at end of file
+};
+
+extern JobSystem* g_theJobSystem;
\ No newline at end of file
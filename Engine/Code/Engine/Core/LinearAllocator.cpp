@@ -0,0 +1,167 @@
+#include "Engine/Core/LinearAllocator.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <cstdlib>
+
+//------------------------------------------------------------------------------------------------
+// One per thread, created on first use. App resets the main thread's copy every frame.
+//------------------------------------------------------------------------------------------------
+thread_local LinearAllocator t_frameAllocator;
+
+LinearAllocator::LinearAllocator(size_t blockSize)
+	: m_blockSize(blockSize)
+{
+}
+
+LinearAllocator::~LinearAllocator()
+{
+	for (size_t index = 0; index < m_blocks.size(); index++)
+	{
+		free(m_blocks[index].m_data);
+	}
+
+	m_blocks.clear();
+}
+
+void* LinearAllocator::Allocate(size_t size, size_t alignment)
+{
+	GUARANTEE_OR_DIE(alignment != 0 && (alignment & (alignment - 1)) == 0, "LINEAR ALLOCATOR ALIGNMENT MUST BE A POWER OF TWO");
+
+	if (size == 0)
+	{
+		size = 1;
+	}
+
+	while (true)
+	{
+		if (m_currentBlock < m_blocks.size())
+		{
+			Block& block = m_blocks[m_currentBlock];
+
+			size_t address = reinterpret_cast<size_t>(block.m_data) + m_currentOffset;
+			size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+			if (m_currentOffset + padding + size <= block.m_size)
+			{
+				void* result = block.m_data + m_currentOffset + padding;
+				m_currentOffset += padding + size;
+
+				m_stats.m_numAllocations++;
+				m_stats.m_bytesAllocated += size;
+
+				size_t bytesInUse = GetBytesInUse();
+
+				if (bytesInUse > m_stats.m_peakBytesAllocated)
+				{
+					m_stats.m_peakBytesAllocated = bytesInUse;
+				}
+
+				return result;
+			}
+
+			// Blocks past the current one survive a reset, so try them before growing
+			if (m_currentBlock + 1 < m_blocks.size() && m_blocks[m_currentBlock + 1].m_size >= size + alignment)
+			{
+				m_currentBlock++;
+				m_currentOffset = 0;
+				continue;
+			}
+		}
+
+		AddBlock(size + alignment);
+	}
+}
+
+void LinearAllocator::Reset()
+{
+	m_lastResetStats = m_stats;
+	m_lastResetStats.m_bytesReserved = 0;
+
+	for (size_t index = 0; index < m_blocks.size(); index++)
+	{
+		m_lastResetStats.m_bytesReserved += m_blocks[index].m_size;
+	}
+
+	m_lastResetStats.m_numBlocks = m_blocks.size();
+
+	m_currentBlock = 0;
+	m_currentOffset = 0;
+
+	m_stats = LinearAllocatorStats();
+}
+
+LinearAllocatorMarker LinearAllocator::GetMarker() const
+{
+	LinearAllocatorMarker marker;
+	marker.m_blockIndex = m_currentBlock;
+	marker.m_offset = m_currentOffset;
+
+	return marker;
+}
+
+void LinearAllocator::RewindToMarker(LinearAllocatorMarker const& marker)
+{
+	GUARANTEE_OR_DIE(marker.m_blockIndex < m_currentBlock || (marker.m_blockIndex == m_currentBlock && marker.m_offset <= m_currentOffset), "LINEAR ALLOCATOR REWOUND PAST ITS CURRENT POSITION");
+
+	m_currentBlock = marker.m_blockIndex;
+	m_currentOffset = marker.m_offset;
+}
+
+size_t LinearAllocator::GetBytesInUse() const
+{
+	size_t bytesInUse = m_currentOffset;
+
+	for (size_t index = 0; index < m_currentBlock && index < m_blocks.size(); index++)
+	{
+		bytesInUse += m_blocks[index].m_size;
+	}
+
+	return bytesInUse;
+}
+
+//------------------------------------------------------------------------------------------------
+// Inserts a block after the current one, so the blocks already filled this frame stay valid
+//------------------------------------------------------------------------------------------------
+void LinearAllocator::AddBlock(size_t minSize)
+{
+	Block block;
+	block.m_size = minSize > m_blockSize ? minSize : m_blockSize;
+	block.m_data = static_cast<unsigned char*>(malloc(block.m_size));
+
+	GUARANTEE_OR_DIE(block.m_data != nullptr, "LINEAR ALLOCATOR FAILED TO ALLOCATE A BLOCK");
+
+	if (m_blocks.empty())
+	{
+		m_blocks.push_back(block);
+		m_currentBlock = 0;
+	}
+	else
+	{
+		m_blocks.insert(m_blocks.begin() + m_currentBlock + 1, block);
+		m_currentBlock++;
+	}
+
+	m_currentOffset = 0;
+}
+
+ScopedFrameAllocatorMarker::ScopedFrameAllocatorMarker()
+	: m_allocator(GetFrameAllocator())
+	, m_marker(GetFrameAllocator().GetMarker())
+{
+}
+
+ScopedFrameAllocatorMarker::~ScopedFrameAllocatorMarker()
+{
+	m_allocator.RewindToMarker(m_marker);
+}
+
+LinearAllocator& GetFrameAllocator()
+{
+	return t_frameAllocator;
+}
+
+void FrameAllocatorBeginFrame()
+{
+	t_frameAllocator.Reset();
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+constexpr size_t DEFAULT_FRAME_ALLOCATOR_BLOCK_SIZE = 1 << 20;
+
+//------------------------------------------------------------------------------------------------
+struct LinearAllocatorMarker
+{
+	size_t							m_blockIndex			= 0;
+	size_t							m_offset				= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+struct LinearAllocatorStats
+{
+	size_t							m_numAllocations		= 0;
+	size_t							m_bytesAllocated		= 0;
+	size_t							m_peakBytesAllocated	= 0;
+	size_t							m_bytesReserved			= 0;
+	size_t							m_numBlocks				= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Bump allocator over a chain of blocks. Individual frees are no-ops; memory comes back all at
+// once through Reset or RewindToMarker. Blocks are kept across resets so a steady-state frame
+// never touches the general heap.
+//------------------------------------------------------------------------------------------------
+class LinearAllocator
+{
+public:
+	struct Block
+	{
+		unsigned char*				m_data					= nullptr;
+		size_t						m_size					= 0;
+	};
+
+	size_t							m_blockSize				= DEFAULT_FRAME_ALLOCATOR_BLOCK_SIZE;
+	std::vector<Block>				m_blocks;
+	size_t							m_currentBlock			= 0;
+	size_t							m_currentOffset			= 0;
+
+	LinearAllocatorStats			m_stats;
+	LinearAllocatorStats			m_lastResetStats;
+public:
+									LinearAllocator(size_t blockSize = DEFAULT_FRAME_ALLOCATOR_BLOCK_SIZE);
+									~LinearAllocator();
+
+	void*							Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+	void							Reset();
+
+	LinearAllocatorMarker			GetMarker() const;
+	void							RewindToMarker(LinearAllocatorMarker const& marker);
+
+	size_t							GetBytesInUse() const;
+private:
+	void							AddBlock(size_t minSize);
+};
+
+//------------------------------------------------------------------------------------------------
+// Rewinds the calling thread's frame allocator on scope exit, for scratch memory that must not
+// live until the end of the frame (or on worker threads, which are never reset by App)
+//------------------------------------------------------------------------------------------------
+class ScopedFrameAllocatorMarker
+{
+public:
+	LinearAllocator&				m_allocator;
+	LinearAllocatorMarker			m_marker;
+public:
+									ScopedFrameAllocatorMarker();
+									~ScopedFrameAllocatorMarker();
+};
+
+LinearAllocator&	GetFrameAllocator();
+void				FrameAllocatorBeginFrame();
+
+//------------------------------------------------------------------------------------------------
+// STL adapter over the calling thread's frame allocator. Containers using it must not outlive
+// the frame (or the enclosing ScopedFrameAllocatorMarker) and must not cross threads.
+//------------------------------------------------------------------------------------------------
+template<typename T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+
+	LinearAllocator*				m_allocator				= nullptr;
+public:
+									FrameAllocator() noexcept : m_allocator(&GetFrameAllocator()) {}
+	template<typename U>			FrameAllocator(FrameAllocator<U> const& other) noexcept : m_allocator(other.m_allocator) {}
+
+	T*								allocate(size_t count) { return static_cast<T*>(m_allocator->Allocate(count * sizeof(T), alignof(T))); }
+	void							deallocate(T* pointer, size_t count) noexcept { (void)pointer; (void)count; }
+};
+
+template<typename T, typename U>
+bool operator==(FrameAllocator<T> const& a, FrameAllocator<U> const& b) { return a.m_allocator == b.m_allocator; }
+
+template<typename T, typename U>
+bool operator!=(FrameAllocator<T> const& a, FrameAllocator<U> const& b) { return a.m_allocator != b.m_allocator; }
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
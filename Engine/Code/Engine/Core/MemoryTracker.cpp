@@ -0,0 +1,564 @@
+#include "Engine/Core/MemoryTracker.hpp"
+
+#include "Game/EngineBuildPreferences.hpp"
+
+#include "Engine/Core/LinearAllocator.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(ENGINE_DISABLE_MEMORY_TRACKER) && defined(ENGINE_MEMORY_LEAK_REPORT)
+#error ENGINE_MEMORY_LEAK_REPORT needs the tracked operator new; undefine ENGINE_DISABLE_MEMORY_TRACKER
+#endif
+
+constexpr int MAX_LEAKS_REPORTED = 64;
+
+#if !defined(ENGINE_DISABLE_MEMORY_TRACKER)
+//------------------------------------------------------------------------------------------------
+// Sits directly before every pointer handed out, so a free knows which tag to credit. 16-byte
+// aligned so the pointer handed back keeps malloc's alignment. Over-aligned blocks are padded
+// in front of the header, and m_blockOffset walks back from the header to the malloc'd block.
+//------------------------------------------------------------------------------------------------
+struct alignas(16) AllocationHeader
+{
+	size_t							m_size					= 0;
+	MemoryTag						m_tag					= MemoryTag::UNTAGGED;
+	unsigned int					m_blockOffset			= 0;
+#if defined(ENGINE_MEMORY_LEAK_REPORT)
+	AllocationHeader*				m_prev					= nullptr;
+	AllocationHeader*				m_next					= nullptr;
+	unsigned long long				m_allocationIndex		= 0;
+#endif
+};
+#endif
+
+//------------------------------------------------------------------------------------------------
+struct MemoryTagCounters
+{
+	std::atomic<long long>				m_liveBytes;
+	std::atomic<long long>				m_peakBytes;
+	std::atomic<long long>				m_liveAllocations;
+	std::atomic<unsigned long long>		m_numAllocations;
+	std::atomic<unsigned long long>		m_bytesAllocated;
+};
+
+//------------------------------------------------------------------------------------------------
+// Plain statics rather than an object so the counters are valid for allocations made during
+// static initialisation, before any startup function has run
+//------------------------------------------------------------------------------------------------
+static std::atomic<unsigned long long> s_numHeapAllocations = 0;
+static std::atomic<unsigned long long> s_numHeapFrees = 0;
+static std::atomic<unsigned long long> s_numHeapBytesAllocated = 0;
+
+static MemoryTagCounters s_tagCounters[(int)MemoryTag::COUNT];
+
+static HeapAllocationStats s_frameStartTotals;
+static HeapAllocationStats s_lastFrameStats;
+
+static unsigned long long s_tagFrameStartAllocations[(int)MemoryTag::COUNT];
+static unsigned long long s_tagFrameStartBytes[(int)MemoryTag::COUNT];
+static unsigned long long s_tagLastFrameAllocations[(int)MemoryTag::COUNT];
+static unsigned long long s_tagLastFrameBytes[(int)MemoryTag::COUNT];
+
+static long long s_tagBudgetBytes[(int)MemoryTag::COUNT];
+static bool s_tagIsOverBudget[(int)MemoryTag::COUNT];
+
+static thread_local MemoryTag t_currentMemoryTag = MemoryTag::UNTAGGED;
+
+static char const* s_memoryTagNames[(int)MemoryTag::COUNT] =
+{
+	"Untagged",
+	"Engine",
+	"Renderer",
+	"Audio",
+	"Assets",
+	"Map",
+	"Actors",
+	"AI",
+	"Debug",
+};
+
+#if defined(ENGINE_MEMORY_LEAK_REPORT)
+static std::atomic_flag s_liveListLock = ATOMIC_FLAG_INIT;
+static AllocationHeader* s_liveListHead = nullptr;
+
+static void LockLiveList()
+{
+	while (s_liveListLock.test_and_set(std::memory_order_acquire))
+	{
+	}
+}
+
+static void UnlockLiveList()
+{
+	s_liveListLock.clear(std::memory_order_release);
+}
+#endif
+
+#if !defined(ENGINE_DISABLE_MEMORY_TRACKER)
+//------------------------------------------------------------------------------------------------
+// Returns nullptr on failure; the throwing operators turn that into std::bad_alloc
+//------------------------------------------------------------------------------------------------
+static void* TrackedAllocate(size_t size, size_t alignment)
+{
+	if (alignment < alignof(AllocationHeader))
+	{
+		alignment = alignof(AllocationHeader);
+	}
+
+	unsigned char* block = static_cast<unsigned char*>(malloc(sizeof(AllocationHeader) + size + alignment - alignof(AllocationHeader)));
+
+	if (block == nullptr)
+		return nullptr;
+
+	uintptr_t userAddress = (reinterpret_cast<uintptr_t>(block) + sizeof(AllocationHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	AllocationHeader* header = reinterpret_cast<AllocationHeader*>(userAddress) - 1;
+
+	MemoryTag tag = t_currentMemoryTag;
+	MemoryTagCounters& counters = s_tagCounters[(int)tag];
+
+	unsigned long long allocationIndex = s_numHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+	s_numHeapBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+	counters.m_numAllocations.fetch_add(1, std::memory_order_relaxed);
+	counters.m_bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+	counters.m_liveAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	long long liveBytes = counters.m_liveBytes.fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+	long long peakBytes = counters.m_peakBytes.load(std::memory_order_relaxed);
+
+	while (liveBytes > peakBytes && !counters.m_peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+	{
+	}
+
+	header->m_size = size;
+	header->m_tag = tag;
+	header->m_blockOffset = (unsigned int)(reinterpret_cast<unsigned char*>(header) - block);
+
+#if defined(ENGINE_MEMORY_LEAK_REPORT)
+	header->m_allocationIndex = allocationIndex;
+	header->m_prev = nullptr;
+
+	LockLiveList();
+	header->m_next = s_liveListHead;
+
+	if (s_liveListHead)
+	{
+		s_liveListHead->m_prev = header;
+	}
+
+	s_liveListHead = header;
+	UnlockLiveList();
+#else
+	UNUSED(allocationIndex);
+#endif
+
+	return header + 1;
+}
+
+static void* TrackedAllocateOrThrow(size_t size, size_t alignment)
+{
+	void* pointer = TrackedAllocate(size, alignment);
+
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return pointer;
+}
+
+static void TrackedFree(void* pointer)
+{
+	if (pointer == nullptr)
+		return;
+
+	AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+	MemoryTagCounters& counters = s_tagCounters[(int)header->m_tag];
+
+	s_numHeapFrees.fetch_add(1, std::memory_order_relaxed);
+
+	counters.m_liveBytes.fetch_sub((long long)header->m_size, std::memory_order_relaxed);
+	counters.m_liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+#if defined(ENGINE_MEMORY_LEAK_REPORT)
+	LockLiveList();
+
+	if (header->m_prev)
+	{
+		header->m_prev->m_next = header->m_next;
+	}
+	else
+	{
+		s_liveListHead = header->m_next;
+	}
+
+	if (header->m_next)
+	{
+		header->m_next->m_prev = header->m_prev;
+	}
+
+	UnlockLiveList();
+#endif
+
+	free(reinterpret_cast<unsigned char*>(header) - header->m_blockOffset);
+}
+
+void* operator new(size_t size)
+{
+	return TrackedAllocateOrThrow(size, 0);
+}
+
+void* operator new[](size_t size)
+{
+	return TrackedAllocateOrThrow(size, 0);
+}
+
+void* operator new(size_t size, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size, 0);
+}
+
+void* operator new[](size_t size, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return TrackedAllocateOrThrow(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return TrackedAllocateOrThrow(size, (size_t)alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size, (size_t)alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept
+{
+	UNUSED(size);
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t size) noexcept
+{
+	UNUSED(size);
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::nothrow_t const&) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::nothrow_t const&) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+	UNUSED(alignment);
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept
+{
+	UNUSED(alignment);
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t size, std::align_val_t alignment) noexcept
+{
+	UNUSED(size);
+	UNUSED(alignment);
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t size, std::align_val_t alignment) noexcept
+{
+	UNUSED(size);
+	UNUSED(alignment);
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+	UNUSED(alignment);
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+	UNUSED(alignment);
+	TrackedFree(pointer);
+}
+#endif
+
+ScopedMemoryTag::ScopedMemoryTag(MemoryTag tag)
+	: m_previousTag(t_currentMemoryTag)
+{
+	t_currentMemoryTag = tag;
+}
+
+ScopedMemoryTag::~ScopedMemoryTag()
+{
+	t_currentMemoryTag = m_previousTag;
+}
+
+static void PrintMemoryLine(Rgba8 const& color, std::string const& line)
+{
+	if (g_theConsole)
+	{
+		g_theConsole->AddLine(color, line);
+	}
+	else
+	{
+		DebuggerPrintf("%s\n", line.c_str());
+	}
+}
+
+void MemoryTrackerStartup()
+{
+	s_frameStartTotals = GetHeapAllocationTotals();
+
+	SubscribeEventCallbackFunction("MEMORYSTATS", Command_MemoryStats);
+}
+
+void MemoryTrackerShutdown()
+{
+#if defined(ENGINE_MEMORY_LEAK_REPORT)
+	MemoryTrackerDumpLeaks();
+#endif
+}
+
+void MemoryTrackerBeginFrame()
+{
+	HeapAllocationStats totals = GetHeapAllocationTotals();
+
+	s_lastFrameStats.m_numAllocations = totals.m_numAllocations - s_frameStartTotals.m_numAllocations;
+	s_lastFrameStats.m_numFrees = totals.m_numFrees - s_frameStartTotals.m_numFrees;
+	s_lastFrameStats.m_bytesAllocated = totals.m_bytesAllocated - s_frameStartTotals.m_bytesAllocated;
+
+	s_frameStartTotals = totals;
+
+	for (int tag = 0; tag < (int)MemoryTag::COUNT; tag++)
+	{
+		unsigned long long numAllocations = s_tagCounters[tag].m_numAllocations.load(std::memory_order_relaxed);
+		unsigned long long bytesAllocated = s_tagCounters[tag].m_bytesAllocated.load(std::memory_order_relaxed);
+
+		s_tagLastFrameAllocations[tag] = numAllocations - s_tagFrameStartAllocations[tag];
+		s_tagLastFrameBytes[tag] = bytesAllocated - s_tagFrameStartBytes[tag];
+
+		s_tagFrameStartAllocations[tag] = numAllocations;
+		s_tagFrameStartBytes[tag] = bytesAllocated;
+
+		long long budgetBytes = s_tagBudgetBytes[tag];
+		long long liveBytes = s_tagCounters[tag].m_liveBytes.load(std::memory_order_relaxed);
+		bool isOverBudget = budgetBytes > 0 && liveBytes > budgetBytes;
+
+		if (isOverBudget && !s_tagIsOverBudget[tag])
+		{
+			PrintMemoryLine(DevConsole::WARNING, Stringf("Memory tag %s is over budget: %.1f KB live, budget %.1f KB", s_memoryTagNames[tag], liveBytes / 1024.0, budgetBytes / 1024.0));
+		}
+
+		s_tagIsOverBudget[tag] = isOverBudget;
+	}
+}
+
+HeapAllocationStats GetHeapAllocationTotals()
+{
+	HeapAllocationStats stats;
+	stats.m_numAllocations = s_numHeapAllocations.load(std::memory_order_relaxed);
+	stats.m_numFrees = s_numHeapFrees.load(std::memory_order_relaxed);
+	stats.m_bytesAllocated = s_numHeapBytesAllocated.load(std::memory_order_relaxed);
+
+	return stats;
+}
+
+HeapAllocationStats GetHeapAllocationStatsLastFrame()
+{
+	return s_lastFrameStats;
+}
+
+MemoryTagStats GetMemoryTagStats(MemoryTag tag)
+{
+	MemoryTagCounters const& counters = s_tagCounters[(int)tag];
+
+	MemoryTagStats stats;
+	stats.m_liveBytes = counters.m_liveBytes.load(std::memory_order_relaxed);
+	stats.m_peakBytes = counters.m_peakBytes.load(std::memory_order_relaxed);
+	stats.m_liveAllocations = counters.m_liveAllocations.load(std::memory_order_relaxed);
+	stats.m_allocationsLastFrame = s_tagLastFrameAllocations[(int)tag];
+	stats.m_bytesLastFrame = s_tagLastFrameBytes[(int)tag];
+	stats.m_budgetBytes = s_tagBudgetBytes[(int)tag];
+
+	return stats;
+}
+
+char const* GetMemoryTagName(MemoryTag tag)
+{
+	return s_memoryTagNames[(int)tag];
+}
+
+bool GetMemoryTagByName(char const* name, MemoryTag& outTag)
+{
+	for (int tag = 0; tag < (int)MemoryTag::COUNT; tag++)
+	{
+		char const* tagName = s_memoryTagNames[tag];
+		int charIndex = 0;
+
+		while (name[charIndex] != '\0' && tolower((unsigned char)name[charIndex]) == tolower((unsigned char)tagName[charIndex]))
+		{
+			charIndex++;
+		}
+
+		if (name[charIndex] == '\0' && tagName[charIndex] == '\0')
+		{
+			outTag = (MemoryTag)tag;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void SetMemoryTagBudget(MemoryTag tag, long long budgetBytes)
+{
+	s_tagBudgetBytes[(int)tag] = budgetBytes;
+	s_tagIsOverBudget[(int)tag] = false;
+}
+
+long long GetMemoryTagBudget(MemoryTag tag)
+{
+	return s_tagBudgetBytes[(int)tag];
+}
+
+void MemoryTrackerDumpReport()
+{
+	LinearAllocatorStats const& frameStats = GetFrameAllocator().m_lastResetStats;
+
+#if defined(ENGINE_DISABLE_MEMORY_TRACKER)
+	PrintMemoryLine(DevConsole::INFO_MAJOR, "Heap tracking is compiled out (ENGINE_DISABLE_MEMORY_TRACKER)");
+	PrintMemoryLine(DevConsole::INFO_MAJOR, Stringf("Frame allocator   allocs %zu  bytes %zu  peak %zu  reserved %zu in %zu blocks", frameStats.m_numAllocations, frameStats.m_bytesAllocated, frameStats.m_peakBytesAllocated, frameStats.m_bytesReserved, frameStats.m_numBlocks));
+#else
+	HeapAllocationStats totals = GetHeapAllocationTotals();
+
+	PrintMemoryLine(DevConsole::INFO_MAJOR, Stringf("Heap last frame   allocs %llu  frees %llu  bytes %llu", s_lastFrameStats.m_numAllocations, s_lastFrameStats.m_numFrees, s_lastFrameStats.m_bytesAllocated));
+	PrintMemoryLine(DevConsole::INFO_MINOR, Stringf("Heap total        allocs %llu  frees %llu  bytes %llu", totals.m_numAllocations, totals.m_numFrees, totals.m_bytesAllocated));
+	PrintMemoryLine(DevConsole::INFO_MAJOR, Stringf("Frame allocator   allocs %zu  bytes %zu  peak %zu  reserved %zu in %zu blocks", frameStats.m_numAllocations, frameStats.m_bytesAllocated, frameStats.m_peakBytesAllocated, frameStats.m_bytesReserved, frameStats.m_numBlocks));
+	PrintMemoryLine(DevConsole::INFO_MAJOR, "Tag          live KB    peak KB     blocks   allocs/frame   KB/frame  budget KB");
+
+	for (int tag = 0; tag < (int)MemoryTag::COUNT; tag++)
+	{
+		MemoryTagStats stats = GetMemoryTagStats((MemoryTag)tag);
+
+		bool isOverBudget = stats.m_budgetBytes > 0 && stats.m_liveBytes > stats.m_budgetBytes;
+		std::string line = Stringf("%-10s %9.1f %10.1f %10lld %14llu %10.1f", s_memoryTagNames[tag], stats.m_liveBytes / 1024.0, stats.m_peakBytes / 1024.0, stats.m_liveAllocations, stats.m_allocationsLastFrame, stats.m_bytesLastFrame / 1024.0);
+
+		if (stats.m_budgetBytes > 0)
+		{
+			line += Stringf(" %10.1f%s", stats.m_budgetBytes / 1024.0, isOverBudget ? "  OVER" : "");
+		}
+
+		PrintMemoryLine(isOverBudget ? DevConsole::WARNING : DevConsole::INFO_MINOR, line);
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+// Untagged blocks are left out: static containers legitimately outlive every shutdown call
+//------------------------------------------------------------------------------------------------
+void MemoryTrackerDumpLeaks()
+{
+	for (int tag = 1; tag < (int)MemoryTag::COUNT; tag++)
+	{
+		MemoryTagStats stats = GetMemoryTagStats((MemoryTag)tag);
+
+		if (stats.m_liveAllocations > 0)
+		{
+			PrintMemoryLine(DevConsole::WARNING, Stringf("Leaked %lld blocks (%lld bytes) tagged %s", stats.m_liveAllocations, stats.m_liveBytes, s_memoryTagNames[tag]));
+		}
+	}
+
+#if defined(ENGINE_MEMORY_LEAK_REPORT)
+	// Copy out under the lock, print outside it, since printing allocates
+	AllocationHeader leaks[MAX_LEAKS_REPORTED];
+	int numLeaks = 0;
+
+	LockLiveList();
+
+	for (AllocationHeader* header = s_liveListHead; header != nullptr && numLeaks < MAX_LEAKS_REPORTED; header = header->m_next)
+	{
+		if (header->m_tag != MemoryTag::UNTAGGED)
+		{
+			leaks[numLeaks] = *header;
+			numLeaks++;
+		}
+	}
+
+	UnlockLiveList();
+
+	for (int leakIndex = 0; leakIndex < numLeaks; leakIndex++)
+	{
+		PrintMemoryLine(DevConsole::WARNING, Stringf("  allocation #%llu  %zu bytes  %s", leaks[leakIndex].m_allocationIndex, leaks[leakIndex].m_size, s_memoryTagNames[(int)leaks[leakIndex].m_tag]));
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+// "MemoryStats tag=Renderer budgetMB=64" sets a budget; budgetMB=0 clears it
+//------------------------------------------------------------------------------------------------
+bool Command_MemoryStats(EventArgs& args)
+{
+	std::string tagName = args.GetValue("tag", "");
+
+	if (!tagName.empty())
+	{
+		MemoryTag tag = MemoryTag::UNTAGGED;
+
+		if (!GetMemoryTagByName(tagName.c_str(), tag))
+		{
+			PrintMemoryLine(DevConsole::ERROR, Stringf("Unknown memory tag %s", tagName.c_str()));
+			return false;
+		}
+
+		float budgetMB = args.GetValue("budgetMB", (float)GetMemoryTagBudget(tag) / (1024.f * 1024.f));
+		SetMemoryTagBudget(tag, (long long)(budgetMB * 1024.f * 1024.f));
+	}
+
+	if (args.GetValue("leaks", false))
+	{
+		MemoryTrackerDumpLeaks();
+	}
+	else
+	{
+		MemoryTrackerDumpReport();
+	}
+
+	return true;
+}
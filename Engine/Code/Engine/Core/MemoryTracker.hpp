@@ -0,0 +1,73 @@
+#pragma once
+
+class NamedStrings;
+
+typedef NamedStrings EventArgs;
+
+//------------------------------------------------------------------------------------------------
+enum class MemoryTag : unsigned char
+{
+	UNTAGGED,
+	ENGINE,
+	RENDERER,
+	AUDIO,
+	ASSETS,
+	MAP,
+	ACTORS,
+	AI,
+	DEBUG,
+	COUNT
+};
+
+//------------------------------------------------------------------------------------------------
+struct HeapAllocationStats
+{
+	unsigned long long				m_numAllocations		= 0;
+	unsigned long long				m_numFrees				= 0;
+	unsigned long long				m_bytesAllocated		= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+struct MemoryTagStats
+{
+	long long						m_liveBytes				= 0;
+	long long						m_peakBytes				= 0;
+	long long						m_liveAllocations		= 0;
+	unsigned long long				m_allocationsLastFrame	= 0;
+	unsigned long long				m_bytesLastFrame		= 0;
+	long long						m_budgetBytes			= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Every allocation made through the global operator new, which the engine replaces, is charged
+// to the calling thread's current tag. Tags nest: the innermost ScopedMemoryTag wins. With
+// ENGINE_DISABLE_MEMORY_TRACKER the operators are not replaced and every heap stat reads 0.
+//------------------------------------------------------------------------------------------------
+class ScopedMemoryTag
+{
+public:
+	MemoryTag						m_previousTag			= MemoryTag::UNTAGGED;
+public:
+	explicit						ScopedMemoryTag(MemoryTag tag);
+									~ScopedMemoryTag();
+};
+
+void					MemoryTrackerStartup();
+void					MemoryTrackerShutdown();
+void					MemoryTrackerBeginFrame();
+
+HeapAllocationStats		GetHeapAllocationTotals();
+HeapAllocationStats		GetHeapAllocationStatsLastFrame();
+MemoryTagStats			GetMemoryTagStats(MemoryTag tag);
+char const*				GetMemoryTagName(MemoryTag tag);
+bool					GetMemoryTagByName(char const* name, MemoryTag& outTag);
+
+// A budget of 0 means unbudgeted. Tags over budget are warned about once per crossing at BeginFrame
+void					SetMemoryTagBudget(MemoryTag tag, long long budgetBytes);
+long long				GetMemoryTagBudget(MemoryTag tag);
+
+// Prints to the DevConsole when there is one and to stdout otherwise
+void					MemoryTrackerDumpReport();
+void					MemoryTrackerDumpLeaks();
+
+bool					Command_MemoryStats(EventArgs& args);
@@ -1,35 +1,45 @@
 #include "NamedStrings.hpp"
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/IntVec2.hpp"
 
+#include <cstdlib>
+
+static unsigned int HashNamedStringsKey(std::string const& keyName)
+{
+	unsigned int hash = 2166136261u;
+
+	for (size_t index = 0; index < keyName.size(); index++)
+	{
+		hash ^= (unsigned char)keyName[index];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
 void NamedStrings::PopulateFromXmlElementAttributes(XmlElement const& element, bool isAdditional)
 {
-	
+
 	const XmlAttribute* attribute = element.FirstAttribute();
 
 	while (attribute != nullptr)
 	{
-		if (isAdditional)
+		NamedStringsEntry const* existing = isAdditional ? FindEntry(attribute->Name()) : nullptr;
+
+		if (existing != nullptr)
 		{
-			auto it = m_keyValuePairs.find(attribute->Name());
-			if (it != m_keyValuePairs.end())
-			{
-				// Attribute already exists, decide whether to append or override.
-				it->second += "," + std::string(attribute->Value());
-			}
-			else
-			{
-				// Attribute does not exist, add it.
-				m_keyValuePairs[attribute->Name()] = attribute->Value();
-			}
+			// Attribute already exists, decide whether to append or override.
+			std::string appended = GetText(*existing) + "," + attribute->Value();
+			SetValue(attribute->Name(), appended);
 		}
 		else
 		{
 			// Default behavior for adding new attributes.
-			m_keyValuePairs[attribute->Name()] = attribute->Value();
+			SetValue(attribute->Name(), attribute->Value());
 		}
 		attribute = attribute->Next();
 	}
@@ -37,145 +47,279 @@ void NamedStrings::PopulateFromXmlElementAttributes(XmlElement const& element, b
 
 bool NamedStrings::HasArgument(std::string const& keyName)
 {
-	std::map<std::string, std::string>::const_iterator it = m_keyValuePairs.find(keyName);
+	return FindEntry(keyName) != nullptr;
+}
 
-    if (it != m_keyValuePairs.end())
-    {
-        return true;
-    }
-    return false;
+void NamedStrings::Clear()
+{
+	m_numEntries = 0;
+	m_overflowEntries.clear();
 }
 
 void NamedStrings::SetValue(std::string const& keyName, std::string const& newValue)
 {
-	m_keyValuePairs[keyName] = newValue;
+	NamedStringsEntry& entry = FindOrAddEntry(keyName);
+	entry.m_text = newValue;
+	entry.m_hasText = true;
+	entry.m_cachedType = NamedStringsValueType::NONE;
+}
+
+void NamedStrings::SetValue(std::string const& keyName, char const* newValue)
+{
+	NamedStringsEntry& entry = FindOrAddEntry(keyName);
+	entry.m_text = newValue;
+	entry.m_hasText = true;
+	entry.m_cachedType = NamedStringsValueType::NONE;
+}
+
+void NamedStrings::SetValue(std::string const& keyName, bool newValue)
+{
+	NamedStringsTypedValue value;
+	value.m_bool = newValue;
+
+	SetTypedValue(keyName, NamedStringsValueType::BOOL, value);
+}
+
+void NamedStrings::SetValue(std::string const& keyName, int newValue)
+{
+	NamedStringsTypedValue value;
+	value.m_int = newValue;
+
+	SetTypedValue(keyName, NamedStringsValueType::INT, value);
+}
+
+void NamedStrings::SetValue(std::string const& keyName, float newValue)
+{
+	NamedStringsTypedValue value;
+	value.m_float = newValue;
+
+	SetTypedValue(keyName, NamedStringsValueType::FLOAT, value);
 }
 
 std::string NamedStrings::GetValue(std::string const& keyName, std::string const& defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
-	
-	if (found == m_keyValuePairs.end())
+	NamedStringsEntry const* found = FindEntry(keyName);
+
+	if (found == nullptr)
 		return defaultValue;
 	else
 	{
-		return found->second;
+		return GetText(*found);
 	}
 }
 
 bool NamedStrings::GetValue(std::string const& keyName, bool defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
-	
-	if (found == m_keyValuePairs.end())
-		return defaultValue;
-	else
-	{
-		bool value;
-
-		std::string text = found->second.c_str();
+	NamedStringsEntry const* found = FindEntry(keyName);
 
-		if (text == "true")
-			value = true;
-		else
-			value = false;
+	if (found == nullptr)
+		return defaultValue;
 
-		return value;
+	if (found->m_cachedType != NamedStringsValueType::BOOL)
+	{
+		found->m_cachedValue.m_bool = GetText(*found) == "true";
+		found->m_cachedType = NamedStringsValueType::BOOL;
 	}
+
+	return found->m_cachedValue.m_bool;
 }
 
 int NamedStrings::GetValue(std::string const& keyName, int defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
-	
-	if (found == m_keyValuePairs.end())
+	NamedStringsEntry const* found = FindEntry(keyName);
+
+	if (found == nullptr)
 		return defaultValue;
-	else
-	{
-		int value;
-		
-		value = std::atoi(found->second.c_str());
 
-		return value;
+	if (found->m_cachedType != NamedStringsValueType::INT)
+	{
+		found->m_cachedValue.m_int = std::atoi(GetText(*found).c_str());
+		found->m_cachedType = NamedStringsValueType::INT;
 	}
+
+	return found->m_cachedValue.m_int;
 }
 
 float NamedStrings::GetValue(std::string const& keyName, float defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
+	NamedStringsEntry const* found = FindEntry(keyName);
 
-	if (found == m_keyValuePairs.end())
+	if (found == nullptr)
 		return defaultValue;
-	else
-	{
-		float value;
-
-		value = static_cast<float>(std::atof(found->second.c_str()));
 
-		return value;
+	if (found->m_cachedType != NamedStringsValueType::FLOAT)
+	{
+		found->m_cachedValue.m_float = static_cast<float>(std::atof(GetText(*found).c_str()));
+		found->m_cachedType = NamedStringsValueType::FLOAT;
 	}
+
+	return found->m_cachedValue.m_float;
 }
 
 std::string NamedStrings::GetValue(std::string const& keyName, char const* defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
+	NamedStringsEntry const* found = FindEntry(keyName);
 
-	if (found == m_keyValuePairs.end())
+	if (found == nullptr)
 		return defaultValue;
 	else
 	{
-		std::string value;
-
-		value = found->second.c_str();
-
-		return value;
+		return GetText(*found);
 	}
 }
 
 Rgba8 NamedStrings::GetValue(std::string const& keyName, Rgba8 const& defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
+	NamedStringsEntry const* found = FindEntry(keyName);
 
-	if (found == m_keyValuePairs.end())
+	if (found == nullptr)
 		return defaultValue;
-	else
+
+	if (found->m_cachedType != NamedStringsValueType::RGBA8)
 	{
 		Rgba8 value;
+		value.SetFromText(GetText(*found).c_str());
 
-		value.SetFromText(found->second.c_str());
-
-		return value;
+		found->m_cachedValue.m_rgba8[0] = value.r;
+		found->m_cachedValue.m_rgba8[1] = value.g;
+		found->m_cachedValue.m_rgba8[2] = value.b;
+		found->m_cachedValue.m_rgba8[3] = value.a;
+		found->m_cachedType = NamedStringsValueType::RGBA8;
 	}
+
+	unsigned char const* rgba = found->m_cachedValue.m_rgba8;
+
+	return Rgba8(rgba[0], rgba[1], rgba[2], rgba[3]);
 }
 
 Vec2 NamedStrings::GetValue(std::string const& keyName, Vec2 const& defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
+	NamedStringsEntry const* found = FindEntry(keyName);
 
-	if (found == m_keyValuePairs.end())
+	if (found == nullptr)
 		return defaultValue;
-	else
+
+	if (found->m_cachedType != NamedStringsValueType::VEC2)
 	{
 		Vec2 value;
+		value.SetFromText(GetText(*found).c_str());
 
-		value.SetFromText(found->second.c_str());
-
-		return value;
+		found->m_cachedValue.m_vec2[0] = value.x;
+		found->m_cachedValue.m_vec2[1] = value.y;
+		found->m_cachedType = NamedStringsValueType::VEC2;
 	}
+
+	return Vec2(found->m_cachedValue.m_vec2[0], found->m_cachedValue.m_vec2[1]);
 }
 
 IntVec2 NamedStrings::GetValue(std::string const& keyName, IntVec2 const& defaultValue) const
 {
-	std::map<std::string, std::string>::const_iterator found = m_keyValuePairs.find(keyName);
+	NamedStringsEntry const* found = FindEntry(keyName);
 
-	if (found == m_keyValuePairs.end())
+	if (found == nullptr)
 		return defaultValue;
-	else
+
+	if (found->m_cachedType != NamedStringsValueType::INTVEC2)
 	{
 		IntVec2 value;
+		value.SetFromText(GetText(*found).c_str());
+
+		found->m_cachedValue.m_intVec2[0] = value.x;
+		found->m_cachedValue.m_intVec2[1] = value.y;
+		found->m_cachedType = NamedStringsValueType::INTVEC2;
+	}
+
+	return IntVec2(found->m_cachedValue.m_intVec2[0], found->m_cachedValue.m_intVec2[1]);
+}
+
+int NamedStrings::FindEntryIndex(std::string const& keyName) const
+{
+	unsigned int keyHash = HashNamedStringsKey(keyName);
 
-		value.SetFromText(found->second.c_str());
+	for (int index = 0; index < m_numEntries; index++)
+	{
+		NamedStringsEntry const& entry = GetEntry(index);
 
-		return value;
+		if (entry.m_keyHash == keyHash && entry.m_key == keyName)
+			return index;
 	}
+
+	return -1;
+}
+
+NamedStringsEntry const* NamedStrings::FindEntry(std::string const& keyName) const
+{
+	int index = FindEntryIndex(keyName);
+
+	return index >= 0 ? &GetEntry(index) : nullptr;
 }
+
+NamedStringsEntry& NamedStrings::FindOrAddEntry(std::string const& keyName)
+{
+	int index = FindEntryIndex(keyName);
+
+	if (index >= 0)
+		return GetEntry(index);
+
+	if (m_numEntries >= NAMED_STRINGS_INLINE_CAPACITY)
+	{
+		m_overflowEntries.emplace_back();
+	}
+
+	NamedStringsEntry& entry = GetEntry(m_numEntries);
+	m_numEntries++;
+
+	entry.m_key = keyName;
+	entry.m_keyHash = HashNamedStringsKey(keyName);
+	entry.m_hasText = true;
+	entry.m_cachedType = NamedStringsValueType::NONE;
+	entry.m_text.clear();
+
+	return entry;
+}
+
+NamedStringsEntry& NamedStrings::GetEntry(int index)
+{
+	if (index < NAMED_STRINGS_INLINE_CAPACITY)
+		return m_inlineEntries[index];
+
+	return m_overflowEntries[index - NAMED_STRINGS_INLINE_CAPACITY];
+}
+
+NamedStringsEntry const& NamedStrings::GetEntry(int index) const
+{
+	if (index < NAMED_STRINGS_INLINE_CAPACITY)
+		return m_inlineEntries[index];
+
+	return m_overflowEntries[index - NAMED_STRINGS_INLINE_CAPACITY];
+}
+
+void NamedStrings::SetTypedValue(std::string const& keyName, NamedStringsValueType type, NamedStringsTypedValue const& value)
+{
+	NamedStringsEntry& entry = FindOrAddEntry(keyName);
+	entry.m_cachedType = type;
+	entry.m_cachedValue = value;
+	entry.m_hasText = false;
+}
+
+//------------------------------------------------------------------------------------------------
+// Values set typed get their text form on first string read
+//------------------------------------------------------------------------------------------------
+std::string const& NamedStrings::GetText(NamedStringsEntry const& entry) const
+{
+	if (!entry.m_hasText)
+	{
+		switch (entry.m_cachedType)
+		{
+		case NamedStringsValueType::BOOL:	entry.m_text = entry.m_cachedValue.m_bool ? "true" : "false";	break;
+		case NamedStringsValueType::INT:	entry.m_text = Stringf("%d", entry.m_cachedValue.m_int);		break;
+		case NamedStringsValueType::FLOAT:	entry.m_text = Stringf("%g", entry.m_cachedValue.m_float);		break;
+		default:							entry.m_text.clear();											break;
+		}
+
+		entry.m_hasText = true;
+	}
+
+	return entry.m_text;
+}
+
@@ -3,18 +3,73 @@
 #include "Engine/Core/XmlUtils.hpp"
 
 #include <string>
-#include <map>
+#include <vector>
 
+class NamedStrings;
+
+typedef NamedStrings EventArgs;
+
+constexpr int NAMED_STRINGS_INLINE_CAPACITY = 8;
+
+//------------------------------------------------------------------------------------------------
+enum class NamedStringsValueType : unsigned char
+{
+	NONE,
+	BOOL,
+	INT,
+	FLOAT,
+	RGBA8,
+	VEC2,
+	INTVEC2
+};
+
+//------------------------------------------------------------------------------------------------
+union NamedStringsTypedValue
+{
+	bool							m_bool;
+	int								m_int;
+	float							m_float;
+	unsigned char					m_rgba8[4];
+	float							m_vec2[2];
+	int								m_intVec2[2];
+};
+
+//------------------------------------------------------------------------------------------------
+// The key's hash is compared before its text. The text is authoritative unless the value was set
+// typed; the last typed read is cached so repeated GetValue calls skip parsing.
+//------------------------------------------------------------------------------------------------
+struct NamedStringsEntry
+{
+	std::string						m_key;
+	unsigned int					m_keyHash				= 0;
+	mutable bool					m_hasText				= true;
+	mutable NamedStringsValueType	m_cachedType			= NamedStringsValueType::NONE;
+	mutable NamedStringsTypedValue	m_cachedValue			= {};
+	mutable std::string				m_text;
+};
+
+//------------------------------------------------------------------------------------------------
+// Flat key/value store: the first NAMED_STRINGS_INLINE_CAPACITY entries live inline, the rest
+// spill into a vector. Single-threaded: the const GetValue overloads write the typed cache, so an
+// instance must not be read from two threads at once, JobSystem workers included. Copy it first.
+//------------------------------------------------------------------------------------------------
 class NamedStrings
 {
-	std::map<std::string, std::string> m_keyValuePairs;
+	NamedStringsEntry				m_inlineEntries[NAMED_STRINGS_INLINE_CAPACITY];
+	std::vector<NamedStringsEntry>	m_overflowEntries;
+	int								m_numEntries			= 0;
 public:
 					NamedStrings() = default;
 					~NamedStrings() = default;
 
 	void			PopulateFromXmlElementAttributes(XmlElement const& element, bool isAdditional);
 	bool			HasArgument(std::string const& keyName);
+	void			Clear();
 	void			SetValue(std::string const& keyName, std::string const& newValue);
+	void			SetValue(std::string const& keyName, char const* newValue);
+	void			SetValue(std::string const& keyName, bool newValue);
+	void			SetValue(std::string const& keyName, int newValue);
+	void			SetValue(std::string const& keyName, float newValue);
 	std::string		GetValue(std::string const& keyName, std::string const& defaultValue) const;
 	bool			GetValue(std::string const& keyName, bool defaultValue) const;
 	int				GetValue(std::string const& keyName, int defaultValue) const;
@@ -23,5 +78,12 @@ public:
 	Rgba8			GetValue(std::string const& keyName, Rgba8 const& defaultValue) const;
 	Vec2			GetValue(std::string const& keyName, Vec2 const& defaultValue) const;
 	IntVec2			GetValue(std::string const& keyName, IntVec2 const& defaultValue) const;
-
-};
\ No newline at end of file
+private:
+	int							FindEntryIndex(std::string const& keyName) const;
+	NamedStringsEntry const*	FindEntry(std::string const& keyName) const;
+	NamedStringsEntry&			FindOrAddEntry(std::string const& keyName);
+	NamedStringsEntry&			GetEntry(int index);
+	NamedStringsEntry const&	GetEntry(int index) const;
+	void						SetTypedValue(std::string const& keyName, NamedStringsValueType type, NamedStringsTypedValue const& value);
+	std::string const&			GetText(NamedStringsEntry const& entry) const;
+};
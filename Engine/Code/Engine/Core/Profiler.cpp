@@ -0,0 +1,435 @@
+#include "Engine/Core/Profiler.hpp"
+
+#if !defined(ENGINE_DISABLE_PROFILER)
+
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+Profiler* g_theProfiler = nullptr;
+
+//------------------------------------------------------------------------------------------------
+// Cached per thread so a zone costs two counter reads and one store
+//------------------------------------------------------------------------------------------------
+thread_local ProfileThreadBuffer* t_profileBuffer = nullptr;
+
+Profiler::Profiler(ProfilerConfig const& config)
+	: m_config(config)
+{
+	m_frameMilliseconds.resize(m_config.m_historyFrames);
+}
+
+Profiler::~Profiler()
+{
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+	for (size_t index = 0; index < m_threads.size(); index++)
+	{
+		DELETE_PTR(m_threads[index]);
+	}
+
+	m_threads.clear();
+}
+
+void Profiler::StartUp()
+{
+	SetThreadName("Main");
+
+	m_frameStartTicks = GetCurrentTimeTicks();
+
+	SubscribeEventCallbackFunction("PROFILERDUMP", Profiler::Command_ProfilerDump);
+	SubscribeEventCallbackFunction("PROFILERTRACE", Profiler::Command_ProfilerTrace);
+}
+
+void Profiler::ShutDown()
+{
+}
+
+void Profiler::BeginFrame()
+{
+	m_frameStartTicks = GetCurrentTimeTicks();
+}
+
+//------------------------------------------------------------------------------------------------
+// Copies the samples published from firstIndex on and returns the write count the copy ended at.
+// The owning thread keeps writing while this runs, so the count is read again afterwards and any
+// sample whose slot may have been reused during the copy is dropped instead of returned torn. The
+// slot at the current count counts as reused, since the writer fills it before publishing.
+//------------------------------------------------------------------------------------------------
+static unsigned long long CopyPublishedSamples(ProfileThreadBuffer const* buffer, unsigned long long firstIndex, std::vector<ProfileSample>& outSamples)
+{
+	outSamples.clear();
+
+	unsigned long long capacity = buffer->m_samples.size();
+	unsigned long long numWritten = buffer->m_numWritten.load(std::memory_order_acquire);
+
+	if (numWritten - firstIndex > capacity)
+	{
+		firstIndex = numWritten - capacity;
+	}
+
+	for (unsigned long long sampleIndex = firstIndex; sampleIndex < numWritten; sampleIndex++)
+	{
+		outSamples.push_back(buffer->m_samples[sampleIndex % capacity]);
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	unsigned long long numWrittenAfterCopy = buffer->m_numWritten.load(std::memory_order_relaxed);
+	unsigned long long firstIntactIndex = (numWrittenAfterCopy + 1 > capacity) ? numWrittenAfterCopy + 1 - capacity : 0;
+
+	if (firstIntactIndex > firstIndex)
+	{
+		size_t numTorn = static_cast<size_t>(std::min<unsigned long long>(firstIntactIndex - firstIndex, outSamples.size()));
+		outSamples.erase(outSamples.begin(), outSamples.begin() + numTorn);
+	}
+
+	return numWritten;
+}
+
+//------------------------------------------------------------------------------------------------
+// Folds every sample published since the last frame into per-zone totals and advances history
+//------------------------------------------------------------------------------------------------
+void Profiler::EndFrame()
+{
+	double millisecondsPerTick = GetSecondsPerTick() * 1000.0;
+
+	m_frameMilliseconds[m_historyIndex] = static_cast<float>(static_cast<double>(GetCurrentTimeTicks() - m_frameStartTicks) * millisecondsPerTick);
+
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+		for (size_t threadIndex = 0; threadIndex < m_threads.size(); threadIndex++)
+		{
+			ProfileThreadBuffer* buffer = m_threads[threadIndex];
+
+			unsigned long long numWritten = CopyPublishedSamples(buffer, buffer->m_numConsumed, m_sampleSnapshot);
+
+			for (size_t sampleIndex = 0; sampleIndex < m_sampleSnapshot.size(); sampleIndex++)
+			{
+				ProfileSample const& sample = m_sampleSnapshot[sampleIndex];
+
+				auto found = m_zoneIndexByName.find(sample.m_name);
+				int zoneIndex = 0;
+
+				if (found == m_zoneIndexByName.end())
+				{
+					zoneIndex = static_cast<int>(m_zones.size());
+					m_zoneIndexByName[sample.m_name] = zoneIndex;
+
+					ProfileZoneStats zone;
+					zone.m_name = sample.m_name;
+					zone.m_depth = sample.m_depth;
+					zone.m_firstStartTicks = sample.m_startTicks;
+					zone.m_frameMilliseconds.resize(m_config.m_historyFrames);
+
+					m_zones.push_back(zone);
+				}
+				else
+				{
+					zoneIndex = found->second;
+				}
+
+				m_zones[zoneIndex].m_ticksThisFrame += sample.m_endTicks - sample.m_startTicks;
+				m_zones[zoneIndex].m_callsThisFrame++;
+			}
+
+			buffer->m_numConsumed = numWritten;
+		}
+	}
+
+	for (size_t zoneIndex = 0; zoneIndex < m_zones.size(); zoneIndex++)
+	{
+		ProfileZoneStats& zone = m_zones[zoneIndex];
+
+		zone.m_frameMilliseconds[m_historyIndex] = static_cast<float>(static_cast<double>(zone.m_ticksThisFrame) * millisecondsPerTick);
+		zone.m_lastCalls = zone.m_callsThisFrame;
+		zone.m_ticksThisFrame = 0;
+		zone.m_callsThisFrame = 0;
+	}
+
+	int numCounters = m_numCounters.load();
+
+	for (int counterIndex = 0; counterIndex < numCounters; counterIndex++)
+	{
+		ProfileCounter& counter = m_counters[counterIndex];
+
+		counter.m_lastValue = counter.m_valueThisFrame.exchange(0);
+		counter.m_maxValue = (counter.m_lastValue > counter.m_maxValue) ? counter.m_lastValue : counter.m_maxValue;
+	}
+
+	m_historyIndex = (m_historyIndex + 1) % m_config.m_historyFrames;
+	m_numHistoryFrames = (m_numHistoryFrames < m_config.m_historyFrames) ? m_numHistoryFrames + 1 : m_numHistoryFrames;
+}
+
+ProfileThreadBuffer* Profiler::GetThreadBuffer()
+{
+	if (t_profileBuffer)
+		return t_profileBuffer;
+
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+	ProfileThreadBuffer* buffer = new ProfileThreadBuffer();
+	buffer->m_threadIndex = static_cast<unsigned int>(m_threads.size());
+	buffer->m_name = Stringf("Thread %u", buffer->m_threadIndex);
+	buffer->m_samples.resize(m_config.m_samplesPerThread);
+
+	m_threads.push_back(buffer);
+
+	t_profileBuffer = buffer;
+
+	return buffer;
+}
+
+void Profiler::SetThreadName(char const* name)
+{
+	ProfileThreadBuffer* buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+	buffer->m_name = name;
+}
+
+void Profiler::RecordSample(ProfileThreadBuffer* buffer, char const* name, unsigned long long startTicks, int depth)
+{
+	unsigned long long sampleIndex = buffer->m_numWritten.load(std::memory_order_relaxed);
+
+	ProfileSample& sample = buffer->m_samples[sampleIndex % buffer->m_samples.size()];
+	sample.m_name = name;
+	sample.m_startTicks = startTicks;
+	sample.m_endTicks = GetCurrentTimeTicks();
+	sample.m_depth = depth;
+
+	buffer->m_numWritten.store(sampleIndex + 1, std::memory_order_release);
+}
+
+int Profiler::RegisterCounter(char const* name)
+{
+	std::lock_guard<std::mutex> lock(m_countersMutex);
+
+	int numCounters = m_numCounters.load();
+
+	for (int counterIndex = 0; counterIndex < numCounters; counterIndex++)
+	{
+		if (strcmp(m_counters[counterIndex].m_name, name) == 0)
+			return counterIndex;
+	}
+
+	GUARANTEE_OR_DIE(numCounters < MAX_PROFILE_COUNTERS, "TOO MANY PROFILE COUNTERS");
+
+	m_counters[numCounters].m_name = name;
+	m_numCounters.store(numCounters + 1);
+
+	return numCounters;
+}
+
+void Profiler::AddToCounter(int counterIndex, long long amount)
+{
+	m_counters[counterIndex].m_valueThisFrame.fetch_add(amount, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------
+static void GetHistoryStats(std::vector<float> const& history, int numFrames, float& out_min, float& out_avg, float& out_p99, float& out_max)
+{
+	out_min = out_avg = out_p99 = out_max = 0.0f;
+
+	if (numFrames <= 0)
+		return;
+
+	std::vector<float> sorted(history.begin(), history.begin() + numFrames);
+	std::sort(sorted.begin(), sorted.end());
+
+	float total = 0.0f;
+
+	for (int index = 0; index < numFrames; index++)
+	{
+		total += sorted[index];
+	}
+
+	int p99Index = (numFrames * 99) / 100;
+
+	out_min = sorted.front();
+	out_max = sorted.back();
+	out_avg = total / static_cast<float>(numFrames);
+	out_p99 = sorted[p99Index < numFrames ? p99Index : numFrames - 1];
+}
+
+void Profiler::DumpStats() const
+{
+	float minMs, avgMs, p99Ms, maxMs;
+
+	GetHistoryStats(m_frameMilliseconds, m_numHistoryFrames, minMs, avgMs, p99Ms, maxMs);
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Profiler over %d frames   frame  min %.3f  avg %.3f  p99 %.3f  max %.3f ms", m_numHistoryFrames, minMs, avgMs, p99Ms, maxMs));
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, "Zone                                     calls    min ms    avg ms    p99 ms    max ms");
+
+	// Nested zones start inside their parent, so ordering by first start time lists parents before children
+	std::vector<size_t> zoneOrder(m_zones.size());
+
+	for (size_t zoneIndex = 0; zoneIndex < m_zones.size(); zoneIndex++)
+	{
+		zoneOrder[zoneIndex] = zoneIndex;
+	}
+
+	std::sort(zoneOrder.begin(), zoneOrder.end(), [this](size_t a, size_t b) { return m_zones[a].m_firstStartTicks < m_zones[b].m_firstStartTicks; });
+
+	for (size_t orderIndex = 0; orderIndex < zoneOrder.size(); orderIndex++)
+	{
+		ProfileZoneStats const& zone = m_zones[zoneOrder[orderIndex]];
+
+		GetHistoryStats(zone.m_frameMilliseconds, m_numHistoryFrames, minMs, avgMs, p99Ms, maxMs);
+
+		std::string name = std::string(static_cast<size_t>(zone.m_depth) * 2, ' ') + zone.m_name;
+
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("%-40s %6d %9.3f %9.3f %9.3f %9.3f", name.c_str(), zone.m_lastCalls, minMs, avgMs, p99Ms, maxMs));
+	}
+
+	int numCounters = m_numCounters.load();
+
+	for (int counterIndex = 0; counterIndex < numCounters; counterIndex++)
+	{
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Counter %-32s last %lld  max %lld", m_counters[counterIndex].m_name, m_counters[counterIndex].m_lastValue, m_counters[counterIndex].m_maxValue));
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Zone names come from __FUNCTION__ and user literals, so quotes, backslashes and control
+// characters are escaped to keep the trace valid JSON
+//------------------------------------------------------------------------------------------------
+static void AppendJsonEscapedString(std::string& json, char const* text)
+{
+	for (char const* character = text; *character != '\0'; character++)
+	{
+		unsigned char c = static_cast<unsigned char>(*character);
+
+		switch (c)
+		{
+		case '"':	json += "\\\"";	break;
+		case '\\':	json += "\\\\";	break;
+		case '\n':	json += "\\n";	break;
+		case '\r':	json += "\\r";	break;
+		case '\t':	json += "\\t";	break;
+		default:
+			if (c < 0x20)
+			{
+				json += Stringf("\\u%04x", c);
+			}
+			else
+			{
+				json += static_cast<char>(c);
+			}
+			break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Writes every sample still held in the ring buffers as Chrome "complete" events (chrome://tracing)
+//------------------------------------------------------------------------------------------------
+bool Profiler::ExportChromeTrace(std::string const& filePath)
+{
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+	double microsecondsPerTick = GetSecondsPerTick() * 1000000.0;
+
+	// Snapshot every buffer first so the timestamps and events below come from the same samples
+	std::vector<std::vector<ProfileSample>> threadSamples(m_threads.size());
+
+	unsigned long long baseTicks = ~0ull;
+
+	for (size_t threadIndex = 0; threadIndex < m_threads.size(); threadIndex++)
+	{
+		CopyPublishedSamples(m_threads[threadIndex], 0, threadSamples[threadIndex]);
+
+		for (ProfileSample const& sample : threadSamples[threadIndex])
+		{
+			baseTicks = (sample.m_startTicks < baseTicks) ? sample.m_startTicks : baseTicks;
+		}
+	}
+
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool isFirstEvent = true;
+
+	for (size_t threadIndex = 0; threadIndex < m_threads.size(); threadIndex++)
+	{
+		ProfileThreadBuffer const* buffer = m_threads[threadIndex];
+
+		json += isFirstEvent ? "" : ",\n";
+		json += Stringf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", buffer->m_threadIndex);
+		AppendJsonEscapedString(json, buffer->m_name.c_str());
+		json += "\"}}";
+		isFirstEvent = false;
+
+		for (ProfileSample const& sample : threadSamples[threadIndex])
+		{
+			double startMicroseconds = static_cast<double>(sample.m_startTicks - baseTicks) * microsecondsPerTick;
+			double durationMicroseconds = static_cast<double>(sample.m_endTicks - sample.m_startTicks) * microsecondsPerTick;
+
+			json += ",\n{\"name\":\"";
+			AppendJsonEscapedString(json, sample.m_name);
+			json += Stringf("\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->m_threadIndex, startMicroseconds, durationMicroseconds);
+		}
+	}
+
+	json += "\n]}\n";
+
+	std::vector<unsigned char> buffer(json.begin(), json.end());
+	std::string fileName = filePath;
+
+	WriteBufferToFile(buffer, fileName);
+
+	return true;
+}
+
+bool Profiler::Command_ProfilerDump(EventArgs& args)
+{
+	UNUSED(args);
+
+	if (g_theProfiler == nullptr)
+		return false;
+
+	g_theProfiler->DumpStats();
+
+	return true;
+}
+
+bool Profiler::Command_ProfilerTrace(EventArgs& args)
+{
+	if (g_theProfiler == nullptr)
+		return false;
+
+	std::string filePath = args.GetValue("file", "Profile.json");
+
+	g_theProfiler->ExportChromeTrace(filePath);
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Profiler trace written to %s", filePath.c_str()));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+ScopedProfileZone::ScopedProfileZone(char const* name)
+	: m_name(name)
+{
+	if (g_theProfiler == nullptr)
+		return;
+
+	m_buffer = g_theProfiler->GetThreadBuffer();
+	m_depth = m_buffer->m_depth++;
+	m_startTicks = GetCurrentTimeTicks();
+}
+
+ScopedProfileZone::~ScopedProfileZone()
+{
+	if (m_buffer == nullptr)
+		return;
+
+	m_buffer->m_depth--;
+
+	g_theProfiler->RecordSample(m_buffer, m_name, m_startTicks, m_depth);
+}
+
+#endif
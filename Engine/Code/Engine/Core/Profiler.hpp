@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Game/EngineBuildPreferences.hpp"
+
+#if !defined(ENGINE_DISABLE_PROFILER)
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class NamedStrings;
+
+typedef NamedStrings EventArgs;
+
+constexpr int MAX_PROFILE_COUNTERS = 64;
+
+//------------------------------------------------------------------------------------------------
+struct ProfileSample
+{
+	char const*						m_name					= nullptr;
+	unsigned long long				m_startTicks			= 0;
+	unsigned long long				m_endTicks				= 0;
+	int								m_depth					= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Written only by its owning thread. The profiler reads behind the published write count.
+//------------------------------------------------------------------------------------------------
+struct ProfileThreadBuffer
+{
+	std::string						m_name;
+	unsigned int					m_threadIndex			= 0;
+	std::vector<ProfileSample>		m_samples;
+	std::atomic<unsigned long long>	m_numWritten			= 0;
+	unsigned long long				m_numConsumed			= 0;
+	int								m_depth					= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+struct ProfileZoneStats
+{
+	char const*						m_name					= nullptr;
+	int								m_depth					= 0;
+	unsigned long long				m_firstStartTicks		= 0;
+	unsigned long long				m_ticksThisFrame		= 0;
+	int								m_callsThisFrame		= 0;
+	std::vector<float>				m_frameMilliseconds;
+	int								m_lastCalls				= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+struct ProfileCounter
+{
+	char const*						m_name					= nullptr;
+	std::atomic<long long>			m_valueThisFrame		= 0;
+	long long						m_lastValue				= 0;
+	long long						m_maxValue				= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+struct ProfilerConfig
+{
+	int								m_samplesPerThread		= 1 << 16;
+	int								m_historyFrames			= 240;
+};
+
+//------------------------------------------------------------------------------------------------
+// Hierarchical CPU profiler. Scoped zones are appended to a per-thread ring buffer,
+// folded into per-zone history at EndFrame, and the retained samples can be exported
+// as a Chrome trace.
+//------------------------------------------------------------------------------------------------
+class Profiler
+{
+public:
+	ProfilerConfig						m_config;
+
+	std::mutex							m_threadsMutex;
+	std::vector<ProfileThreadBuffer*>	m_threads;
+
+	std::vector<ProfileSample>			m_sampleSnapshot;
+
+	std::vector<ProfileZoneStats>		m_zones;
+	std::unordered_map<char const*, int> m_zoneIndexByName;
+
+	std::mutex							m_countersMutex;
+	ProfileCounter						m_counters[MAX_PROFILE_COUNTERS];
+	std::atomic<int>					m_numCounters				= 0;
+
+	unsigned long long					m_frameStartTicks			= 0;
+	std::vector<float>					m_frameMilliseconds;
+	int									m_historyIndex				= 0;
+	int									m_numHistoryFrames			= 0;
+public:
+										Profiler(ProfilerConfig const& config);
+										~Profiler();
+
+	void								StartUp();
+	void								ShutDown();
+	void								BeginFrame();
+	void								EndFrame();
+
+	ProfileThreadBuffer*				GetThreadBuffer();
+	void								SetThreadName(char const* name);
+	void								RecordSample(ProfileThreadBuffer* buffer, char const* name, unsigned long long startTicks, int depth);
+
+	int									RegisterCounter(char const* name);
+	void								AddToCounter(int counterIndex, long long amount);
+
+	void								DumpStats() const;
+	bool								ExportChromeTrace(std::string const& filePath);
+
+	static bool							Command_ProfilerDump(EventArgs& args);
+	static bool							Command_ProfilerTrace(EventArgs& args);
+};
+
+//------------------------------------------------------------------------------------------------
+class ScopedProfileZone
+{
+public:
+	ProfileThreadBuffer*				m_buffer					= nullptr;
+	char const*							m_name						= nullptr;
+	unsigned long long					m_startTicks				= 0;
+	int									m_depth						= 0;
+public:
+										ScopedProfileZone(char const* name);
+										~ScopedProfileZone();
+};
+
+extern Profiler* g_theProfiler;
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// name must be a string literal, zones are keyed by pointer
+#define PROFILE_SCOPE(name) ScopedProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_COUNTER(name, amount) do { if (g_theProfiler) { static int s_profileCounterIndex = g_theProfiler->RegisterCounter(name); g_theProfiler->AddToCounter(s_profileCounterIndex, amount); } } while (0)
+#define PROFILE_SET_THREAD_NAME(name) do { if (g_theProfiler) { g_theProfiler->SetThreadName(name); } } while (0)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_COUNTER(name, amount)
+#define PROFILE_SET_THREAD_NAME(name)
+
+#endif
@@ -1,7 +1,8 @@
 #include "Engine/Core/StringUtils.hpp"
 
 #include <stdarg.h>
-#include <sstream>
+#include <charconv>
+#include <cstring>
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
@@ -45,19 +46,28 @@ const std::string Stringf( int maxLength, char const* format, ... )
 
 Strings SplitStringOnDelimiter(std::string const& originalString, char delimiterToSplitOn)
 {
-	std::istringstream ss(originalString);
-	std::string token;
+	// Same results as std::getline: no token for a trailing delimiter or an empty string
 	Strings tokens;
+	size_t position = 0;
 
-	while (std::getline(ss, token, delimiterToSplitOn))
+	while (position < originalString.size())
 	{
-		tokens.push_back(token);
+		size_t end = FindCharacter(originalString, delimiterToSplitOn, position);
+
+		if (end == std::string_view::npos)
+		{
+			tokens.emplace_back(originalString, position);
+			break;
+		}
+
+		tokens.emplace_back(originalString, position, end - position);
+		position = end + 1;
 	}
 
 	return tokens;
 }
 
-Strings SplitStringWithQuotes(std::string const& originalString, char delimiterToSplitOn, bool removeInsideQuotes)
+Strings SplitStringWithQuotes(std::string_view originalString, char delimiterToSplitOn, bool removeInsideQuotes)
 {
     Strings result;
     bool insideQuotes = false;
@@ -147,3 +157,125 @@ int SplitStringOnDelimiter(Strings& outString, std::string const& originalString
 //{
 //	return Strings();
 //}
+
+StringTokenizer::StringTokenizer(std::string_view text, char delimiter, bool skipEmpty)
+	: m_text(text)
+	, m_delimiter(delimiter)
+	, m_skipEmpty(skipEmpty)
+{
+}
+
+bool StringTokenizer::GetNextToken(std::string_view& outToken)
+{
+	// Running one past the end yields the empty token after a trailing delimiter
+	while (m_position <= m_text.size())
+	{
+		size_t end = FindCharacter(m_text, m_delimiter, m_position);
+
+		if (end == std::string_view::npos)
+		{
+			end = m_text.size();
+		}
+
+		outToken = m_text.substr(m_position, end - m_position);
+		m_position = end + 1;
+
+		if (!m_skipEmpty || !outToken.empty())
+			return true;
+	}
+
+	return false;
+}
+
+std::string_view StringTokenizer::GetRemainingText() const
+{
+	if (m_position >= m_text.size())
+		return std::string_view();
+
+	return m_text.substr(m_position);
+}
+
+//-----------------------------------------------------------------------------------------------
+// memchr is vectorised by every CRT we ship on, so this is the one place delimiters get scanned
+//-----------------------------------------------------------------------------------------------
+size_t FindCharacter(std::string_view text, char character, size_t startPosition)
+{
+	if (startPosition >= text.size())
+		return std::string_view::npos;
+
+	void const* found = memchr(text.data() + startPosition, character, text.size() - startPosition);
+
+	if (found == nullptr)
+		return std::string_view::npos;
+
+	return static_cast<size_t>(static_cast<char const*>(found) - text.data());
+}
+
+//-----------------------------------------------------------------------------------------------
+// Pops the first line off text, without its '\n' or '\r\n'. Returns false once text is empty.
+//-----------------------------------------------------------------------------------------------
+bool GetNextLine(std::string_view& text, std::string_view& outLine)
+{
+	if (text.empty())
+		return false;
+
+	size_t end = FindCharacter(text, '\n');
+
+	if (end == std::string_view::npos)
+	{
+		outLine = text;
+		text = std::string_view();
+	}
+	else
+	{
+		outLine = text.substr(0, end);
+		text.remove_prefix(end + 1);
+	}
+
+	if (!outLine.empty() && outLine.back() == '\r')
+	{
+		outLine.remove_suffix(1);
+	}
+
+	return true;
+}
+
+int SplitStringView(std::string_view text, char delimiterToSplitOn, std::string_view* outTokens, int maxTokens, bool skipEmpty)
+{
+	StringTokenizer tokenizer(text, delimiterToSplitOn, skipEmpty);
+
+	int numTokens = 0;
+	std::string_view token;
+
+	while (numTokens < maxTokens && tokenizer.GetNextToken(token))
+	{
+		outTokens[numTokens] = token;
+		numTokens++;
+	}
+
+	return numTokens;
+}
+
+bool ParseInt(std::string_view text, int& outValue)
+{
+	if (!text.empty() && text.front() == '+')
+	{
+		text.remove_prefix(1);
+	}
+
+	std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), outValue);
+
+	return result.ec == std::errc() && result.ptr != text.data();
+}
+
+bool ParseFloat(std::string_view text, float& outValue)
+{
+	if (!text.empty() && text.front() == '+')
+	{
+		text.remove_prefix(1);
+	}
+
+	std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), outValue);
+
+	return result.ec == std::errc() && result.ptr != text.data();
+}
@@ -1,6 +1,7 @@
 #pragma once
 //-----------------------------------------------------------------------------------------------
 #include <string>
+#include <string_view>
 #include <vector>
 
 typedef std::vector<std::string> Strings;
@@ -10,8 +11,31 @@ const std::string Stringf( char const* format, ... );
 const std::string Stringf( int maxLength, char const* format, ... );
 
 Strings SplitStringOnDelimiter(std::string const& originalString, char delimiterToSplitOn);
-Strings SplitStringWithQuotes(std::string const& originalString, char delimiterToSplitOn, bool removeInsideQuotes = false);
+Strings SplitStringWithQuotes(std::string_view originalString, char delimiterToSplitOn, bool removeInsideQuotes = false);
 void TrimString(std::string& originalString, char delimiterToTrim);
 //Strings SplitStringOnDelimiter(std::string const& originalString, char delimiterToSplitOn = ',', bool removeEmpty = false);
 int SplitStringOnDelimiter(Strings& outString, std::string const& originalString, std::string const& delimiterToSplitOn);
-//Strings SplitStringOnDelimiter(std::string const& originalString, std::string const& delimiterToSplitOn, bool removeEmpty = false);
\ No newline at end of file
+//Strings SplitStringOnDelimiter(std::string const& originalString, std::string const& delimiterToSplitOn, bool removeEmpty = false);
+
+//-----------------------------------------------------------------------------------------------
+// Zero-copy tokenizing. Views point into the source text, which must outlive them.
+//-----------------------------------------------------------------------------------------------
+class StringTokenizer
+{
+public:
+	std::string_view	m_text;
+	size_t				m_position		= 0;
+	char				m_delimiter		= ' ';
+	bool				m_skipEmpty		= true;
+public:
+						StringTokenizer(std::string_view text, char delimiter, bool skipEmpty = true);
+
+	bool				GetNextToken(std::string_view& outToken);
+	std::string_view	GetRemainingText() const;
+};
+
+size_t	FindCharacter(std::string_view text, char character, size_t startPosition = 0);
+bool	GetNextLine(std::string_view& text, std::string_view& outLine);
+int		SplitStringView(std::string_view text, char delimiterToSplitOn, std::string_view* outTokens, int maxTokens, bool skipEmpty = true);
+bool	ParseInt(std::string_view text, int& outValue);
+bool	ParseFloat(std::string_view text, float& outValue);
@@ -32,3 +32,22 @@ double GetCurrentTimeSeconds()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Raw performance counter, cheaper than GetCurrentTimeSeconds for timestamps converted later
+//-----------------------------------------------------------------------------------------------
+unsigned long long GetCurrentTimeTicks()
+{
+	LARGE_INTEGER currentCount;
+	QueryPerformanceCounter( &currentCount );
+	return static_cast< unsigned long long >( currentCount.QuadPart );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+double GetSecondsPerTick()
+{
+	static LARGE_INTEGER initialTime;
+	static double secondsPerCount = InitializeTime( initialTime );
+	return secondsPerCount;
+}
+
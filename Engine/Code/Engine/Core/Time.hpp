@@ -6,5 +6,7 @@
 
 //-----------------------------------------------------------------------------------------------
 double GetCurrentTimeSeconds();
+unsigned long long GetCurrentTimeTicks();
+double GetSecondsPerTick();
 
 	
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/FileUtils.hpp"
 
 int ParseXmlAttribute(XmlElement const& element, char const* attributeName, int defaultValue)
 {
@@ -218,3 +219,19 @@ std::string ParseXmlAttribute(XmlElement const& element, char const* attributeNa
 
 	return stringValue;
 }
+
+//------------------------------------------------------------------------------------------------
+// Reads through FileUtils so documents resolve against mounted archives before loose files.
+//------------------------------------------------------------------------------------------------
+XmlError LoadXmlDocument(XmlDocument& outDocument, std::string const& filePath)
+{
+	std::string xmlText;
+	std::string xmlFilePath = filePath;
+
+	if (FileReadToString(xmlText, xmlFilePath) != 0)
+	{
+		return tinyxml2::XML_ERROR_FILE_NOT_FOUND;
+	}
+
+	return outDocument.Parse(xmlText.data(), xmlText.size());
+}
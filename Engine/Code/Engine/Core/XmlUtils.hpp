@@ -28,4 +28,6 @@ EulerAngles						ParseXmlAttribute(XmlElement const& element, char const* attrib
 IntVec2							ParseXmlAttribute(XmlElement const& element, char const* attributeName, IntVec2 const& defaultValue);
 std::string						ParseXmlAttribute(XmlElement const& element, char const* attributeName, std::string const& defaultValue);
 Strings							ParseXmlAttribute(XmlElement const& element, char const* attributeName, Strings const& defaultValues);
-std::string						ParseXmlAttribute(XmlElement const& element, char const* attributeName, char const* defaultValue );
\ No newline at end of file
+std::string						ParseXmlAttribute(XmlElement const& element, char const* attributeName, char const* defaultValue );
+
+XmlError						LoadXmlDocument(XmlDocument& outDocument, std::string const& filePath);
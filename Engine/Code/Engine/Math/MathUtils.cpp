@@ -10,17 +10,18 @@
 #include "Engine/Core/EngineCommon.hpp"
 
 #include <stdio.h>
+#include <emmintrin.h>
 
 float ConvertDegreesToRadians(float degrees)
 {
-	float radians = degrees * (M_PI / 180.0f);
+	float radians = degrees * (PI / 180.0f);
 
 	return radians;
 }
 
 float ConvertRadiansToDegrees(float radians)
 {
-	float degrees = radians * (180.0f / M_PI);
+	float degrees = radians * (180.0f / PI);
 
 	return degrees;
 }
@@ -1175,3 +1176,114 @@ int RoundDownToInt(float value)
 
 	return static_cast<int>(roundedNum);
 }
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+// Octant k covers local yaw [k*45 - 22.5, k*45 + 22.5). The direction is rotated by +22.5 degrees and
+// folded by half turns and quarter turns so the octant falls out of three comparisons, no atan2 needed.
+//----------------------------------------------------------------------------------------------------------------------------------------
+static float const OCTANT_ROTATION_COS = 0.92387953f;
+static float const OCTANT_ROTATION_SIN = 0.38268343f;
+
+int GetOctantForLocalDirection2D(float localX, float localY)
+{
+	float x = localX * OCTANT_ROTATION_COS - localY * OCTANT_ROTATION_SIN;
+	float y = localX * OCTANT_ROTATION_SIN + localY * OCTANT_ROTATION_COS;
+
+	int octant = 0;
+
+	if (y < 0.0f)
+	{
+		x = -x;
+		y = -y;
+		octant += 4;
+	}
+
+	if (x <= 0.0f)
+	{
+		float temp = x;
+		x = y;
+		y = -temp;
+		octant += 2;
+	}
+
+	if (y >= x)
+	{
+		octant += 1;
+	}
+
+	return octant;
+}
+
+float GetOctantYawDegrees(int octant)
+{
+	return (octant < 4) ? 45.0f * (float)octant : 45.0f * (float)octant - 360.0f;
+}
+
+void ComputeViewOctants(float const* positionsX, float const* positionsY, float const* yawCos, float const* yawSin, int count, Vec2 const& viewPosition, unsigned char* out_octants)
+{
+	__m128 const viewX		= _mm_set1_ps(viewPosition.x);
+	__m128 const viewY		= _mm_set1_ps(viewPosition.y);
+	__m128 const rotCos		= _mm_set1_ps(OCTANT_ROTATION_COS);
+	__m128 const rotSin		= _mm_set1_ps(OCTANT_ROTATION_SIN);
+	__m128 const zero		= _mm_setzero_ps();
+	__m128 const signMask	= _mm_set1_ps(-0.0f);
+	__m128i const four		= _mm_set1_epi32(4);
+	__m128i const two		= _mm_set1_epi32(2);
+	__m128i const one		= _mm_set1_epi32(1);
+
+	int index = 0;
+
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 dx = _mm_sub_ps(viewX, _mm_loadu_ps(positionsX + index));
+		__m128 dy = _mm_sub_ps(viewY, _mm_loadu_ps(positionsY + index));
+		__m128 c = _mm_loadu_ps(yawCos + index);
+		__m128 s = _mm_loadu_ps(yawSin + index);
+
+		// Into actor local space
+		__m128 lx = _mm_add_ps(_mm_mul_ps(dx, c), _mm_mul_ps(dy, s));
+		__m128 ly = _mm_sub_ps(_mm_mul_ps(dy, c), _mm_mul_ps(dx, s));
+
+		// Rotate by half an octant
+		__m128 x = _mm_sub_ps(_mm_mul_ps(lx, rotCos), _mm_mul_ps(ly, rotSin));
+		__m128 y = _mm_add_ps(_mm_mul_ps(lx, rotSin), _mm_mul_ps(ly, rotCos));
+
+		// Half turn
+		__m128 mask = _mm_cmplt_ps(y, zero);
+		__m128 flip = _mm_and_ps(mask, signMask);
+		x = _mm_xor_ps(x, flip);
+		y = _mm_xor_ps(y, flip);
+		__m128i octant = _mm_and_si128(_mm_castps_si128(mask), four);
+
+		// Quarter turn
+		mask = _mm_cmple_ps(x, zero);
+		__m128 rotatedX = y;
+		__m128 rotatedY = _mm_xor_ps(x, signMask);
+		x = _mm_or_ps(_mm_and_ps(mask, rotatedX), _mm_andnot_ps(mask, x));
+		y = _mm_or_ps(_mm_and_ps(mask, rotatedY), _mm_andnot_ps(mask, y));
+		octant = _mm_add_epi32(octant, _mm_and_si128(_mm_castps_si128(mask), two));
+
+		// Upper half of the quadrant
+		mask = _mm_cmpge_ps(y, x);
+		octant = _mm_add_epi32(octant, _mm_and_si128(_mm_castps_si128(mask), one));
+
+		alignas(16) int octants[4];
+		_mm_store_si128((__m128i*)octants, octant);
+
+		out_octants[index + 0] = (unsigned char)octants[0];
+		out_octants[index + 1] = (unsigned char)octants[1];
+		out_octants[index + 2] = (unsigned char)octants[2];
+		out_octants[index + 3] = (unsigned char)octants[3];
+	}
+
+	for (; index < count; index++)
+	{
+		float dx = viewPosition.x - positionsX[index];
+		float dy = viewPosition.y - positionsY[index];
+
+		float lx = dx * yawCos[index] + dy * yawSin[index];
+		float ly = dy * yawCos[index] - dx * yawSin[index];
+
+		out_octants[index] = (unsigned char)GetOctantForLocalDirection2D(lx, ly);
+	}
+}
@@ -24,7 +24,7 @@ enum class BillboardType
 	COUNT
 };
 
-constexpr float M_PI = 3.14159f;
+constexpr float PI = 3.14159f;
 
 float			GetClamped(float value, float minValue, float maxValue);
 float			GetClampedZeroToOne(float value);
@@ -104,6 +104,10 @@ Vec3 const		GetNearestPointOnPlane3D(Vec3 const& referencePosition, Plane3D cons
 
 Mat44			GetBillboardMatrix(BillboardType type, Mat44 const& cameraMatrix, Vec3 const& billboardPosition, Vec2 const& billboardScale = Vec2(1.0f, 1.0f));
 
+int				GetOctantForLocalDirection2D(float localX, float localY);
+float			GetOctantYawDegrees(int octant);
+void			ComputeViewOctants(float const* positionsX, float const* positionsY, float const* yawCos, float const* yawSin, int count, Vec2 const& viewPosition, unsigned char* out_octants);
+
 bool			PushDiscOutOfPoint2D(Vec2& mobileDiscCenter, float discRadius, Vec2 const& fixedPoint);
 bool			PushDiscOutOfDisc2D(Vec2& mobileDiscCenter, float mobileDiscRadius, Vec2 const& fixedDiscCenter, float const& fixedDiscRadius);
 bool			PushDiscsOutOfEachOther2D(Vec2& aCenter, float aRadius, Vec2& bCenter, float bRadius);
@@ -56,11 +56,12 @@ void Net::StartUp()
 			return;
 		}
 
-		Strings hostInfo = SplitStringOnDelimiter(m_config.m_hostAddressString, ':');
+		std::string_view hostInfo[2];
+		SplitStringView(m_config.m_hostAddressString, ':', hostInfo, 2, false);
 
 		// Convert the host address
 		IN_ADDR addr;
-		result = inet_pton(AF_INET, hostInfo[0].c_str(), &addr);
+		result = inet_pton(AF_INET, std::string(hostInfo[0]).c_str(), &addr);
 		if (result == 0)
 		{
 			// Log error (Invalid IP address format)
@@ -81,7 +82,9 @@ void Net::StartUp()
 		// Save address and port
 
 		m_hostAddress = ntohl(addr.S_un.S_addr);
-		m_hostPort = (unsigned short)(atoi(hostInfo[1].c_str()));
+		int hostPort = 0;
+		ParseInt(hostInfo[1], hostPort);
+		m_hostPort = (unsigned short)hostPort;
 	}
 	else if (IsServer())
 	{
@@ -118,10 +121,13 @@ void Net::StartUp()
 		}
 
 		// Bind the listen socket to a port
-		Strings hostInfo = SplitStringOnDelimiter(m_config.m_hostAddressString, ':');
+		std::string_view hostInfo[2];
+		SplitStringView(m_config.m_hostAddressString, ':', hostInfo, 2, false);
 
 		m_hostAddress = INADDR_ANY;
-		m_hostPort = (unsigned short)(atoi(hostInfo[1].c_str()));
+		int hostPort = 0;
+		ParseInt(hostInfo[1], hostPort);
+		m_hostPort = (unsigned short)hostPort;
 
 		sockaddr_in addr = {};
 		addr.sin_family = AF_INET;
@@ -494,8 +494,8 @@ void DX11Renderer::StartUp()
 
 	m_deviceContext->OMSetDepthStencilState(m_depthStencilState, 0);
 
-	Image* image = new Image(IntVec2(2, 2), Rgba8::WHITE);
-	m_defaultTexture = CreateTextureFromImage(*image);
+	Image image(IntVec2(2, 2), Rgba8::WHITE);
+	m_defaultTexture = CreateTextureFromImage(image);
 	BindTexture();
 
 	m_defaultShader = CreateShader("Default", VertexType::PCU);
@@ -660,9 +660,9 @@ Texture* DX11Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
 
 Texture* DX11Renderer::CreateTextureFromFile(char const* imageFilePath)
 {
-	Image* image = new Image(imageFilePath);
+	Image image(imageFilePath);
 
-	Texture* newTexture = CreateTextureFromImage(*image);
+	Texture* newTexture = CreateTextureFromImage(image);
 
 	m_loadedTextures.push_back(newTexture);
 	return newTexture;
@@ -1190,7 +1190,7 @@ void DX11Renderer::SetDirectionalLightConstants(Vec3 sunDirection, float sunInte
 	BindConstantBuffer(k_directionalLightConstantSlot, m_directionalLightCBO);
 }
 
-void DX11Renderer::SetPointLightConstants(std::vector<Vec3> pointPosition, std::vector<Rgba8> pointColor)
+void DX11Renderer::SetPointLightConstants(std::vector<Vec3> const& pointPosition, std::vector<Rgba8> const& pointColor)
 {
 	PointLightConstants lightConstants[10];
 
@@ -1207,7 +1207,7 @@ void DX11Renderer::SetPointLightConstants(std::vector<Vec3> pointPosition, std::
 	BindConstantBuffer(k_pointLightConstantSlot, m_pointLightCBO);
 }
 
-void DX11Renderer::SetSpotLightConstants(std::vector<Vec3> spotLightPosition, std::vector<float> cutOff, std::vector<Vec3> spotLightDirection, std::vector<Rgba8> spotColor)
+void DX11Renderer::SetSpotLightConstants(std::vector<Vec3> const& spotLightPosition, std::vector<float> const& cutOff, std::vector<Vec3> const& spotLightDirection, std::vector<Rgba8> const& spotColor)
 {
 	SpotLightConstants spotLightConstants[2];
 
@@ -1597,9 +1597,14 @@ void DX11Renderer::DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexe
 }
 
 void DX11Renderer::DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, std::vector<unsigned int> const& indices)
+{
+	DrawVertexArrayIndexed(numVertexes, vertexes, (int)indices.size(), indices.data());
+}
+
+void DX11Renderer::DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes)
 {
 	CopyCPUToGPU(vertexes, numVertexes * 60, m_immediateVBO);
-	CopyCPUToGPU(indices.data(), indices.size() * sizeof(unsigned int), m_immediateIBO);
+	CopyCPUToGPU(indexes, numIndexes * sizeof(unsigned int), m_immediateIBO);
 
 	DrawVertexBufferIndexed(m_immediateVBO, m_immediateIBO, 60);
 }
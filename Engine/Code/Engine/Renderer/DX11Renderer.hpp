@@ -159,8 +159,8 @@ public:
 
 	void			SetModelConstants(Mat44 const& modelMatrix = Mat44(), Rgba8 const& modelColor = Rgba8::WHITE);
 	void			SetDirectionalLightConstants(Vec3 sunDirection, float sunIntensity, float ambientIntensity, Vec3 worldEyePosition, LightDebug lightDebugFlags, float minFalloff, float maxFalloff, float minFalloffMultiplier, float maxFalloffMultiplier);
-	void			SetPointLightConstants(std::vector<Vec3> pointPosition, std::vector<Rgba8> pointColor);
-	void			SetSpotLightConstants(std::vector<Vec3> spotLightPosition, std::vector<float> cutOff, std::vector<Vec3> spotLightDirection, std::vector<Rgba8> spotColor);
+	void			SetPointLightConstants(std::vector<Vec3> const& pointPosition, std::vector<Rgba8> const& pointColor);
+	void			SetSpotLightConstants(std::vector<Vec3> const& spotLightPosition, std::vector<float> const& cutOff, std::vector<Vec3> const& spotLightDirection, std::vector<Rgba8> const& spotColor);
 	void			SetBlurConstants(BlurConstants constants);
 
 	void			SetBlendMode( BlendMode blendMode );
@@ -186,6 +186,7 @@ public:
 	void			DrawVertexArrayIndexed(int numVertexes, Vertex_PCU const* vertexes, std::vector<unsigned int> const& indices);
 	void			DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes);
 	void			DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, std::vector<unsigned int> const& indices);
+	void			DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes);
 public:
 	ID3D11ComputeShader*			m_thresholdCSShader						= nullptr;
 	ID3D11ComputeShader*			m_downsampleCSShader					= nullptr;
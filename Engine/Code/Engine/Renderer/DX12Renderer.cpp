@@ -36,6 +36,7 @@
 #include "ThirdParty/DXC/dxcapi.h"
 
 #include <fstream>
+#include <filesystem>
 
 #define UNUSED(x) (void)x
 #define DELETE_PTR(x) if(x) { delete x; x = nullptr; }
@@ -360,8 +361,8 @@ void DX12Renderer::StartUp()
 
 	//------------------------------------------------------------------------------------
 
-	Image* image = new Image(IntVec2(2, 2), Rgba8::WHITE);
-	m_defaultTexture = CreateTextureFromImage(*image);
+	Image image(IntVec2(2, 2), Rgba8::WHITE);
+	m_defaultTexture = CreateTextureFromImage(image);
 
 	CreateZBufferDescHeap();
 
@@ -584,8 +585,29 @@ void DX12Renderer::SignalAndWait()
 	}
 }
 
+//------------------------------------------------------------------------------------------------
+// Mesh shader models are OBJ files loaded through the meshlet cache next to them, so only the
+// first load parses and meshletizes the source.
+//------------------------------------------------------------------------------------------------
 Model* DX12Renderer::LoadModel(char const* filePath, RootSig pipelineMode)
 {
+	if (pipelineMode == MESH_SHADER_PIPELINE && std::filesystem::path(filePath).extension() == ".obj")
+	{
+		Mat44 transform;
+		std::string cachePath = GetMeshletCachePath(filePath);
+		MeshletCacheKey cacheKey = GetMeshletCacheKey(filePath, transform);
+
+		Model* model = new Model(std::vector<MeshVertex_PCUTBN>(), std::vector<unsigned int>());
+
+		if (!model->InitializeGPUData(cachePath, cacheKey, filePath, transform))
+		{
+			delete model;
+			return nullptr;
+		}
+
+		return model;
+	}
+
 	Assimp::Importer importer;
 
 	aiScene const* scene = importer.ReadFile(filePath,
@@ -766,9 +788,9 @@ Texture* DX12Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
 
 Texture* DX12Renderer::CreateTextureFromFile(char const* imageFilePath)
 {
-	Image* image = new Image(imageFilePath);
+	Image image(imageFilePath);
 
-	Texture* newTexture = CreateTextureFromImage(*image);
+	Texture* newTexture = CreateTextureFromImage(image);
 
 	m_loadedTextures.push_back(newTexture);
 	return newTexture;
@@ -2316,14 +2338,14 @@ void DX12Renderer::SetDirectionalLightConstants(Vec3 sunDirection, float sunInte
 	BindConstantBuffer(rootSigSlot, m_directionalLightCBO, rootSig);
 }
 
-void DX12Renderer::SetPointLightConstants(std::vector<Vec3> pointPosition, std::vector<Rgba8> pointColor)
+void DX12Renderer::SetPointLightConstants(std::vector<Vec3> const& pointPosition, std::vector<Rgba8> const& pointColor)
 {
 	UNUSED(pointPosition);
 	UNUSED(pointColor);
 
 }
 
-void DX12Renderer::SetSpotLightConstants(std::vector<Vec3> spotLightPosition, std::vector<float> cutOff, std::vector<Vec3> spotLightDirection, std::vector<Rgba8> spotColor)
+void DX12Renderer::SetSpotLightConstants(std::vector<Vec3> const& spotLightPosition, std::vector<float> const& cutOff, std::vector<Vec3> const& spotLightDirection, std::vector<Rgba8> const& spotColor)
 {
 	UNUSED(spotLightPosition);
 	UNUSED(cutOff);
@@ -4272,6 +4294,14 @@ void DX12Renderer::DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const*
 	UNUSED(indices);
 }
 
+void DX12Renderer::DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+	UNUSED(numVertexes);
+	UNUSED(vertexes);
+	UNUSED(numIndexes);
+	UNUSED(indexes);
+}
+
 void DX12Renderer::DrawMesh(int numOfMeshlets, uint32_t isSecondPass)
 {
 	//if (isSecondPass)
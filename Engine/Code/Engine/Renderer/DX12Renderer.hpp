@@ -413,8 +413,8 @@ public:
 	void									SetModelConstants(RootSig pipelineMode, int rootSigSlot = 0, Mat44 const& modelMatrix = Mat44(), Rgba8 const& modelColor = Rgba8::WHITE, ConstantBuffer* modelCBO = nullptr);
 	void									SetModelConstants(std::vector<Mat44> const& modelMatrix, std::vector<Rgba8> const& modelColor); // TODO: FLesh out multi model constants data system
 	void									SetDirectionalLightConstants(Vec3 sunDirection, float sunIntensity, float ambientIntensity, int rootSigSlot = 0, RootSig rootSig = RootSig::DEFAULT_PIPELINE);
-	void									SetPointLightConstants(std::vector<Vec3> pointPosition, std::vector<Rgba8> pointColor);
-	void									SetSpotLightConstants(std::vector<Vec3> spotLightPosition, std::vector<float> cutOff, std::vector<Vec3> spotLightDirection, std::vector<Rgba8> spotColor);
+	void									SetPointLightConstants(std::vector<Vec3> const& pointPosition, std::vector<Rgba8> const& pointColor);
+	void									SetSpotLightConstants(std::vector<Vec3> const& spotLightPosition, std::vector<float> const& cutOff, std::vector<Vec3> const& spotLightDirection, std::vector<Rgba8> const& spotColor);
 	void									SetMeshletDebugConstants(ProfilerConstants debugConstants);
 	void									SetSecondPassConstants(int isSecondPass);
 
@@ -456,6 +456,7 @@ public:
 	void									DrawVertexArrayIndexed(int numVertexes, Vertex_PCU const* vertexes, std::vector<unsigned int> const& indices);
 	void									DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes);
 	void									DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, std::vector<unsigned int> const& indices);
+	void									DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes);
 	void									DrawMesh(int numOfMeshlets, uint32_t isSecondPass);
 
 	void									DispatchComputeShader();
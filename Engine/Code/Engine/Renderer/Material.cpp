@@ -29,7 +29,7 @@ bool Material::Load(std::string const& xmlFilename)
 {
 	tinyxml2::XMLDocument document;
 	
-	if (document.LoadFile(xmlFilename.c_str()) == tinyxml2::XML_SUCCESS)
+	if (LoadXmlDocument(document, xmlFilename) == tinyxml2::XML_SUCCESS)
 	{
 		// Get the root element 
 		tinyxml2::XMLElement* rootElement = document.RootElement();
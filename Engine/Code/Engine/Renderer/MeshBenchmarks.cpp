@@ -0,0 +1,1634 @@
+#include "Engine/Renderer/MeshBenchmarks.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/MeshVertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Renderer/MeshLOD.hpp"
+#include "Engine/Renderer/MeshProcessing.hpp"
+#include "Engine/Renderer/MeshletCuller.hpp"
+#include "Engine/Renderer/MeshletCache.hpp"
+#include "Engine/Renderer/ObjLoader.hpp"
+#include "Engine/Renderer/VertexQuantization.hpp"
+
+#include "ThirdParty/Meshoptimizer/src/meshoptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <string.h>
+#include <thread>
+#include <unordered_map>
+
+extern DevConsole* g_theConsole;
+
+//------------------------------------------------------------------------------------------------
+// The pre-lookup remap: primitives held mesh vertex indices and were rewritten by scanning every
+// unique vertex against every primitive, then appended one at a time. Kept for the benchmark.
+//------------------------------------------------------------------------------------------------
+static void LegacyRemapAndFlattenMeshlets(std::vector<InlineMeshlet>& inlineMeshlets, std::vector<uint32_t>& outUniqueVertexIndices, std::vector<PackedPrimitive>& outPrimitiveIndices)
+{
+	for (size_t i = 0; i < inlineMeshlets.size(); i++)
+	{
+		for (uint32_t k = 0; k < inlineMeshlets[i].m_uniqueVertexIndices.size(); k++)
+		{
+			for (size_t j = 0; j < inlineMeshlets[i].m_primitiveIndices.size(); j++)
+			{
+				if (inlineMeshlets[i].m_primitiveIndices[j].m_i0 == inlineMeshlets[i].m_uniqueVertexIndices[k])
+				{
+					inlineMeshlets[i].m_primitiveIndices[j].m_i0 = k;
+				}
+
+				if (inlineMeshlets[i].m_primitiveIndices[j].m_i1 == inlineMeshlets[i].m_uniqueVertexIndices[k])
+				{
+					inlineMeshlets[i].m_primitiveIndices[j].m_i1 = k;
+				}
+
+				if (inlineMeshlets[i].m_primitiveIndices[j].m_i2 == inlineMeshlets[i].m_uniqueVertexIndices[k])
+				{
+					inlineMeshlets[i].m_primitiveIndices[j].m_i2 = k;
+				}
+			}
+		}
+	}
+
+	for (size_t j = 0; j < inlineMeshlets.size(); j++)
+	{
+		for (size_t i = 0; i < inlineMeshlets[j].m_uniqueVertexIndices.size(); i++)
+		{
+			outUniqueVertexIndices.push_back(inlineMeshlets[j].m_uniqueVertexIndices[i]);
+		}
+
+		for (size_t i = 0; i < inlineMeshlets[j].m_primitiveIndices.size(); i++)
+		{
+			outPrimitiveIndices.push_back(inlineMeshlets[j].m_primitiveIndices[i]);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+struct MeshletBenchmarkMesh
+{
+	std::string							m_name;
+	std::vector<MeshVertex_PCUTBN>		m_vertices;
+	std::vector<uint32_t>				m_indices;
+};
+
+//------------------------------------------------------------------------------------------------
+struct MeshletBenchmarkResult
+{
+	double								m_buildSeconds			= 0.0;
+	size_t								m_numMeshlets			= 0;
+	double								m_verticesPerMeshlet	= 0.0;
+	double								m_trianglesPerMeshlet	= 0.0;
+	double								m_cullableConeFraction	= 0.0;
+	double								m_averageConeCutoff		= 0.0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Cone tightness is the quantized cutoff in m_normalCone[3] (the sine of the normal cone's half
+// angle): lower is tighter. A cutoff of 255 can never cull, so it counts as not cullable.
+//------------------------------------------------------------------------------------------------
+static void MeasureMeshletQuality(Mesh const& mesh, MeshletBenchmarkResult& outResult)
+{
+	size_t numVertices = 0;
+	size_t numTriangles = 0;
+	size_t numCullableCones = 0;
+	double coneCutoffSum = 0.0;
+
+	for (Meshlet const& meshlet : mesh.m_meshlets)
+	{
+		numVertices += meshlet.m_vertexCount;
+		numTriangles += meshlet.m_primitiveCount;
+	}
+
+	for (CullData const& cullData : mesh.m_cullData)
+	{
+		if (cullData.m_normalCone[3] < 255)
+		{
+			numCullableCones++;
+			coneCutoffSum += (double)cullData.m_normalCone[3] / 255.0;
+		}
+	}
+
+	size_t numMeshlets = mesh.m_meshlets.size();
+
+	outResult.m_numMeshlets = numMeshlets;
+	outResult.m_verticesPerMeshlet = numMeshlets > 0 ? (double)numVertices / (double)numMeshlets : 0.0;
+	outResult.m_trianglesPerMeshlet = numMeshlets > 0 ? (double)numTriangles / (double)numMeshlets : 0.0;
+	outResult.m_cullableConeFraction = numMeshlets > 0 ? (double)numCullableCones / (double)numMeshlets : 0.0;
+	outResult.m_averageConeCutoff = numCullableCones > 0 ? coneCutoffSum / (double)numCullableCones : 0.0;
+}
+
+//------------------------------------------------------------------------------------------------
+static std::string GetMeshletQualityString(MeshletBenchmarkResult const& result)
+{
+	return Stringf("%6d meshlets  %5.1f verts  %5.1f tris  %5.1f%% cullable  cutoff %.3f", (int)result.m_numMeshlets, result.m_verticesPerMeshlet, result.m_trianglesPerMeshlet,
+		result.m_cullableConeFraction * 100.0, result.m_averageConeCutoff);
+}
+
+//------------------------------------------------------------------------------------------------
+// MeshletBenchmark directory=Data/Models iterations=3 rings=512
+// Meshletizes every OBJ in the directory (or a generated sphere when there are none; 512 rings
+// is about a million triangles) serially and on the JobSystem, timing ComputeMeshlets plus
+// ComputeMeshletCullData and comparing meshlet quality. The remap/flatten step is also timed
+// against the legacy nested-loop remap on the same meshlets.
+//------------------------------------------------------------------------------------------------
+bool Command_MeshletBenchmark(EventArgs& args)
+{
+	std::string directory = args.GetValue("directory", std::string("Data/Models"));
+	int iterations = args.GetValue("iterations", 3);
+	int numRings = args.GetValue("rings", 512);
+
+	if (iterations < 1)
+	{
+		iterations = 1;
+	}
+
+	std::vector<MeshletBenchmarkMesh> meshes;
+	std::error_code errorCode;
+
+	for (std::filesystem::directory_iterator fileIter(directory, errorCode), endIter; fileIter != endIter; fileIter.increment(errorCode))
+	{
+		if (errorCode)
+		{
+			break;
+		}
+
+		if (!fileIter->is_regular_file() || fileIter->path().extension() != ".obj")
+		{
+			continue;
+		}
+
+		Mesh objMesh;
+
+		if (!LoadMeshFromObj(fileIter->path().generic_string(), Mat44(), objMesh))
+		{
+			continue;
+		}
+
+		MeshletBenchmarkMesh mesh;
+		mesh.m_name = fileIter->path().filename().generic_string();
+		mesh.m_vertices = std::move(objMesh.m_meshVertices);
+		mesh.m_indices = std::move(objMesh.m_indices);
+
+		meshes.push_back(std::move(mesh));
+	}
+
+	if (meshes.empty())
+	{
+		MeshletBenchmarkMesh sphere;
+		sphere.m_name = Stringf("sphere %dx%d", numRings, numRings * 2);
+		BuildBenchmarkSphere(numRings, numRings * 2, sphere.m_vertices, sphere.m_indices);
+		meshes.push_back(std::move(sphere));
+	}
+
+	size_t totalTriangles = 0;
+	double totalSerialSeconds = 0.0;
+	double totalParallelSeconds = 0.0;
+	double totalRemapSeconds = 0.0;
+	double totalLegacyRemapSeconds = 0.0;
+
+	for (MeshletBenchmarkMesh const& benchmarkMesh : meshes)
+	{
+		MeshletBenchmarkResult serialResult;
+		MeshletBenchmarkResult parallelResult;
+		double remapSeconds = 0.0;
+		double legacyRemapSeconds = 0.0;
+
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			for (int pass = 0; pass < 2; pass++)
+			{
+				bool useJobSystem = pass == 1;
+				MeshletBenchmarkResult& result = useJobSystem ? parallelResult : serialResult;
+
+				Mesh mesh;
+				mesh.m_meshVertices = benchmarkMesh.m_vertices;
+				mesh.m_indices = benchmarkMesh.m_indices;
+
+				double startTime = GetCurrentTimeSeconds();
+				mesh.ComputeMeshlets(useJobSystem);
+				mesh.m_cullData = mesh.ComputeMeshletCullData();
+				result.m_buildSeconds += GetCurrentTimeSeconds() - startTime;
+
+				MeasureMeshletQuality(mesh, result);
+
+				if (!useJobSystem)
+				{
+					continue;
+				}
+
+				startTime = GetCurrentTimeSeconds();
+				mesh.FlattenMeshlets();
+				remapSeconds += GetCurrentTimeSeconds() - startTime;
+
+				std::vector<InlineMeshlet> legacyMeshlets = mesh.m_inlineMeshlets;
+
+				for (InlineMeshlet& legacyMeshlet : legacyMeshlets)
+				{
+					for (PackedPrimitive& primitive : legacyMeshlet.m_primitiveIndices)
+					{
+						primitive.m_i0 = legacyMeshlet.m_uniqueVertexIndices[primitive.m_i0];
+						primitive.m_i1 = legacyMeshlet.m_uniqueVertexIndices[primitive.m_i1];
+						primitive.m_i2 = legacyMeshlet.m_uniqueVertexIndices[primitive.m_i2];
+					}
+				}
+
+				std::vector<uint32_t> legacyUniqueVertexIndices;
+				std::vector<PackedPrimitive> legacyPrimitiveIndices;
+
+				startTime = GetCurrentTimeSeconds();
+				LegacyRemapAndFlattenMeshlets(legacyMeshlets, legacyUniqueVertexIndices, legacyPrimitiveIndices);
+				legacyRemapSeconds += GetCurrentTimeSeconds() - startTime;
+			}
+		}
+
+		size_t numTriangles = benchmarkMesh.m_indices.size() / 3;
+
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-24s %8d tris  serial %8.2f ms  parallel %8.2f ms  (remap %.2f ms, legacy %.2f ms)", benchmarkMesh.m_name.c_str(), (int)numTriangles,
+			serialResult.m_buildSeconds * 1000.0 / (double)iterations, parallelResult.m_buildSeconds * 1000.0 / (double)iterations, remapSeconds * 1000.0 / (double)iterations, legacyRemapSeconds * 1000.0 / (double)iterations));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("    serial   %s", GetMeshletQualityString(serialResult).c_str()));
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("    parallel %s", GetMeshletQualityString(parallelResult).c_str()));
+
+		totalTriangles += numTriangles * (size_t)iterations;
+		totalSerialSeconds += serialResult.m_buildSeconds;
+		totalParallelSeconds += parallelResult.m_buildSeconds;
+		totalRemapSeconds += remapSeconds;
+		totalLegacyRemapSeconds += legacyRemapSeconds;
+	}
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Meshletized %d meshes x %d: serial %.2f MTris/s, parallel %.2f MTris/s (%.1fx)", (int)meshes.size(), iterations,
+		(double)totalTriangles / totalSerialSeconds / 1000000.0, (double)totalTriangles / totalParallelSeconds / 1000000.0, totalSerialSeconds / totalParallelSeconds));
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Remap/flatten per pass: %.2f ms, legacy %.2f ms (%.1fx)", totalRemapSeconds * 1000.0 / (double)iterations, totalLegacyRemapSeconds * 1000.0 / (double)iterations,
+		totalLegacyRemapSeconds / totalRemapSeconds));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+// BuildMeshletCaches directory=Data/Models rings=512
+// Builds or refreshes the cache next to every OBJ in the directory, then times loading it back.
+// With no OBJs, a generated sphere is cached to a temporary file instead so the timing still runs.
+//------------------------------------------------------------------------------------------------
+bool Command_BuildMeshletCaches(EventArgs& args)
+{
+	std::string directory = args.GetValue("directory", std::string("Data/Models"));
+	int numRings = args.GetValue("rings", 512);
+
+	std::vector<std::string> sourcePaths;
+	std::error_code errorCode;
+
+	for (std::filesystem::directory_iterator fileIter(directory, errorCode), endIter; fileIter != endIter; fileIter.increment(errorCode))
+	{
+		if (errorCode)
+		{
+			break;
+		}
+
+		if (fileIter->is_regular_file() && fileIter->path().extension() == ".obj")
+		{
+			sourcePaths.push_back(fileIter->path().generic_string());
+		}
+	}
+
+	bool isGeneratedSphere = sourcePaths.empty();
+
+	if (isGeneratedSphere)
+	{
+		sourcePaths.push_back(Stringf("MeshletCacheSphere%d.obj", numRings));
+	}
+
+	double totalBuildSeconds = 0.0;
+	double totalLoadSeconds = 0.0;
+
+	for (std::string const& sourcePath : sourcePaths)
+	{
+		std::string cachePath = GetMeshletCachePath(sourcePath);
+
+		double startTime = GetCurrentTimeSeconds();
+
+		Mesh mesh;
+		MeshletCacheKey key;
+
+		if (isGeneratedSphere)
+		{
+			BuildBenchmarkSphere(numRings, numRings * 2, mesh.m_meshVertices, mesh.m_indices);
+			key = GetMeshletCacheKey(GetMeshletCacheKey(std::string(), Mat44()), mesh.m_meshVertices.data(), mesh.m_meshVertices.size() * sizeof(MeshVertex_PCUTBN));
+		}
+		else
+		{
+			key = GetMeshletCacheKey(sourcePath, Mat44());
+
+			if (!LoadMeshFromObj(sourcePath, Mat44(), mesh))
+			{
+				g_theConsole->AddLine(DevConsole::WARNING, Stringf("  %s: no triangles, skipped", sourcePath.c_str()));
+				continue;
+			}
+		}
+
+		mesh.ComputeMeshlets();
+		mesh.m_cullData = mesh.ComputeMeshletCullData();
+
+		double buildSeconds = GetCurrentTimeSeconds() - startTime;
+
+		if (!WriteMeshletCache(cachePath, mesh, key))
+		{
+			g_theConsole->AddLine(DevConsole::WARNING, Stringf("  %s: could not write %s", sourcePath.c_str(), cachePath.c_str()));
+			continue;
+		}
+
+		startTime = GetCurrentTimeSeconds();
+
+		MeshletCacheKey loadKey = isGeneratedSphere ? key : GetMeshletCacheKey(sourcePath, Mat44());
+		MeshletCache cache;
+		bool isLoaded = cache.Open(cachePath, loadKey);
+		MeshletData meshletData = cache.GetMeshletData();
+
+		double loadSeconds = GetCurrentTimeSeconds() - startTime;
+
+		if (!isLoaded || meshletData.m_numMeshlets != (uint32_t)mesh.m_meshlets.size() || memcmp(meshletData.m_primitiveIndices, mesh.m_primitiveIndices.data(), mesh.m_primitiveIndices.size() * sizeof(PackedPrimitive)) != 0)
+		{
+			g_theConsole->AddLine(DevConsole::WARNING, Stringf("  %s: cache did not read back correctly", sourcePath.c_str()));
+			continue;
+		}
+
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-32s %7d meshlets  build %9.2f ms  cached load %7.3f ms", sourcePath.c_str(), (int)meshletData.m_numMeshlets, buildSeconds * 1000.0, loadSeconds * 1000.0));
+
+		totalBuildSeconds += buildSeconds;
+		totalLoadSeconds += loadSeconds;
+
+		if (isGeneratedSphere)
+		{
+			cache.Close();
+			std::filesystem::remove(cachePath, errorCode);
+		}
+	}
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Meshlet caches: build %.2f ms, cached load %.3f ms", totalBuildSeconds * 1000.0, totalLoadSeconds * 1000.0));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+static float GetAngleDegreesBetweenDirections(Vec3 const& a, Vec3 const& b)
+{
+	return ConvertRadiansToDegrees(acosf(GetClamped(DotProduct3D(a.GetNormalized(), b.GetNormalized()), -1.0f, 1.0f)));
+}
+
+//------------------------------------------------------------------------------------------------
+// Packs a generated sphere, checks every attribute against its quantisation bound, round-trips the
+// stream through a file, and times packing, unpacking and vertex codec decoding.
+//------------------------------------------------------------------------------------------------
+bool Command_VertexQuantizationBenchmark(EventArgs& args)
+{
+	int numRings = args.GetValue("rings", 512);
+	int numIterations = args.GetValue("iterations", 10);
+
+	if (numRings < 2 || numIterations < 1)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, "VertexQuantizationBenchmark: rings must be at least 2 and iterations at least 1");
+		return false;
+	}
+
+	std::vector<MeshVertex_PCUTBN> vertices;
+	std::vector<uint32_t> indices;
+	BuildBenchmarkSphere(numRings, numRings * 2, vertices, indices);
+
+	meshopt_optimizeVertexFetch(vertices.data(), indices.data(), indices.size(), vertices.data(), vertices.size(), sizeof(MeshVertex_PCUTBN));
+
+	size_t numVertices = vertices.size();
+	AABB3 bounds = GetVertexPositionBounds(vertices.data(), numVertices);
+
+	std::vector<PackedVertex_PCUTBN> packedVertices(numVertices);
+	std::vector<MeshVertex_PCUTBN> unpackedVertices(numVertices);
+	std::vector<PackedVertex_PCUTBN> decodedVertices(numVertices);
+	std::vector<unsigned char> encoded;
+
+	double startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < numIterations; iteration++)
+	{
+		PackVertices(vertices.data(), numVertices, bounds, packedVertices.data());
+	}
+	double packSeconds = (GetCurrentTimeSeconds() - startTime) / (double)numIterations;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < numIterations; iteration++)
+	{
+		UnpackVertices(packedVertices.data(), numVertices, bounds, unpackedVertices.data());
+	}
+	double unpackSeconds = (GetCurrentTimeSeconds() - startTime) / (double)numIterations;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < numIterations; iteration++)
+	{
+		EncodePackedVertices(packedVertices.data(), numVertices, encoded);
+	}
+	double encodeSeconds = (GetCurrentTimeSeconds() - startTime) / (double)numIterations;
+
+	bool isDecoded = true;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < numIterations; iteration++)
+	{
+		isDecoded &= DecodePackedVertices(encoded.data(), encoded.size(), numVertices, decodedVertices.data());
+	}
+	double decodeSeconds = (GetCurrentTimeSeconds() - startTime) / (double)numIterations;
+
+	if (!isDecoded || memcmp(decodedVertices.data(), packedVertices.data(), numVertices * sizeof(PackedVertex_PCUTBN)) != 0)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, "VertexQuantizationBenchmark: vertex codec did not round-trip the packed stream");
+		return false;
+	}
+
+	Vec3 maxPositionError = GetPackedPositionMaxError(bounds);
+	float worstPositionErrorRatio = 0.0f;
+	float worstNormalDegrees = 0.0f;
+	float worstTangentDegrees = 0.0f;
+	float worstBiTangentDegrees = 0.0f;
+	float worstUVError = 0.0f;
+
+	for (size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		MeshVertex_PCUTBN const& original = vertices[vertexIndex];
+		MeshVertex_PCUTBN const& unpacked = unpackedVertices[vertexIndex];
+
+		Vec3 positionError = unpacked.m_position - original.m_position;
+		worstPositionErrorRatio = fmaxf(worstPositionErrorRatio, maxPositionError.x > 0.0f ? fabsf(positionError.x) / maxPositionError.x : 0.0f);
+		worstPositionErrorRatio = fmaxf(worstPositionErrorRatio, maxPositionError.y > 0.0f ? fabsf(positionError.y) / maxPositionError.y : 0.0f);
+		worstPositionErrorRatio = fmaxf(worstPositionErrorRatio, maxPositionError.z > 0.0f ? fabsf(positionError.z) / maxPositionError.z : 0.0f);
+
+		worstNormalDegrees = fmaxf(worstNormalDegrees, GetAngleDegreesBetweenDirections(original.m_normal, unpacked.m_normal));
+		worstTangentDegrees = fmaxf(worstTangentDegrees, GetAngleDegreesBetweenDirections(original.m_tangent, unpacked.m_tangent));
+		worstBiTangentDegrees = fmaxf(worstBiTangentDegrees, GetAngleDegreesBetweenDirections(original.m_biTangent, unpacked.m_biTangent));
+
+		worstUVError = fmaxf(worstUVError, fmaxf(fabsf(unpacked.m_uv.x - original.m_uv.x), fabsf(unpacked.m_uv.y - original.m_uv.y)));
+	}
+
+	std::string streamPath = "VertexQuantizationBenchmark.pvtx";
+	std::vector<PackedVertex_PCUTBN> streamVertices;
+	AABB3 streamBounds;
+
+	bool isStreamValid = WritePackedVertexStream(streamPath, packedVertices.data(), numVertices, bounds)
+		&& ReadPackedVertexStream(streamPath, streamVertices, streamBounds)
+		&& streamVertices.size() == numVertices
+		&& memcmp(streamVertices.data(), packedVertices.data(), numVertices * sizeof(PackedVertex_PCUTBN)) == 0;
+
+	std::error_code errorCode;
+	std::filesystem::remove(streamPath, errorCode);
+
+	double rawBytes = (double)(numVertices * sizeof(MeshVertex_PCUTBN));
+	double packedBytes = (double)(numVertices * sizeof(PackedVertex_PCUTBN));
+	double encodedBytes = (double)encoded.size();
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Vertex quantization: %d vertices, %d iterations", (int)numVertices, numIterations));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  bytes/vertex: MeshVertex_PCUTBN %d, Vertex_PCUTBN %d, packed %d, encoded %.2f (%.1fx smaller than raw)",
+		(int)sizeof(MeshVertex_PCUTBN), (int)sizeof(Vertex_PCUTBN), (int)sizeof(PackedVertex_PCUTBN), encodedBytes / (double)numVertices, rawBytes / encodedBytes));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  max error: position %.3f of bound, normal %.4f deg, tangent %.4f deg, bitangent %.4f deg, uv %.6f",
+		worstPositionErrorRatio, worstNormalDegrees, worstTangentDegrees, worstBiTangentDegrees, worstUVError));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  pack %.2f ms, unpack %.2f ms (%.1f Mverts/s), encode %.2f ms",
+		packSeconds * 1000.0, unpackSeconds * 1000.0, (double)numVertices / unpackSeconds * 1e-6, encodeSeconds * 1000.0));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  codec decode %.2f ms: %.1f Mverts/s, %.0f MB/s out, %.0f MB/s in",
+		decodeSeconds * 1000.0, (double)numVertices / decodeSeconds * 1e-6, packedBytes / decodeSeconds / (1024.0 * 1024.0), encodedBytes / decodeSeconds / (1024.0 * 1024.0)));
+
+	if (!isStreamValid)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, "  packed vertex stream file did not read back correctly");
+	}
+
+	bool isWithinBounds = worstPositionErrorRatio <= 1.01f && worstNormalDegrees < 0.05f && worstTangentDegrees < 0.05f && worstBiTangentDegrees < 0.05f;
+
+	if (!isWithinBounds)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, "  quantization error exceeded its expected bound");
+	}
+
+	return isStreamValid && isWithinBounds;
+}
+
+//------------------------------------------------------------------------------------------------
+// MeshLODBenchmark directory=Data/Models rings=256 levels=5 ratio=0.5 maxError=0.02 instances=100000 fov=60 height=1080 pixelError=1
+// Builds an LOD chain for every OBJ in the directory (or a generated sphere when there are none)
+// and reports triangles, error, simplify and meshletize time per level. The chain is written to
+// the level caches and read back, then instances spread from 1 to 1000 bounding radii away are
+// assigned levels to time SelectMeshLODs.
+//------------------------------------------------------------------------------------------------
+bool Command_MeshLODBenchmark(EventArgs& args)
+{
+	std::string directory = args.GetValue("directory", std::string("Data/Models"));
+	int numRings = args.GetValue("rings", 256);
+	int numInstances = args.GetValue("instances", 100000);
+	float fovDegrees = args.GetValue("fov", 60.0f);
+	float screenHeight = args.GetValue("height", 1080.0f);
+	float maxPixelError = args.GetValue("pixelError", 1.0f);
+
+	MeshLODConfig config;
+	config.m_numLevels = args.GetValue("levels", config.m_numLevels);
+	config.m_triangleRatio = args.GetValue("ratio", config.m_triangleRatio);
+	config.m_maxError = args.GetValue("maxError", config.m_maxError);
+
+	std::vector<std::string> sourcePaths;
+	std::error_code errorCode;
+
+	for (std::filesystem::directory_iterator fileIter(directory, errorCode), endIter; fileIter != endIter; fileIter.increment(errorCode))
+	{
+		if (errorCode)
+		{
+			break;
+		}
+
+		if (fileIter->is_regular_file() && fileIter->path().extension() == ".obj")
+		{
+			sourcePaths.push_back(fileIter->path().generic_string());
+		}
+	}
+
+	bool isGeneratedSphere = sourcePaths.empty();
+
+	if (isGeneratedSphere)
+	{
+		sourcePaths.push_back(Stringf("MeshLODSphere%d.obj", numRings));
+	}
+
+	float projectionScale = GetMeshLODProjectionScale(fovDegrees, screenHeight);
+	bool isMatching = true;
+
+	for (std::string const& sourcePath : sourcePaths)
+	{
+		Mesh sourceMesh;
+		MeshletCacheKey sourceKey;
+
+		if (isGeneratedSphere)
+		{
+			BuildBenchmarkSphere(numRings, numRings * 2, sourceMesh.m_meshVertices, sourceMesh.m_indices);
+			sourceKey = GetMeshletCacheKey(GetMeshletCacheKey(std::string(), Mat44()), sourceMesh.m_meshVertices.data(), sourceMesh.m_meshVertices.size() * sizeof(MeshVertex_PCUTBN));
+		}
+		else
+		{
+			sourceKey = GetMeshletCacheKey(sourcePath, Mat44());
+
+			if (!LoadMeshFromObj(sourcePath, Mat44(), sourceMesh))
+			{
+				g_theConsole->AddLine(DevConsole::WARNING, Stringf("  %s: no triangles, skipped", sourcePath.c_str()));
+				continue;
+			}
+		}
+
+		MeshLODChain chain;
+		BuildMeshLODChain(sourceMesh.m_meshVertices, sourceMesh.m_indices, config, chain);
+		ComputeMeshLODMeshlets(chain);
+
+		g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("MeshLODBenchmark: %s, %d levels, bounding radius %.3f", sourcePath.c_str(), (int)chain.m_levels.size(), chain.m_bounds.m_radius));
+
+		double totalSimplifySeconds = 0.0;
+
+		for (int level = 0; level < (int)chain.m_levels.size(); level++)
+		{
+			MeshLODLevel const& lodLevel = chain.m_levels[level];
+			totalSimplifySeconds += lodLevel.m_simplifySeconds;
+
+			g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  LOD%d %9d tris (%5.1f%%) %8d verts  error %.5f (%6.3f%% of radius)  simplify %8.2f ms  meshletize %8.2f ms %7d meshlets",
+				level, (int)lodLevel.m_numTriangles, 100.0 * (double)lodLevel.m_numTriangles / (double)chain.m_levels[0].m_numTriangles, (int)lodLevel.m_mesh.m_meshVertices.size(),
+				lodLevel.m_error, 100.0f * lodLevel.m_error / chain.m_bounds.m_radius, lodLevel.m_simplifySeconds * 1000.0, lodLevel.m_meshletizeSeconds * 1000.0, (int)lodLevel.m_mesh.m_meshlets.size()));
+		}
+
+		double startTime = GetCurrentTimeSeconds();
+
+		bool isWritten = WriteMeshLODCaches(sourcePath, sourceKey, config, chain);
+
+		double writeSeconds = GetCurrentTimeSeconds() - startTime;
+
+		startTime = GetCurrentTimeSeconds();
+
+		MeshLODChain cachedChain;
+		bool isRead = isWritten && ReadMeshLODCaches(sourcePath, sourceKey, config, cachedChain);
+
+		double readSeconds = GetCurrentTimeSeconds() - startTime;
+
+		bool isCacheMatching = isRead && cachedChain.m_levels.size() == chain.m_levels.size();
+
+		for (size_t level = 0; isCacheMatching && level < chain.m_levels.size(); level++)
+		{
+			Mesh const& builtMesh = chain.m_levels[level].m_mesh;
+			Mesh const& cachedMesh = cachedChain.m_levels[level].m_mesh;
+
+			isCacheMatching = cachedChain.m_levels[level].m_error == chain.m_levels[level].m_error && cachedMesh.m_meshlets.size() == builtMesh.m_meshlets.size()
+				&& cachedMesh.m_primitiveIndices.size() == builtMesh.m_primitiveIndices.size()
+				&& memcmp(cachedMesh.m_primitiveIndices.data(), builtMesh.m_primitiveIndices.data(), builtMesh.m_primitiveIndices.size() * sizeof(PackedPrimitive)) == 0;
+		}
+
+		isMatching &= isCacheMatching;
+
+		g_theConsole->AddLine(isCacheMatching ? DevConsole::INFO_MINOR : DevConsole::WARNING, Stringf("  simplify total %.2f ms, level caches written in %.2f ms, read back in %.2f ms%s",
+			totalSimplifySeconds * 1000.0, writeSeconds * 1000.0, readSeconds * 1000.0, isCacheMatching ? "" : "  cache did not read back correctly"));
+
+		if (isGeneratedSphere)
+		{
+			for (size_t level = 0; level < chain.m_levels.size(); level++)
+			{
+				std::filesystem::remove(GetMeshLODCachePath(sourcePath, (int)level), errorCode);
+			}
+		}
+
+		// Instances on a spiral, from just outside the bounding sphere out to 1000 radii
+		std::vector<MeshletInstance> instances;
+		instances.resize(std::max(numInstances, 1));
+
+		for (int instanceIndex = 0; instanceIndex < (int)instances.size(); instanceIndex++)
+		{
+			float fraction = (float)instanceIndex / (float)instances.size();
+			float distance = chain.m_bounds.m_radius * (2.0f + 998.0f * fraction * fraction);
+			float angle = 137.5f * (float)instanceIndex;
+
+			MeshletInstance& instance = instances[instanceIndex];
+			instance.InstanceTransform.SetTranslation3D(Vec3(distance * CosDegrees(angle), distance * SinDegrees(angle), 0.0f) - chain.m_bounds.m_center);
+		}
+
+		startTime = GetCurrentTimeSeconds();
+
+		SelectMeshLODs(chain, instances, Vec3::ZERO, projectionScale, maxPixelError);
+
+		double selectSeconds = GetCurrentTimeSeconds() - startTime;
+
+		std::string levelCounts;
+
+		for (size_t level = 0; level < chain.m_levels.size(); level++)
+		{
+			levelCounts += Stringf(" LOD%d %d", (int)level, chain.m_levels[level].m_mesh.m_numOfInstances);
+		}
+
+		g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  selected %d instances in %.2f ms (%.1f ns each) at %.1f px error:%s",
+			(int)instances.size(), selectSeconds * 1000.0, selectSeconds * 1.0e9 / (double)instances.size(), maxPixelError, levelCounts.c_str()));
+	}
+
+	return isMatching;
+}
+
+//------------------------------------------------------------------------------------------------
+// Looks along the yawed and pitched +X axis with Z up. Plane normals point into the frustum and
+// every plane satisfies dot(normal, p) + distance = 0 for points p on it.
+//------------------------------------------------------------------------------------------------
+static Frustum MakeMeshletCullFrustum(Vec3 const& position, float yawDegrees, float pitchDegrees, float fovDegrees, float aspect, float nearDistance, float farDistance)
+{
+	Mat44 orientation = Mat44::CreateZRotationDegrees(yawDegrees);
+	orientation.AppendYRotation(-pitchDegrees);
+
+	float tanHalfVertical = TanDegrees(fovDegrees * 0.5f);
+	float tanHalfHorizontal = tanHalfVertical * aspect;
+
+	Vec3 forward = orientation.TransformVectorQuantity3D(Vec3(1.0f, 0.0f, 0.0f));
+
+	Frustum frustum;
+
+	frustum.m_nearPlane.m_normal = forward;
+	frustum.m_nearPlane.m_distanceFromOriginAlongNormal = -DotProduct3D(forward, position + forward * nearDistance);
+
+	frustum.m_farPlane.m_normal = forward * -1.0f;
+	frustum.m_farPlane.m_distanceFromOriginAlongNormal = DotProduct3D(forward, position + forward * farDistance);
+
+	Vec3 sideNormals[4] =
+	{
+		Vec3(tanHalfHorizontal, 1.0f, 0.0f),
+		Vec3(tanHalfHorizontal, -1.0f, 0.0f),
+		Vec3(tanHalfVertical, 0.0f, -1.0f),
+		Vec3(tanHalfVertical, 0.0f, 1.0f)
+	};
+
+	Plane3D* sidePlanes[4] = { &frustum.m_rightPlane, &frustum.m_leftPlane, &frustum.m_topPlane, &frustum.m_bottomPlane };
+
+	for (int sideIndex = 0; sideIndex < 4; sideIndex++)
+	{
+		Vec3 normal = orientation.TransformVectorQuantity3D(sideNormals[sideIndex].GetNormalized());
+
+		sidePlanes[sideIndex]->m_normal = normal;
+		sidePlanes[sideIndex]->m_distanceFromOriginAlongNormal = -DotProduct3D(normal, position);
+	}
+
+	return frustum;
+}
+
+//------------------------------------------------------------------------------------------------
+static CullData MakeMeshletCullTestData(Vec3 const& center, float radius, Vec3 const& axis, float coneCutoff, float apexOffset)
+{
+	CullData cullData;
+	cullData.m_boundingSphere = BoundingSphere(center, radius);
+
+	Vec4 quantizedAxis = QuantizeSNorm(Vec4(axis.x, axis.y, axis.z, 0.0f));
+	cullData.m_normalCone[0] = (uint8_t)quantizedAxis.x;
+	cullData.m_normalCone[1] = (uint8_t)quantizedAxis.y;
+	cullData.m_normalCone[2] = (uint8_t)quantizedAxis.z;
+	cullData.m_normalCone[3] = (uint8_t)ceilf(coneCutoff * 255.0f);
+	cullData.m_apexOffset = apexOffset;
+
+	return cullData;
+}
+
+//------------------------------------------------------------------------------------------------
+static MeshletInstance MakeMeshletCullTestInstance(Vec3 const& position, float zRotationDegrees, float scale)
+{
+	MeshletInstance instance;
+	instance.InstanceTransform.SetTranslation3D(position);
+	instance.InstanceTransform.AppendZRotation(zRotationDegrees);
+	instance.InstanceTransform.AppendScaleUniform3D(scale);
+	instance.InstanceScale = scale;
+
+	return instance;
+}
+
+//------------------------------------------------------------------------------------------------
+static bool AreVisibleMeshletsEqual(std::vector<VisibleMeshlet> const& a, std::vector<VisibleMeshlet> const& b)
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+
+	for (size_t index = 0; index < a.size(); index++)
+	{
+		if (a[index].m_instanceIndex != b[index].m_instanceIndex || a[index].m_meshletIndex != b[index].m_meshletIndex)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+// A culled meshlet is only correct if nothing of it could be seen: every vertex outside one plane,
+// or every triangle facing away from the view position. Checked on the real geometry, with the
+// same winding ComputeNormalConeData uses.
+//------------------------------------------------------------------------------------------------
+static bool IsMeshletCullConservative(Mesh const& mesh, uint32_t meshletIndex, MeshletInstance const& instance, Frustum const& frustum, Vec3 const& cullViewPosition, bool& outWasConeCulled)
+{
+	Meshlet const& meshlet = mesh.m_meshlets[meshletIndex];
+
+	std::vector<Vec3> worldPositions;
+	worldPositions.reserve(meshlet.m_vertexCount);
+
+	for (uint32_t vertexIndex = 0; vertexIndex < meshlet.m_vertexCount; vertexIndex++)
+	{
+		Vec3 const& position = mesh.m_meshVertices[mesh.m_uniqueVertexIndices[meshlet.m_vertexOffset + vertexIndex]].m_position;
+		worldPositions.push_back(instance.InstanceTransform.TransformPosition3D(position));
+	}
+
+	float tolerance = 1.0e-4f * std::max(instance.InstanceScale, 1.0f);
+	float minDoubleArea = 1.0e-6f * instance.InstanceScale * instance.InstanceScale;
+
+	Plane3D const* planes[6] = { &frustum.m_nearPlane, &frustum.m_farPlane, &frustum.m_rightPlane, &frustum.m_leftPlane, &frustum.m_topPlane, &frustum.m_bottomPlane };
+
+	for (int planeIndex = 0; planeIndex < 6; planeIndex++)
+	{
+		bool isAllOutside = true;
+
+		for (Vec3 const& position : worldPositions)
+		{
+			if (DotProduct3D(planes[planeIndex]->m_normal, position) + planes[planeIndex]->m_distanceFromOriginAlongNormal >= tolerance)
+			{
+				isAllOutside = false;
+				break;
+			}
+		}
+
+		if (isAllOutside)
+		{
+			outWasConeCulled = false;
+			return true;
+		}
+	}
+
+	outWasConeCulled = true;
+
+	for (uint32_t primitiveIndex = 0; primitiveIndex < meshlet.m_primitiveCount; primitiveIndex++)
+	{
+		PackedPrimitive const& primitive = mesh.m_primitiveIndices[meshlet.m_primitiveOffset + primitiveIndex];
+
+		Vec3 const& p0 = worldPositions[primitive.m_i0];
+		Vec3 const& p1 = worldPositions[primitive.m_i1];
+		Vec3 const& p2 = worldPositions[primitive.m_i2];
+
+		// Collapsed triangles, like the ones at a sphere's poles, cover no pixels and have no
+		// reliable winding, so they cannot make a cull unsafe
+		Vec3 normal = CrossProduct3D(p1 - p0, p2 - p0);
+		float doubleArea = normal.GetLength();
+
+		if (doubleArea <= minDoubleArea)
+		{
+			continue;
+		}
+
+		if (DotProduct3D(normal / doubleArea, cullViewPosition - p0) > tolerance)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+// MeshletCullTests trials=200
+// Golden-image-free checks of the CPU culler: hand-built meshlets with known answers for each
+// plane, the cone, the apex offset and instance transforms, then random cameras and instances
+// over a meshletized sphere where the SIMD culler must match the reference exactly and every
+// culled meshlet must be provably invisible.
+//------------------------------------------------------------------------------------------------
+bool Command_MeshletCullTests(EventArgs& args)
+{
+	int numTrials = args.GetValue("trials", 200);
+
+	struct MeshletCullTestCase
+	{
+		char const*		m_name;
+		CullData		m_cullData;
+		MeshletInstance	m_instance;
+		bool			m_isVisible;
+	};
+
+	Vec3 const towardViewer(-1.0f, 0.0f, 0.0f);
+	Vec3 const awayFromViewer(1.0f, 0.0f, 0.0f);
+
+	MeshletCullTestCase testCases[] =
+	{
+		{ "in front, facing the viewer",		MakeMeshletCullTestData(Vec3(10.0f, 0.0f, 0.0f), 1.0f, towardViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), true },
+		{ "behind the near plane",				MakeMeshletCullTestData(Vec3(-5.0f, 0.0f, 0.0f), 1.0f, towardViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), false },
+		{ "beyond the far plane",				MakeMeshletCullTestData(Vec3(150.0f, 0.0f, 0.0f), 1.0f, towardViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), false },
+		{ "straddling the far plane",			MakeMeshletCullTestData(Vec3(100.5f, 0.0f, 0.0f), 1.0f, towardViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), true },
+		{ "left of the frustum",				MakeMeshletCullTestData(Vec3(10.0f, 20.0f, 0.0f), 1.0f, towardViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), false },
+		{ "touching the left plane",			MakeMeshletCullTestData(Vec3(10.0f, 11.0f, 0.0f), 1.0f, towardViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), true },
+		{ "right of the frustum",				MakeMeshletCullTestData(Vec3(10.0f, -20.0f, 0.0f), 1.0f, towardViewer, 0.5f, 0.0f),	MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), false },
+		{ "above the frustum",					MakeMeshletCullTestData(Vec3(10.0f, 0.0f, 20.0f), 1.0f, towardViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), false },
+		{ "below the frustum",					MakeMeshletCullTestData(Vec3(10.0f, 0.0f, -20.0f), 1.0f, towardViewer, 0.5f, 0.0f),	MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), false },
+		{ "facing away",						MakeMeshletCullTestData(Vec3(10.0f, 0.0f, 0.0f), 1.0f, awayFromViewer, 0.5f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), false },
+		{ "facing away, degenerate cone",		MakeMeshletCullTestData(Vec3(10.0f, 0.0f, 0.0f), 1.0f, awayFromViewer, 1.0f, 0.0f),		MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), true },
+		{ "facing away, viewer past the apex",	MakeMeshletCullTestData(Vec3(10.0f, 0.0f, 0.0f), 1.0f, awayFromViewer, 0.5f, 20.0f),	MakeMeshletCullTestInstance(Vec3::ZERO, 0.0f, 1.0f), true },
+		{ "facing away, turned side-on",		MakeMeshletCullTestData(Vec3::ZERO, 1.0f, awayFromViewer, 0.5f, 0.0f),					MakeMeshletCullTestInstance(Vec3(10.0f, 0.0f, 0.0f), 90.0f, 1.0f), true },
+		{ "facing away, turned to face",		MakeMeshletCullTestData(Vec3::ZERO, 1.0f, awayFromViewer, 0.5f, 0.0f),					MakeMeshletCullTestInstance(Vec3(10.0f, 0.0f, 0.0f), 180.0f, 1.0f), true },
+		{ "instance moved behind the viewer",	MakeMeshletCullTestData(Vec3::ZERO, 1.0f, towardViewer, 0.5f, 0.0f),					MakeMeshletCullTestInstance(Vec3(-10.0f, 0.0f, 0.0f), 0.0f, 1.0f), false },
+		{ "instance beside the frustum",		MakeMeshletCullTestData(Vec3::ZERO, 1.0f, towardViewer, 0.5f, 0.0f),					MakeMeshletCullTestInstance(Vec3(10.0f, 12.5f, 0.0f), 0.0f, 1.0f), false },
+		{ "scaled instance reaching in",		MakeMeshletCullTestData(Vec3::ZERO, 1.0f, towardViewer, 0.5f, 0.0f),					MakeMeshletCullTestInstance(Vec3(10.0f, 12.5f, 0.0f), 0.0f, 3.0f), true },
+	};
+
+	Frustum frustum = MakeMeshletCullFrustum(Vec3::ZERO, 0.0f, 0.0f, 90.0f, 1.0f, 0.1f, 100.0f);
+
+	int numFailures = 0;
+	int numCases = 0;
+
+	for (MeshletCullTestCase const& testCase : testCases)
+	{
+		numCases++;
+
+		bool isReferenceVisible = IsMeshletVisible(testCase.m_cullData, testCase.m_instance, frustum, Vec3::ZERO);
+
+		MeshletCuller culler;
+		culler.SetCullData(&testCase.m_cullData, 1);
+
+		std::vector<VisibleMeshlet> visibleMeshlets;
+		culler.Cull(&testCase.m_instance, 1, frustum, Vec3::ZERO, visibleMeshlets);
+
+		bool isCullerVisible = !visibleMeshlets.empty();
+
+		if (isReferenceVisible != testCase.m_isVisible || isCullerVisible != testCase.m_isVisible)
+		{
+			numFailures++;
+			g_theConsole->AddLine(DevConsole::WARNING, Stringf("  FAILED %s: expected %s, reference %s, SIMD %s", testCase.m_name,
+				testCase.m_isVisible ? "visible" : "culled", isReferenceVisible ? "visible" : "culled", isCullerVisible ? "visible" : "culled"));
+		}
+	}
+
+	// Random cameras and instances over a real meshletized mesh
+	Mesh mesh;
+	BuildBenchmarkSphere(24, 48, mesh.m_meshVertices, mesh.m_indices);
+	mesh.ComputeMeshlets(false);
+	mesh.m_cullData = mesh.ComputeMeshletCullData();
+
+	uint32_t numMeshlets = (uint32_t)mesh.m_meshlets.size();
+
+	MeshletCuller culler;
+	culler.SetCullData(mesh.m_cullData.data(), numMeshlets);
+
+	RandomNumberGenerator rng;
+
+	size_t numTested = 0;
+	size_t numFrustumCulled = 0;
+	size_t numConeCulled = 0;
+	int numMismatches = 0;
+	int numUnsafeCulls = 0;
+
+	std::vector<VisibleMeshlet> referenceVisible;
+	std::vector<VisibleMeshlet> simdVisible;
+
+	for (int trial = 0; trial < numTrials; trial++)
+	{
+		Vec3 cameraPosition(rng.RollRandomFloatInRange(-6.0f, 6.0f), rng.RollRandomFloatInRange(-6.0f, 6.0f), rng.RollRandomFloatInRange(-6.0f, 6.0f));
+		Frustum trialFrustum = MakeMeshletCullFrustum(cameraPosition, rng.RollRandomFloatInRange(0.0f, 360.0f), rng.RollRandomFloatInRange(-80.0f, 80.0f),
+			rng.RollRandomFloatInRange(30.0f, 100.0f), rng.RollRandomFloatInRange(1.0f, 2.0f), 0.1f, rng.RollRandomFloatInRange(4.0f, 20.0f));
+
+		std::vector<MeshletInstance> instances;
+
+		for (int instanceIndex = 0; instanceIndex < 4; instanceIndex++)
+		{
+			Vec3 position(rng.RollRandomFloatInRange(-4.0f, 4.0f), rng.RollRandomFloatInRange(-4.0f, 4.0f), rng.RollRandomFloatInRange(-4.0f, 4.0f));
+			MeshletInstance instance = MakeMeshletCullTestInstance(position, rng.RollRandomFloatInRange(0.0f, 360.0f), rng.RollRandomFloatInRange(0.5f, 2.0f));
+			instance.InstanceTransform.AppendXRotation(rng.RollRandomFloatInRange(0.0f, 360.0f));
+			instances.push_back(instance);
+		}
+
+		CullMeshletsScalar(mesh.m_cullData.data(), numMeshlets, instances.data(), (uint32_t)instances.size(), trialFrustum, cameraPosition, referenceVisible);
+		culler.Cull(instances.data(), (uint32_t)instances.size(), trialFrustum, cameraPosition, simdVisible);
+
+		if (!AreVisibleMeshletsEqual(referenceVisible, simdVisible))
+		{
+			numMismatches++;
+		}
+
+		size_t visibleIndex = 0;
+
+		for (uint32_t instanceIndex = 0; instanceIndex < (uint32_t)instances.size(); instanceIndex++)
+		{
+			for (uint32_t meshletIndex = 0; meshletIndex < numMeshlets; meshletIndex++)
+			{
+				numTested++;
+
+				if (visibleIndex < referenceVisible.size() && referenceVisible[visibleIndex].m_instanceIndex == instanceIndex && referenceVisible[visibleIndex].m_meshletIndex == meshletIndex)
+				{
+					visibleIndex++;
+					continue;
+				}
+
+				bool wasConeCulled = false;
+
+				if (!IsMeshletCullConservative(mesh, meshletIndex, instances[instanceIndex], trialFrustum, cameraPosition, wasConeCulled))
+				{
+					numUnsafeCulls++;
+				}
+
+				wasConeCulled ? numConeCulled++ : numFrustumCulled++;
+			}
+		}
+	}
+
+	if (numMismatches > 0 || numUnsafeCulls > 0)
+	{
+		numFailures++;
+		g_theConsole->AddLine(DevConsole::WARNING, Stringf("  FAILED random trials: %d SIMD/reference mismatches, %d culled meshlets that could be visible", numMismatches, numUnsafeCulls));
+	}
+
+	g_theConsole->AddLine(numFailures == 0 ? DevConsole::INFO_MAJOR : DevConsole::WARNING, Stringf("MeshletCullTests: %d of %d cases passed; %d random trials over %d meshlets tested %d meshlet instances, %d frustum culled, %d cone culled",
+		numCases + 1 - numFailures, numCases + 1, numTrials, (int)numMeshlets, (int)numTested, (int)numFrustumCulled, (int)numConeCulled));
+
+	return numFailures == 0;
+}
+
+//------------------------------------------------------------------------------------------------
+// MeshletCullBenchmark rings=512 instances=64 iterations=20
+// Culls a meshletized sphere drawn as a ring of instances around a camera looking down +X, with
+// the scalar reference and with MeshletCuller, and reports meshlets tested per second.
+//------------------------------------------------------------------------------------------------
+bool Command_MeshletCullBenchmark(EventArgs& args)
+{
+	int numRings = args.GetValue("rings", 512);
+	int numInstances = std::max(args.GetValue("instances", 64), 1);
+	int iterations = std::max(args.GetValue("iterations", 20), 1);
+
+	Mesh mesh;
+	BuildBenchmarkSphere(numRings, numRings * 2, mesh.m_meshVertices, mesh.m_indices);
+	mesh.ComputeMeshlets();
+	mesh.m_cullData = mesh.ComputeMeshletCullData();
+
+	uint32_t numMeshlets = (uint32_t)mesh.m_meshlets.size();
+
+	std::vector<MeshletInstance> instances;
+
+	for (int instanceIndex = 0; instanceIndex < numInstances; instanceIndex++)
+	{
+		float angle = 360.0f * (float)instanceIndex / (float)numInstances;
+		float distance = 4.0f + 4.0f * (float)(instanceIndex % 4);
+		instances.push_back(MakeMeshletCullTestInstance(Vec3(distance * CosDegrees(angle), distance * SinDegrees(angle), 0.0f), angle, 1.0f));
+	}
+
+	Frustum frustum = MakeMeshletCullFrustum(Vec3::ZERO, 0.0f, 0.0f, 60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+	std::vector<VisibleMeshlet> referenceVisible;
+	std::vector<VisibleMeshlet> simdVisible;
+	referenceVisible.reserve((size_t)numMeshlets * numInstances);
+	simdVisible.reserve((size_t)numMeshlets * numInstances);
+
+	double startTime = GetCurrentTimeSeconds();
+
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		CullMeshletsScalar(mesh.m_cullData.data(), numMeshlets, instances.data(), (uint32_t)instances.size(), frustum, Vec3::ZERO, referenceVisible);
+	}
+
+	double scalarSeconds = (GetCurrentTimeSeconds() - startTime) / (double)iterations;
+
+	MeshletCuller culler;
+	culler.SetCullData(mesh.m_cullData.data(), numMeshlets);
+
+	startTime = GetCurrentTimeSeconds();
+
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		culler.Cull(instances.data(), (uint32_t)instances.size(), frustum, Vec3::ZERO, simdVisible);
+	}
+
+	double simdSeconds = (GetCurrentTimeSeconds() - startTime) / (double)iterations;
+
+	bool isMatching = AreVisibleMeshletsEqual(referenceVisible, simdVisible);
+	double numTested = (double)numMeshlets * (double)numInstances;
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("MeshletCullBenchmark: %d meshlets x %d instances, %d visible (%.1f%%)",
+		(int)numMeshlets, numInstances, (int)simdVisible.size(), 100.0 * (double)simdVisible.size() / numTested));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  scalar reference: %8.3f ms  %8.1f M meshlets/s", scalarSeconds * 1000.0, numTested / scalarSeconds / 1.0e6));
+	g_theConsole->AddLine(isMatching ? DevConsole::INFO_MINOR : DevConsole::WARNING, Stringf("  SSE culler:       %8.3f ms  %8.1f M meshlets/s, %.2fx%s",
+		simdSeconds * 1000.0, numTested / simdSeconds / 1.0e6, scalarSeconds / simdSeconds, isMatching ? "" : "  differs from the reference"));
+
+	return isMatching;
+}
+
+
+//------------------------------------------------------------------------------------------------
+// The line-at-a-time parser ParseObjText replaced: a tokenizer pass per line, a heap-allocated
+// vertex list per face and no reserve. Kept for the benchmark.
+//------------------------------------------------------------------------------------------------
+struct LegacyObjFace
+{
+	std::vector<Vertex> m_vertices;
+	Rgba8 m_color;
+};
+
+static void LegacyParseObjText(std::string_view text, std::vector<Vec3>& positions, std::vector<Vec2>& uvs, std::vector<Vec3>& normals, std::vector<LegacyObjFace>& outFaces)
+{
+	std::unordered_map<std::string, Rgba8> materialLibrary;
+
+	std::string_view remaining = text;
+	std::string_view line;
+
+	while (GetNextLine(remaining, line))
+	{
+		ObjLoader::ParsingMaterialFile(line, materialLibrary);
+	}
+
+	Rgba8 faceColor = Rgba8::WHITE;
+	remaining = text;
+
+	while (GetNextLine(remaining, line))
+	{
+		if (line.size() > 1 && line[0] == 'v' && (line[1] == ' ' || line[1] == 'n'))
+		{
+			std::string_view fields[4];
+			SplitStringView(line, ' ', fields, 4);
+
+			Vec3 value;
+			ParseFloat(fields[1], value.x);
+			ParseFloat(fields[2], value.y);
+			ParseFloat(fields[3], value.z);
+
+			(line[1] == ' ' ? positions : normals).push_back(value);
+		}
+		else if (line.size() > 1 && line[0] == 'v' && line[1] == 't')
+		{
+			std::string_view fields[3];
+			SplitStringView(line, ' ', fields, 3);
+
+			Vec2 uv;
+			ParseFloat(fields[1], uv.x);
+			ParseFloat(fields[2], uv.y);
+
+			uvs.push_back(uv);
+		}
+		else if (line.substr(0, 6) == "usemtl")
+		{
+			std::string_view materialInfo[3];
+			faceColor = SplitStringView(line, ' ', materialInfo, 3) == 2 ? materialLibrary[std::string(materialInfo[1])] : Rgba8::WHITE;
+		}
+		else if (!line.empty() && line[0] == 'f')
+		{
+			StringTokenizer faces(line, ' ');
+			std::string_view faceToken;
+
+			faces.GetNextToken(faceToken);
+
+			LegacyObjFace face;
+
+			while (faces.GetNextToken(faceToken))
+			{
+				std::string_view faceInfo[3];
+				int numParts = SplitStringView(faceToken, '/', faceInfo, 3, false);
+
+				Vertex vert;
+				ParseInt(faceInfo[0], vert.m_v);
+
+				if (numParts > 1 && !ParseInt(faceInfo[1], vert.m_vt))
+				{
+					vert.m_vt = -1;
+				}
+
+				if (numParts > 2 && !ParseInt(faceInfo[2], vert.m_vn))
+				{
+					vert.m_vn = -1;
+				}
+
+				face.m_vertices.push_back(vert);
+			}
+
+			face.m_color = faceColor;
+			outFaces.push_back(face);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Writes a UV sphere as v/vt/vn OBJ text, growing it until the text reaches targetSize bytes
+//------------------------------------------------------------------------------------------------
+static void BuildBenchmarkObjText(size_t targetSize, std::string& outText)
+{
+	int numRings = std::max(2, (int)sqrt((double)targetSize / 330.0));
+	int numSegments = numRings * 2;
+
+	outText.clear();
+	outText.reserve(targetSize + targetSize / 4);
+	outText += "# ObjLoaderBenchmark sphere\n";
+
+	char line[128];
+
+	for (int ring = 0; ring <= numRings; ring++)
+	{
+		for (int segment = 0; segment <= numSegments; segment++)
+		{
+			Vec3 normal = Vec3::MakeFromPolarDegrees(-90.0f + 180.0f * (float)ring / (float)numRings, 360.0f * (float)segment / (float)numSegments, 1.0f);
+			Vec3 position = normal * 25.0f;
+
+			int length = snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn %.6f %.6f %.6f\n",
+				position.x, position.y, position.z, (float)segment / (float)numSegments, (float)ring / (float)numRings, normal.x, normal.y, normal.z);
+			outText.append(line, (size_t)length);
+		}
+	}
+
+	for (int ring = 0; ring < numRings; ring++)
+	{
+		for (int segment = 0; segment < numSegments; segment++)
+		{
+			int bottomLeft = ring * (numSegments + 1) + segment + 1;
+			int topLeft = bottomLeft + numSegments + 1;
+
+			int length = snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n",
+				bottomLeft, bottomLeft, bottomLeft, bottomLeft + 1, bottomLeft + 1, bottomLeft + 1, topLeft + 1, topLeft + 1, topLeft + 1, topLeft, topLeft, topLeft);
+			outText.append(line, (size_t)length);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// ObjLoaderBenchmark sizeMB=200 file=
+// Parses an OBJ with the legacy line parser and with ParseObjText, checks both produce the same
+// data, and times vertex generation. Without a file a generated sphere of sizeMB is used.
+//------------------------------------------------------------------------------------------------
+bool Command_ObjLoaderBenchmark(EventArgs& args)
+{
+	std::string fileName = args.GetValue("file", std::string());
+	int sizeMB = args.GetValue("sizeMB", 200);
+
+	bool isGenerated = fileName.empty();
+
+	if (isGenerated)
+	{
+		if (sizeMB <= 0)
+		{
+			g_theConsole->AddLine(DevConsole::WARNING, "ObjLoaderBenchmark: sizeMB must be positive");
+			return false;
+		}
+
+		std::string objText;
+		BuildBenchmarkObjText((size_t)sizeMB * 1024 * 1024, objText);
+
+		fileName = "ObjLoaderBenchmark.obj";
+		std::vector<unsigned char> buffer(objText.begin(), objText.end());
+		WriteBufferToFile(buffer, fileName);
+	}
+
+	MappedFile objFile;
+
+	if (!objFile.Open(fileName))
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, Stringf("ObjLoaderBenchmark: could not open %s", fileName.c_str()));
+		return false;
+	}
+
+	std::string_view text = objFile.GetText();
+
+	double startTime = GetCurrentTimeSeconds();
+
+	std::vector<Vec3> legacyPositions;
+	std::vector<Vec2> legacyUVs;
+	std::vector<Vec3> legacyNormals;
+	std::vector<LegacyObjFace> legacyFaces;
+	LegacyParseObjText(text, legacyPositions, legacyUVs, legacyNormals, legacyFaces);
+
+	double legacySeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+
+	ObjData objData;
+	ObjLoader::ParseObjText(text, objData);
+
+	double parseSeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+
+	std::vector<Vertex_PCUTBN> vertices;
+	std::vector<unsigned int> indices;
+	ObjLoader::GenerateVerticesAndIndices(objData, vertices, indices);
+
+	double generateSeconds = GetCurrentTimeSeconds() - startTime;
+
+	bool isMatching = legacyPositions.size() == objData.m_positions.size() && legacyUVs.size() == objData.m_uvs.size() && legacyNormals.size() == objData.m_normals.size() && legacyFaces.size() == objData.m_faces.size()
+		&& memcmp(legacyPositions.data(), objData.m_positions.data(), legacyPositions.size() * sizeof(Vec3)) == 0
+		&& memcmp(legacyUVs.data(), objData.m_uvs.data(), legacyUVs.size() * sizeof(Vec2)) == 0
+		&& memcmp(legacyNormals.data(), objData.m_normals.data(), legacyNormals.size() * sizeof(Vec3)) == 0;
+
+	for (size_t faceIndex = 0; isMatching && faceIndex < legacyFaces.size(); faceIndex++)
+	{
+		LegacyObjFace const& legacyFace = legacyFaces[faceIndex];
+		Face const& face = objData.m_faces[faceIndex];
+
+		isMatching = legacyFace.m_vertices.size() == face.m_numVertices && memcmp(&legacyFace.m_color, &face.m_color, sizeof(Rgba8)) == 0;
+
+		for (uint32_t faceVertexIndex = 0; isMatching && faceVertexIndex < face.m_numVertices; faceVertexIndex++)
+		{
+			isMatching = VertexEqual()(legacyFace.m_vertices[faceVertexIndex], objData.m_faceVertices[face.m_firstVertex + faceVertexIndex]);
+		}
+	}
+
+	double megabytes = (double)text.size() / (1024.0 * 1024.0);
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("ObjLoaderBenchmark: %s, %.1f MB, %d faces", fileName.c_str(), megabytes, (int)objData.m_faces.size()));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  legacy line parser: %8.1f ms (%5.0f MB/s)", legacySeconds * 1000.0, megabytes / legacySeconds));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  streaming parser:   %8.1f ms (%5.0f MB/s), %.2fx", parseSeconds * 1000.0, megabytes / parseSeconds, legacySeconds / parseSeconds));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  generate vertices:  %8.1f ms, %d vertices, %d indices", generateSeconds * 1000.0, (int)vertices.size(), (int)indices.size()));
+
+	if (!isMatching)
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, "  streaming parser output differs from the legacy parser");
+	}
+
+	if (isGenerated)
+	{
+		objFile.Close();
+
+		std::error_code errorCode;
+		std::filesystem::remove(fileName, errorCode);
+	}
+
+	return isMatching;
+}
+
+//------------------------------------------------------------------------------------------------
+static bool IsObjDataEqual(ObjData const& a, ObjData const& b)
+{
+	return a.m_hasUVs == b.m_hasUVs && a.m_hasNormals == b.m_hasNormals
+		&& a.m_positions.size() == b.m_positions.size() && a.m_uvs.size() == b.m_uvs.size() && a.m_normals.size() == b.m_normals.size()
+		&& a.m_faceVertices.size() == b.m_faceVertices.size() && a.m_faces.size() == b.m_faces.size()
+		&& memcmp(a.m_positions.data(), b.m_positions.data(), a.m_positions.size() * sizeof(Vec3)) == 0
+		&& memcmp(a.m_uvs.data(), b.m_uvs.data(), a.m_uvs.size() * sizeof(Vec2)) == 0
+		&& memcmp(a.m_normals.data(), b.m_normals.data(), a.m_normals.size() * sizeof(Vec3)) == 0
+		&& memcmp(a.m_faceVertices.data(), b.m_faceVertices.data(), a.m_faceVertices.size() * sizeof(Vertex)) == 0
+		&& memcmp(a.m_faces.data(), b.m_faces.data(), a.m_faces.size() * sizeof(Face)) == 0;
+}
+
+//------------------------------------------------------------------------------------------------
+// ObjParallelBenchmark sizeMB=200 file= maxThreads=16
+// Parses and welds an OBJ serially, then with temporary job systems of 1, 2, 4 ... maxThreads
+// workers, checking every parallel result against the serial one. The engine's job system is
+// restored afterwards. Without a file a generated sphere of sizeMB is used.
+//------------------------------------------------------------------------------------------------
+bool Command_ObjParallelBenchmark(EventArgs& args)
+{
+	std::string fileName = args.GetValue("file", std::string());
+	int sizeMB = args.GetValue("sizeMB", 200);
+	int maxThreads = args.GetValue("maxThreads", 16);
+
+	MappedFile objFile;
+	std::string generatedText;
+	std::string_view text;
+
+	if (fileName.empty())
+	{
+		if (sizeMB <= 0)
+		{
+			g_theConsole->AddLine(DevConsole::WARNING, "ObjParallelBenchmark: sizeMB must be positive");
+			return false;
+		}
+
+		BuildBenchmarkObjText((size_t)sizeMB * 1024 * 1024, generatedText);
+		text = generatedText;
+		fileName = "generated sphere";
+	}
+	else if (objFile.Open(fileName))
+	{
+		text = objFile.GetText();
+	}
+	else
+	{
+		g_theConsole->AddLine(DevConsole::WARNING, Stringf("ObjParallelBenchmark: could not open %s", fileName.c_str()));
+		return false;
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+
+	ObjData serialData;
+	ObjLoader::ParseObjText(text, serialData);
+
+	double serialParseSeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+
+	std::vector<uint32_t> serialUniqueFaceVertices;
+	std::vector<uint32_t> serialFaceVertexRemap;
+	ObjLoader::WeldFaceVertices(serialData, serialUniqueFaceVertices, serialFaceVertexRemap, false);
+
+	double serialWeldSeconds = GetCurrentTimeSeconds() - startTime;
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("ObjParallelBenchmark: %s, %.1f MB, %d face vertices welded to %d, %u hardware threads",
+		fileName.c_str(), (double)text.size() / (1024.0 * 1024.0), (int)serialData.m_faceVertices.size(), (int)serialUniqueFaceVertices.size(), std::thread::hardware_concurrency()));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  serial:     parse %8.1f ms         weld %8.1f ms", serialParseSeconds * 1000.0, serialWeldSeconds * 1000.0));
+
+	JobSystem* engineJobSystem = g_theJobSystem;
+	bool isMatching = true;
+
+	for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+	{
+		JobSystemConfig config;
+		config.m_numOfWorkerThreads = numThreads;
+		g_theJobSystem = new JobSystem(config);
+
+		startTime = GetCurrentTimeSeconds();
+
+		ObjData parallelData;
+		ObjLoader::ParseObjTextParallel(text, parallelData);
+
+		double parseSeconds = GetCurrentTimeSeconds() - startTime;
+
+		startTime = GetCurrentTimeSeconds();
+
+		std::vector<uint32_t> uniqueFaceVertices;
+		std::vector<uint32_t> faceVertexRemap;
+		ObjLoader::WeldFaceVertices(parallelData, uniqueFaceVertices, faceVertexRemap, true);
+
+		double weldSeconds = GetCurrentTimeSeconds() - startTime;
+
+		delete g_theJobSystem;
+		g_theJobSystem = engineJobSystem;
+
+		bool isThreadMatching = IsObjDataEqual(serialData, parallelData) && uniqueFaceVertices == serialUniqueFaceVertices && faceVertexRemap == serialFaceVertexRemap;
+		isMatching &= isThreadMatching;
+
+		g_theConsole->AddLine(isThreadMatching ? DevConsole::INFO_MINOR : DevConsole::WARNING, Stringf("  %2d threads: parse %8.1f ms (%.2fx) weld %8.1f ms (%.2fx)%s",
+			numThreads, parseSeconds * 1000.0, serialParseSeconds / parseSeconds, weldSeconds * 1000.0, serialWeldSeconds / weldSeconds, isThreadMatching ? "" : "  differs from serial"));
+	}
+
+	return isMatching;
+}
+
+//------------------------------------------------------------------------------------------------
+// The hash and container the loader used before VertexWeldTable, kept for VertexWeldBenchmark
+//------------------------------------------------------------------------------------------------
+struct LegacyVertexHash
+{
+	size_t operator()(const Vertex& vertex) const
+	{
+		return std::hash<int>()(vertex.m_v) ^ (std::hash<int>()(vertex.m_vt) << 1) ^ (std::hash<int>()(vertex.m_vn) << 2);
+	}
+};
+
+static size_t s_legacyWeldCurrentBytes = 0;
+static size_t s_legacyWeldPeakBytes = 0;
+
+//------------------------------------------------------------------------------------------------
+// Counts the bytes a container requests, excluding heap bookkeeping, so node-based and flat
+// containers can be compared
+//------------------------------------------------------------------------------------------------
+template <typename ElementType>
+struct LegacyWeldAllocator
+{
+	typedef ElementType value_type;
+
+	LegacyWeldAllocator() = default;
+
+	template <typename OtherType>
+	LegacyWeldAllocator(LegacyWeldAllocator<OtherType> const&) {}
+
+	ElementType* allocate(size_t count)
+	{
+		s_legacyWeldCurrentBytes += count * sizeof(ElementType);
+		s_legacyWeldPeakBytes = std::max(s_legacyWeldPeakBytes, s_legacyWeldCurrentBytes);
+
+		return (ElementType*)::operator new(count * sizeof(ElementType));
+	}
+
+	void deallocate(ElementType* pointer, size_t count)
+	{
+		s_legacyWeldCurrentBytes -= count * sizeof(ElementType);
+		::operator delete(pointer);
+	}
+
+	template <typename OtherType>
+	bool operator==(LegacyWeldAllocator<OtherType> const&) const { return true; }
+
+	template <typename OtherType>
+	bool operator!=(LegacyWeldAllocator<OtherType> const&) const { return false; }
+};
+
+//------------------------------------------------------------------------------------------------
+// Face vertices of a gridSize x gridSize quad grid split into triangles, with v = vt = vn: the
+// sequential index triples a scanned or tessellated mesh produces
+//------------------------------------------------------------------------------------------------
+static void BuildBenchmarkWeldData(size_t targetFaceVertices, ObjData& outData)
+{
+	int gridSize = std::max((int)sqrt((double)targetFaceVertices / 6.0), 1);
+	int rowVertices = gridSize + 1;
+
+	outData = ObjData();
+	outData.m_faceVertices.reserve((size_t)gridSize * gridSize * 6);
+	outData.m_faces.reserve((size_t)gridSize * gridSize * 2);
+
+	for (int y = 0; y < gridSize; y++)
+	{
+		for (int x = 0; x < gridSize; x++)
+		{
+			int corners[4] = { y * rowVertices + x + 1, y * rowVertices + x + 2, (y + 1) * rowVertices + x + 2, (y + 1) * rowVertices + x + 1 };
+			int triangles[2][3] = { { corners[0], corners[1], corners[2] }, { corners[0], corners[2], corners[3] } };
+
+			for (int triangle = 0; triangle < 2; triangle++)
+			{
+				Face face;
+				face.m_firstVertex = (uint32_t)outData.m_faceVertices.size();
+				face.m_numVertices = 3;
+				face.m_color = Rgba8::WHITE;
+				outData.m_faces.push_back(face);
+
+				for (int corner = 0; corner < 3; corner++)
+				{
+					Vertex faceVertex;
+					faceVertex.m_v = triangles[triangle][corner];
+					faceVertex.m_vt = triangles[triangle][corner];
+					faceVertex.m_vn = triangles[triangle][corner];
+					outData.m_faceVertices.push_back(faceVertex);
+				}
+			}
+		}
+	}
+
+	outData.m_hasUVs = true;
+	outData.m_hasNormals = true;
+}
+
+//------------------------------------------------------------------------------------------------
+// VertexWeldBenchmark faceVerticesM=10 file=
+// Welds the face vertices of an OBJ, or of a generated grid of about faceVerticesM million face
+// vertices, with the old VertexHash + std::unordered_map and with VertexWeldTable, reporting time
+// and the peak bytes each dedup container held. Both results are checked against WeldFaceVertices.
+//------------------------------------------------------------------------------------------------
+bool Command_VertexWeldBenchmark(EventArgs& args)
+{
+	std::string fileName = args.GetValue("file", std::string());
+	float faceVerticesM = args.GetValue("faceVerticesM", 10.0f);
+
+	ObjData objData;
+
+	if (fileName.empty())
+	{
+		if (faceVerticesM <= 0.0f)
+		{
+			g_theConsole->AddLine(DevConsole::WARNING, "VertexWeldBenchmark: faceVerticesM must be positive");
+			return false;
+		}
+
+		BuildBenchmarkWeldData((size_t)(faceVerticesM * 1000000.0f), objData);
+		fileName = "generated grid";
+	}
+	else
+	{
+		MappedFile objFile;
+
+		if (!objFile.Open(fileName))
+		{
+			g_theConsole->AddLine(DevConsole::WARNING, Stringf("VertexWeldBenchmark: could not open %s", fileName.c_str()));
+			return false;
+		}
+
+		ObjLoader::ParseObjTextParallel(objFile.GetText(), objData);
+	}
+
+	size_t numFaceVertices = objData.m_faceVertices.size();
+
+	std::vector<uint32_t> expectedUniqueFaceVertices;
+	std::vector<uint32_t> expectedFaceVertexRemap;
+	ObjLoader::WeldFaceVertices(objData, expectedUniqueFaceVertices, expectedFaceVertexRemap, false);
+
+	std::vector<uint32_t> uniqueFaceVertices;
+	std::vector<uint32_t> faceVertexRemap(numFaceVertices);
+
+	// Old path: reserved to the face vertex count, one node allocation per unique vertex
+	double legacySeconds = 0.0;
+	size_t legacyPeakBytes = 0;
+	bool isLegacyMatching = false;
+	{
+		s_legacyWeldCurrentBytes = 0;
+		s_legacyWeldPeakBytes = 0;
+
+		double startTime = GetCurrentTimeSeconds();
+		{
+			std::unordered_map<Vertex, uint32_t, LegacyVertexHash, VertexEqual, LegacyWeldAllocator<std::pair<Vertex const, uint32_t>>> uniqueVertices;
+			uniqueVertices.reserve(numFaceVertices);
+
+			for (size_t faceVertexIndex = 0; faceVertexIndex < numFaceVertices; faceVertexIndex++)
+			{
+				auto insertResult = uniqueVertices.emplace(objData.m_faceVertices[faceVertexIndex], (uint32_t)uniqueFaceVertices.size());
+
+				if (insertResult.second)
+				{
+					uniqueFaceVertices.push_back((uint32_t)faceVertexIndex);
+				}
+
+				faceVertexRemap[faceVertexIndex] = insertResult.first->second;
+			}
+		}
+		legacySeconds = GetCurrentTimeSeconds() - startTime;
+		legacyPeakBytes = s_legacyWeldPeakBytes;
+
+		isLegacyMatching = uniqueFaceVertices == expectedUniqueFaceVertices && faceVertexRemap == expectedFaceVertexRemap;
+	}
+
+	// New path: reserved to the face count, one flat allocation
+	uniqueFaceVertices.clear();
+
+	double tableSeconds = 0.0;
+	size_t tablePeakBytes = 0;
+	bool isTableMatching = false;
+	{
+		double startTime = GetCurrentTimeSeconds();
+		{
+			VertexWeldTable uniqueVertices(objData.m_faces.size());
+			size_t reservedBytes = uniqueVertices.GetMemoryBytes();
+
+			for (size_t faceVertexIndex = 0; faceVertexIndex < numFaceVertices; faceVertexIndex++)
+			{
+				if (faceVertexIndex + OBJ_WELD_PREFETCH_DISTANCE < numFaceVertices)
+				{
+					uniqueVertices.Prefetch(objData.m_faceVertices[faceVertexIndex + OBJ_WELD_PREFETCH_DISTANCE]);
+				}
+
+				uint32_t uniqueIndex = (uint32_t)uniqueFaceVertices.size();
+				uint32_t weldedIndex = uniqueVertices.FindOrInsert(objData.m_faceVertices[faceVertexIndex], uniqueIndex);
+
+				if (weldedIndex == uniqueIndex)
+				{
+					uniqueFaceVertices.push_back((uint32_t)faceVertexIndex);
+				}
+
+				faceVertexRemap[faceVertexIndex] = weldedIndex;
+			}
+
+			// A table that outgrew its reserve briefly held its old slots alongside the doubled ones
+			tablePeakBytes = uniqueVertices.GetMemoryBytes();
+
+			if (tablePeakBytes > reservedBytes)
+			{
+				tablePeakBytes += tablePeakBytes / 2;
+			}
+		}
+		tableSeconds = GetCurrentTimeSeconds() - startTime;
+
+		isTableMatching = uniqueFaceVertices == expectedUniqueFaceVertices && faceVertexRemap == expectedFaceVertexRemap;
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+
+	ObjLoader::WeldFaceVertices(objData, uniqueFaceVertices, faceVertexRemap, true);
+
+	double parallelSeconds = GetCurrentTimeSeconds() - startTime;
+	bool isParallelMatching = uniqueFaceVertices == expectedUniqueFaceVertices && faceVertexRemap == expectedFaceVertexRemap;
+
+	double const bytesPerMB = 1024.0 * 1024.0;
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("VertexWeldBenchmark: %s, %d faces, %d face vertices welded to %d, output arrays %.1f MB",
+		fileName.c_str(), (int)objData.m_faces.size(), (int)numFaceVertices, (int)expectedUniqueFaceVertices.size(),
+		(double)(numFaceVertices + expectedUniqueFaceVertices.size()) * sizeof(uint32_t) / bytesPerMB));
+	g_theConsole->AddLine(isLegacyMatching ? DevConsole::INFO_MINOR : DevConsole::WARNING, Stringf("  unordered_map + old hash: %8.1f ms, peak %7.1f MB%s",
+		legacySeconds * 1000.0, (double)legacyPeakBytes / bytesPerMB, isLegacyMatching ? "" : "  differs"));
+	g_theConsole->AddLine(isTableMatching ? DevConsole::INFO_MINOR : DevConsole::WARNING, Stringf("  VertexWeldTable:          %8.1f ms, peak %7.1f MB, %.2fx faster, %.2fx less memory%s",
+		tableSeconds * 1000.0, (double)tablePeakBytes / bytesPerMB, legacySeconds / tableSeconds, (double)legacyPeakBytes / (double)tablePeakBytes, isTableMatching ? "" : "  differs"));
+	g_theConsole->AddLine(isParallelMatching ? DevConsole::INFO_MINOR : DevConsole::WARNING, Stringf("  WeldFaceVertices on jobs: %8.1f ms%s",
+		parallelSeconds * 1000.0, isParallelMatching ? "" : "  differs"));
+
+	return isLegacyMatching && isTableMatching && isParallelMatching;
+}
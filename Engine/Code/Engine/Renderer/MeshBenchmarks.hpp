@@ -0,0 +1,19 @@
+#pragma once
+
+class NamedStrings;
+
+typedef NamedStrings EventArgs;
+
+//------------------------------------------------------------------------------------------------
+// Console benchmarks for the CPU mesh pipeline. They report through the DevConsole, so they live
+// here rather than next to the code they measure, which stays free of console and window headers.
+//------------------------------------------------------------------------------------------------
+bool		Command_MeshletBenchmark(EventArgs& args);
+bool		Command_BuildMeshletCaches(EventArgs& args);
+bool		Command_VertexQuantizationBenchmark(EventArgs& args);
+bool		Command_MeshLODBenchmark(EventArgs& args);
+bool		Command_MeshletCullTests(EventArgs& args);
+bool		Command_MeshletCullBenchmark(EventArgs& args);
+bool		Command_ObjLoaderBenchmark(EventArgs& args);
+bool		Command_ObjParallelBenchmark(EventArgs& args);
+bool		Command_VertexWeldBenchmark(EventArgs& args);
@@ -0,0 +1,303 @@
+#include "Engine/Renderer/MeshLOD.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "ThirdParty/Meshoptimizer/src/meshoptimizer.h"
+
+#include <algorithm>
+
+//------------------------------------------------------------------------------------------------
+static BoundingSphere ComputeMeshLODBounds(Mesh& levelZeroMesh)
+{
+	std::vector<Vec3> positions;
+	positions.reserve(levelZeroMesh.m_meshVertices.size());
+
+	for (MeshVertex_PCUTBN const& vertex : levelZeroMesh.m_meshVertices)
+	{
+		positions.push_back(vertex.m_position);
+	}
+
+	if (positions.empty())
+	{
+		return BoundingSphere(Vec3::ZERO, 0.0f);
+	}
+
+	return levelZeroMesh.ComputeMinimumBoundingSphere(positions, positions.size());
+}
+
+//------------------------------------------------------------------------------------------------
+// Every level is simplified from the one before it, which is much cheaper than starting from
+// level 0 each time, so the step errors are summed to keep each level's error conservative. The
+// simplifier works on indices into the shared source vertices; each level then gets its own
+// compacted copy of the vertices it uses.
+//------------------------------------------------------------------------------------------------
+void BuildMeshLODChain(std::vector<MeshVertex_PCUTBN> const& vertices, std::vector<uint32_t> const& indices, MeshLODConfig const& config, MeshLODChain& outChain)
+{
+	outChain.m_levels.clear();
+	outChain.m_bounds = BoundingSphere(Vec3::ZERO, 0.0f);
+
+	if (vertices.empty() || indices.size() < 3)
+	{
+		return;
+	}
+
+	int numLevels = std::max(std::min(config.m_numLevels, MAX_MESH_LOD_LEVELS), 1);
+	outChain.m_levels.reserve(numLevels);
+
+	float const* positions = &vertices[0].m_position.x;
+	size_t const vertexStride = sizeof(MeshVertex_PCUTBN);
+	float errorScale = meshopt_simplifyScale(positions, vertices.size(), vertexStride);
+	unsigned int options = config.m_lockBorder ? meshopt_SimplifyLockBorder : 0;
+
+	std::vector<uint32_t> levelIndices(indices.begin(), indices.end() - indices.size() % 3);
+	std::vector<uint32_t> simplifiedIndices(levelIndices.size());
+	float levelError = 0.0f;
+
+	for (int level = 0; level < numLevels; level++)
+	{
+		double simplifySeconds = 0.0;
+
+		if (level > 0)
+		{
+			double startTime = GetCurrentTimeSeconds();
+
+			size_t targetIndexCount = (size_t)((float)(levelIndices.size() / 3) * config.m_triangleRatio) * 3;
+			float stepError = 0.0f;
+			size_t numIndices = meshopt_simplify(simplifiedIndices.data(), levelIndices.data(), levelIndices.size(), positions, vertices.size(), vertexStride, targetIndexCount, config.m_maxError, options, &stepError);
+
+			simplifySeconds = GetCurrentTimeSeconds() - startTime;
+
+			if (numIndices == 0 || (float)numIndices > (float)levelIndices.size() * (1.0f - config.m_minReduction))
+			{
+				break;
+			}
+
+			levelIndices.assign(simplifiedIndices.begin(), simplifiedIndices.begin() + numIndices);
+			levelError += stepError * errorScale;
+		}
+
+		outChain.m_levels.emplace_back();
+
+		MeshLODLevel& lodLevel = outChain.m_levels.back();
+		lodLevel.m_error = levelError;
+		lodLevel.m_numTriangles = (uint32_t)(levelIndices.size() / 3);
+		lodLevel.m_simplifySeconds = simplifySeconds;
+
+		Mesh& levelMesh = lodLevel.m_mesh;
+		levelMesh.m_indices = levelIndices;
+		levelMesh.m_meshVertices.resize(vertices.size());
+
+		size_t numLevelVertices = meshopt_optimizeVertexFetch(levelMesh.m_meshVertices.data(), levelMesh.m_indices.data(), levelMesh.m_indices.size(), vertices.data(), vertices.size(), vertexStride);
+		levelMesh.m_meshVertices.resize(numLevelVertices);
+	}
+
+	outChain.m_bounds = ComputeMeshLODBounds(outChain.m_levels[0].m_mesh);
+}
+
+//------------------------------------------------------------------------------------------------
+void ComputeMeshLODMeshlets(MeshLODChain& chain, bool useJobSystem)
+{
+	for (MeshLODLevel& lodLevel : chain.m_levels)
+	{
+		double startTime = GetCurrentTimeSeconds();
+
+		lodLevel.m_mesh.ComputeMeshlets(useJobSystem);
+		lodLevel.m_mesh.m_cullData = lodLevel.m_mesh.ComputeMeshletCullData();
+
+		lodLevel.m_meshletizeSeconds = GetCurrentTimeSeconds() - startTime;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+MeshletCacheKey GetMeshLODCacheKey(MeshletCacheKey const& sourceKey, MeshLODConfig const& config, int lodLevel)
+{
+	float lodParams[] =
+	{
+		(float)config.m_numLevels,
+		config.m_triangleRatio,
+		config.m_maxError,
+		config.m_minReduction,
+		config.m_lockBorder ? 1.0f : 0.0f,
+		(float)lodLevel
+	};
+
+	return GetMeshletCacheKey(sourceKey, lodParams, sizeof(lodParams));
+}
+
+//------------------------------------------------------------------------------------------------
+// Kept apart from GetMeshletCachePath so a chain's level 0 never overwrites the plain cache
+//------------------------------------------------------------------------------------------------
+std::string GetMeshLODCachePath(std::string const& sourcePath, int lodLevel)
+{
+	return Stringf("%s.lod%d.meshlets", sourcePath.c_str(), lodLevel);
+}
+
+//------------------------------------------------------------------------------------------------
+// Level 0 records the chain length, so a chain that stopped short of m_numLevels is still a hit.
+// Any missing or stale level fails the whole chain.
+//------------------------------------------------------------------------------------------------
+bool ReadMeshLODCaches(std::string const& sourcePath, MeshletCacheKey const& sourceKey, MeshLODConfig const& config, MeshLODChain& outChain)
+{
+	outChain.m_levels.clear();
+
+	MeshletCache cache;
+
+	if (!cache.Open(GetMeshLODCachePath(sourcePath, 0), GetMeshLODCacheKey(sourceKey, config, 0)))
+	{
+		return false;
+	}
+
+	uint32_t numLevels = cache.GetHeader()->m_numLODLevels;
+
+	if (numLevels > (uint32_t)MAX_MESH_LOD_LEVELS)
+	{
+		return false;
+	}
+
+	outChain.m_levels.reserve(numLevels);
+
+	for (uint32_t level = 0; level < numLevels; level++)
+	{
+		if (level > 0 && !cache.Open(GetMeshLODCachePath(sourcePath, level), GetMeshLODCacheKey(sourceKey, config, level)))
+		{
+			outChain.m_levels.clear();
+			return false;
+		}
+
+		MeshletCacheHeader const* header = cache.GetHeader();
+
+		if (header->m_lodLevel != level || header->m_numLODLevels != numLevels)
+		{
+			outChain.m_levels.clear();
+			return false;
+		}
+
+		outChain.m_levels.emplace_back();
+
+		MeshLODLevel& lodLevel = outChain.m_levels.back();
+		cache.CopyToMesh(lodLevel.m_mesh);
+		lodLevel.m_error = header->m_lodError;
+		lodLevel.m_numTriangles = header->m_numPrimitiveIndices;
+	}
+
+	outChain.m_bounds = ComputeMeshLODBounds(outChain.m_levels[0].m_mesh);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+bool WriteMeshLODCaches(std::string const& sourcePath, MeshletCacheKey const& sourceKey, MeshLODConfig const& config, MeshLODChain const& chain)
+{
+	uint32_t numLevels = (uint32_t)chain.m_levels.size();
+
+	for (uint32_t level = 0; level < numLevels; level++)
+	{
+		MeshLODLevel const& lodLevel = chain.m_levels[level];
+
+		if (!WriteMeshletCache(GetMeshLODCachePath(sourcePath, level), lodLevel.m_mesh, GetMeshLODCacheKey(sourceKey, config, level), level, numLevels, lodLevel.m_error))
+		{
+			return false;
+		}
+	}
+
+	return numLevels > 0;
+}
+
+//------------------------------------------------------------------------------------------------
+// Loads every level from its cache when all of them are current; otherwise simplifies and
+// meshletizes the OBJ and rewrites the caches.
+//------------------------------------------------------------------------------------------------
+bool LoadMeshLODChain(std::string const& objPath, Mat44 const& transform, MeshLODConfig const& config, MeshLODChain& outChain, bool useJobSystem)
+{
+	MeshletCacheKey sourceKey = GetMeshletCacheKey(objPath, transform);
+
+	if (ReadMeshLODCaches(objPath, sourceKey, config, outChain))
+	{
+		return true;
+	}
+
+	Mesh sourceMesh;
+
+	if (!LoadMeshFromObj(objPath, transform, sourceMesh, useJobSystem))
+	{
+		return false;
+	}
+
+	BuildMeshLODChain(sourceMesh.m_meshVertices, sourceMesh.m_indices, config, outChain);
+	ComputeMeshLODMeshlets(outChain, useJobSystem);
+	WriteMeshLODCaches(objPath, sourceKey, config, outChain);
+
+	return !outChain.m_levels.empty();
+}
+
+//------------------------------------------------------------------------------------------------
+// Pixels per world unit at distance 1 for a perspective camera
+//------------------------------------------------------------------------------------------------
+float GetMeshLODProjectionScale(float fovDegrees, float screenHeightPixels)
+{
+	return screenHeightPixels / (2.0f * TanDegrees(fovDegrees * 0.5f));
+}
+
+//------------------------------------------------------------------------------------------------
+// Picks the coarsest level whose error, projected at the nearest point of the instance's bounding
+// sphere, is at most maxPixelError. Errors grow with the level, so the first level over budget
+// ends the search. A camera inside the sphere always gets level 0.
+//------------------------------------------------------------------------------------------------
+int SelectMeshLOD(MeshLODChain const& chain, MeshletInstance const& instance, Vec3 const& cameraPosition, float projectionScale, float maxPixelError)
+{
+	Vec3 center = instance.InstanceTransform.TransformPosition3D(chain.m_bounds.m_center);
+	float radius = chain.m_bounds.m_radius * instance.InstanceScale;
+	float distance = GetDistance3D(center, cameraPosition) - radius;
+
+	if (distance <= 0.0f)
+	{
+		return 0;
+	}
+
+	float maxObjectError = maxPixelError * distance / (projectionScale * instance.InstanceScale);
+	int numLevels = (int)chain.m_levels.size();
+	int selectedLevel = 0;
+
+	for (int level = 1; level < numLevels; level++)
+	{
+		if (chain.m_levels[level].m_error > maxObjectError)
+		{
+			break;
+		}
+
+		selectedLevel = level;
+	}
+
+	return selectedLevel;
+}
+
+//------------------------------------------------------------------------------------------------
+// Rebuilds each level's m_instanceData and m_numOfInstances. Nothing consumes these per frame
+// yet: Model uploads its instance data once in InitializeGPUData, so drawing a chain needs a
+// per-level instance buffer that is re-uploaded after selection.
+//------------------------------------------------------------------------------------------------
+void SelectMeshLODs(MeshLODChain& chain, std::vector<MeshletInstance> const& instances, Vec3 const& cameraPosition, float projectionScale, float maxPixelError)
+{
+	for (MeshLODLevel& lodLevel : chain.m_levels)
+	{
+		lodLevel.m_mesh.m_instanceData.clear();
+	}
+
+	if (chain.m_levels.empty())
+	{
+		return;
+	}
+
+	for (MeshletInstance const& instance : instances)
+	{
+		int level = SelectMeshLOD(chain, instance, cameraPosition, projectionScale, maxPixelError);
+		chain.m_levels[level].m_mesh.m_instanceData.push_back(instance);
+	}
+
+	for (MeshLODLevel& lodLevel : chain.m_levels)
+	{
+		lodLevel.m_mesh.m_numOfInstances = (int)lodLevel.m_mesh.m_instanceData.size();
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/MeshProcessing.hpp"
+#include "Engine/Renderer/MeshletCache.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+constexpr int MAX_MESH_LOD_LEVELS = 8;
+
+//------------------------------------------------------------------------------------------------
+// Each level aims for m_triangleRatio of the previous level's triangles, and one simplification
+// step may move the surface by at most m_maxError of the mesh extents. The chain ends early when
+// a step removes less than m_minReduction of the triangles.
+//------------------------------------------------------------------------------------------------
+struct MeshLODConfig
+{
+	int								m_numLevels				= 5;
+	float							m_triangleRatio			= 0.5f;
+	float							m_maxError				= 0.02f;
+	float							m_minReduction			= 0.1f;
+	bool							m_lockBorder			= false;
+};
+
+//------------------------------------------------------------------------------------------------
+// m_mesh owns the level's compacted vertices, its indices, meshlets and cull data, so it can be
+// meshletized, cached and uploaded like any other Mesh. m_error is the object-space distance the
+// level may deviate from level 0.
+//------------------------------------------------------------------------------------------------
+struct MeshLODLevel
+{
+	Mesh							m_mesh;
+	float							m_error					= 0.0f;
+	uint32_t						m_numTriangles			= 0;
+	double							m_simplifySeconds		= 0.0;
+	double							m_meshletizeSeconds		= 0.0;
+};
+
+struct MeshLODChain
+{
+	std::vector<MeshLODLevel>		m_levels;
+	BoundingSphere					m_bounds				= BoundingSphere(Vec3::ZERO, 0.0f);
+};
+
+//------------------------------------------------------------------------------------------------
+// The CPU side of mesh LODs only: building, caching and per-instance selection. No draw path
+// consumes a chain yet; Model still draws the single mesh it was initialized with.
+//------------------------------------------------------------------------------------------------
+void				BuildMeshLODChain(std::vector<MeshVertex_PCUTBN> const& vertices, std::vector<uint32_t> const& indices, MeshLODConfig const& config, MeshLODChain& outChain);
+void				ComputeMeshLODMeshlets(MeshLODChain& chain, bool useJobSystem = true);
+
+MeshletCacheKey		GetMeshLODCacheKey(MeshletCacheKey const& sourceKey, MeshLODConfig const& config, int lodLevel);
+std::string			GetMeshLODCachePath(std::string const& sourcePath, int lodLevel);
+bool				ReadMeshLODCaches(std::string const& sourcePath, MeshletCacheKey const& sourceKey, MeshLODConfig const& config, MeshLODChain& outChain);
+bool				WriteMeshLODCaches(std::string const& sourcePath, MeshletCacheKey const& sourceKey, MeshLODConfig const& config, MeshLODChain const& chain);
+bool				LoadMeshLODChain(std::string const& objPath, Mat44 const& transform, MeshLODConfig const& config, MeshLODChain& outChain, bool useJobSystem = true);
+
+float				GetMeshLODProjectionScale(float fovDegrees, float screenHeightPixels);
+int					SelectMeshLOD(MeshLODChain const& chain, MeshletInstance const& instance, Vec3 const& cameraPosition, float projectionScale, float maxPixelError);
+void				SelectMeshLODs(MeshLODChain& chain, std::vector<MeshletInstance> const& instances, Vec3 const& cameraPosition, float projectionScale, float maxPixelError);
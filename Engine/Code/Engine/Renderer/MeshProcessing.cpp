@@ -0,0 +1,1384 @@
+#include "Engine/Renderer/MeshProcessing.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Renderer/ObjLoader.hpp"
+
+#include "ThirdParty/Meshoptimizer/src/meshoptimizer.h"
+
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <iterator>
+
+int Mesh::ComputeReuseScore(std::vector<uint8_t> const& localVertexLookup, uint32_t (&triIndices)[3])
+{
+	int count = 0;
+
+	for (int j = 0; j < 3; j++)
+	{
+		if (localVertexLookup[triIndices[j]] != MESHLET_LOCAL_VERTEX_NONE)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+Vec3 Mesh::ComputeNormals(Vec3* triVerts)
+{
+	Vec3 p0 = triVerts[0];
+	Vec3 p1 = triVerts[1];
+	Vec3 p2 = triVerts[2];
+
+	Vec3 e1 = p1 - p0;
+	Vec3 e2 = p2 - p0;
+
+	Vec3 normal = CrossProduct3D(e1, e2).GetNormalized();
+
+	return normal;
+}
+
+BoundingSphere Mesh::ComputeMinimumBoundingSphere(std::vector<Vec3> const& verts, size_t count)
+{
+	uint32_t minAxis[3] = {0, 0, 0};
+	uint32_t maxAxis[3] = {0, 0, 0};
+
+	float min = FLT_MAX;
+	float max = 0.0f;
+
+	uint32_t minIndex = UINT32_MAX;
+	uint32_t maxIndex = 0;
+
+	// X-AXIS MIN MAX VERTEX
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (min > verts[i].x)
+		{
+			min = verts[i].x;
+			minIndex = i;
+		}
+
+		if (max < verts[i].x)
+		{				  
+			max = verts[i].x;
+			maxIndex = i;
+		}
+	}
+
+	minAxis[0] = minIndex;
+	maxAxis[0] = maxIndex;
+
+	// Y-AXIS MIN MAX VERTEX
+
+	min = FLT_MAX;
+	max = 0.0f;
+
+	minIndex = UINT32_MAX;
+	maxIndex = 0;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (min > verts[i].y)
+		{
+			min = verts[i].y;
+			minIndex = i;
+		}
+
+		if (max < verts[i].y)
+		{
+			max = verts[i].y;
+			maxIndex = i;
+		}
+	}
+
+	minAxis[1] = minIndex;
+	maxAxis[1] = maxIndex;
+
+	// Z-AXIS MIN MAX VERTEX
+
+	min = FLT_MAX;
+	max = 0.0f;
+
+	minIndex = UINT32_MAX;
+	maxIndex = 0;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (min > verts[i].z)
+		{
+			min = verts[i].z;
+			minIndex = i;
+		}
+
+		if (max < verts[i].z)
+		{
+			max = verts[i].z;
+			maxIndex = i;
+		}
+	}
+
+	minAxis[2] = minIndex;
+	maxAxis[2] = maxIndex;
+
+	int maxDistAxis = 0;
+	float maxDistSquared = 0.0f;
+
+	for (int i = 0; i < 3; i++)
+	{
+		minIndex = minAxis[i];
+		maxIndex = maxAxis[i];
+
+		float distSquared = GetDistanceSquared3D(verts[minIndex], verts[maxIndex]);
+
+		if (distSquared > maxDistSquared)
+		{
+			maxDistSquared = distSquared;
+			maxDistAxis = i;
+		}
+	}
+
+	Vec3 p1 = verts[minAxis[maxDistAxis]];
+	Vec3 p2 = verts[maxAxis[maxDistAxis]];
+
+	Vec3 currentCenter = (p1 + p2) * 0.5f;
+
+	float currentRadius = GetDistance3D(p2, p1) * 0.5f;
+	float radiusSq = currentRadius * currentRadius;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Vec3 point = verts[i];
+
+		float distSq = GetDistanceSquared3D(point, currentCenter);
+
+		if (distSq > radiusSq)
+		{
+			float dist = sqrtf(distSq);
+			float k = (currentRadius / dist) * 0.5f + 0.5f;
+
+			currentCenter = currentCenter * k + point * (1 - k);
+			currentRadius = (currentRadius + dist) * 0.5f;
+		}
+	}
+
+	return BoundingSphere(currentCenter, currentRadius);
+}
+
+//------------------------------------------------------------------------------------------------
+// localVertexLookup maps a mesh vertex to its slot in the meshlet being built (or
+// MESHLET_LOCAL_VERTEX_NONE), so primitives are written with local indices straight away.
+//------------------------------------------------------------------------------------------------
+bool Mesh::AddToMeshlet(InlineMeshlet& meshlet, uint32_t(&tri)[3], std::vector<uint8_t>& localVertexLookup)
+{
+	if (meshlet.m_primitiveIndices.size() >= MAX_TRIANGLES_PER_MESHLET)
+		return false;
+
+	size_t newCount = 0;
+
+	for (int j = 0; j < 3; j++)
+	{
+		if (localVertexLookup[tri[j]] == MESHLET_LOCAL_VERTEX_NONE)
+		{
+			newCount++;
+		}
+	}
+
+	if (meshlet.m_uniqueVertexIndices.size() + newCount > MAX_VERTICES_PER_MESHLET)
+		return false;
+
+	uint32_t localIndices[3];
+
+	for (int j = 0; j < 3; j++)
+	{
+		uint8_t& localIndex = localVertexLookup[tri[j]];
+
+		if (localIndex == MESHLET_LOCAL_VERTEX_NONE)
+		{
+			localIndex = (uint8_t)meshlet.m_uniqueVertexIndices.size();
+			meshlet.m_uniqueVertexIndices.push_back(tri[j]);
+		}
+
+		localIndices[j] = localIndex;
+	}
+
+	meshlet.m_primitiveIndices.push_back(PackedPrimitive(localIndices[0], localIndices[1], localIndices[2]));
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+static InlineMeshlet* BeginMeshlet(std::vector<InlineMeshlet>& output, std::vector<uint8_t>& localVertexLookup)
+{
+	if (!output.empty())
+	{
+		for (uint32_t vertexIndex : output.back().m_uniqueVertexIndices)
+		{
+			localVertexLookup[vertexIndex] = MESHLET_LOCAL_VERTEX_NONE;
+		}
+	}
+
+	output.emplace_back();
+
+	InlineMeshlet* meshlet = &output.back();
+	meshlet->m_uniqueVertexIndices.reserve(MAX_VERTICES_PER_MESHLET);
+	meshlet->m_primitiveIndices.reserve(MAX_TRIANGLES_PER_MESHLET);
+
+	return meshlet;
+}
+
+//------------------------------------------------------------------------------------------------
+// adjacency[tri * 3 + edge] is the triangle across that edge, or UINT32_MAX when the edge is open
+// or shared by more than two triangles. Edges are matched by sorting their vertex-pair keys.
+//------------------------------------------------------------------------------------------------
+void Mesh::BuildAdjacencyList( const uint32_t* indices, uint32_t indexCount, std::vector<uint32_t>& adjacency )
+{
+	std::vector<std::pair<uint64_t, uint32_t>> edges;
+	edges.resize(indexCount);
+
+	for (uint32_t i = 0; i < indexCount; i++)
+	{
+		uint32_t triStart = i - (i % 3);
+		Edge edge(indices[i], indices[triStart + (i + 1 - triStart) % 3]);
+
+		edges[i] = std::make_pair(((uint64_t)edge.m_startVert << 32) | edge.m_endVert, i);
+	}
+
+	std::sort(edges.begin(), edges.end());
+
+	adjacency.assign(indexCount, UINT32_MAX);
+
+	size_t runStart = 0;
+
+	while (runStart < edges.size())
+	{
+		size_t runEnd = runStart + 1;
+
+		while (runEnd < edges.size() && edges[runEnd].first == edges[runStart].first)
+		{
+			runEnd++;
+		}
+
+		if (runEnd - runStart == 2)
+		{
+			uint32_t slotA = edges[runStart].second;
+			uint32_t slotB = edges[runStart + 1].second;
+
+			adjacency[slotA] = slotB / 3;
+			adjacency[slotB] = slotA / 3;
+		}
+
+		runStart = runEnd;
+	}
+}
+
+bool Mesh::IsMeshletFull(InlineMeshlet& meshlet)
+{
+	return (meshlet.m_uniqueVertexIndices.size() == MAX_VERTICES_PER_MESHLET || meshlet.m_primitiveIndices.size() == MAX_TRIANGLES_PER_MESHLET);
+}
+
+bool CompareTestScores(const std::pair<uint32_t, float>& a, const std::pair<uint32_t, float>& b)
+{
+	return a.second > b.second;
+}
+
+Vec4 QuantizeSNorm(Vec4 value)
+{
+	Vec4 quantized;
+
+	quantized.x = (GetClamped(value.x, -1.0f, 1.0f) * 0.5f + 0.5f) * 255.0f;
+	quantized.y = (GetClamped(value.y, -1.0f, 1.0f) * 0.5f + 0.5f) * 255.0f;
+	quantized.z = (GetClamped(value.z, -1.0f, 1.0f) * 0.5f + 0.5f) * 255.0f;
+	quantized.w = (GetClamped(value.w, -1.0f, 1.0f) * 0.5f + 0.5f) * 255.0f;
+
+	return quantized;
+}
+
+Vec4 QuantizeUNorm(Vec4 value)
+{
+	Vec4 quantized;
+
+	quantized.x = (GetClamped(value.x, 0.0f, 1.0f)) * 255.0f;
+	quantized.y = (GetClamped(value.y, 0.0f, 1.0f)) * 255.0f;
+	quantized.z = (GetClamped(value.z, 0.0f, 1.0f)) * 255.0f;
+	quantized.w = (GetClamped(value.w, 0.0f, 1.0f)) * 255.0f;
+
+	return quantized;
+}
+
+float Mesh::ComputeScore(std::vector<uint8_t> const& localVertexLookup, BoundingSphere sphere, BoundingSphere normal, uint32_t(&triIndices)[3], Vec3* triVerts)
+{
+	const float reuseWeight = 0.33f;
+	const float locWeight = 0.33f;
+	const float oriWeight = 0.33f;
+
+	// Vertex reuse
+	uint32_t reuse = ComputeReuseScore(localVertexLookup, triIndices);
+	float reuseScore = 1 - ((float(reuse)) / 3.0f);
+
+	// Distance from center point
+	float maxSq = 0.0f;
+	for (uint32_t i = 0; i < 3u; ++i)
+	{
+		Vec3 v = sphere.m_center - triVerts[i];
+		maxSq = std::max(maxSq, DotProduct3D(v, v));
+	}
+	float r = sphere.m_radius;
+	float r2 = r * r;
+	float locScore = std::log2(maxSq / r2 + 1);
+
+	Vec3 triNormal = ComputeNormals(triVerts);
+	float dotValue = DotProduct3D(triNormal, normal.m_center);
+	float oriScore = (1.0f - dotValue) * 0.5f;
+
+	float b = (reuseWeight * reuseScore) + (locWeight * locScore) + (oriWeight * oriScore);
+
+	return b;
+}
+
+void Mesh::Meshletize(std::vector<InlineMeshlet>& output, const uint32_t* indices, uint32_t indexCount, std::vector<MeshVertex_PCUTBN> const& positions, uint32_t vertexCount)
+{
+	const uint32_t triCount = indexCount / 3;
+
+	// Build a primitive adjacency list
+	std::vector<uint32_t> adjacency;
+	BuildAdjacencyList(indices, indexCount, adjacency);
+
+	// Rest our outputs
+	output.clear();
+	output.reserve(triCount / MAX_TRIANGLES_PER_MESHLET + 1);
+
+	std::vector<uint8_t> localVertexLookup(vertexCount, MESHLET_LOCAL_VERTEX_NONE);
+	InlineMeshlet* curr = BeginMeshlet(output, localVertexLookup);
+	uint32_t currIndex = 0;
+
+	// Whether each triangle has been added to a meshlet, and the last meshlet it was a candidate
+	// for, so starting a meshlet forgets every candidate without clearing anything.
+	std::vector<uint8_t> checklist(triCount, 0);
+	std::vector<uint32_t> candidateOf(triCount, UINT32_MAX);
+
+	std::vector<Vec3> meshletPositions;
+	std::vector<Vec3> meshletNormals;
+	std::vector<std::pair<uint32_t, float>> candidates;
+
+	meshletPositions.reserve(MAX_TRIANGLES_PER_MESHLET * 3);
+	meshletNormals.reserve(MAX_TRIANGLES_PER_MESHLET);
+
+	BoundingSphere psphere;
+	BoundingSphere normal;
+
+	// Arbitrarily start at triangle zero.
+	uint32_t triIndex = 0;
+	candidates.push_back(std::make_pair(triIndex, 0.0f));
+	candidateOf[triIndex] = currIndex;
+
+	// Continue adding triangles until 
+	while (!candidates.empty())
+	{
+		uint32_t index = candidates.back().first;
+		candidates.pop_back();
+
+		uint32_t tri[3] =
+		{
+			indices[index * 3],
+			indices[index * 3 + 1],
+			indices[index * 3 + 2],
+		};
+
+		assert(tri[0] < vertexCount);
+		assert(tri[1] < vertexCount);
+		assert(tri[2] < vertexCount);
+
+		// Try to add triangle to meshlet
+		if (AddToMeshlet(*curr, tri, localVertexLookup))
+		{
+			// Success! Mark as added.
+			checklist[index] = 1;
+
+			// Add positions & normal to list
+			Vec3 points[3] =
+			{
+				positions[tri[0]].m_position,
+				positions[tri[1]].m_position,
+				positions[tri[2]].m_position,
+			};
+
+			meshletPositions.push_back(points[0]);
+			meshletPositions.push_back(points[1]);
+			meshletPositions.push_back(points[2]);
+
+			Vec3 triNormal;
+			triNormal = ComputeNormals(points);
+			meshletNormals.push_back(triNormal);
+
+			// Compute new bounding sphere & normal axis
+			psphere = ComputeMinimumBoundingSphere(meshletPositions, meshletPositions.size());
+
+			BoundingSphere nsphere = ComputeMinimumBoundingSphere(meshletNormals, meshletNormals.size());
+
+			normal.m_center = nsphere.m_center.GetNormalized();
+			normal.m_radius = nsphere.m_radius;
+
+			// Find and add all applicable adjacent triangles to candidate list
+			const uint32_t adjIndex = index * 3;
+
+			uint32_t adj[3] =
+			{
+				adjacency[adjIndex],
+				adjacency[adjIndex + 1],
+				adjacency[adjIndex + 2],
+			};
+
+			for (uint32_t i = 0; i < 3u; ++i)
+			{
+				// Invalid triangle in adjacency slot
+				if (adj[i] == UINT32_MAX)
+					continue;
+
+				// Already processed triangle
+				if (checklist[adj[i]])
+					continue;
+
+				// Triangle already in the candidate list
+				if (candidateOf[adj[i]] == currIndex)
+					continue;
+
+				candidates.push_back(std::make_pair(adj[i], FLT_MAX));
+				candidateOf[adj[i]] = currIndex;
+			}
+
+			// Re-score remaining candidate triangles
+			for (uint32_t i = 0; i < static_cast<uint32_t>(candidates.size()); ++i)
+			{
+				uint32_t candidate = candidates[i].first;
+
+				uint32_t triIndices[3] =
+				{
+					indices[candidate * 3],
+					indices[candidate * 3 + 1],
+					indices[candidate * 3 + 2],
+				};
+
+				assert(triIndices[0] < vertexCount);
+				assert(triIndices[1] < vertexCount);
+				assert(triIndices[2] < vertexCount);
+
+				Vec3 triVerts[3] =
+				{
+					positions[triIndices[0]].m_position,
+					positions[triIndices[1]].m_position,
+					positions[triIndices[2]].m_position,
+				};
+
+				candidates[i].second = ComputeScore(localVertexLookup, psphere, normal, triIndices, triVerts);
+			}
+
+			// Determine whether we need to move to the next meshlet.
+			if (IsMeshletFull(*curr))
+			{
+				meshletPositions.clear();
+				meshletNormals.clear();
+
+				curr = BeginMeshlet(output, localVertexLookup);
+				currIndex++;
+
+				// Use one of our existing candidates as the next meshlet seed.
+				if (!candidates.empty())
+				{
+					candidates[0] = candidates.back();
+					candidates.resize(1);
+					candidateOf[candidates[0].first] = currIndex;
+				}
+			}
+			else
+			{
+				std::sort(candidates.begin(), candidates.end(), &CompareTestScores);
+			}
+		}
+		else
+		{
+			if (candidates.empty())
+			{
+				meshletPositions.clear();
+				meshletNormals.clear();
+
+				curr = BeginMeshlet(output, localVertexLookup);
+				currIndex++;
+			}
+		}
+
+		// Ran out of candidates; add a new seed candidate to start the next meshlet.
+		if (candidates.empty())
+		{
+			while (triIndex < triCount && checklist[triIndex])
+				++triIndex;
+
+			if (triIndex == triCount)
+				break;
+
+			candidates.push_back(std::make_pair(triIndex, 0.0f));
+			candidateOf[triIndex] = currIndex;
+		}
+	}
+
+	// The last meshlet may have never had any primitives added to it - in which case we want to remove it.
+	if (output.back().m_primitiveIndices.empty())
+	{
+		output.pop_back();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Interleaves the low 10 bits of value so two zero bits separate each.
+//------------------------------------------------------------------------------------------------
+static uint32_t SpreadBitsForMorton(uint32_t value)
+{
+	value &= 0x000003FF;
+	value = (value | (value << 16)) & 0x030000FF;
+	value = (value | (value << 8)) & 0x0300F00F;
+	value = (value | (value << 4)) & 0x030C30C3;
+	value = (value | (value << 2)) & 0x09249249;
+
+	return value;
+}
+
+//------------------------------------------------------------------------------------------------
+// Quantizes against the largest extent on every axis, so a flat axis doesn't get the same number
+// of Morton bits as the wide ones and scatter neighbouring triangles across the curve.
+//------------------------------------------------------------------------------------------------
+static uint32_t GetMortonCode3D(Vec3 const& point, AABB3 const& bounds)
+{
+	Vec3 extents = bounds.m_maxs - bounds.m_mins;
+	float maxExtent = std::max(extents.x, std::max(extents.y, extents.z));
+	float scale = maxExtent > 0.0f ? 1023.0f / maxExtent : 0.0f;
+
+	uint32_t cellX = (uint32_t)GetClamped((point.x - bounds.m_mins.x) * scale, 0.0f, 1023.0f);
+	uint32_t cellY = (uint32_t)GetClamped((point.y - bounds.m_mins.y) * scale, 0.0f, 1023.0f);
+	uint32_t cellZ = (uint32_t)GetClamped((point.z - bounds.m_mins.z) * scale, 0.0f, 1023.0f);
+
+	return (SpreadBitsForMorton(cellX) << 2) | (SpreadBitsForMorton(cellY) << 1) | SpreadBitsForMorton(cellZ);
+}
+
+//------------------------------------------------------------------------------------------------
+// A cluster's indices are compact: they address m_clusterToMesh, which lists the mesh vertices the
+// cluster uses. Meshletize then sizes its per-vertex lookup to the cluster rather than the mesh.
+//------------------------------------------------------------------------------------------------
+class MeshletizeClusterJob : public Job
+{
+public:
+	Mesh*									m_mesh					= nullptr;
+	std::vector<MeshVertex_PCUTBN> const*	m_positions				= nullptr;
+	std::vector<uint32_t>					m_indices;
+	std::vector<uint32_t>					m_clusterToMesh;
+	std::vector<InlineMeshlet>				m_meshlets;
+public:
+	MeshletizeClusterJob(Mesh* mesh, std::vector<MeshVertex_PCUTBN> const* positions);
+
+	virtual void Execute() override;
+};
+
+//------------------------------------------------------------------------------------------------
+MeshletizeClusterJob::MeshletizeClusterJob(Mesh* mesh, std::vector<MeshVertex_PCUTBN> const* positions)
+	: m_mesh(mesh)
+	, m_positions(positions)
+{
+}
+
+//------------------------------------------------------------------------------------------------
+void MeshletizeClusterJob::Execute()
+{
+	uint32_t clusterVertexCount = (uint32_t)m_clusterToMesh.size();
+
+	std::vector<MeshVertex_PCUTBN> clusterVertices(clusterVertexCount);
+
+	for (uint32_t clusterVertex = 0; clusterVertex < clusterVertexCount; clusterVertex++)
+	{
+		clusterVertices[clusterVertex] = (*m_positions)[m_clusterToMesh[clusterVertex]];
+	}
+
+	// Same vertex cache pass the serial path runs, limited to the cluster
+	std::vector<uint32_t> optimizedIndices(m_indices.size());
+	meshopt_optimizeVertexCache(optimizedIndices.data(), m_indices.data(), m_indices.size(), clusterVertexCount);
+
+	m_mesh->Meshletize(m_meshlets, optimizedIndices.data(), (uint32_t)optimizedIndices.size(), clusterVertices, clusterVertexCount);
+
+	for (InlineMeshlet& meshlet : m_meshlets)
+	{
+		for (uint32_t& vertexIndex : meshlet.m_uniqueVertexIndices)
+		{
+			vertexIndex = m_clusterToMesh[vertexIndex];
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Sorts triangles by the Morton code of their centroid, cuts the sorted list into clusters of
+// MESHLETIZE_CLUSTER_TRIANGLES and meshletizes each cluster as its own job. Triangles only grow
+// into neighbours within their cluster, so meshlets never straddle a cluster boundary. One
+// mesh-sized remap table, reset after each cluster, gives every cluster compact vertex indices.
+//------------------------------------------------------------------------------------------------
+void Mesh::MeshletizeParallel(std::vector<InlineMeshlet>& output, const uint32_t* indices, uint32_t indexCount, std::vector<MeshVertex_PCUTBN> const& positions, uint32_t vertexCount)
+{
+	const uint32_t triCount = indexCount / 3;
+
+	output.clear();
+
+	if (triCount == 0)
+	{
+		return;
+	}
+
+	std::vector<Vec3> centroids;
+	centroids.resize(triCount);
+
+	AABB3 bounds(FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (uint32_t triIndex = 0; triIndex < triCount; triIndex++)
+	{
+		Vec3 centroid = (positions[indices[triIndex * 3]].m_position + positions[indices[triIndex * 3 + 1]].m_position + positions[indices[triIndex * 3 + 2]].m_position) / 3.0f;
+
+		bounds.m_mins.x = std::min(bounds.m_mins.x, centroid.x);
+		bounds.m_mins.y = std::min(bounds.m_mins.y, centroid.y);
+		bounds.m_mins.z = std::min(bounds.m_mins.z, centroid.z);
+		bounds.m_maxs.x = std::max(bounds.m_maxs.x, centroid.x);
+		bounds.m_maxs.y = std::max(bounds.m_maxs.y, centroid.y);
+		bounds.m_maxs.z = std::max(bounds.m_maxs.z, centroid.z);
+
+		centroids[triIndex] = centroid;
+	}
+
+	// Morton code in the high half, triangle index in the low half keeps the sort deterministic.
+	std::vector<uint64_t> sortedTriangles;
+	sortedTriangles.resize(triCount);
+
+	for (uint32_t triIndex = 0; triIndex < triCount; triIndex++)
+	{
+		sortedTriangles[triIndex] = ((uint64_t)GetMortonCode3D(centroids[triIndex], bounds) << 32) | triIndex;
+	}
+
+	std::sort(sortedTriangles.begin(), sortedTriangles.end());
+
+	uint32_t numClusters = (triCount + MESHLETIZE_CLUSTER_TRIANGLES - 1) / MESHLETIZE_CLUSTER_TRIANGLES;
+
+	std::vector<MeshletizeClusterJob*> jobs;
+	jobs.reserve(numClusters);
+
+	std::vector<uint32_t> meshToCluster(vertexCount, UINT32_MAX);
+
+	for (uint32_t clusterIndex = 0; clusterIndex < numClusters; clusterIndex++)
+	{
+		uint32_t firstTriangle = clusterIndex * MESHLETIZE_CLUSTER_TRIANGLES;
+		uint32_t lastTriangle = std::min(firstTriangle + MESHLETIZE_CLUSTER_TRIANGLES, triCount);
+
+		MeshletizeClusterJob* job = new MeshletizeClusterJob(this, &positions);
+		job->m_indices.resize((size_t)(lastTriangle - firstTriangle) * 3);
+
+		for (uint32_t sortedIndex = firstTriangle; sortedIndex < lastTriangle; sortedIndex++)
+		{
+			uint32_t triIndex = (uint32_t)(sortedTriangles[sortedIndex] & 0xFFFFFFFF);
+			uint32_t* clusterTri = &job->m_indices[(size_t)(sortedIndex - firstTriangle) * 3];
+
+			for (uint32_t corner = 0; corner < 3; corner++)
+			{
+				uint32_t meshVertex = indices[triIndex * 3 + corner];
+
+				if (meshToCluster[meshVertex] == UINT32_MAX)
+				{
+					meshToCluster[meshVertex] = (uint32_t)job->m_clusterToMesh.size();
+					job->m_clusterToMesh.push_back(meshVertex);
+				}
+
+				clusterTri[corner] = meshToCluster[meshVertex];
+			}
+		}
+
+		for (uint32_t meshVertex : job->m_clusterToMesh)
+		{
+			meshToCluster[meshVertex] = UINT32_MAX;
+		}
+
+		if (g_theJobSystem)
+		{
+			g_theJobSystem->AddJob(job);
+		}
+		else
+		{
+			job->Execute();
+		}
+
+		jobs.push_back(job);
+	}
+
+	size_t numMeshlets = 0;
+
+	for (MeshletizeClusterJob* job : jobs)
+	{
+		if (g_theJobSystem)
+		{
+			g_theJobSystem->WaitForJob(job);
+		}
+
+		numMeshlets += job->m_meshlets.size();
+	}
+
+	output.reserve(numMeshlets);
+
+	for (MeshletizeClusterJob* job : jobs)
+	{
+		std::move(job->m_meshlets.begin(), job->m_meshlets.end(), std::back_inserter(output));
+		delete job;
+	}
+}
+
+void Mesh::ComputeMeshlets(bool useJobSystem)
+{
+	if (useJobSystem && m_indices.size() / 3 > MESHLETIZE_CLUSTER_TRIANGLES)
+	{
+		// Runs the vertex cache pass per cluster, after Morton clustering has picked the clusters
+		MeshletizeParallel(m_inlineMeshlets, m_indices.data(), (uint32_t)m_indices.size(), m_meshVertices, (uint32_t)m_meshVertices.size());
+	}
+	else
+	{
+		std::vector<uint32_t> optimizedIndices(m_indices.size(), UINT32_MAX);
+
+		meshopt_optimizeVertexCache(optimizedIndices.data(), m_indices.data(), m_indices.size(), m_meshVertices.size());
+
+		Meshletize(m_inlineMeshlets, optimizedIndices.data(), (uint32_t)optimizedIndices.size(), m_meshVertices, (uint32_t)m_meshVertices.size());
+	}
+
+	Rgba8 colors[] = 
+	{
+		Rgba8::WHITE,
+		Rgba8::RED,
+		Rgba8::GREEN,
+		Rgba8::BLUE,
+		Rgba8::CYAN,
+		Rgba8::MAGENTA,
+		Rgba8::YELLOW
+	};
+
+	for (size_t i = 0; i < m_inlineMeshlets.size(); i++)
+	{
+		m_inlineMeshlets[i].m_color = colors[i % 7];
+	}
+
+	FlattenMeshlets();
+}
+
+//------------------------------------------------------------------------------------------------
+// Packs the inline meshlets into the flat arrays the GPU reads. Primitive indices are already
+// meshlet-local, so this is a sized copy.
+//------------------------------------------------------------------------------------------------
+void Mesh::FlattenMeshlets()
+{
+	size_t numUniqueVertices = 0;
+	size_t numPrimitives = 0;
+
+	for (InlineMeshlet const& inlineMeshlet : m_inlineMeshlets)
+	{
+		numUniqueVertices += inlineMeshlet.m_uniqueVertexIndices.size();
+		numPrimitives += inlineMeshlet.m_primitiveIndices.size();
+	}
+
+	m_meshlets.resize(m_inlineMeshlets.size());
+	m_uniqueVertexIndices.resize(numUniqueVertices);
+	m_primitiveIndices.resize(numPrimitives);
+
+	uint32_t vertexOffset = 0;
+	uint32_t primitiveOffset = 0;
+
+	for (size_t j = 0; j < m_inlineMeshlets.size(); j++)
+	{
+		InlineMeshlet const& inlineMeshlet = m_inlineMeshlets[j];
+		Meshlet& meshlet = m_meshlets[j];
+
+		std::copy(inlineMeshlet.m_uniqueVertexIndices.begin(), inlineMeshlet.m_uniqueVertexIndices.end(), m_uniqueVertexIndices.begin() + vertexOffset);
+		std::copy(inlineMeshlet.m_primitiveIndices.begin(), inlineMeshlet.m_primitiveIndices.end(), m_primitiveIndices.begin() + primitiveOffset);
+
+		meshlet.m_vertexOffset = vertexOffset;
+		meshlet.m_vertexCount = (uint32_t)inlineMeshlet.m_uniqueVertexIndices.size();
+
+		meshlet.m_primitiveOffset = primitiveOffset;
+		meshlet.m_primitiveCount = (uint32_t)inlineMeshlet.m_primitiveIndices.size();
+
+		inlineMeshlet.m_color.GetAsFloats(meshlet.m_color);
+
+		vertexOffset += meshlet.m_vertexCount;
+		primitiveOffset += meshlet.m_primitiveCount;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+MeshletData Mesh::GetMeshletData() const
+{
+	MeshletData meshletData;
+
+	meshletData.m_vertices = m_meshVertices.data();
+	meshletData.m_meshlets = m_meshlets.data();
+	meshletData.m_uniqueVertexIndices = m_uniqueVertexIndices.data();
+	meshletData.m_primitiveIndices = m_primitiveIndices.data();
+	meshletData.m_cullData = m_cullData.data();
+	meshletData.m_numVertices = (uint32_t)m_meshVertices.size();
+	meshletData.m_numMeshlets = (uint32_t)m_meshlets.size();
+	meshletData.m_numUniqueVertexIndices = (uint32_t)m_uniqueVertexIndices.size();
+	meshletData.m_numPrimitiveIndices = (uint32_t)m_primitiveIndices.size();
+
+	return meshletData;
+}
+
+std::vector<CullData> Mesh::ComputeMeshletCullData()
+{
+	std::vector<CullData> cullData;
+	cullData.resize(m_inlineMeshlets.size());
+
+	std::vector<BoundingSphere> boundSpheres = ComputeBoundSphereData();
+	ConeData normalConeData = ComputeNormalConeData();
+
+	for (size_t i = 0; i < cullData.size(); i++)
+	{
+		cullData[i].m_boundingSphere = boundSpheres[i];
+		cullData[i].m_normalCone[0] = normalConeData[i].first[0];
+		cullData[i].m_normalCone[1] = normalConeData[i].first[1];
+		cullData[i].m_normalCone[2] = normalConeData[i].first[2];
+		cullData[i].m_normalCone[3] = normalConeData[i].first[3];
+		cullData[i].m_apexOffset = normalConeData[i].second;
+	}
+
+	return cullData;
+}
+
+std::vector<BoundingSphere> Mesh::ComputeBoundSphereData()
+{
+	std::vector<BoundingSphere> bSp;
+
+	for (size_t i = 0; i < m_inlineMeshlets.size(); i++)
+	{
+		std::vector<Vec3> positions;
+
+		for (size_t j = 0; j < m_inlineMeshlets[i].m_uniqueVertexIndices.size(); j++)
+		{
+			positions.push_back(m_meshVertices[m_inlineMeshlets[i].m_uniqueVertexIndices[j]].m_position);
+		}
+
+		Vec3 centroid(0, 0, 0);
+		int numVertices = (int)positions.size();
+
+		// Step 1: Compute the centroid (geometric center)
+		for (const Vec3& v : positions) {
+			centroid.x += v.x;
+			centroid.y += v.y;
+			centroid.z += v.z;
+		}
+
+		centroid.x /= numVertices;
+		centroid.y /= numVertices;
+		centroid.z /= numVertices;
+
+		// Step 2: Compute the radius (max distance from the centroid to any vertex)
+		float maxDistSquared = 0.0f;
+		for (const Vec3& v : positions) {
+			Vec3 diff = v - centroid;
+			float distSquared = diff.GetLengthSquared();  // Avoid using sqrt here for efficiency
+			if (distSquared > maxDistSquared) {
+				maxDistSquared = distSquared;
+			}
+		}
+
+		// Step 3: The radius is the square root of the max distance squared
+		float radius = sqrtf(maxDistSquared);
+
+		// Return the bounding sphere with the calculated center and radius
+		BoundingSphere sph = BoundingSphere(centroid, radius);
+
+		bSp.push_back(sph);
+	}
+
+	return bSp;
+}
+void Mesh::GenerateBoundingBox()
+{
+	float minX = 0.0f;
+	float maxX = 0.0f;
+	float minY = 0.0f;
+	float maxY = 0.0f;
+	float minZ = 0.0f;
+	float maxZ = 0.0f;
+
+	for (size_t i = 0; i < m_meshVertices.size(); i++)
+	{
+		if (maxX < m_meshVertices[i].m_position.x)
+		{
+			maxX = m_meshVertices[i].m_position.x;
+		}
+
+		if (minX > m_meshVertices[i].m_position.x)
+		{
+			minX = m_meshVertices[i].m_position.x;
+		}
+
+		if (maxY < m_meshVertices[i].m_position.y)
+		{
+			maxY = m_meshVertices[i].m_position.y;
+		}
+
+		if (minY > m_meshVertices[i].m_position.y)
+		{
+			minY = m_meshVertices[i].m_position.y;
+		}
+
+		if (maxZ < m_meshVertices[i].m_position.z)
+		{
+			maxZ = m_meshVertices[i].m_position.z;
+		}
+
+		if (minZ > m_meshVertices[i].m_position.z)
+		{
+			minZ = m_meshVertices[i].m_position.z;
+		}
+	}
+
+	m_worldBoundingBox = AABB3(minX, minY, minZ, maxX, maxY, maxZ);
+}
+
+ConeData Mesh::ComputeNormalConeData()
+{
+	std::vector<std::pair<uint8_t[4], float>> coneData;
+	coneData.resize(m_meshlets.size());
+	
+	std::vector<Vec3> vertices;
+	std::vector<Vec3> normals;
+	
+	vertices.resize(256);
+	normals.resize(256);
+	
+	for (uint32_t mi = 0; mi < m_meshlets.size(); ++mi)
+	{
+		auto& m = m_meshlets[mi];
+		auto& c = coneData[mi];
+	
+		// Cache vertices
+		for (uint32_t i = 0; i < m.m_vertexCount; ++i)
+		{
+			uint32_t vIndex = m_uniqueVertexIndices[m.m_vertexOffset + i];
+	
+			assert(vIndex < m_meshVertices.size());
+			vertices[i] = m_meshVertices[vIndex].m_position;
+		}
+	
+		// Generate primitive normals & cache
+		for (uint32_t i = 0; i < m.m_primitiveCount; ++i)
+		{
+			auto primitive = m_primitiveIndices[m.m_primitiveOffset + i];
+	
+			Vec3 triangle[3]
+			{
+				vertices[primitive.m_i0],
+				vertices[primitive.m_i1],
+				vertices[primitive.m_i2],
+			};
+	
+			Vec3 p10 = triangle[1] - triangle[0];
+			Vec3 p20 = triangle[2] - triangle[0];
+			Vec3 n = (CrossProduct3D(p10, p20)).GetNormalized();
+	
+			normals[i] = n;
+		}
+	
+		// The apex is measured from the stored bounding sphere's center, the vertex centroid from
+		// ComputeBoundSphereData, because that is the center the culling test offsets it from
+		Vec3 positionCenter(0.0f, 0.0f, 0.0f);
+
+		for (uint32_t i = 0; i < m.m_vertexCount; ++i)
+		{
+			positionCenter += vertices[i];
+		}
+
+		positionCenter /= (float)m.m_vertexCount;
+	
+		// Calculate the normal cone
+		// 1. Normalized center point of minimum bounding sphere of unit normals == conic axis
+		BoundingSphere normalBounds = ComputeMinimumBoundingSphere(normals, m.m_primitiveCount);
+	
+		// 2. Calculate dot product of all normals to conic axis, selecting minimum
+	
+		Vec4 axis;
+		axis.x = normalBounds.m_center.GetNormalized().x;
+		axis.y = normalBounds.m_center.GetNormalized().y;
+		axis.z = normalBounds.m_center.GetNormalized().z;
+		axis.w = 0;
+	
+		float minDot = 1.0f;
+		for (uint32_t i = 0; i < m.m_primitiveCount; ++i)
+		{
+			float dot = DotProduct3D(Vec3(axis.x, axis.y, axis.z), normals[i]);
+			minDot = std::min(minDot, dot);
+		}
+	
+		if (minDot < 0.1f)
+		{
+			// Degenerate cone
+			c.first[0] = 127;
+			c.first[1] = 127;
+			c.first[2] = 127;
+			c.first[3] = 255;
+			continue;
+		}
+	
+		// Find the point on center-t*axis ray that lies in negative half-space of all triangles
+		float maxt = 0;
+	
+		for (uint32_t i = 0; i < m.m_primitiveCount; ++i)
+		{
+			auto primitive = m_primitiveIndices[m.m_primitiveOffset + i];
+	
+			uint32_t indices[3]
+			{
+				primitive.m_i0,
+				primitive.m_i1,
+				primitive.m_i2,
+			};
+	
+			Vec3 triangle[3]
+			{
+				vertices[indices[0]],
+				vertices[indices[1]],
+				vertices[indices[2]],
+			};
+	
+			Vec3 cj = positionCenter - triangle[0];
+	
+			Vec3 n = (normals[i]);
+			float dc = DotProduct3D(cj, n);
+			float dn = DotProduct3D(Vec3(axis.x, axis.y, axis.z), n);
+	
+			// dn should be larger than mindp cutoff above
+			assert(dn > 0.0f);
+			float t = dc / dn;
+	
+			maxt = (t > maxt) ? t : maxt;
+		}
+	
+		// cone apex should be in the negative half-space of all cluster triangles by construction
+		c.second = maxt;
+	
+		// cos(a) for normal cone is minDot; we need to add 90 degrees on both sides and invert the cone
+		// which gives us -cos(a+90) = -(-sin(a)) = sin(a) = sqrt(1 - cos^2(a))
+		float coneCutoffValue = sqrtf(1.0f - minDot * minDot);
+		Vec4 coneCutoff = Vec4(coneCutoffValue, coneCutoffValue, coneCutoffValue, coneCutoffValue);
+	
+		Vec4 quantized = QuantizeSNorm(axis);
+		c.first[0] = (uint8_t)quantized.x;
+		c.first[1] = (uint8_t)quantized.y;
+		c.first[2] = (uint8_t)quantized.z;
+	
+		Vec4 error = (((quantized / 255.0f) * 2.0f) - Vec4::ONE) - axis;
+	
+		error.x = fabsf(error.x);
+		error.y = fabsf(error.y); 
+		error.z = fabsf(error.z);
+		error.w = fabsf(error.w);
+	
+		float sum = error.x + error.y + error.z + error.w;
+		error = Vec4(sum, sum, sum, sum);
+	
+		quantized = QuantizeUNorm(coneCutoff + error);
+		quantized.x = std::min(quantized.x + 1.0f, 255.0f);
+		quantized.y = std::min(quantized.y + 1.0f, 255.0f);
+		quantized.z = std::min(quantized.z + 1.0f, 255.0f);
+		quantized.w = std::min(quantized.w + 1.0f, 255.0f);
+		c.first[3] = (uint8_t)quantized.x;
+	}
+
+	return coneData;
+}
+void Mesh::ComputeInstanceData(std::vector<Vec3> instancePositions, std::vector<float> instanceScales, bool isRock)
+{
+	if (!isRock)
+	{
+		for (int i = 0; i < m_numOfInstances; i++)
+		{
+			Mat44 transform;
+			transform.SetTranslation3D(instancePositions[i]);
+			transform.AppendScaleUniform3D(instanceScales[i]);
+
+			MeshletInstance instanceData;
+			instanceData.InstanceTransform = transform;
+			instanceData.InstanceScale = instanceScales[i];
+
+			m_instanceData.push_back(instanceData);
+		}
+	}
+	else
+	{
+		RandomNumberGenerator rng = RandomNumberGenerator();
+
+		for (int i = 0; i < m_numOfInstances; i++)
+		{
+			Mat44 transform;
+			transform.SetTranslation3D(instancePositions[i]);
+			transform.AppendScaleUniform3D(instanceScales[i]);
+			transform.AppendXRotation(90.0f);
+			transform.AppendYRotation(90.0f);
+
+			MeshletInstance instanceData;
+			instanceData.InstanceTransform = transform;
+			instanceData.InstanceScale = instanceScales[i];
+
+			m_instanceData.push_back(instanceData);
+		}
+	}
+}
+
+//std::vector<CullData> Mesh::ComputeTestMeshletCullData()
+//{ 
+//	std::vector<CullData> cullData;
+//	cullData.resize(m_meshlets.size());
+//
+//    std::vector<Vec3> vertices;
+//    std::vector<Vec3> normals;
+//
+//	vertices.resize(256);
+//	normals.resize(256);
+//
+//    for (uint32_t mi = 0; mi < m_meshlets.size(); ++mi)
+//    {
+//        auto& m = m_meshlets[mi];
+//        auto& c = cullData[mi];
+//
+//        // Cache vertices
+//        for (uint32_t i = 0; i < m.m_vertexCount; ++i)
+//        {
+//            uint32_t vIndex = m_uniqueVertexIndices[m.m_vertexOffset + i];
+//
+//            assert(vIndex < m_meshVertices.size());
+//            vertices[i] = m_meshVertices[vIndex].m_position;
+//        }
+//
+//        // Generate primitive normals & cache
+//        for (uint32_t i = 0; i < m.m_primitiveCount; ++i)
+//        {
+//            auto primitive = m_primitiveIndices[m.m_primitiveOffset + i];
+//
+//            Vec3 triangle[3]
+//            {
+//                vertices[primitive.m_i0],
+//                vertices[primitive.m_i1],
+//                vertices[primitive.m_i2],
+//            };
+//
+//            Vec3 p10 = triangle[1] - triangle[0];
+//            Vec3 p20 = triangle[2] - triangle[0];
+//            Vec3 n = (CrossProduct3D(p10, p20)).GetNormalized();
+//
+//            normals[i] = n;
+//        }
+//
+//        // Calculate spatial bounds
+//        BoundingSphere positionBounds = ComputeMinimumBoundingSphere(vertices, m.m_vertexCount);
+//        c.m_boundingSphere = positionBounds;
+//
+//        // Calculate the normal cone
+//        // 1. Normalized center point of minimum bounding sphere of unit normals == conic axis
+//        BoundingSphere normalBounds = ComputeMinimumBoundingSphere(normals, m.m_primitiveCount);
+//
+//        // 2. Calculate dot product of all normals to conic axis, selecting minimum
+//
+//		Vec4 axis;
+//		axis.x = normalBounds.m_center.GetNormalized().x;
+//		axis.y = normalBounds.m_center.GetNormalized().y;
+//		axis.z = normalBounds.m_center.GetNormalized().z;
+//		axis.w = 0;
+//
+//        float minDot = 1.0f;
+//        for (uint32_t i = 0; i < m.m_primitiveCount; ++i)
+//        {
+//            float dot = DotProduct3D(Vec3(axis.x, axis.y, axis.z), normals[i]);
+//            minDot = std::min(minDot, dot);
+//        }
+//
+//        if (minDot < 0.1f)
+//        {
+//            // Degenerate cone
+//            c.m_normalCone[0] = 127;
+//            c.m_normalCone[1] = 127;
+//            c.m_normalCone[2] = 127;
+//            c.m_normalCone[3] = 255;
+//            continue;
+//        }
+//
+//        // Find the point on center-t*axis ray that lies in negative half-space of all triangles
+//        float maxt = 0;
+//
+//        for (uint32_t i = 0; i < m.m_primitiveCount; ++i)
+//        {
+//            auto primitive = m_primitiveIndices[m.m_primitiveOffset + i];
+//
+//            uint32_t indices[3]
+//            {
+//                primitive.m_i0,
+//                primitive.m_i1,
+//                primitive.m_i2,
+//            };
+//
+//            Vec3 triangle[3]
+//            {
+//                vertices[indices[0]],
+//                vertices[indices[1]],
+//                vertices[indices[2]],
+//            };
+//
+//            Vec3 cj = positionBounds.m_center - triangle[0];
+//
+//            Vec3 n = (normals[i]);
+//            float dc = DotProduct3D(cj, n);
+//            float dn = DotProduct3D(Vec3(axis.x, axis.y, axis.z), n);
+//
+//            // dn should be larger than mindp cutoff above
+//            assert(dn > 0.0f);
+//            float t = dc / dn;
+//
+//            maxt = (t > maxt) ? t : maxt;
+//        }
+//
+//        // cone apex should be in the negative half-space of all cluster triangles by construction
+//        c.m_apexOffset = maxt;
+//
+//        // cos(a) for normal cone is minDot; we need to add 90 degrees on both sides and invert the cone
+//        // which gives us -cos(a+90) = -(-sin(a)) = sin(a) = sqrt(1 - cos^2(a))
+//		float coneCutoffValue = sqrtf(1.0f - minDot * minDot);
+//		Vec4 coneCutoff = Vec4(coneCutoffValue, coneCutoffValue, coneCutoffValue, coneCutoffValue);
+//
+//		Vec4 quantized = QuantizeSNorm(axis);
+//		c.m_normalCone[0] = (uint8_t)quantized.x;
+//		c.m_normalCone[1] = (uint8_t)quantized.y;
+//		c.m_normalCone[2] = (uint8_t)quantized.z;
+//
+//		Vec4 error = (((quantized / 255.0f) * 2.0f) - Vec4::ONE) - axis;
+//
+//		error.x = fabsf(error.x);
+//		error.y = fabsf(error.y); 
+//		error.z = fabsf(error.z);
+//		error.w = fabsf(error.w);
+//
+//		float sum = error.x + error.y + error.z + error.w;
+//		error = Vec4(sum, sum, sum, sum);
+//
+//		quantized = QuantizeUNorm(coneCutoff + error);
+//		quantized.x = std::min(quantized.x + 1.0f, 255.0f);
+//		quantized.y = std::min(quantized.y + 1.0f, 255.0f);
+//		quantized.z = std::min(quantized.z + 1.0f, 255.0f);
+//		quantized.w = std::min(quantized.w + 1.0f, 255.0f);
+//		c.m_normalCone[3] = (uint8_t)quantized.x;
+//    }
+//
+//	return cullData;
+//}
+
+//------------------------------------------------------------------------------------------------
+// Loads positions, UVs and normals into outMesh's vertex and index arrays, welding face vertices
+// that share {v, vt, vn}; meshlets are not built. With useJobSystem the text is parsed and welded
+// on the job system, with identical results.
+//------------------------------------------------------------------------------------------------
+bool LoadMeshFromObj(std::string const& objPath, Mat44 const& transform, Mesh& outMesh, bool useJobSystem)
+{
+	MappedFile objFile;
+
+	if (!objFile.Open(objPath))
+	{
+		return false;
+	}
+
+	ObjData objData;
+
+	if (useJobSystem)
+	{
+		ObjLoader::ParseObjTextParallel(objFile.GetText(), objData);
+	}
+	else
+	{
+		ObjLoader::ParseObjText(objFile.GetText(), objData);
+	}
+
+	objFile.Close();
+
+	std::vector<uint32_t> uniqueFaceVertices;
+	std::vector<uint32_t> faceVertexRemap;
+	ObjLoader::WeldFaceVertices(objData, uniqueFaceVertices, faceVertexRemap, useJobSystem);
+
+	outMesh.m_indices.clear();
+	ObjLoader::GenerateWeldedIndices(objData, faceVertexRemap, outMesh.m_indices);
+
+	if (outMesh.m_indices.empty())
+	{
+		return false;
+	}
+
+	outMesh.m_meshVertices.clear();
+	outMesh.m_meshVertices.reserve(uniqueFaceVertices.size());
+
+	for (uint32_t faceVertexIndex : uniqueFaceVertices)
+	{
+		Vec3 position;
+		Vec2 uv;
+		Vec3 normal;
+		ObjLoader::GetFaceVertexAttributes(objData, objData.m_faceVertices[faceVertexIndex], position, uv, normal);
+
+		position = transform.TransformPosition3D(position);
+
+		if (objData.m_hasNormals)
+		{
+			normal = transform.TransformVectorQuantity3D(normal);
+		}
+
+		outMesh.m_meshVertices.push_back(MeshVertex_PCUTBN(position, Vec4(1.0f, 1.0f, 1.0f, 1.0f), uv, normal));
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+void BuildBenchmarkSphere(int numRings, int numSegments, std::vector<MeshVertex_PCUTBN>& outVertices, std::vector<uint32_t>& outIndices)
+{
+	outVertices.clear();
+	outIndices.clear();
+	outVertices.reserve((size_t)(numRings + 1) * (size_t)(numSegments + 1));
+	outIndices.reserve((size_t)numRings * (size_t)numSegments * 6);
+
+	for (int ring = 0; ring <= numRings; ring++)
+	{
+		float latitude = -90.0f + 180.0f * (float)ring / (float)numRings;
+
+		for (int segment = 0; segment <= numSegments; segment++)
+		{
+			float longitude = 360.0f * (float)segment / (float)numSegments;
+			Vec3 position = Vec3::MakeFromPolarDegrees(latitude, longitude, 1.0f);
+
+			MeshVertex_PCUTBN vertex(position, Vec4(1.0f, 1.0f, 1.0f, 1.0f), Vec2((float)segment / (float)numSegments, (float)ring / (float)numRings), position);
+			vertex.m_tangent = Vec3(-SinDegrees(longitude), CosDegrees(longitude), 0.0f);
+			vertex.m_biTangent = CrossProduct3D(vertex.m_normal, vertex.m_tangent);
+			outVertices.push_back(vertex);
+		}
+	}
+
+	for (int ring = 0; ring < numRings; ring++)
+	{
+		for (int segment = 0; segment < numSegments; segment++)
+		{
+			uint32_t bottomLeft = (uint32_t)(ring * (numSegments + 1) + segment);
+			uint32_t topLeft = bottomLeft + (uint32_t)(numSegments + 1);
+
+			outIndices.push_back(bottomLeft);
+			outIndices.push_back(bottomLeft + 1);
+			outIndices.push_back(topLeft + 1);
+
+			outIndices.push_back(bottomLeft);
+			outIndices.push_back(topLeft + 1);
+			outIndices.push_back(topLeft);
+		}
+	}
+}
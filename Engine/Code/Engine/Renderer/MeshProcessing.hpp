@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/MeshVertex_PCU.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------
+// CPU-side mesh processing: meshletization, per-meshlet culling data, bounds and instance data.
+// Nothing here touches a graphics API; the DX12 Model uploads what Mesh produces.
+//------------------------------------------------------------------------------------------------
+constexpr int MAX_VERTICES_PER_MESHLET = 64;
+constexpr int MAX_TRIANGLES_PER_MESHLET = 42;
+constexpr uint8_t MESHLET_LOCAL_VERTEX_NONE = 0xFF;
+
+static_assert(MAX_VERTICES_PER_MESHLET < MESHLET_LOCAL_VERTEX_NONE, "Meshlet local vertex indices must fit in a byte");
+
+// Meshes with more triangles than this are split into Morton-ordered clusters of this size and
+// meshletized in parallel on the JobSystem.
+constexpr uint32_t MESHLETIZE_CLUSTER_TRIANGLES = 8192;
+
+typedef std::vector<std::pair<uint8_t[4], float>> ConeData;
+
+struct Edge
+{
+	uint32_t m_startVert;
+	uint32_t m_endVert;
+
+	Edge(uint32_t v1, uint32_t v2) : m_startVert(std::min(v1, v2)), m_endVert(std::max(v1, v2)) {};
+};
+
+struct PackedPrimitive
+{
+	uint32_t m_i0;
+	uint32_t m_i1;
+	uint32_t m_i2;
+
+	PackedPrimitive() = default;
+	PackedPrimitive(uint32_t i0, uint32_t i1, uint32_t i2) : m_i0(i0), m_i1(i1), m_i2(i2) {}
+};
+
+struct BoundingSphere
+{
+	Vec3 m_center;
+	float m_radius;
+
+	BoundingSphere() = default;
+	BoundingSphere(Vec3 center, float radius) : m_center(center), m_radius(radius) {};
+};
+
+//------------------------------------------------------------------------------------------------
+// m_primitiveIndices index into m_uniqueVertexIndices, which index the mesh vertices.
+//------------------------------------------------------------------------------------------------
+struct InlineMeshlet
+{
+	std::vector<uint32_t>				m_uniqueVertexIndices;
+	std::vector<PackedPrimitive>		m_primitiveIndices;
+	Rgba8								m_color;
+};
+
+struct Meshlet
+{
+	uint32_t							m_vertexOffset;
+	uint32_t							m_vertexCount;
+
+	uint32_t							m_primitiveOffset;
+	uint32_t							m_primitiveCount;
+	float								m_color[4];
+};
+
+struct MeshletInstance
+{
+	Mat44 InstanceTransform;
+	float InstanceScale = 1.0f;
+};
+
+struct CullData
+{
+	BoundingSphere						m_boundingSphere;
+	uint8_t								m_normalCone[4];
+	float								m_apexOffset;
+};
+
+//------------------------------------------------------------------------------------------------
+// Non-owning view of the arrays the GPU needs, backed either by a Mesh or a mapped MeshletCache.
+//------------------------------------------------------------------------------------------------
+struct MeshletData
+{
+	MeshVertex_PCUTBN const*			m_vertices				= nullptr;
+	Meshlet const*						m_meshlets				= nullptr;
+	uint32_t const*						m_uniqueVertexIndices	= nullptr;
+	PackedPrimitive const*				m_primitiveIndices		= nullptr;
+	CullData const*						m_cullData				= nullptr;
+	uint32_t							m_numVertices			= 0;
+	uint32_t							m_numMeshlets			= 0;
+	uint32_t							m_numUniqueVertexIndices = 0;
+	uint32_t							m_numPrimitiveIndices	= 0;
+};
+
+struct Mesh
+{
+	std::vector<MeshVertex_PCUTBN>	m_meshVertices;
+	std::vector<uint32_t>			m_indices;
+	std::vector<InlineMeshlet>		m_inlineMeshlets;
+	std::vector<Meshlet>			m_meshlets;
+	std::vector<CullData>			m_cullData;
+	std::vector<MeshletInstance>	m_instanceData;
+	std::vector<uint32_t>			m_uniqueVertexIndices;
+	std::vector<PackedPrimitive>	m_primitiveIndices;
+	std::vector<uint32_t>			m_meshletsVisibility;
+	AABB3							m_worldBoundingBox;
+	AABB2							m_screenSpaceBoundingBox;
+	int								m_numOfInstances		= 1;
+
+									Mesh() = default;
+									~Mesh() {};
+
+	void							BuildAdjacencyList( const uint32_t* indices, uint32_t indexCount, std::vector<uint32_t>& adjacency );
+	bool							IsMeshletFull(InlineMeshlet& meshlet);
+	int								ComputeReuseScore(std::vector<uint8_t> const& localVertexLookup, uint32_t (&triIndices)[3]);
+	Vec3							ComputeNormals(Vec3* triVerts);
+	BoundingSphere					ComputeMinimumBoundingSphere(std::vector<Vec3> const& verts, size_t count);
+	float							ComputeScore(std::vector<uint8_t> const& localVertexLookup, BoundingSphere sphere, BoundingSphere normal, uint32_t (&triIndices)[3], Vec3* triVerts);
+	bool							AddToMeshlet(InlineMeshlet& meshlet, uint32_t (&tri)[3], std::vector<uint8_t>& localVertexLookup);
+	void							Meshletize(std::vector<InlineMeshlet>& output, const uint32_t* indices, uint32_t indexCount, std::vector<MeshVertex_PCUTBN> const& positions, uint32_t vertexCount);
+	void							MeshletizeParallel(std::vector<InlineMeshlet>& output, const uint32_t* indices, uint32_t indexCount, std::vector<MeshVertex_PCUTBN> const& positions, uint32_t vertexCount);
+	
+	void							ComputeMeshlets(bool useJobSystem = true);
+	void							FlattenMeshlets();
+	std::vector<CullData>			ComputeMeshletCullData();
+	std::vector<BoundingSphere>		ComputeBoundSphereData();
+	ConeData						ComputeNormalConeData();
+	void							ComputeInstanceData(std::vector<Vec3> instancePositions, std::vector<float> instanceScales, bool isRock = false);
+	
+	void							GenerateBoundingBox();
+
+	MeshletData						GetMeshletData() const;
+
+	// FOR TESTING PURPOSE!!! NOT FINAL CODE!!! HAVE TO WRITE MY OWN VERSION!!!!
+	//std::vector<CullData>			ComputeTestMeshletCullData();
+};
+
+bool								CompareTestScores(const std::pair<uint32_t, float>& a, const std::pair<uint32_t, float>& b);
+
+Vec4								QuantizeSNorm(Vec4 value);
+Vec4								QuantizeUNorm(Vec4 value);
+
+bool								LoadMeshFromObj(std::string const& objPath, Mat44 const& transform, Mesh& outMesh, bool useJobSystem = true);
+void								BuildBenchmarkSphere(int numRings, int numSegments, std::vector<MeshVertex_PCUTBN>& outVertices, std::vector<uint32_t>& outIndices);
+
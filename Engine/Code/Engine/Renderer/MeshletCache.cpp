@@ -0,0 +1,304 @@
+#include "Engine/Renderer/MeshletCache.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+
+#include <string.h>
+
+constexpr uint64_t MESHLET_CACHE_HASH_OFFSET	= 14695981039346656037ull;
+constexpr uint64_t MESHLET_CACHE_HASH_PRIME		= 1099511628211ull;
+
+//------------------------------------------------------------------------------------------------
+// FNV-1a over 8-byte words rather than bytes, with an extra shift to fold the high bits back in;
+// source files can be hundreds of megabytes and are hashed on every load.
+//------------------------------------------------------------------------------------------------
+static uint64_t HashMeshletCacheBytes(void const* data, size_t size, uint64_t hash = MESHLET_CACHE_HASH_OFFSET)
+{
+	unsigned char const* bytes = (unsigned char const*)data;
+	size_t numWords = size / sizeof(uint64_t);
+
+	for (size_t wordIndex = 0; wordIndex < numWords; wordIndex++)
+	{
+		uint64_t word;
+		memcpy(&word, bytes + wordIndex * sizeof(uint64_t), sizeof(uint64_t));
+
+		hash ^= word;
+		hash *= MESHLET_CACHE_HASH_PRIME;
+		hash ^= hash >> 29;
+	}
+
+	for (size_t byteIndex = numWords * sizeof(uint64_t); byteIndex < size; byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= MESHLET_CACHE_HASH_PRIME;
+	}
+
+	hash ^= (uint64_t)size;
+	hash *= MESHLET_CACHE_HASH_PRIME;
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------
+static uint64_t AlignMeshletCacheOffset(uint64_t offset)
+{
+	return (offset + MESHLET_CACHE_ALIGNMENT - 1) & ~(MESHLET_CACHE_ALIGNMENT - 1);
+}
+
+//------------------------------------------------------------------------------------------------
+static bool IsMeshletCacheSectionValid(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+{
+	return offset <= fileSize && count <= (fileSize - offset) / elementSize && (offset % alignof(uint32_t)) == 0;
+}
+
+//------------------------------------------------------------------------------------------------
+MeshletCacheKey GetMeshletCacheKey(std::string const& sourcePath, Mat44 const& transform)
+{
+	MeshletCacheKey key;
+
+	MappedFile sourceFile;
+
+	if (sourceFile.Open(sourcePath))
+	{
+		key.m_sourceHash = HashMeshletCacheBytes(sourceFile.GetData(), sourceFile.GetSize());
+	}
+
+	uint32_t buildParams[] =
+	{
+		MESHLET_CACHE_VERSION,
+		(uint32_t)MAX_VERTICES_PER_MESHLET,
+		(uint32_t)MAX_TRIANGLES_PER_MESHLET,
+		MESHLETIZE_CLUSTER_TRIANGLES,
+		(uint32_t)sizeof(MeshVertex_PCUTBN),
+		(uint32_t)sizeof(Meshlet),
+		(uint32_t)sizeof(PackedPrimitive),
+		(uint32_t)sizeof(CullData)
+	};
+
+	key.m_paramsHash = HashMeshletCacheBytes(buildParams, sizeof(buildParams));
+	key.m_paramsHash = HashMeshletCacheBytes(transform.m_values, sizeof(transform.m_values), key.m_paramsHash);
+
+	return key;
+}
+
+//------------------------------------------------------------------------------------------------
+// Folds build settings that only some caches have, such as an LOD level and its simplifier
+// settings, into an existing key without rehashing the source file
+//------------------------------------------------------------------------------------------------
+MeshletCacheKey GetMeshletCacheKey(MeshletCacheKey const& baseKey, void const* extraParams, size_t extraParamsSize)
+{
+	MeshletCacheKey key = baseKey;
+	key.m_paramsHash = HashMeshletCacheBytes(extraParams, extraParamsSize, key.m_paramsHash);
+
+	return key;
+}
+
+//------------------------------------------------------------------------------------------------
+std::string GetMeshletCachePath(std::string const& sourcePath)
+{
+	return sourcePath + ".meshlets";
+}
+
+//------------------------------------------------------------------------------------------------
+bool WriteMeshletCache(std::string const& cachePath, Mesh const& mesh, MeshletCacheKey const& key, uint32_t lodLevel, uint32_t numLODLevels, float lodError)
+{
+	if (mesh.m_cullData.size() != mesh.m_meshlets.size())
+	{
+		return false;
+	}
+
+	MeshletData meshletData = mesh.GetMeshletData();
+
+	MeshletCacheHeader header;
+	header.m_key = key;
+	header.m_numVertices = meshletData.m_numVertices;
+	header.m_numMeshlets = meshletData.m_numMeshlets;
+	header.m_numUniqueVertexIndices = meshletData.m_numUniqueVertexIndices;
+	header.m_numPrimitiveIndices = meshletData.m_numPrimitiveIndices;
+	header.m_lodLevel = lodLevel;
+	header.m_numLODLevels = numLODLevels;
+	header.m_lodError = lodError;
+
+	header.m_verticesOffset = AlignMeshletCacheOffset(sizeof(MeshletCacheHeader));
+	header.m_meshletsOffset = AlignMeshletCacheOffset(header.m_verticesOffset + (uint64_t)header.m_numVertices * sizeof(MeshVertex_PCUTBN));
+	header.m_uniqueVertexIndicesOffset = AlignMeshletCacheOffset(header.m_meshletsOffset + (uint64_t)header.m_numMeshlets * sizeof(Meshlet));
+	header.m_primitiveIndicesOffset = AlignMeshletCacheOffset(header.m_uniqueVertexIndicesOffset + (uint64_t)header.m_numUniqueVertexIndices * sizeof(uint32_t));
+	header.m_cullDataOffset = AlignMeshletCacheOffset(header.m_primitiveIndicesOffset + (uint64_t)header.m_numPrimitiveIndices * sizeof(PackedPrimitive));
+
+	uint64_t fileSize = header.m_cullDataOffset + (uint64_t)header.m_numMeshlets * sizeof(CullData);
+
+	std::vector<unsigned char> buffer;
+	buffer.resize((size_t)fileSize);
+
+	memcpy(buffer.data(), &header, sizeof(MeshletCacheHeader));
+	memcpy(buffer.data() + header.m_verticesOffset, meshletData.m_vertices, (size_t)header.m_numVertices * sizeof(MeshVertex_PCUTBN));
+	memcpy(buffer.data() + header.m_meshletsOffset, meshletData.m_meshlets, (size_t)header.m_numMeshlets * sizeof(Meshlet));
+	memcpy(buffer.data() + header.m_uniqueVertexIndicesOffset, meshletData.m_uniqueVertexIndices, (size_t)header.m_numUniqueVertexIndices * sizeof(uint32_t));
+	memcpy(buffer.data() + header.m_primitiveIndicesOffset, meshletData.m_primitiveIndices, (size_t)header.m_numPrimitiveIndices * sizeof(PackedPrimitive));
+	memcpy(buffer.data() + header.m_cullDataOffset, meshletData.m_cullData, (size_t)header.m_numMeshlets * sizeof(CullData));
+
+	std::string fileName = cachePath;
+	WriteBufferToFile(buffer, fileName);
+
+	MeshletCache writtenCache;
+	return writtenCache.Open(cachePath, key);
+}
+
+//------------------------------------------------------------------------------------------------
+// The sections are in bounds by now; this checks that every index they hold stays inside the
+// section it addresses, so a corrupt cache cannot send the mesh shader out of its buffers.
+//------------------------------------------------------------------------------------------------
+static bool AreMeshletCacheContentsValid(unsigned char const* data, MeshletCacheHeader const& header)
+{
+	Meshlet const* meshlets = (Meshlet const*)(data + header.m_meshletsOffset);
+	uint32_t const* uniqueVertexIndices = (uint32_t const*)(data + header.m_uniqueVertexIndicesOffset);
+	PackedPrimitive const* primitiveIndices = (PackedPrimitive const*)(data + header.m_primitiveIndicesOffset);
+
+	for (uint32_t meshletIndex = 0; meshletIndex < header.m_numMeshlets; meshletIndex++)
+	{
+		Meshlet const& meshlet = meshlets[meshletIndex];
+
+		if ((uint64_t)meshlet.m_vertexOffset + meshlet.m_vertexCount > header.m_numUniqueVertexIndices)
+		{
+			return false;
+		}
+
+		if ((uint64_t)meshlet.m_primitiveOffset + meshlet.m_primitiveCount > header.m_numPrimitiveIndices)
+		{
+			return false;
+		}
+
+		for (uint32_t primitiveIndex = 0; primitiveIndex < meshlet.m_primitiveCount; primitiveIndex++)
+		{
+			PackedPrimitive const& primitive = primitiveIndices[meshlet.m_primitiveOffset + primitiveIndex];
+
+			if (primitive.m_i0 >= meshlet.m_vertexCount || primitive.m_i1 >= meshlet.m_vertexCount || primitive.m_i2 >= meshlet.m_vertexCount)
+			{
+				return false;
+			}
+		}
+	}
+
+	for (uint32_t uniqueIndex = 0; uniqueIndex < header.m_numUniqueVertexIndices; uniqueIndex++)
+	{
+		if (uniqueVertexIndices[uniqueIndex] >= header.m_numVertices)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+static MeshletCacheHeader const* ValidateMeshletCache(MappedFile const& file, MeshletCacheKey const& expectedKey)
+{
+	unsigned char const* data = file.GetData();
+	uint64_t fileSize = (uint64_t)file.GetSize();
+
+	if (fileSize < sizeof(MeshletCacheHeader))
+	{
+		return nullptr;
+	}
+
+	MeshletCacheHeader const* header = (MeshletCacheHeader const*)data;
+
+	bool isValid = header->m_magic == MESHLET_CACHE_MAGIC && header->m_version == MESHLET_CACHE_VERSION;
+	isValid = isValid && header->m_key.m_sourceHash == expectedKey.m_sourceHash && header->m_key.m_paramsHash == expectedKey.m_paramsHash;
+	isValid = isValid && header->m_lodLevel < header->m_numLODLevels;
+	isValid = isValid && IsMeshletCacheSectionValid(header->m_verticesOffset, header->m_numVertices, sizeof(MeshVertex_PCUTBN), fileSize);
+	isValid = isValid && IsMeshletCacheSectionValid(header->m_meshletsOffset, header->m_numMeshlets, sizeof(Meshlet), fileSize);
+	isValid = isValid && IsMeshletCacheSectionValid(header->m_uniqueVertexIndicesOffset, header->m_numUniqueVertexIndices, sizeof(uint32_t), fileSize);
+	isValid = isValid && IsMeshletCacheSectionValid(header->m_primitiveIndicesOffset, header->m_numPrimitiveIndices, sizeof(PackedPrimitive), fileSize);
+	isValid = isValid && IsMeshletCacheSectionValid(header->m_cullDataOffset, header->m_numMeshlets, sizeof(CullData), fileSize);
+	isValid = isValid && AreMeshletCacheContentsValid(data, *header);
+
+	return isValid ? header : nullptr;
+}
+
+//------------------------------------------------------------------------------------------------
+// A stale cache packed into a mounted archive would shadow a fresh loose one, so a cache that
+// fails validation is retried as a loose file.
+//------------------------------------------------------------------------------------------------
+bool MeshletCache::Open(std::string const& cachePath, MeshletCacheKey const& expectedKey)
+{
+	Close();
+
+	if (m_file.Open(cachePath))
+	{
+		m_header = ValidateMeshletCache(m_file, expectedKey);
+	}
+
+	if (!m_header && m_file.OpenLooseFile(cachePath))
+	{
+		m_header = ValidateMeshletCache(m_file, expectedKey);
+	}
+
+	if (!m_header)
+	{
+		m_file.Close();
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+void MeshletCache::Close()
+{
+	m_file.Close();
+	m_header = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------
+bool MeshletCache::IsOpen() const
+{
+	return m_header != nullptr;
+}
+
+//------------------------------------------------------------------------------------------------
+MeshletCacheHeader const* MeshletCache::GetHeader() const
+{
+	return m_header;
+}
+
+//------------------------------------------------------------------------------------------------
+MeshletData MeshletCache::GetMeshletData() const
+{
+	MeshletData meshletData;
+
+	if (!m_header)
+	{
+		return meshletData;
+	}
+
+	unsigned char const* data = m_file.GetData();
+
+	meshletData.m_vertices = (MeshVertex_PCUTBN const*)(data + m_header->m_verticesOffset);
+	meshletData.m_meshlets = (Meshlet const*)(data + m_header->m_meshletsOffset);
+	meshletData.m_uniqueVertexIndices = (uint32_t const*)(data + m_header->m_uniqueVertexIndicesOffset);
+	meshletData.m_primitiveIndices = (PackedPrimitive const*)(data + m_header->m_primitiveIndicesOffset);
+	meshletData.m_cullData = (CullData const*)(data + m_header->m_cullDataOffset);
+	meshletData.m_numVertices = m_header->m_numVertices;
+	meshletData.m_numMeshlets = m_header->m_numMeshlets;
+	meshletData.m_numUniqueVertexIndices = m_header->m_numUniqueVertexIndices;
+	meshletData.m_numPrimitiveIndices = m_header->m_numPrimitiveIndices;
+
+	return meshletData;
+}
+
+//------------------------------------------------------------------------------------------------
+// For CPU-side tools that want to edit or re-process the cached data. The inline meshlets and
+// source indices are not stored, so those arrays come back empty.
+//------------------------------------------------------------------------------------------------
+void MeshletCache::CopyToMesh(Mesh& outMesh) const
+{
+	MeshletData meshletData = GetMeshletData();
+
+	outMesh.m_meshVertices.assign(meshletData.m_vertices, meshletData.m_vertices + meshletData.m_numVertices);
+	outMesh.m_meshlets.assign(meshletData.m_meshlets, meshletData.m_meshlets + meshletData.m_numMeshlets);
+	outMesh.m_uniqueVertexIndices.assign(meshletData.m_uniqueVertexIndices, meshletData.m_uniqueVertexIndices + meshletData.m_numUniqueVertexIndices);
+	outMesh.m_primitiveIndices.assign(meshletData.m_primitiveIndices, meshletData.m_primitiveIndices + meshletData.m_numPrimitiveIndices);
+	outMesh.m_cullData.assign(meshletData.m_cullData, meshletData.m_cullData + meshletData.m_numMeshlets);
+	outMesh.m_inlineMeshlets.clear();
+	outMesh.m_indices.clear();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Renderer/MeshProcessing.hpp"
+
+#include <stdint.h>
+#include <string>
+
+struct Mat44;
+
+constexpr uint32_t MESHLET_CACHE_MAGIC		= 0x484C534D; // "MSLH"
+constexpr uint32_t MESHLET_CACHE_VERSION	= 4;
+constexpr uint64_t MESHLET_CACHE_ALIGNMENT	= 64;
+
+//------------------------------------------------------------------------------------------------
+// m_sourceHash covers the source file bytes; m_paramsHash covers the load transform, the meshlet
+// limits and the layout of every stored struct, so changing any of them invalidates the cache.
+//------------------------------------------------------------------------------------------------
+struct MeshletCacheKey
+{
+	uint64_t						m_sourceHash			= 0;
+	uint64_t						m_paramsHash			= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// On-disk layout: header, then vertices, meshlets, unique vertex indices, packed primitives and
+// cull data, each aligned to MESHLET_CACHE_ALIGNMENT. Offsets are from the start of the file and
+// there is one cull data entry per meshlet. A file holding one level of an LOD chain records the
+// level, the chain length and the level's object-space simplification error.
+//------------------------------------------------------------------------------------------------
+struct MeshletCacheHeader
+{
+	uint32_t						m_magic					= MESHLET_CACHE_MAGIC;
+	uint32_t						m_version				= MESHLET_CACHE_VERSION;
+	MeshletCacheKey					m_key;
+	uint32_t						m_numVertices			= 0;
+	uint32_t						m_numMeshlets			= 0;
+	uint32_t						m_numUniqueVertexIndices = 0;
+	uint32_t						m_numPrimitiveIndices	= 0;
+	uint32_t						m_lodLevel				= 0;
+	uint32_t						m_numLODLevels			= 1;
+	float							m_lodError				= 0.0f;
+	uint32_t						m_reserved				= 0;
+	uint64_t						m_verticesOffset		= 0;
+	uint64_t						m_meshletsOffset		= 0;
+	uint64_t						m_uniqueVertexIndicesOffset = 0;
+	uint64_t						m_primitiveIndicesOffset = 0;
+	uint64_t						m_cullDataOffset		= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Read-only view of a meshlet cache file. Open maps the file once and validates it against the
+// expected key; GetMeshletData then points straight into the mapping, so it can be uploaded
+// without copying. The view stays valid until Close or destruction.
+//------------------------------------------------------------------------------------------------
+class MeshletCache
+{
+	MappedFile						m_file;
+	MeshletCacheHeader const*		m_header				= nullptr;
+public:
+									MeshletCache() = default;
+									~MeshletCache() = default;
+
+	bool							Open(std::string const& cachePath, MeshletCacheKey const& expectedKey);
+	void							Close();
+
+	bool							IsOpen() const;
+	MeshletCacheHeader const*		GetHeader() const;
+	MeshletData						GetMeshletData() const;
+	void							CopyToMesh(Mesh& outMesh) const;
+};
+
+MeshletCacheKey	GetMeshletCacheKey(std::string const& sourcePath, Mat44 const& transform);
+MeshletCacheKey	GetMeshletCacheKey(MeshletCacheKey const& baseKey, void const* extraParams, size_t extraParamsSize);
+std::string		GetMeshletCachePath(std::string const& sourcePath);
+bool			WriteMeshletCache(std::string const& cachePath, Mesh const& mesh, MeshletCacheKey const& key, uint32_t lodLevel = 0, uint32_t numLODLevels = 1, float lodError = 0.0f);
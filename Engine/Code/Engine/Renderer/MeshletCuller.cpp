@@ -0,0 +1,293 @@
+#include "Engine/Renderer/MeshletCuller.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <xmmintrin.h>
+
+constexpr uint8_t MESHLET_CONE_DEGENERATE = 0xFF;
+
+//------------------------------------------------------------------------------------------------
+// The cone is stored as unorm bytes: xyz map [0, 255] onto [-1, 1] and w onto [0, 1]
+//------------------------------------------------------------------------------------------------
+static float UnpackMeshletConeAxis(uint8_t packed)
+{
+	return ((float)packed / 255.0f) * 2.0f - 1.0f;
+}
+
+//------------------------------------------------------------------------------------------------
+static float UnpackMeshletConeCutoff(uint8_t packed)
+{
+	return (float)packed / 255.0f;
+}
+
+//------------------------------------------------------------------------------------------------
+static void GetMeshletCullPlanes(Frustum const& frustum, Plane3D const* (&outPlanes)[6])
+{
+	outPlanes[0] = &frustum.m_nearPlane;
+	outPlanes[1] = &frustum.m_farPlane;
+	outPlanes[2] = &frustum.m_rightPlane;
+	outPlanes[3] = &frustum.m_leftPlane;
+	outPlanes[4] = &frustum.m_topPlane;
+	outPlanes[5] = &frustum.m_bottomPlane;
+}
+
+//------------------------------------------------------------------------------------------------
+// The reference for MeshletCuller, written step for step like the shader and with the same
+// floating point operation order as the SIMD path, so the two agree bit for bit
+//------------------------------------------------------------------------------------------------
+bool IsMeshletVisible(CullData const& cullData, MeshletInstance const& instance, Frustum const& frustum, Vec3 const& cullViewPosition)
+{
+	float const* world = instance.InstanceTransform.m_values;
+	Vec3 const& localCenter = cullData.m_boundingSphere.m_center;
+
+	Vec3 center;
+	center.x = world[Mat44::Ix] * localCenter.x + world[Mat44::Jx] * localCenter.y + world[Mat44::Kx] * localCenter.z + world[Mat44::Tx];
+	center.y = world[Mat44::Iy] * localCenter.x + world[Mat44::Jy] * localCenter.y + world[Mat44::Ky] * localCenter.z + world[Mat44::Ty];
+	center.z = world[Mat44::Iz] * localCenter.x + world[Mat44::Jz] * localCenter.y + world[Mat44::Kz] * localCenter.z + world[Mat44::Tz];
+
+	float radius = cullData.m_boundingSphere.m_radius * instance.InstanceScale;
+
+	Plane3D const* planes[6];
+	GetMeshletCullPlanes(frustum, planes);
+
+	for (int planeIndex = 0; planeIndex < 6; planeIndex++)
+	{
+		Plane3D const& plane = *planes[planeIndex];
+		float distance = plane.m_normal.x * center.x + plane.m_normal.y * center.y + plane.m_normal.z * center.z + plane.m_distanceFromOriginAlongNormal;
+
+		if (distance < -radius)
+		{
+			return false;
+		}
+	}
+
+	if (cullData.m_normalCone[3] == MESHLET_CONE_DEGENERATE)
+	{
+		return true;
+	}
+
+	Vec3 localAxis(UnpackMeshletConeAxis(cullData.m_normalCone[0]), UnpackMeshletConeAxis(cullData.m_normalCone[1]), UnpackMeshletConeAxis(cullData.m_normalCone[2]));
+	float coneCutoff = UnpackMeshletConeCutoff(cullData.m_normalCone[3]);
+
+	Vec3 axis;
+	axis.x = world[Mat44::Ix] * localAxis.x + world[Mat44::Jx] * localAxis.y + world[Mat44::Kx] * localAxis.z;
+	axis.y = world[Mat44::Iy] * localAxis.x + world[Mat44::Jy] * localAxis.y + world[Mat44::Ky] * localAxis.z;
+	axis.z = world[Mat44::Iz] * localAxis.x + world[Mat44::Jz] * localAxis.y + world[Mat44::Kz] * localAxis.z;
+
+	float axisLength = sqrtf(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+	axis.x = axis.x / axisLength;
+	axis.y = axis.y / axisLength;
+	axis.z = axis.z / axisLength;
+
+	// The apex sits behind the meshlet along the axis, scaled with the instance
+	float apexOffset = cullData.m_apexOffset * instance.InstanceScale;
+
+	Vec3 view;
+	view.x = cullViewPosition.x - (center.x - axis.x * apexOffset);
+	view.y = cullViewPosition.y - (center.y - axis.y * apexOffset);
+	view.z = cullViewPosition.z - (center.z - axis.z * apexOffset);
+
+	float viewLength = sqrtf(view.x * view.x + view.y * view.y + view.z * view.z);
+	view.x = view.x / viewLength;
+	view.y = view.y / viewLength;
+	view.z = view.z / viewLength;
+
+	// The cutoff is the smallest dot product along the inverted axis at which every triangle faces away
+	float viewDotInvertedAxis = -(view.x * axis.x + view.y * axis.y + view.z * axis.z);
+
+	return !(viewDotInvertedAxis > coneCutoff);
+}
+
+//------------------------------------------------------------------------------------------------
+void CullMeshletsScalar(CullData const* cullData, uint32_t numMeshlets, MeshletInstance const* instances, uint32_t numInstances, Frustum const& frustum, Vec3 const& cullViewPosition, std::vector<VisibleMeshlet>& outVisibleMeshlets)
+{
+	outVisibleMeshlets.clear();
+
+	for (uint32_t instanceIndex = 0; instanceIndex < numInstances; instanceIndex++)
+	{
+		for (uint32_t meshletIndex = 0; meshletIndex < numMeshlets; meshletIndex++)
+		{
+			if (IsMeshletVisible(cullData[meshletIndex], instances[instanceIndex], frustum, cullViewPosition))
+			{
+				VisibleMeshlet visibleMeshlet;
+				visibleMeshlet.m_instanceIndex = instanceIndex;
+				visibleMeshlet.m_meshletIndex = meshletIndex;
+				outVisibleMeshlets.push_back(visibleMeshlet);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Arrays are padded to a multiple of four. Padding has a radius of -infinity, which no plane test
+// passes, and a degenerate cone gets an infinite cutoff so the cone test can never cull it.
+//------------------------------------------------------------------------------------------------
+void MeshletCuller::SetCullData(CullData const* cullData, uint32_t numMeshlets)
+{
+	m_numMeshlets = numMeshlets;
+
+	size_t numPadded = ((size_t)numMeshlets + 3) & ~(size_t)3;
+
+	m_centerX.assign(numPadded, 0.0f);
+	m_centerY.assign(numPadded, 0.0f);
+	m_centerZ.assign(numPadded, 0.0f);
+	m_radius.assign(numPadded, -INFINITY);
+	m_axisX.assign(numPadded, 0.0f);
+	m_axisY.assign(numPadded, 0.0f);
+	m_axisZ.assign(numPadded, 1.0f);
+	m_coneCutoff.assign(numPadded, INFINITY);
+	m_apexOffset.assign(numPadded, 0.0f);
+
+	for (uint32_t meshletIndex = 0; meshletIndex < numMeshlets; meshletIndex++)
+	{
+		CullData const& meshletCullData = cullData[meshletIndex];
+
+		m_centerX[meshletIndex] = meshletCullData.m_boundingSphere.m_center.x;
+		m_centerY[meshletIndex] = meshletCullData.m_boundingSphere.m_center.y;
+		m_centerZ[meshletIndex] = meshletCullData.m_boundingSphere.m_center.z;
+		m_radius[meshletIndex] = meshletCullData.m_boundingSphere.m_radius;
+
+		if (meshletCullData.m_normalCone[3] != MESHLET_CONE_DEGENERATE)
+		{
+			m_axisX[meshletIndex] = UnpackMeshletConeAxis(meshletCullData.m_normalCone[0]);
+			m_axisY[meshletIndex] = UnpackMeshletConeAxis(meshletCullData.m_normalCone[1]);
+			m_axisZ[meshletIndex] = UnpackMeshletConeAxis(meshletCullData.m_normalCone[2]);
+			m_coneCutoff[meshletIndex] = UnpackMeshletConeCutoff(meshletCullData.m_normalCone[3]);
+			m_apexOffset[meshletIndex] = meshletCullData.m_apexOffset;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Instances are the outer loop so the transform and planes stay in registers while four meshlets
+// at a time stream through. Groups with nothing left after the plane tests skip the cone test.
+//------------------------------------------------------------------------------------------------
+void MeshletCuller::Cull(MeshletInstance const* instances, uint32_t numInstances, Frustum const& frustum, Vec3 const& cullViewPosition, std::vector<VisibleMeshlet>& outVisibleMeshlets) const
+{
+	outVisibleMeshlets.clear();
+
+	Plane3D const* planes[6];
+	GetMeshletCullPlanes(frustum, planes);
+
+	__m128 planeX[6];
+	__m128 planeY[6];
+	__m128 planeZ[6];
+	__m128 planeW[6];
+
+	for (int planeIndex = 0; planeIndex < 6; planeIndex++)
+	{
+		planeX[planeIndex] = _mm_set1_ps(planes[planeIndex]->m_normal.x);
+		planeY[planeIndex] = _mm_set1_ps(planes[planeIndex]->m_normal.y);
+		planeZ[planeIndex] = _mm_set1_ps(planes[planeIndex]->m_normal.z);
+		planeW[planeIndex] = _mm_set1_ps(planes[planeIndex]->m_distanceFromOriginAlongNormal);
+	}
+
+	__m128 const viewX = _mm_set1_ps(cullViewPosition.x);
+	__m128 const viewY = _mm_set1_ps(cullViewPosition.y);
+	__m128 const viewZ = _mm_set1_ps(cullViewPosition.z);
+	__m128 const signMask = _mm_set1_ps(-0.0f);
+
+	uint32_t numGroups = (m_numMeshlets + 3) / 4;
+
+	for (uint32_t instanceIndex = 0; instanceIndex < numInstances; instanceIndex++)
+	{
+		MeshletInstance const& instance = instances[instanceIndex];
+		float const* world = instance.InstanceTransform.m_values;
+
+		__m128 const ix = _mm_set1_ps(world[Mat44::Ix]);
+		__m128 const iy = _mm_set1_ps(world[Mat44::Iy]);
+		__m128 const iz = _mm_set1_ps(world[Mat44::Iz]);
+		__m128 const jx = _mm_set1_ps(world[Mat44::Jx]);
+		__m128 const jy = _mm_set1_ps(world[Mat44::Jy]);
+		__m128 const jz = _mm_set1_ps(world[Mat44::Jz]);
+		__m128 const kx = _mm_set1_ps(world[Mat44::Kx]);
+		__m128 const ky = _mm_set1_ps(world[Mat44::Ky]);
+		__m128 const kz = _mm_set1_ps(world[Mat44::Kz]);
+		__m128 const tx = _mm_set1_ps(world[Mat44::Tx]);
+		__m128 const ty = _mm_set1_ps(world[Mat44::Ty]);
+		__m128 const tz = _mm_set1_ps(world[Mat44::Tz]);
+		__m128 const scale = _mm_set1_ps(instance.InstanceScale);
+
+		for (uint32_t groupIndex = 0; groupIndex < numGroups; groupIndex++)
+		{
+			size_t first = (size_t)groupIndex * 4;
+
+			__m128 localX = _mm_loadu_ps(&m_centerX[first]);
+			__m128 localY = _mm_loadu_ps(&m_centerY[first]);
+			__m128 localZ = _mm_loadu_ps(&m_centerZ[first]);
+
+			__m128 centerX = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ix, localX), _mm_mul_ps(jx, localY)), _mm_mul_ps(kx, localZ)), tx);
+			__m128 centerY = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(iy, localX), _mm_mul_ps(jy, localY)), _mm_mul_ps(ky, localZ)), ty);
+			__m128 centerZ = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(iz, localX), _mm_mul_ps(jz, localY)), _mm_mul_ps(kz, localZ)), tz);
+			__m128 negativeRadius = _mm_xor_ps(_mm_mul_ps(_mm_loadu_ps(&m_radius[first]), scale), signMask);
+
+			__m128 visible = _mm_cmpnlt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[0], centerX), _mm_mul_ps(planeY[0], centerY)), _mm_mul_ps(planeZ[0], centerZ)), planeW[0]), negativeRadius);
+
+			for (int planeIndex = 1; planeIndex < 6; planeIndex++)
+			{
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[planeIndex], centerX), _mm_mul_ps(planeY[planeIndex], centerY)), _mm_mul_ps(planeZ[planeIndex], centerZ)), planeW[planeIndex]);
+				visible = _mm_and_ps(visible, _mm_cmpnlt_ps(distance, negativeRadius));
+			}
+
+			if (_mm_movemask_ps(visible) == 0)
+			{
+				continue;
+			}
+
+			__m128 localAxisX = _mm_loadu_ps(&m_axisX[first]);
+			__m128 localAxisY = _mm_loadu_ps(&m_axisY[first]);
+			__m128 localAxisZ = _mm_loadu_ps(&m_axisZ[first]);
+
+			__m128 axisX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ix, localAxisX), _mm_mul_ps(jx, localAxisY)), _mm_mul_ps(kx, localAxisZ));
+			__m128 axisY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(iy, localAxisX), _mm_mul_ps(jy, localAxisY)), _mm_mul_ps(ky, localAxisZ));
+			__m128 axisZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(iz, localAxisX), _mm_mul_ps(jz, localAxisY)), _mm_mul_ps(kz, localAxisZ));
+
+			__m128 axisLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(axisX, axisX), _mm_mul_ps(axisY, axisY)), _mm_mul_ps(axisZ, axisZ)));
+			axisX = _mm_div_ps(axisX, axisLength);
+			axisY = _mm_div_ps(axisY, axisLength);
+			axisZ = _mm_div_ps(axisZ, axisLength);
+
+			__m128 apexOffset = _mm_mul_ps(_mm_loadu_ps(&m_apexOffset[first]), scale);
+
+			__m128 toViewX = _mm_sub_ps(viewX, _mm_sub_ps(centerX, _mm_mul_ps(axisX, apexOffset)));
+			__m128 toViewY = _mm_sub_ps(viewY, _mm_sub_ps(centerY, _mm_mul_ps(axisY, apexOffset)));
+			__m128 toViewZ = _mm_sub_ps(viewZ, _mm_sub_ps(centerZ, _mm_mul_ps(axisZ, apexOffset)));
+
+			__m128 toViewLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(toViewX, toViewX), _mm_mul_ps(toViewY, toViewY)), _mm_mul_ps(toViewZ, toViewZ)));
+			toViewX = _mm_div_ps(toViewX, toViewLength);
+			toViewY = _mm_div_ps(toViewY, toViewLength);
+			toViewZ = _mm_div_ps(toViewZ, toViewLength);
+
+			__m128 viewDotAxis = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toViewX, axisX), _mm_mul_ps(toViewY, axisY)), _mm_mul_ps(toViewZ, axisZ));
+			__m128 isBackFacing = _mm_cmpgt_ps(_mm_xor_ps(viewDotAxis, signMask), _mm_loadu_ps(&m_coneCutoff[first]));
+
+			int visibleMask = _mm_movemask_ps(_mm_andnot_ps(isBackFacing, visible));
+
+			while (visibleMask != 0)
+			{
+				int lane = 0;
+
+				while ((visibleMask & (1 << lane)) == 0)
+				{
+					lane++;
+				}
+
+				visibleMask &= visibleMask - 1;
+
+				VisibleMeshlet visibleMeshlet;
+				visibleMeshlet.m_instanceIndex = instanceIndex;
+				visibleMeshlet.m_meshletIndex = (uint32_t)first + (uint32_t)lane;
+				outVisibleMeshlets.push_back(visibleMeshlet);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+uint32_t MeshletCuller::GetNumMeshlets() const
+{
+	return m_numMeshlets;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Renderer/MeshProcessing.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------
+// One meshlet of one instance that survived culling
+//------------------------------------------------------------------------------------------------
+struct VisibleMeshlet
+{
+	uint32_t						m_instanceIndex			= 0;
+	uint32_t						m_meshletIndex			= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// CPU version of the amplification shader's per-meshlet test. A meshlet is visible unless its
+// bounding sphere is fully behind one frustum plane, or the view position lies inside its inverted
+// normal cone, where every triangle faces away. Planes are read as the shader reads the uploaded
+// Plane3D, dot(normal, p) + distance >= 0 inside, and a cone whose cutoff byte is 255 is treated
+// as degenerate and never culls.
+//
+// SetCullData swizzles the cull data into groups of four once per mesh, so Cull can test four
+// meshlets per SSE instruction. Results, including their order, match IsMeshletVisible exactly.
+//------------------------------------------------------------------------------------------------
+class MeshletCuller
+{
+	std::vector<float>				m_centerX;
+	std::vector<float>				m_centerY;
+	std::vector<float>				m_centerZ;
+	std::vector<float>				m_radius;
+	std::vector<float>				m_axisX;
+	std::vector<float>				m_axisY;
+	std::vector<float>				m_axisZ;
+	std::vector<float>				m_coneCutoff;
+	std::vector<float>				m_apexOffset;
+	uint32_t						m_numMeshlets			= 0;
+public:
+									MeshletCuller() = default;
+									~MeshletCuller() = default;
+
+	void							SetCullData(CullData const* cullData, uint32_t numMeshlets);
+	void							Cull(MeshletInstance const* instances, uint32_t numInstances, Frustum const& frustum, Vec3 const& cullViewPosition, std::vector<VisibleMeshlet>& outVisibleMeshlets) const;
+
+	uint32_t						GetNumMeshlets() const;
+};
+
+bool								IsMeshletVisible(CullData const& cullData, MeshletInstance const& instance, Frustum const& frustum, Vec3 const& cullViewPosition);
+void								CullMeshletsScalar(CullData const* cullData, uint32_t numMeshlets, MeshletInstance const* instances, uint32_t numInstances, Frustum const& frustum, Vec3 const& cullViewPosition, std::vector<VisibleMeshlet>& outVisibleMeshlets);
@@ -6,105 +6,52 @@
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
 
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
 #include <filesystem>
-
-bool ObjLoader::Load(std::string const& fileName, Mat44 const& transform, std::vector<Vertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs)
+#include <string.h>
+#include <thread>
+#include <xmmintrin.h>
+
+//------------------------------------------------------------------------------------------------
+// Maps the file and parses it on the job system; a file that cannot be opened is reported
+//------------------------------------------------------------------------------------------------
+static bool ParseObjFile(std::string const& fileName, ObjData& outData)
 {
-	std::vector<Vec3> posArr;
-	std::vector<Vec2> uvArr;
-	std::vector<Vec3> normArr;
-	std::vector<Face> faceArr;
-	std::unordered_map<std::string, Rgba8> materialLibrary;
-
-	std::string strr;
-	std::string filePath = fileName;
-
-	FileReadToString(strr, filePath);
-
-	Strings st;
-
-	std::string currentFaceMaterial;
-
-	int w = SplitStringOnDelimiter(st, strr, "\r\n");
+	MappedFile objFile;
 
-	if (w == 1)
+	if (!objFile.Open(fileName))
 	{
-		for (int i = 0; i < (int)st.size(); i++)
-		{
-			ParsingMaterialFile(st[i], materialLibrary);
-		}
-	}
-	else
-	{
-		w = SplitStringOnDelimiter(st, strr, "\n");
-
-		if (w == 1)
-		{
-			for (int i = 0; i < (int)st.size(); i++)
-			{
-				ParsingMaterialFile(st[i], materialLibrary);
-			}
-		}
+		ERROR_RECOVERABLE(Stringf("Could not open OBJ file \"%s\"", fileName.c_str()));
+		return false;
 	}
 
-	if (w == 1)
-	{
-		Strings faceMaterialInfo;
+	ObjLoader::ParseObjTextParallel(objFile.GetText(), outData);
 
-		for (int i = 0; i < (int)st.size(); i++)
-		{
-			ParsingVertexPos(st[i], posArr);
-			ParsingVertexUVs(st[i], uvArr, outHasUVs);
-			ParsingVertexNormals(st[i], normArr, outHasNormals);
+	return true;
+}
 
-			if (st[i].substr(0, 6) == "usemtl")
-			{
-				faceMaterialInfo = SplitStringOnDelimiter(st[i], ' ');
-			}
+//------------------------------------------------------------------------------------------------
+// Keeps one vertex per face vertex: the normals are rebuilt flat per triangle, which only works
+// while no two faces share a vertex
+//------------------------------------------------------------------------------------------------
+bool ObjLoader::Load(std::string const& fileName, Mat44 const& transform, std::vector<Vertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs)
+{
+	ObjData objData;
 
-			if (faceMaterialInfo.size() == 2)
-			{
-				ParsingFaces(st[i], faceArr, materialLibrary[faceMaterialInfo[1]]);
-			}
-			else
-			{
-				ParsingFaces(st[i], faceArr);
-			}
-		}
-	}
-	else
+	if (!ParseObjFile(fileName, objData))
 	{
-		w = SplitStringOnDelimiter(st, strr, "\n");
-
-		if (w == 1)
-		{
-			Strings faceMaterialInfo;
-
-			for (int i = 0; i < (int)st.size(); i++)
-			{
-				ParsingVertexPos(st[i], posArr);
-				ParsingVertexUVs(st[i], uvArr, outHasUVs);
-				ParsingVertexNormals(st[i], normArr, outHasNormals);
-
-				if (st[i].substr(0, 6) == "usemtl")
-				{
-					faceMaterialInfo = SplitStringOnDelimiter(st[i], ' ');
-				}
-
-				if (faceMaterialInfo.size() == 2)
-				{
-					ParsingFaces(st[i], faceArr, materialLibrary[faceMaterialInfo[1]]);
-				}
-				else
-				{
-					ParsingFaces(st[i], faceArr);
-				}
-			}
-		}
+		return false;
 	}
 
-	GenerateVerticesAndIndices(faceArr, posArr, uvArr, normArr, outVertices, outIndices);
+	outHasNormals = objData.m_hasNormals;
+	outHasUVs = objData.m_hasUVs;
+
+	GenerateVerticesAndIndices(objData, outVertices, outIndices);
 
 	TransformVertexArray3D(outVertices, transform, outHasNormals);
 
@@ -113,104 +60,50 @@ bool ObjLoader::Load(std::string const& fileName, Mat44 const& transform, std::v
 
 #if DX12_RENDERER
 
-bool ObjLoader::Load(std::string const& fileName, Mat44 const& transform, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs)
+//------------------------------------------------------------------------------------------------
+// Welds face vertices that share {v, vt, vn} on the job system and appends the triangle indices,
+// offset by firstVertex; outUniqueFaceVertices lists the face vertex each output vertex comes from
+//------------------------------------------------------------------------------------------------
+static void WeldObjFaceVertices(ObjData const& data, uint32_t firstVertex, std::vector<uint32_t>& outUniqueFaceVertices, std::vector<unsigned int>& outIndices)
 {
-	UNUSED(transform);
-
-	std::vector<Vec3> posArr;
-	std::vector<Vec2> uvArr;
-	std::vector<Vec3> normArr;
-	std::vector<Face> faceArr;
-	std::unordered_map<std::string, Rgba8> materialLibrary;
-
-	std::string strr;
-	std::string filePath = fileName;
-
-	FileReadToString(strr, filePath);
-
-	Strings st;
-
-	std::string currentFaceMaterial;
+	std::vector<uint32_t> faceVertexRemap;
+	ObjLoader::WeldFaceVertices(data, outUniqueFaceVertices, faceVertexRemap);
 
-	int w = SplitStringOnDelimiter(st, strr, "\r\n");
+	size_t firstIndex = outIndices.size();
+	ObjLoader::GenerateWeldedIndices(data, faceVertexRemap, outIndices);
 
-	if (w == 1)
+	for (size_t index = firstIndex; index < outIndices.size(); index++)
 	{
-		for (int i = 0; i < st.size(); i++)
-		{
-			ParsingMaterialFile(st[i], materialLibrary);
-		}
+		outIndices[index] += firstVertex;
 	}
-	else
-	{
-		w = SplitStringOnDelimiter(st, strr, "\n");
+}
 
-		if (w == 1)
-		{
-			for (int i = 0; i < st.size(); i++)
-			{
-				ParsingMaterialFile(st[i], materialLibrary);
-			}
-		}
-	}
+bool ObjLoader::Load(std::string const& fileName, Mat44 const& transform, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs)
+{
+	ObjData objData;
 
-	if (w == 1)
+	if (!ParseObjFile(fileName, objData))
 	{
-		Strings faceMaterialInfo;
-
-		for (int i = 0; i < st.size(); i++)
-		{
-			ParsingVertexPos(st[i], posArr);
-			ParsingVertexUVs(st[i], uvArr, outHasUVs);
-			ParsingVertexNormals(st[i], normArr, outHasNormals);
-
-			if (st[i].substr(0, 6) == "usemtl")
-			{
-				faceMaterialInfo = SplitStringOnDelimiter(st[i], ' ');
-			}
-
-			if (faceMaterialInfo.size() == 2)
-			{
-				ParsingFaces(st[i], faceArr, materialLibrary[faceMaterialInfo[1]]);
-			}
-			else
-			{
-				ParsingFaces(st[i], faceArr);
-			}
-		}
+		return false;
 	}
-	else
-	{
-		w = SplitStringOnDelimiter(st, strr, "\n");
 
-		if (w == 1)
-		{
-			Strings faceMaterialInfo;
+	outHasNormals = objData.m_hasNormals;
+	outHasUVs = objData.m_hasUVs;
 
-			for (int i = 0; i < st.size(); i++)
-			{
-				ParsingVertexPos(st[i], posArr);
-				ParsingVertexUVs(st[i], uvArr, outHasUVs);
-				ParsingVertexNormals(st[i], normArr, outHasNormals);
+	std::vector<uint32_t> uniqueFaceVertices;
+	WeldObjFaceVertices(objData, (uint32_t)outVertices.size(), uniqueFaceVertices, outIndices);
 
-				if (st[i].substr(0, 6) == "usemtl")
-				{
-					faceMaterialInfo = SplitStringOnDelimiter(st[i], ' ');
-				}
+	outVertices.reserve(outVertices.size() + uniqueFaceVertices.size());
 
-				if (faceMaterialInfo.size() == 2)
-				{
-					ParsingFaces(st[i], faceArr, materialLibrary[faceMaterialInfo[1]]);
-				}
-				else
-				{
-					ParsingFaces(st[i], faceArr);
-				}
-			}
-		}
-	}
+	for (uint32_t faceVertexIndex : uniqueFaceVertices)
+	{
+		Vec3 position;
+		Vec2 uv;
+		Vec3 normal;
+		GetFaceVertexAttributes(objData, objData.m_faceVertices[faceVertexIndex], position, uv, normal);
 
-	GenerateVerticesAndIndices(faceArr, posArr, uvArr, normArr, outVertices, outIndices);
+		outVertices.push_back(MeshVertex_PCU(position, Vec4::ONE, uv));
+	}
 
 	TransformVertexArray3D(outVertices, transform, outHasNormals);
 
@@ -221,100 +114,32 @@ bool ObjLoader::Load(std::string const& fileName, Mat44 const& transform, std::v
 {
 	UNUSED(transform);
 
-	std::vector<Vec3> posArr;
-	std::vector<Vec2> uvArr;
-	std::vector<Vec3> normArr;
-	std::vector<Face> faceArr;
-	std::unordered_map<std::string, Rgba8> materialLibrary;
-
-	std::string strr;
-	std::string filePath = fileName;
+	ObjData objData;
 
-	FileReadToString(strr, filePath);
-
-	Strings st;
-
-	std::string currentFaceMaterial;
-
-	int w = SplitStringOnDelimiter(st, strr, "\r\n");
-
-	if (w == 1)
-	{
-		for (int i = 0; i < st.size(); i++)
-		{
-			ParsingMaterialFile(st[i], materialLibrary);
-		}
-	}
-	else
+	if (!ParseObjFile(fileName, objData))
 	{
-		w = SplitStringOnDelimiter(st, strr, "\n");
-
-		if (w == 1)
-		{
-			for (int i = 0; i < st.size(); i++)
-			{
-				ParsingMaterialFile(st[i], materialLibrary);
-			}
-		}
+		return false;
 	}
 
-	if (w == 1)
-	{
-		Strings faceMaterialInfo;
+	outHasNormals = objData.m_hasNormals;
+	outHasUVs = objData.m_hasUVs;
 
-		for (int i = 0; i < st.size(); i++)
-		{
-			ParsingVertexPos(st[i], posArr);
-			ParsingVertexUVs(st[i], uvArr, outHasUVs);
-			ParsingVertexNormals(st[i], normArr, outHasNormals);
+	std::vector<uint32_t> uniqueFaceVertices;
+	WeldObjFaceVertices(objData, (uint32_t)outVertices.size(), uniqueFaceVertices, outIndices);
 
-			if (st[i].substr(0, 6) == "usemtl")
-			{
-				faceMaterialInfo = SplitStringOnDelimiter(st[i], ' ');
-			}
+	outVertices.reserve(outVertices.size() + uniqueFaceVertices.size());
 
-			if (faceMaterialInfo.size() == 2)
-			{
-				ParsingFaces(st[i], faceArr, materialLibrary[faceMaterialInfo[1]]);
-			}
-			else
-			{
-				ParsingFaces(st[i], faceArr);
-			}
-		}
-	}
-	else
+	for (uint32_t faceVertexIndex : uniqueFaceVertices)
 	{
-		w = SplitStringOnDelimiter(st, strr, "\n");
-
-		if (w == 1)
-		{
-			Strings faceMaterialInfo;
-
-			for (int i = 0; i < st.size(); i++)
-			{
-				ParsingVertexPos(st[i], posArr);
-				ParsingVertexUVs(st[i], uvArr, outHasUVs);
-				ParsingVertexNormals(st[i], normArr, outHasNormals);
-
-				if (st[i].substr(0, 6) == "usemtl")
-				{
-					faceMaterialInfo = SplitStringOnDelimiter(st[i], ' ');
-				}
+		Vec3 position;
+		Vec2 uv;
+		Vec3 normal;
+		GetFaceVertexAttributes(objData, objData.m_faceVertices[faceVertexIndex], position, uv, normal);
 
-				if (faceMaterialInfo.size() == 2)
-				{
-					ParsingFaces(st[i], faceArr, materialLibrary[faceMaterialInfo[1]]);
-				}
-				else
-				{
-					ParsingFaces(st[i], faceArr);
-				}
-			}
-		}
+		outVertices.push_back(MeshVertex_PCUTBN(position, Vec4::ONE, uv, normal));
 	}
 
-	GenerateVerticesAndIndices(faceArr, posArr, uvArr, normArr, outVertices, outIndices);
+	CalculateTangentSpaceBasisVectors(outVertices, outIndices, true, false);
 
 	//TransformVertexArray3D(outVertices, transform, outHasNormals);
 
@@ -326,7 +151,7 @@ bool ObjLoader::LoadXML(std::string const& fileName, Mat44 const& transform, std
 	UNUSED(transform);
 
 	tinyxml2::XMLDocument document;
-	if (document.LoadFile(fileName.c_str()) == tinyxml2::XML_SUCCESS)
+	if (LoadXmlDocument(document, fileName) == tinyxml2::XML_SUCCESS)
 	{
 		// Get the root element 
 		tinyxml2::XMLElement* rootElement = document.RootElement();
@@ -393,498 +218,1293 @@ bool ObjLoader::LoadXML(std::string const& fileName, Mat44 const& transform, std
 }
 #endif
 
-void ObjLoader::ParsingVertexPos(std::string line, std::vector<Vec3>& positions)
+//------------------------------------------------------------------------------------------------
+struct ObjElementCounts
 {
-	if (line[0] == 'v' && line[1] == ' ')
-	{
-		Strings positionStrings;
-
-		std::string sug = line;
+	size_t m_numPositions		= 0;
+	size_t m_numUVs				= 0;
+	size_t m_numNormals			= 0;
+	size_t m_numFaces			= 0;
+	size_t m_numFaceVertices	= 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// m_name is empty for a usemtl that doesn't name exactly one material
+//------------------------------------------------------------------------------------------------
+struct ObjMaterialSwitch
+{
+	uint32_t			m_firstFace		= 0;
+	std::string_view	m_name;
+};
 
-		int d = SplitStringOnDelimiter(positionStrings, sug, "  ");
+struct ObjMaterialState
+{
+	std::vector<std::string_view>	m_materialLibraryLines;
+	std::vector<ObjMaterialSwitch>	m_materialSwitches;
+};
 
-		if (d == 1)
-		{
-			int c = SplitStringOnDelimiter(positionStrings, sug, "   ");
+//------------------------------------------------------------------------------------------------
+static bool IsObjSpace(char character)
+{
+	return character == ' ' || character == '\t';
+}
 
-			if (c == 1)
-			{
-				positionStrings = SplitStringOnDelimiter(sug, ' ');
+//------------------------------------------------------------------------------------------------
+static char const* SkipObjSpaces(char const* cursor, char const* lineEnd)
+{
+	while (cursor < lineEnd && IsObjSpace(*cursor))
+	{
+		cursor++;
+	}
 
-				float x = (float)std::atof(positionStrings[3].c_str());
-				float y = (float)std::atof(positionStrings[4].c_str());
-				float z = (float)std::atof(positionStrings[5].c_str());
+	return cursor;
+}
 
-				positions.push_back(Vec3(x, y, z));
-			}
-			else
-			{
-				positionStrings = SplitStringOnDelimiter(sug, ' ');
+//------------------------------------------------------------------------------------------------
+static char const* FindObjSpace(char const* cursor, char const* lineEnd)
+{
+	while (cursor < lineEnd && !IsObjSpace(*cursor))
+	{
+		cursor++;
+	}
 
-				float x = (float)std::atof(positionStrings[2].c_str());
-				float y = (float)std::atof(positionStrings[3].c_str());
-				float z = (float)std::atof(positionStrings[4].c_str());
+	return cursor;
+}
 
-				positions.push_back(Vec3(x, y, z));
-			}
-		}
-		else
-		{
-			positionStrings = SplitStringOnDelimiter(sug, ' ');
+//------------------------------------------------------------------------------------------------
+// Returns the end of the line starting at cursor, without its "\r\n" or "\n", and where the next
+// line starts.
+//------------------------------------------------------------------------------------------------
+static char const* FindObjLineEnd(char const* cursor, char const* textEnd, char const*& outNextLine)
+{
+	char const* lineEnd = (char const*)memchr(cursor, '\n', (size_t)(textEnd - cursor));
 
-			float x = (float)std::atof(positionStrings[1].c_str());
-			float y = (float)std::atof(positionStrings[2].c_str());
-			float z = (float)std::atof(positionStrings[3].c_str());
+	if (lineEnd)
+	{
+		outNextLine = lineEnd + 1;
+	}
+	else
+	{
+		lineEnd = textEnd;
+		outNextLine = textEnd;
+	}
 
-			positions.push_back(Vec3(x, y, z));
-		}
+	if (lineEnd > cursor && lineEnd[-1] == '\r')
+	{
+		lineEnd--;
 	}
+
+	return lineEnd;
 }
 
-void ObjLoader::ParsingVertexUVs(std::string line, std::vector<Vec2>& uvs, bool& outHasUVs)
+//------------------------------------------------------------------------------------------------
+// True if the line at cursor is the keyword followed by a blank; cursor is left after the keyword
+//------------------------------------------------------------------------------------------------
+static bool IsObjKeyword(char const*& cursor, char const* lineEnd, char const* keyword, size_t keywordLength)
 {
-	if (line[0] == 'v' && line[1] == 't')
+	if ((size_t)(lineEnd - cursor) <= keywordLength || memcmp(cursor, keyword, keywordLength) != 0 || !IsObjSpace(cursor[keywordLength]))
 	{
-		outHasUVs = true;
-
-		Strings uv;
-
-		std::string sug = line;
-
-		int d = SplitStringOnDelimiter(uv, sug, "  ");
-		int c = SplitStringOnDelimiter(uv, sug, "   ");
-
-		if (d == 1)
-		{
-			uv = SplitStringOnDelimiter(sug, ' ');
-
-			float u = (float)std::atof(uv[1].c_str());
-			float v = (float)std::atof(uv[2].c_str());
+		return false;
+	}
 
-			uvs.push_back(Vec2(u, v));
-		}
-		else if(c == 1)
-		{
-			uv = SplitStringOnDelimiter(sug, ' ');
+	cursor += keywordLength;
+	return true;
+}
 
-			float u = (float)std::atof(uv[1].c_str());
-			float v = (float)std::atof(uv[2].c_str());
+//------------------------------------------------------------------------------------------------
+static bool IsObjDigit(char character)
+{
+	return character >= '0' && character <= '9';
+}
 
-			uvs.push_back(Vec2(u, v));
-		}
-		else
-		{
-			uv = SplitStringOnDelimiter(sug, ' ');
+//------------------------------------------------------------------------------------------------
+// Slow path for anything the fast path can't round exactly. Fields are whole blank-separated tokens:
+// trailing junk after a number is skipped and a field that does not parse keeps its default.
+//------------------------------------------------------------------------------------------------
+static char const* ParseObjFloatFromChars(char const* cursor, char const* lineEnd, float& outValue)
+{
+	if (cursor < lineEnd && *cursor == '+')
+	{
+		cursor++;
+	}
 
-			float u = (float)std::atof(uv[1].c_str());
-			float v = (float)std::atof(uv[2].c_str());
+	std::from_chars(cursor, lineEnd, outValue);
 
-			uvs.push_back(Vec2(u, v));
-		}
-	}
+	return FindObjSpace(cursor, lineEnd);
 }
 
-void ObjLoader::ParsingVertexNormals(std::string line, std::vector<Vec3>& normals, bool& outHasNormals)
+//------------------------------------------------------------------------------------------------
+// Clinger's fast path: with at most 2^53 in the mantissa and a power of ten of at most 10^22, one
+// double multiply or divide is correctly rounded. Narrowing to float can round twice only when the
+// double lands exactly halfway between two floats, so those, and everything else, go to from_chars.
+//------------------------------------------------------------------------------------------------
+static char const* ParseObjFloat(char const* cursor, char const* lineEnd, float& outValue)
 {
-	if (line[0] == 'v' && line[1] == 'n')
+	static double const s_powersOfTen[] =
 	{
-		outHasNormals = true;
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
 
-		Strings normal;
+	cursor = SkipObjSpaces(cursor, lineEnd);
 
-		std::string sug = line;
+	char const* numberBegin = cursor;
+	bool isNegative = cursor < lineEnd && *cursor == '-';
 
-		int d = SplitStringOnDelimiter(normal, sug, "  ");
-		int c = SplitStringOnDelimiter(normal, sug, "   ");
+	if (cursor < lineEnd && (*cursor == '-' || *cursor == '+'))
+	{
+		cursor++;
+	}
 
-		if (d == 1)
-		{
-			normal = SplitStringOnDelimiter(sug, ' ');
+	uint64_t mantissa = 0;
+	int numSignificantDigits = 0;
+	int numDigits = 0;
+	int exponent = 0;
 
-			float normX = (float)std::atof(normal[1].c_str());
-			float normY = (float)std::atof(normal[2].c_str());
-			float normZ = (float)std::atof(normal[3].c_str());
+	for (; cursor < lineEnd && IsObjDigit(*cursor); cursor++, numDigits++)
+	{
+		mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+		numSignificantDigits += mantissa != 0 ? 1 : 0;
+	}
 
-			normals.push_back(Vec3(normX, normY, normZ));
-		}
-		else if(c == 1)
+	if (cursor < lineEnd && *cursor == '.')
+	{
+		for (cursor++; cursor < lineEnd && IsObjDigit(*cursor); cursor++, numDigits++)
 		{
-			normal = SplitStringOnDelimiter(sug, ' ');
+			mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+			numSignificantDigits += mantissa != 0 ? 1 : 0;
+			exponent--;
+		}
+	}
 
-			float normX = (float)std::atof(normal[1].c_str());
-			float normY = (float)std::atof(normal[2].c_str());
-			float normZ = (float)std::atof(normal[3].c_str());
+	if (cursor < lineEnd && (*cursor == 'e' || *cursor == 'E'))
+	{
+		char const* exponentCursor = cursor + 1;
+		bool isExponentNegative = exponentCursor < lineEnd && *exponentCursor == '-';
 
-			normals.push_back(Vec3(normX, normY, normZ));
-		}
-		else
+		if (exponentCursor < lineEnd && (*exponentCursor == '-' || *exponentCursor == '+'))
 		{
-			normal = SplitStringOnDelimiter(sug, ' ');
+			exponentCursor++;
+		}
 
-			float normX = (float)std::atof(normal[1].c_str());
-			float normY = (float)std::atof(normal[2].c_str());
-			float normZ = (float)std::atof(normal[3].c_str());
+		int exponentValue = 0;
+		char const* exponentDigits = exponentCursor;
 
-			normals.push_back(Vec3(normX, normY, normZ));
+		for (; exponentCursor < lineEnd && IsObjDigit(*exponentCursor) && exponentValue < 10000; exponentCursor++)
+		{
+			exponentValue = exponentValue * 10 + (*exponentCursor - '0');
+		}
+
+		if (exponentCursor > exponentDigits)
+		{
+			exponent += isExponentNegative ? -exponentValue : exponentValue;
+			cursor = exponentCursor;
 		}
 	}
-}
 
-void ObjLoader::ParsingFaces(std::string line, std::vector<Face>& outFaces, Rgba8 faceColor)
-{
-	if (line[0] == 'f')
-	{
-		Strings faces;
+	bool isFastPath = numDigits > 0 && numSignificantDigits <= 19 && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22
+		&& (cursor == lineEnd || IsObjSpace(*cursor));
 
-		std::string sug = line;
+	if (isFastPath)
+	{
+		double value = (double)mantissa;
+		value = exponent < 0 ? value / s_powersOfTen[-exponent] : value * s_powersOfTen[exponent];
 
-		faces = SplitStringOnDelimiter(sug, ' ');
+		uint64_t valueBits;
+		memcpy(&valueBits, &value, sizeof(valueBits));
 
-		Face face;
+		float narrowed = (float)value;
+		bool isHalfway = (valueBits & 0x1FFFFFFFull) == 0x10000000ull;
+		bool isNormal = value == 0.0 || (fabsf(narrowed) >= FLT_MIN && fabsf(narrowed) <= FLT_MAX);
 
-		for (int j = 1; j < (int)faces.size(); j++)
+		if (!isHalfway && isNormal)
 		{
-			Strings faceInfo;
-
-			int d = SplitStringOnDelimiter(faceInfo, faces[j], "//");
+			outValue = isNegative ? -narrowed : narrowed;
+			return cursor;
+		}
+	}
 
-			if (d == 1)
-			{
-				Vertex vert;
+	return ParseObjFloatFromChars(numberBegin, lineEnd, outValue);
+}
 
-				if (faceInfo.size() == 2)
-				{
-					vert.m_v = std::atoi(faceInfo[0].c_str());
-					vert.m_vt = -1;
-					vert.m_vn = std::atoi(faceInfo[1].c_str());
+//------------------------------------------------------------------------------------------------
+static bool IsObjIndexFieldEnd(char const* cursor, char const* lineEnd)
+{
+	return cursor == lineEnd || *cursor == '/' || IsObjSpace(*cursor);
+}
 
-					face.m_vertices.push_back(vert);
-					continue;
-				}
-				else if (faceInfo.size() == 1)
-				{
-					vert.m_v = std::atoi(faceInfo[0].c_str());
-					vert.m_vt = -1;
-					vert.m_vn = -1;
+//------------------------------------------------------------------------------------------------
+// Parses one index field, which ends at a '/', a blank or the line end, and returns its end. Plain
+// digits are accumulated in the same scan; anything else goes to from_chars, matching ParseInt. An
+// empty or unparsable field keeps its default.
+//------------------------------------------------------------------------------------------------
+static char const* ParseObjIndex(char const* cursor, char const* lineEnd, int& outIndex)
+{
+	char const* fieldBegin = cursor;
+	int value = 0;
+	int numDigits = 0;
 
-					face.m_vertices.push_back(vert);
-					continue;
-				}
-			}
+	for (; cursor < lineEnd && IsObjDigit(*cursor) && numDigits < 9; cursor++, numDigits++)
+	{
+		value = value * 10 + (*cursor - '0');
+	}
 
-			faceInfo = SplitStringOnDelimiter(faces[j], '/');
+	if (numDigits > 0 && IsObjIndexFieldEnd(cursor, lineEnd))
+	{
+		outIndex = value;
+		return cursor;
+	}
 
-			if (faceInfo.size() == 1)
-			{
-				Vertex vert;
+	while (!IsObjIndexFieldEnd(cursor, lineEnd))
+	{
+		cursor++;
+	}
 
-				vert.m_v = std::atoi(faceInfo[0].c_str());
-				vert.m_vt = -1;
-				vert.m_vn = -1;
+	if (fieldBegin < cursor && *fieldBegin == '+')
+	{
+		fieldBegin++;
+	}
 
-				face.m_vertices.push_back(vert);
-				continue;
-			}
-			else if (faceInfo.size() == 2)
-			{
-				Vertex vert;
+	std::from_chars(fieldBegin, cursor, outIndex);
 
-				vert.m_v = std::atoi(faceInfo[0].c_str());
-				vert.m_vt = std::atoi(faceInfo[1].c_str());
-				vert.m_vn = -1;
+	return cursor;
+}
 
-				face.m_vertices.push_back(vert);
-				continue;
-			}
-			else if (faceInfo.size() == 3)
-			{
-				Vertex vert;
+//------------------------------------------------------------------------------------------------
+// v, v/vt, v//vn or v/vt/vn; an empty or missing vt or vn stays -1. Returns the end of the token.
+//------------------------------------------------------------------------------------------------
+static char const* ParseObjFaceVertex(char const* cursor, char const* lineEnd, Vertex& outVertex)
+{
+	cursor = ParseObjIndex(cursor, lineEnd, outVertex.m_v);
 
-				vert.m_v = std::atoi(faceInfo[0].c_str());
-				vert.m_vt = std::atoi(faceInfo[1].c_str());
-				vert.m_vn = std::atoi(faceInfo[2].c_str());
+	if (cursor < lineEnd && *cursor == '/')
+	{
+		cursor = ParseObjIndex(cursor + 1, lineEnd, outVertex.m_vt);
 
-				face.m_vertices.push_back(vert);
-				continue;
-			}
+		if (cursor < lineEnd && *cursor == '/')
+		{
+			cursor = ParseObjIndex(cursor + 1, lineEnd, outVertex.m_vn);
 		}
-
-		face.m_color = faceColor;
-
-		outFaces.push_back(face);
 	}
+
+	return FindObjSpace(cursor, lineEnd);
 }
 
-void ObjLoader::ParsingMaterialFile(std::string line, std::unordered_map<std::string, Rgba8>& outMaterialLib)
+//------------------------------------------------------------------------------------------------
+// Pre-pass: counts every element so the real pass never reallocates
+//------------------------------------------------------------------------------------------------
+static void CountObjElements(std::string_view text, ObjElementCounts& outCounts)
 {
-	std::string matrialFile = line.substr(0, 6);
+	char const* cursor = text.data();
+	char const* textEnd = cursor + text.size();
+	char const* nextLine = cursor;
 
-	if (matrialFile == "mtllib")
+	for (; cursor < textEnd; cursor = nextLine)
 	{
-		Strings materialInfo;
+		char const* lineEnd = FindObjLineEnd(cursor, textEnd, nextLine);
+		cursor = SkipObjSpaces(cursor, lineEnd);
 
-		std::string sug = line;
+		if (lineEnd - cursor < 2)
+		{
+			continue;
+		}
 
-		materialInfo = SplitStringOnDelimiter(sug, ' ');
+		if (cursor[0] == 'v')
+		{
+			outCounts.m_numPositions += IsObjSpace(cursor[1]) ? 1 : 0;
+			outCounts.m_numUVs += cursor[1] == 't' ? 1 : 0;
+			outCounts.m_numNormals += cursor[1] == 'n' ? 1 : 0;
+		}
+		else if (cursor[0] == 'f' && IsObjSpace(cursor[1]))
+		{
+			// One vertex per space is exact for single-spaced faces and only a reserve hint otherwise
+			outCounts.m_numFaces++;
+			outCounts.m_numFaceVertices += (size_t)std::count(cursor + 1, lineEnd, ' ');
+		}
+	}
+}
 
-		Strings materialStrings;
+//------------------------------------------------------------------------------------------------
+// Scans the text once with raw pointers: no per-line strings or vectors, floats and indices are
+// parsed straight out of the text, and every array is reserved from the pre-pass. Faces are left
+// white; mtllib lines and usemtl switches are recorded and applied once the whole file is parsed,
+// since a usemtl may come before its mtllib or in another chunk.
+//------------------------------------------------------------------------------------------------
+static void ParseObjChunk(std::string_view text, ObjData& outData, ObjMaterialState& outMaterialState)
+{
+	ObjElementCounts counts;
+	CountObjElements(text, counts);
 
-		std::string materialString;
-		std::string materialFilePath = "Data/Models/" + materialInfo[1];
+	outData.m_positions.reserve(outData.m_positions.size() + counts.m_numPositions);
+	outData.m_uvs.reserve(outData.m_uvs.size() + counts.m_numUVs);
+	outData.m_normals.reserve(outData.m_normals.size() + counts.m_numNormals);
+	outData.m_faces.reserve(outData.m_faces.size() + counts.m_numFaces);
+	outData.m_faceVertices.reserve(outData.m_faceVertices.size() + counts.m_numFaceVertices);
 
-		FileReadToString(materialString, materialFilePath);
+	char const* cursor = text.data();
+	char const* textEnd = cursor + text.size();
+	char const* nextLine = cursor;
 
-		int materialSplit = SplitStringOnDelimiter(materialStrings, materialString, "\n");
+	for (; cursor < textEnd; cursor = nextLine)
+	{
+		char const* lineEnd = FindObjLineEnd(cursor, textEnd, nextLine);
+		cursor = SkipObjSpaces(cursor, lineEnd);
 
-		if (materialSplit == 1)
+		if (lineEnd - cursor < 2)
 		{
-			std::string materialName;
+			continue;
+		}
 
-			for (int j = 0; j < (int)materialStrings.size(); j++)
-			{
-				if (materialStrings[j].substr(0, 6) == "newmtl")
-				{
-					Strings newMaterial;
+		if (cursor[0] == 'v' && IsObjSpace(cursor[1]))
+		{
+			Vec3 position;
+			cursor = ParseObjFloat(cursor + 1, lineEnd, position.x);
+			cursor = ParseObjFloat(cursor, lineEnd, position.y);
+			ParseObjFloat(cursor, lineEnd, position.z);
+
+			outData.m_positions.push_back(position);
+		}
+		else if (cursor[0] == 'v' && cursor[1] == 't')
+		{
+			outData.m_hasUVs = true;
 
-					newMaterial = SplitStringOnDelimiter(materialStrings[j], ' ');
+			Vec2 uv;
+			cursor = ParseObjFloat(cursor + 2, lineEnd, uv.x);
+			ParseObjFloat(cursor, lineEnd, uv.y);
 
-					materialName = newMaterial[1];
-				}
+			outData.m_uvs.push_back(uv);
+		}
+		else if (cursor[0] == 'v' && cursor[1] == 'n')
+		{
+			outData.m_hasNormals = true;
 
-				if (materialStrings[j].substr(0, 2) == "Kd")
-				{
-					Strings materialDiffuseColor;
+			Vec3 normal;
+			cursor = ParseObjFloat(cursor + 2, lineEnd, normal.x);
+			cursor = ParseObjFloat(cursor, lineEnd, normal.y);
+			ParseObjFloat(cursor, lineEnd, normal.z);
 
-					materialDiffuseColor = SplitStringOnDelimiter(materialStrings[j], ' ');
+			outData.m_normals.push_back(normal);
+		}
+		else if (cursor[0] == 'f' && IsObjSpace(cursor[1]))
+		{
+			Face face;
+			face.m_firstVertex = (uint32_t)outData.m_faceVertices.size();
 
-					Rgba8 color;
+			for (cursor = SkipObjSpaces(cursor + 1, lineEnd); cursor < lineEnd; cursor = SkipObjSpaces(cursor, lineEnd))
+			{
+				Vertex faceVertex;
+				cursor = ParseObjFaceVertex(cursor, lineEnd, faceVertex);
+				outData.m_faceVertices.push_back(faceVertex);
+			}
 
-					float r = (float)std::atof(materialDiffuseColor[1].c_str());
-					float g = (float)std::atof(materialDiffuseColor[2].c_str());
-					float b = (float)std::atof(materialDiffuseColor[3].c_str());
+			face.m_numVertices = (uint32_t)outData.m_faceVertices.size() - face.m_firstVertex;
+			outData.m_faces.push_back(face);
+		}
+		else if (cursor[0] == 'u' && IsObjKeyword(cursor, lineEnd, "usemtl", 6))
+		{
+			// Anything but exactly one name selects white
+			char const* nameBegin = SkipObjSpaces(cursor, lineEnd);
+			char const* nameEnd = FindObjSpace(nameBegin, lineEnd);
 
-					color.r  = unsigned char(r * 255);
-					color.g  = unsigned char(g * 255);
-					color.b  = unsigned char(b * 255);
+			ObjMaterialSwitch materialSwitch;
+			materialSwitch.m_firstFace = (uint32_t)outData.m_faces.size();
 
-					outMaterialLib[materialName] = color;
-				}
+			if (nameBegin < nameEnd && SkipObjSpaces(nameEnd, lineEnd) == lineEnd)
+			{
+				materialSwitch.m_name = std::string_view(nameBegin, (size_t)(nameEnd - nameBegin));
 			}
+
+			outMaterialState.m_materialSwitches.push_back(materialSwitch);
+		}
+		else if (cursor[0] == 'm' && IsObjKeyword(cursor, lineEnd, "mtllib", 6))
+		{
+			char const* lineBegin = cursor - 6;
+			outMaterialState.m_materialLibraryLines.push_back(std::string_view(lineBegin, (size_t)(lineEnd - lineBegin)));
 		}
 	}
 }
 
-void ObjLoader::GenerateVerticesAndIndices(std::vector<Face> inFaces, std::vector<Vec3> positions, std::vector<Vec2> uvs, std::vector<Vec3> normals, std::vector<Vertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices)
+//------------------------------------------------------------------------------------------------
+static void ApplyObjMaterials(ObjMaterialState const& materialState, std::vector<Face>& faces)
 {
-	int index = 0;
+	if (materialState.m_materialSwitches.empty())
+	{
+		return;
+	}
+
+	std::unordered_map<std::string, Rgba8> materialLibrary;
 
-	for (int i = 0; i < (int)inFaces.size(); i++)
+	for (std::string_view materialLibraryLine : materialState.m_materialLibraryLines)
 	{
-		for (int j = 0; j < (int)inFaces[i].m_vertices.size(); j++)
-		{
-			Vertex faceVertex = inFaces[i].m_vertices[j];
-			Rgba8 faceColor = inFaces[i].m_color;
+		ObjLoader::ParsingMaterialFile(materialLibraryLine, materialLibrary);
+	}
 
-			Vertex_PCUTBN vertex;
+	std::vector<ObjMaterialSwitch> const& materialSwitches = materialState.m_materialSwitches;
 
-			vertex.m_position = positions[faceVertex.m_v - 1];
-			vertex.m_color = faceColor;
+	for (size_t switchIndex = 0; switchIndex < materialSwitches.size(); switchIndex++)
+	{
+		Rgba8 faceColor = Rgba8::WHITE;
+
+		if (!materialSwitches[switchIndex].m_name.empty())
+		{
+			auto materialIter = materialLibrary.find(std::string(materialSwitches[switchIndex].m_name));
 
-			if (uvs.size() == 0)
+			if (materialIter != materialLibrary.end())
 			{
-				vertex.m_uvTexCoords = Vec2::ZERO;
+				faceColor = materialIter->second;
 			}
-			else
+		}
+
+		size_t firstFace = materialSwitches[switchIndex].m_firstFace;
+		size_t endFace = switchIndex + 1 < materialSwitches.size() ? materialSwitches[switchIndex + 1].m_firstFace : faces.size();
+
+		for (size_t faceIndex = firstFace; faceIndex < endFace; faceIndex++)
+		{
+			faces[faceIndex].m_color = faceColor;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+void ObjLoader::ParseObjText(std::string_view text, ObjData& outData)
+{
+	ObjMaterialState materialState;
+
+	ParseObjChunk(text, outData, materialState);
+	ApplyObjMaterials(materialState, outData.m_faces);
+}
+
+//------------------------------------------------------------------------------------------------
+// Parses one line-aligned chunk into its own ObjData, then, once every chunk is parsed and the
+// offsets are known, copies it into its slice of the merged arrays.
+//------------------------------------------------------------------------------------------------
+class ObjParseChunkJob : public Job
+{
+public:
+	std::string_view				m_text;
+	ObjData							m_data;
+	ObjMaterialState				m_materialState;
+	ObjData*						m_mergedData			= nullptr;
+	ObjElementCounts				m_mergeOffsets;
+	bool							m_isMerging				= false;
+public:
+	ObjParseChunkJob(std::string_view text);
+
+	virtual void Execute() override;
+};
+
+//------------------------------------------------------------------------------------------------
+ObjParseChunkJob::ObjParseChunkJob(std::string_view text)
+	: m_text(text)
+{
+}
+
+//------------------------------------------------------------------------------------------------
+void ObjParseChunkJob::Execute()
+{
+	if (!m_isMerging)
+	{
+		ParseObjChunk(m_text, m_data, m_materialState);
+		return;
+	}
+
+	std::copy(m_data.m_positions.begin(), m_data.m_positions.end(), m_mergedData->m_positions.begin() + m_mergeOffsets.m_numPositions);
+	std::copy(m_data.m_uvs.begin(), m_data.m_uvs.end(), m_mergedData->m_uvs.begin() + m_mergeOffsets.m_numUVs);
+	std::copy(m_data.m_normals.begin(), m_data.m_normals.end(), m_mergedData->m_normals.begin() + m_mergeOffsets.m_numNormals);
+	std::copy(m_data.m_faceVertices.begin(), m_data.m_faceVertices.end(), m_mergedData->m_faceVertices.begin() + m_mergeOffsets.m_numFaceVertices);
+
+	Face* mergedFaces = m_mergedData->m_faces.data() + m_mergeOffsets.m_numFaces;
+
+	for (size_t faceIndex = 0; faceIndex < m_data.m_faces.size(); faceIndex++)
+	{
+		mergedFaces[faceIndex] = m_data.m_faces[faceIndex];
+		mergedFaces[faceIndex].m_firstVertex += (uint32_t)m_mergeOffsets.m_numFaceVertices;
+	}
+
+	m_data = ObjData();
+}
+
+//------------------------------------------------------------------------------------------------
+// Adds every job to the job system and waits for all of them, or runs them inline without one
+//------------------------------------------------------------------------------------------------
+template <typename JobType>
+static void RunObjJobs(std::vector<JobType*> const& jobs)
+{
+	for (JobType* job : jobs)
+	{
+		if (g_theJobSystem)
+		{
+			g_theJobSystem->AddJob(job);
+		}
+		else
+		{
+			job->Execute();
+		}
+	}
+
+	if (g_theJobSystem)
+	{
+		for (JobType* job : jobs)
+		{
+			while (!g_theJobSystem->RetrieveJob(job))
 			{
-				if (faceVertex.m_vt == -1)
-				{
-					vertex.m_uvTexCoords = Vec2::ZERO;
-				}
-				else
-				{
-					vertex.m_uvTexCoords = uvs[faceVertex.m_vt - 1];
-				}
+				std::this_thread::yield();
 			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Splits the text on line boundaries into OBJ_PARSE_CHUNK_SIZE chunks and parses them as jobs. OBJ
+// indices are absolute, so the chunks merge by prefix-summing their element counts and offsetting
+// each face's first vertex; the result is identical to ParseObjText.
+//------------------------------------------------------------------------------------------------
+void ObjLoader::ParseObjTextParallel(std::string_view text, ObjData& outData)
+{
+	if (!g_theJobSystem || text.size() < 2 * OBJ_PARSE_CHUNK_SIZE)
+	{
+		ParseObjText(text, outData);
+		return;
+	}
+
+	std::vector<ObjParseChunkJob*> jobs;
+	jobs.reserve(text.size() / OBJ_PARSE_CHUNK_SIZE + 1);
+
+	for (size_t chunkBegin = 0; chunkBegin < text.size();)
+	{
+		size_t chunkEnd = chunkBegin + OBJ_PARSE_CHUNK_SIZE;
+
+		if (chunkEnd >= text.size())
+		{
+			chunkEnd = text.size();
+		}
+		else
+		{
+			size_t lineEnd = text.find('\n', chunkEnd);
+			chunkEnd = lineEnd == std::string_view::npos ? text.size() : lineEnd + 1;
+		}
+
+		jobs.push_back(new ObjParseChunkJob(text.substr(chunkBegin, chunkEnd - chunkBegin)));
+		chunkBegin = chunkEnd;
+	}
+
+	RunObjJobs(jobs);
 
-			if (normals.size() == 0)
+	ObjElementCounts totals;
+	totals.m_numPositions = outData.m_positions.size();
+	totals.m_numUVs = outData.m_uvs.size();
+	totals.m_numNormals = outData.m_normals.size();
+	totals.m_numFaces = outData.m_faces.size();
+	totals.m_numFaceVertices = outData.m_faceVertices.size();
+
+	ObjMaterialState materialState;
+
+	for (ObjParseChunkJob* job : jobs)
+	{
+		job->m_mergedData = &outData;
+		job->m_mergeOffsets = totals;
+		job->m_isMerging = true;
+
+		totals.m_numPositions += job->m_data.m_positions.size();
+		totals.m_numUVs += job->m_data.m_uvs.size();
+		totals.m_numNormals += job->m_data.m_normals.size();
+		totals.m_numFaces += job->m_data.m_faces.size();
+		totals.m_numFaceVertices += job->m_data.m_faceVertices.size();
+
+		outData.m_hasUVs |= job->m_data.m_hasUVs;
+		outData.m_hasNormals |= job->m_data.m_hasNormals;
+
+		for (ObjMaterialSwitch materialSwitch : job->m_materialState.m_materialSwitches)
+		{
+			materialSwitch.m_firstFace += (uint32_t)job->m_mergeOffsets.m_numFaces;
+			materialState.m_materialSwitches.push_back(materialSwitch);
+		}
+
+		materialState.m_materialLibraryLines.insert(materialState.m_materialLibraryLines.end(), job->m_materialState.m_materialLibraryLines.begin(), job->m_materialState.m_materialLibraryLines.end());
+	}
+
+	outData.m_positions.resize(totals.m_numPositions);
+	outData.m_uvs.resize(totals.m_numUVs);
+	outData.m_normals.resize(totals.m_numNormals);
+	outData.m_faces.resize(totals.m_numFaces);
+	outData.m_faceVertices.resize(totals.m_numFaceVertices);
+
+	RunObjJobs(jobs);
+
+	for (ObjParseChunkJob* job : jobs)
+	{
+		delete job;
+	}
+
+	ApplyObjMaterials(materialState, outData.m_faces);
+}
+
+void ObjLoader::ParsingMaterialFile(std::string_view line, std::unordered_map<std::string, Rgba8>& outMaterialLib)
+{
+	if (line.substr(0, 6) == "mtllib")
+	{
+		std::string_view materialInfo[2];
+
+		SplitStringView(line, ' ', materialInfo, 2);
+
+		std::string materialString;
+		std::string materialFilePath = "Data/Models/" + std::string(materialInfo[1]);
+
+		FileReadToString(materialString, materialFilePath);
+
+		std::string_view remaining = materialString;
+		std::string_view materialLine;
+		std::string materialName;
+
+		while (GetNextLine(remaining, materialLine))
+		{
+			if (materialLine.substr(0, 6) == "newmtl")
 			{
-				vertex.m_normal = Vec3::ZERO;
+				std::string_view newMaterial[2];
+
+				SplitStringView(materialLine, ' ', newMaterial, 2);
+
+				materialName = std::string(newMaterial[1]);
 			}
-			else
+
+			if (materialLine.substr(0, 2) == "Kd")
 			{
-				if (faceVertex.m_vn == -1)
-				{
-					vertex.m_normal = Vec3::ZERO;
-				}
-				else
-				{
-					vertex.m_normal = normals[faceVertex.m_vn - 1];
-				}
+				std::string_view materialDiffuseColor[4];
+
+				SplitStringView(materialLine, ' ', materialDiffuseColor, 4);
+
+				Rgba8 color;
+
+				float r = 0.f;
+				float g = 0.f;
+				float b = 0.f;
+
+				ParseFloat(materialDiffuseColor[1], r);
+				ParseFloat(materialDiffuseColor[2], g);
+				ParseFloat(materialDiffuseColor[3], b);
+
+				color.r = static_cast<unsigned char>(r * 255);
+				color.g = static_cast<unsigned char>(g * 255);
+				color.b = static_cast<unsigned char>(b * 255);
+
+				outMaterialLib[materialName] = color;
 			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// OBJ indices are 1-based; a missing or out-of-range index gives the default
+//------------------------------------------------------------------------------------------------
+template <typename ElementType>
+static ElementType GetObjElement(std::vector<ElementType> const& elements, int objIndex, ElementType const& defaultElement)
+{
+	if (objIndex < 1 || objIndex > (int)elements.size())
+	{
+		return defaultElement;
+	}
+
+	return elements[objIndex - 1];
+}
+
+//------------------------------------------------------------------------------------------------
+static size_t GetObjTriangleCount(ObjData const& data)
+{
+	size_t numTriangles = 0;
+
+	for (Face const& face : data.m_faces)
+	{
+		numTriangles += face.m_numVertices > 2 ? face.m_numVertices - 2 : 0;
+	}
+
+	return numTriangles;
+}
+
+void ObjLoader::GenerateVerticesAndIndices(ObjData const& data, std::vector<Vertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices)
+{
+	outVertices.reserve(outVertices.size() + data.m_faceVertices.size());
+	outIndices.reserve(outIndices.size() + GetObjTriangleCount(data) * 3);
+
+	unsigned int index = (unsigned int)outVertices.size();
+
+	for (Face const& face : data.m_faces)
+	{
+		for (uint32_t faceVertexIndex = 0; faceVertexIndex < face.m_numVertices; faceVertexIndex++)
+		{
+			Vertex const& faceVertex = data.m_faceVertices[face.m_firstVertex + faceVertexIndex];
+
+			Vertex_PCUTBN vertex;
+
+			vertex.m_position = GetObjElement(data.m_positions, faceVertex.m_v, Vec3::ZERO);
+			vertex.m_color = face.m_color;
+			vertex.m_uvTexCoords = GetObjElement(data.m_uvs, faceVertex.m_vt, Vec2::ZERO);
+			vertex.m_normal = GetObjElement(data.m_normals, faceVertex.m_vn, Vec3::ZERO);
 
 			outVertices.push_back(vertex);
 		}
 
-		for (int j = 0; j < (int)inFaces[i].m_vertices.size() - 2; j++)
+		for (uint32_t j = 0; j + 2 < face.m_numVertices; j++)
 		{
-			unsigned int i0 = index + 0;
-			unsigned int i1 = index + j + 1;
-			unsigned int i2 = index + j + 2;
-
-			outIndices.push_back(i0);
-			outIndices.push_back(i1);
-			outIndices.push_back(i2);
+			outIndices.push_back(index + 0);
+			outIndices.push_back(index + j + 1);
+			outIndices.push_back(index + j + 2);
 		}
 
-		index += (int)inFaces[i].m_vertices.size();
+		index += face.m_numVertices;
 	}
 
-	
-
 	CalculateTangentSpaceBasisVectors(outVertices, outIndices, true, true);
 }
 
 #if DX12_RENDERER
 
-void ObjLoader::GenerateVerticesAndIndices(std::vector<Face> inFaces, std::vector<Vec3> positions, std::vector<Vec2> uvs, std::vector<Vec3> normals, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices)
+//------------------------------------------------------------------------------------------------
+// These loaders index by position, so a triangle with a missing or out-of-range position index
+// is skipped rather than turned into an index past the end of the vertex buffer
+//------------------------------------------------------------------------------------------------
+static bool IsObjPositionTriangleInRange(ObjData const& data, Vertex const& v0, Vertex const& v1, Vertex const& v2)
 {
-	Rgba8 color = Rgba8::WHITE;
-
-	/*for(int i = 0; i < positions.size(); i++)
-	{
-		MeshVertex_PCU vertex;
+	int numPositions = (int)data.m_positions.size();
 
-		float vertColor[4];
-		color.GetAsFloats(vertColor);
-
-		vertex.m_position = positions[i];
-		vertex.m_color = Vec4(vertColor[0], vertColor[1], vertColor[2], vertColor[3]);
-		vertex.m_uv = uvs[i];
+	return v0.m_v >= 1 && v0.m_v <= numPositions
+		&& v1.m_v >= 1 && v1.m_v <= numPositions
+		&& v2.m_v >= 1 && v2.m_v <= numPositions;
+}
 
-		outVertices.push_back(vertex);
-	}*/
+void ObjLoader::GenerateVerticesAndIndices(ObjData const& data, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices)
+{
+	outVertices.reserve(outVertices.size() + data.m_faceVertices.size());
+	outIndices.reserve(outIndices.size() + GetObjTriangleCount(data) * 3);
 
-	for (int i = 0; i < inFaces.size(); i++)
+	for (Face const& face : data.m_faces)
 	{
-		for (int j = 0; j < inFaces[i].m_vertices.size(); j++)
+		Vertex const* faceVertices = data.m_faceVertices.data() + face.m_firstVertex;
+
+		for (uint32_t faceVertexIndex = 0; faceVertexIndex < face.m_numVertices; faceVertexIndex++)
 		{
-			Vertex faceVertex = inFaces[i].m_vertices[j];
-			Rgba8 faceColor = inFaces[i].m_color;
+			Vertex const& faceVertex = faceVertices[faceVertexIndex];
 
 			MeshVertex_PCU vertex;
 
-			vertex.m_position = positions[faceVertex.m_v - 1];
+			vertex.m_position = GetObjElement(data.m_positions, faceVertex.m_v, Vec3::ZERO);
 			vertex.m_color = Vec4::ONE;
+			vertex.m_uv = GetObjElement(data.m_uvs, faceVertex.m_vt, Vec2::ZERO);
 
-			if (uvs.size() == 0)
-			{
-				vertex.m_uv = Vec2::ZERO;
-			}
-			else
+			outVertices.push_back(vertex);
+		}
+
+		for (uint32_t j = 0; j + 2 < face.m_numVertices; j++)
+		{
+			if (!IsObjPositionTriangleInRange(data, faceVertices[0], faceVertices[j + 1], faceVertices[j + 2]))
 			{
-				if (faceVertex.m_vt == -1)
-				{
-					vertex.m_uv = Vec2::ZERO;
-				}
-				else
-				{
-					vertex.m_uv = uvs[faceVertex.m_vt - 1];
-				}
+				continue;
 			}
 
+			unsigned int i0 = faceVertices[0    ].m_v - 1;
+			unsigned int i1 = faceVertices[j + 1].m_v - 1;
+			unsigned int i2 = faceVertices[j + 2].m_v - 1;
+
+			outIndices.push_back(i0);
+			outIndices.push_back(i1);
+			outIndices.push_back(i2);
+		}
+	}
+}
+
+void ObjLoader::GenerateVerticesAndIndices(ObjData const& data, std::vector<MeshVertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices)
+{
+	outVertices.reserve(outVertices.size() + data.m_faceVertices.size());
+	outIndices.reserve(outIndices.size() + GetObjTriangleCount(data) * 3);
+
+	for (Face const& face : data.m_faces)
+	{
+		Vertex const* faceVertices = data.m_faceVertices.data() + face.m_firstVertex;
+
+		for (uint32_t faceVertexIndex = 0; faceVertexIndex < face.m_numVertices; faceVertexIndex++)
+		{
+			Vertex const& faceVertex = faceVertices[faceVertexIndex];
+
+			MeshVertex_PCUTBN vertex;
+
+			vertex.m_position = GetObjElement(data.m_positions, faceVertex.m_v, Vec3::ZERO);
+			vertex.m_color = Vec4::ONE;
+			vertex.m_uv = GetObjElement(data.m_uvs, faceVertex.m_vt, Vec2::ZERO);
+			vertex.m_normal = GetObjElement(data.m_normals, faceVertex.m_vn, Vec3::ZERO);
+
 			outVertices.push_back(vertex);
 		}
 
-		for (int j = 0; j < inFaces[i].m_vertices.size() - 2; j++)
+		for (uint32_t j = 0; j + 2 < face.m_numVertices; j++)
 		{
-			unsigned int i0 = inFaces[i].m_vertices[0    ].m_v - 1;
-			unsigned int i1 = inFaces[i].m_vertices[j + 1].m_v - 1;
-			unsigned int i2 = inFaces[i].m_vertices[j + 2].m_v - 1;
+			if (!IsObjPositionTriangleInRange(data, faceVertices[0], faceVertices[j + 1], faceVertices[j + 2]))
+			{
+				continue;
+			}
+
+			unsigned int i0 = faceVertices[0    ].m_v - 1;
+			unsigned int i1 = faceVertices[j + 1].m_v - 1;
+			unsigned int i2 = faceVertices[j + 2].m_v - 1;
 
 			outIndices.push_back(i0);
 			outIndices.push_back(i1);
 			outIndices.push_back(i2);
 		}
 	}
+
+	CalculateTangentSpaceBasisVectors(outVertices, outIndices, true, false);
 }
+#endif
 
-void ObjLoader::GenerateVerticesAndIndices(std::vector<Face> inFaces, std::vector<Vec3> positions, std::vector<Vec2> uvs, std::vector<Vec3> normals, std::vector<MeshVertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices)
+//------------------------------------------------------------------------------------------------
+void ObjLoader::GetFaceVertexAttributes(ObjData const& data, Vertex const& faceVertex, Vec3& outPosition, Vec2& outUV, Vec3& outNormal)
 {
-	Rgba8 color = Rgba8::WHITE;
+	outPosition = GetObjElement(data.m_positions, faceVertex.m_v, Vec3::ZERO);
+	outUV = GetObjElement(data.m_uvs, faceVertex.m_vt, Vec2::ZERO);
+	outNormal = GetObjElement(data.m_normals, faceVertex.m_vn, Vec3::ZERO);
+}
 
-	//for(int i = 0; i < positions.size(); i++)
-	//{
-	//MeshVertex_PCUTBN vertex;
+//------------------------------------------------------------------------------------------------
+void ObjLoader::GenerateWeldedIndices(ObjData const& data, std::vector<uint32_t> const& faceVertexRemap, std::vector<uint32_t>& outIndices)
+{
+	outIndices.reserve(outIndices.size() + GetObjTriangleCount(data) * 3);
 
-	//float vertColor[4];
-	//color.GetAsFloats(vertColor);
+	for (Face const& face : data.m_faces)
+	{
+		uint32_t const* faceRemap = faceVertexRemap.data() + face.m_firstVertex;
 
-	//vertex.m_position = positions[i];
-	//vertex.m_color = Vec4(vertColor[0], vertColor[1], vertColor[2], vertColor[3]);
-	//vertex.m_uv = /*uvs[i]*/Vec2::ZERO;
+		for (uint32_t j = 0; j + 2 < face.m_numVertices; j++)
+		{
+			outIndices.push_back(faceRemap[0]);
+			outIndices.push_back(faceRemap[j + 1]);
+			outIndices.push_back(faceRemap[j + 2]);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+VertexWeldTable::VertexWeldTable(size_t numKeys)
+{
+	Reserve(numKeys);
+}
 
-	//outVertices.push_back(vertex);
-	//}
+//------------------------------------------------------------------------------------------------
+// Sizes the table so numKeys entries keep it at most three quarters full, rehashing any existing
+// entries. The slot count is not rounded to a power of two, which would nearly double it.
+//------------------------------------------------------------------------------------------------
+void VertexWeldTable::Reserve(size_t numKeys)
+{
+	if (numKeys <= m_maxEntries)
+	{
+		return;
+	}
 
-	for (int i = 0; i < inFaces.size(); i++)
+	std::vector<Slot> oldSlots;
+	oldSlots.swap(m_slots);
+
+	m_slots.resize(std::max<size_t>(numKeys + numKeys / 3, 16));
+	m_maxEntries = m_slots.size() * 3 / 4;
+	m_numEntries = 0;
+
+	for (Slot const& slot : oldSlots)
 	{
-		for (int j = 0; j < inFaces[i].m_vertices.size(); j++)
+		if (slot.m_value != VERTEX_WELD_EMPTY)
 		{
-			Vertex faceVertex = inFaces[i].m_vertices[j];
-			Rgba8 faceColor = inFaces[i].m_color;
+			FindOrInsert(slot.m_key, slot.m_value);
+		}
+	}
+}
 
-			MeshVertex_PCUTBN vertex;
+//------------------------------------------------------------------------------------------------
+void VertexWeldTable::Clear()
+{
+	std::fill(m_slots.begin(), m_slots.end(), Slot());
+	m_numEntries = 0;
+}
 
-			vertex.m_position = positions[faceVertex.m_v - 1];
-			vertex.m_color = Vec4::ONE;
+//------------------------------------------------------------------------------------------------
+// Scales the low 32 bits of the hash onto the slot count with a multiply instead of a modulo
+//------------------------------------------------------------------------------------------------
+size_t VertexWeldTable::GetHomeSlot(Vertex const& key) const
+{
+	return (size_t)(((VertexHash()(key) & 0xFFFFFFFFull) * (uint64_t)m_slots.size()) >> 32);
+}
+
+//------------------------------------------------------------------------------------------------
+// Returns the value already stored for key, or stores and returns value if key is new
+//------------------------------------------------------------------------------------------------
+uint32_t VertexWeldTable::FindOrInsert(Vertex const& key, uint32_t value)
+{
+	if (m_numEntries >= m_maxEntries)
+	{
+		Reserve(std::max<size_t>(m_numEntries * 2, 16));
+	}
+
+	size_t numSlots = m_slots.size();
+	size_t slotIndex = GetHomeSlot(key);
+
+	for (;;)
+	{
+		Slot& slot = m_slots[slotIndex];
+
+		if (slot.m_value == VERTEX_WELD_EMPTY)
+		{
+			slot.m_key = key;
+			slot.m_value = value;
+			m_numEntries++;
+
+			return value;
+		}
+
+		if (VertexEqual()(slot.m_key, key))
+		{
+			return slot.m_value;
+		}
+
+		if (++slotIndex == numSlots)
+		{
+			slotIndex = 0;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Welding walks keys in file order but their slots are scattered, so callers prefetch a few keys
+// ahead to overlap the cache misses
+//------------------------------------------------------------------------------------------------
+void VertexWeldTable::Prefetch(Vertex const& key) const
+{
+	if (!m_slots.empty())
+	{
+		_mm_prefetch((char const*)&m_slots[GetHomeSlot(key)], _MM_HINT_T0);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+size_t VertexWeldTable::GetNumEntries() const
+{
+	return m_numEntries;
+}
 
-			if (uvs.size() == 0)
+//------------------------------------------------------------------------------------------------
+size_t VertexWeldTable::GetMemoryBytes() const
+{
+	return m_slots.capacity() * sizeof(Slot);
+}
+
+//------------------------------------------------------------------------------------------------
+// A closed triangle mesh has about half as many unique vertices as faces, and UV or normal seams
+// add some back, so the face count is the reserve; the table grows if a mesh needs more. A shard
+// reserves its share of the faces.
+//------------------------------------------------------------------------------------------------
+static size_t GetObjWeldReserve(ObjData const& data, size_t numFaceVertices)
+{
+	if (data.m_faceVertices.empty())
+	{
+		return 0;
+	}
+
+	return (size_t)((double)data.m_faces.size() * (double)numFaceVertices / (double)data.m_faceVertices.size());
+}
+
+//------------------------------------------------------------------------------------------------
+// Welding keeps one vertex per distinct {v, vt, vn}, numbered in order of first use, and maps every
+// face vertex onto it.
+//------------------------------------------------------------------------------------------------
+static void WeldFaceVerticesSerial(ObjData const& data, std::vector<uint32_t>& outUniqueFaceVertices, std::vector<uint32_t>& outFaceVertexRemap)
+{
+	size_t numFaceVertices = data.m_faceVertices.size();
+
+	VertexWeldTable uniqueVertices(GetObjWeldReserve(data, numFaceVertices));
+
+	outUniqueFaceVertices.clear();
+	outFaceVertexRemap.resize(numFaceVertices);
+
+	for (size_t faceVertexIndex = 0; faceVertexIndex < numFaceVertices; faceVertexIndex++)
+	{
+		if (faceVertexIndex + OBJ_WELD_PREFETCH_DISTANCE < numFaceVertices)
+		{
+			uniqueVertices.Prefetch(data.m_faceVertices[faceVertexIndex + OBJ_WELD_PREFETCH_DISTANCE]);
+		}
+
+		uint32_t uniqueIndex = (uint32_t)outUniqueFaceVertices.size();
+		uint32_t weldedIndex = uniqueVertices.FindOrInsert(data.m_faceVertices[faceVertexIndex], uniqueIndex);
+
+		if (weldedIndex == uniqueIndex)
+		{
+			outUniqueFaceVertices.push_back((uint32_t)faceVertexIndex);
+		}
+
+		outFaceVertexRemap[faceVertexIndex] = weldedIndex;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+enum class ObjWeldPhase
+{
+	COUNT_SHARDS,
+	SCATTER_SHARDS,
+	DEDUPLICATE_SHARD,
+	COUNT_UNIQUE,
+	ASSIGN_UNIQUE,
+	REMAP,
+};
+
+//------------------------------------------------------------------------------------------------
+// Shared by every weld job. m_shardCounts holds [chunk * OBJ_WELD_NUM_SHARDS + shard] counts, which
+// the prefix sum turns into each chunk's write position in m_shardedFaceVertices.
+//------------------------------------------------------------------------------------------------
+struct ObjWeldState
+{
+	ObjData const*					m_data					= nullptr;
+	std::vector<uint8_t>			m_shardOfFaceVertex;
+	std::vector<uint32_t>			m_shardCounts;
+	std::vector<uint32_t>			m_shardBegins;
+	std::vector<uint32_t>			m_shardedFaceVertices;
+	std::vector<uint32_t>			m_firstOccurrences;
+	std::vector<uint32_t>			m_chunkUniqueOffsets;
+	std::vector<uint32_t>*			m_uniqueFaceVertices	= nullptr;
+	std::vector<uint32_t>*			m_faceVertexRemap		= nullptr;
+};
+
+//------------------------------------------------------------------------------------------------
+// m_index is a chunk of OBJ_WELD_CHUNK_FACE_VERTICES face vertices, or a shard for DEDUPLICATE_SHARD
+//------------------------------------------------------------------------------------------------
+class ObjWeldJob : public Job
+{
+public:
+	ObjWeldState*					m_state					= nullptr;
+	uint32_t						m_index					= 0;
+	ObjWeldPhase					m_phase					= ObjWeldPhase::COUNT_SHARDS;
+public:
+	ObjWeldJob(ObjWeldState* state, uint32_t index);
+
+	virtual void Execute() override;
+};
+
+//------------------------------------------------------------------------------------------------
+ObjWeldJob::ObjWeldJob(ObjWeldState* state, uint32_t index)
+	: m_state(state)
+	, m_index(index)
+{
+}
+
+//------------------------------------------------------------------------------------------------
+// Shards take the top bits of the hash and VertexWeldTable probes from the bottom bits, so the
+// tables inside a shard still spread evenly
+//------------------------------------------------------------------------------------------------
+static uint32_t GetObjWeldShard(Vertex const& vertex)
+{
+	return (uint32_t)(VertexHash()(vertex) >> (64 - OBJ_WELD_SHARD_BITS));
+}
+
+//------------------------------------------------------------------------------------------------
+void ObjWeldJob::Execute()
+{
+	ObjWeldState& state = *m_state;
+	std::vector<Vertex> const& faceVertices = state.m_data->m_faceVertices;
+
+	uint32_t firstFaceVertex = m_index * OBJ_WELD_CHUNK_FACE_VERTICES;
+	uint32_t endFaceVertex = (uint32_t)std::min((size_t)firstFaceVertex + OBJ_WELD_CHUNK_FACE_VERTICES, faceVertices.size());
+
+	std::vector<uint32_t>& firstOccurrences = state.m_firstOccurrences;
+	std::vector<uint32_t>& faceVertexRemap = *state.m_faceVertexRemap;
+
+	switch (m_phase)
+	{
+		case ObjWeldPhase::COUNT_SHARDS:
+		{
+			uint32_t* shardCounts = &state.m_shardCounts[(size_t)m_index * OBJ_WELD_NUM_SHARDS];
+
+			for (uint32_t faceVertexIndex = firstFaceVertex; faceVertexIndex < endFaceVertex; faceVertexIndex++)
 			{
-				vertex.m_uv = Vec2::ZERO;
+				uint32_t shard = GetObjWeldShard(faceVertices[faceVertexIndex]);
+
+				state.m_shardOfFaceVertex[faceVertexIndex] = (uint8_t)shard;
+				shardCounts[shard]++;
 			}
-			else
+
+			break;
+		}
+		case ObjWeldPhase::SCATTER_SHARDS:
+		{
+			uint32_t* shardCursors = &state.m_shardCounts[(size_t)m_index * OBJ_WELD_NUM_SHARDS];
+
+			for (uint32_t faceVertexIndex = firstFaceVertex; faceVertexIndex < endFaceVertex; faceVertexIndex++)
 			{
-				if (faceVertex.m_vt == -1)
-				{
-					vertex.m_uv = Vec2::ZERO;
-				}
-				else
+				state.m_shardedFaceVertices[shardCursors[state.m_shardOfFaceVertex[faceVertexIndex]]++] = faceVertexIndex;
+			}
+
+			break;
+		}
+		case ObjWeldPhase::DEDUPLICATE_SHARD:
+		{
+			// Face vertices arrive in file order, so the first insert of a key is its first use
+			uint32_t shardBegin = state.m_shardBegins[m_index];
+			uint32_t shardEnd = state.m_shardBegins[m_index + 1];
+
+			VertexWeldTable uniqueVertices(GetObjWeldReserve(*state.m_data, shardEnd - shardBegin));
+
+			for (uint32_t shardedIndex = shardBegin; shardedIndex < shardEnd; shardedIndex++)
+			{
+				if (shardedIndex + OBJ_WELD_PREFETCH_DISTANCE < shardEnd)
 				{
-					vertex.m_uv = uvs[faceVertex.m_vt - 1];
+					uniqueVertices.Prefetch(faceVertices[state.m_shardedFaceVertices[shardedIndex + OBJ_WELD_PREFETCH_DISTANCE]]);
 				}
+
+				uint32_t faceVertexIndex = state.m_shardedFaceVertices[shardedIndex];
+				firstOccurrences[faceVertexIndex] = uniqueVertices.FindOrInsert(faceVertices[faceVertexIndex], faceVertexIndex);
 			}
-			
-			if (normals.size() == 0)
+
+			break;
+		}
+		case ObjWeldPhase::COUNT_UNIQUE:
+		{
+			uint32_t numUnique = 0;
+
+			for (uint32_t faceVertexIndex = firstFaceVertex; faceVertexIndex < endFaceVertex; faceVertexIndex++)
 			{
-				vertex.m_normal = Vec3::ZERO;
+				numUnique += firstOccurrences[faceVertexIndex] == faceVertexIndex ? 1 : 0;
 			}
-			else
+
+			state.m_chunkUniqueOffsets[m_index] = numUnique;
+			break;
+		}
+		case ObjWeldPhase::ASSIGN_UNIQUE:
+		{
+			uint32_t uniqueIndex = state.m_chunkUniqueOffsets[m_index];
+
+			for (uint32_t faceVertexIndex = firstFaceVertex; faceVertexIndex < endFaceVertex; faceVertexIndex++)
 			{
-				if (faceVertex.m_vn == -1)
+				if (firstOccurrences[faceVertexIndex] == faceVertexIndex)
 				{
-					vertex.m_normal = Vec3::ZERO;
+					faceVertexRemap[faceVertexIndex] = uniqueIndex;
+					(*state.m_uniqueFaceVertices)[uniqueIndex] = faceVertexIndex;
+					uniqueIndex++;
 				}
-				else
+			}
+
+			break;
+		}
+		case ObjWeldPhase::REMAP:
+		{
+			for (uint32_t faceVertexIndex = firstFaceVertex; faceVertexIndex < endFaceVertex; faceVertexIndex++)
+			{
+				if (firstOccurrences[faceVertexIndex] != faceVertexIndex)
 				{
-					vertex.m_normal = normals[faceVertex.m_vn - 1];
+					faceVertexRemap[faceVertexIndex] = faceVertexRemap[firstOccurrences[faceVertexIndex]];
 				}
 			}
 
-			outVertices.push_back(vertex);
+			break;
 		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+static void RunObjWeldPhase(std::vector<ObjWeldJob*> const& jobs, ObjWeldPhase phase)
+{
+	for (ObjWeldJob* job : jobs)
+	{
+		job->m_phase = phase;
+	}
+
+	RunObjJobs(jobs);
+}
+
+//------------------------------------------------------------------------------------------------
+// The parallel weld hashes every face vertex into one of OBJ_WELD_NUM_SHARDS shards, counting-sorts
+// the face vertices by shard while keeping file order, and deduplicates each shard as its own job.
+// Unique vertices are then numbered by a prefix sum over the chunks, so the output is identical to
+// the serial weld.
+//------------------------------------------------------------------------------------------------
+void ObjLoader::WeldFaceVertices(ObjData const& data, std::vector<uint32_t>& outUniqueFaceVertices, std::vector<uint32_t>& outFaceVertexRemap, bool useJobSystem)
+{
+	size_t numFaceVertices = data.m_faceVertices.size();
+
+	if (!useJobSystem || !g_theJobSystem || numFaceVertices < 2 * (size_t)OBJ_WELD_CHUNK_FACE_VERTICES)
+	{
+		WeldFaceVerticesSerial(data, outUniqueFaceVertices, outFaceVertexRemap);
+		return;
+	}
+
+	uint32_t numChunks = (uint32_t)((numFaceVertices + OBJ_WELD_CHUNK_FACE_VERTICES - 1) / OBJ_WELD_CHUNK_FACE_VERTICES);
+
+	ObjWeldState state;
+	state.m_data = &data;
+	state.m_shardOfFaceVertex.resize(numFaceVertices);
+	state.m_shardCounts.resize((size_t)numChunks * OBJ_WELD_NUM_SHARDS);
+	state.m_shardBegins.resize(OBJ_WELD_NUM_SHARDS + 1);
+	state.m_shardedFaceVertices.resize(numFaceVertices);
+	state.m_firstOccurrences.resize(numFaceVertices);
+	state.m_chunkUniqueOffsets.resize(numChunks);
+	state.m_uniqueFaceVertices = &outUniqueFaceVertices;
+	state.m_faceVertexRemap = &outFaceVertexRemap;
+
+	outFaceVertexRemap.resize(numFaceVertices);
+
+	std::vector<ObjWeldJob*> chunkJobs;
+	std::vector<ObjWeldJob*> shardJobs;
+
+	for (uint32_t chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+	{
+		chunkJobs.push_back(new ObjWeldJob(&state, chunkIndex));
+	}
+
+	for (uint32_t shardIndex = 0; shardIndex < OBJ_WELD_NUM_SHARDS; shardIndex++)
+	{
+		shardJobs.push_back(new ObjWeldJob(&state, shardIndex));
+	}
+
+	RunObjWeldPhase(chunkJobs, ObjWeldPhase::COUNT_SHARDS);
 
-		for (int j = 0; j < inFaces[i].m_vertices.size() - 2; j++)
+	uint32_t numSharded = 0;
+
+	for (uint32_t shardIndex = 0; shardIndex < OBJ_WELD_NUM_SHARDS; shardIndex++)
+	{
+		state.m_shardBegins[shardIndex] = numSharded;
+
+		for (uint32_t chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
 		{
-			unsigned int i0 = inFaces[i].m_vertices[0    ].m_v - 1;
-			unsigned int i1 = inFaces[i].m_vertices[j + 1].m_v - 1;
-			unsigned int i2 = inFaces[i].m_vertices[j + 2].m_v - 1;
+			uint32_t& shardCount = state.m_shardCounts[(size_t)chunkIndex * OBJ_WELD_NUM_SHARDS + shardIndex];
+			uint32_t count = shardCount;
 
-			outIndices.push_back(i0);
-			outIndices.push_back(i1);
-			outIndices.push_back(i2);
+			shardCount = numSharded;
+			numSharded += count;
 		}
 	}
 
-	CalculateTangentSpaceBasisVectors(outVertices, outIndices, true, false);
+	state.m_shardBegins[OBJ_WELD_NUM_SHARDS] = numSharded;
+
+	RunObjWeldPhase(chunkJobs, ObjWeldPhase::SCATTER_SHARDS);
+	RunObjWeldPhase(shardJobs, ObjWeldPhase::DEDUPLICATE_SHARD);
+
+	state.m_shardOfFaceVertex = std::vector<uint8_t>();
+	state.m_shardedFaceVertices = std::vector<uint32_t>();
+
+	RunObjWeldPhase(chunkJobs, ObjWeldPhase::COUNT_UNIQUE);
+
+	uint32_t numUnique = 0;
+
+	for (uint32_t& chunkUniqueOffset : state.m_chunkUniqueOffsets)
+	{
+		uint32_t count = chunkUniqueOffset;
+
+		chunkUniqueOffset = numUnique;
+		numUnique += count;
+	}
+
+	outUniqueFaceVertices.resize(numUnique);
+
+	RunObjWeldPhase(chunkJobs, ObjWeldPhase::ASSIGN_UNIQUE);
+	RunObjWeldPhase(chunkJobs, ObjWeldPhase::REMAP);
+
+	for (ObjWeldJob* job : chunkJobs)
+	{
+		delete job;
+	}
+
+	for (ObjWeldJob* job : shardJobs)
+	{
+		delete job;
+	}
 }
-#endif
\ No newline at end of file
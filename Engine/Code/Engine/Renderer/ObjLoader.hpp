@@ -7,15 +7,23 @@
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
-#include "Engine/Renderer/Model.hpp"
+#include "Engine/Core/MeshVertex_PCU.hpp"
 
+#include <stdint.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <map>
 
 struct Mat44;
 
+constexpr size_t		OBJ_PARSE_CHUNK_SIZE			= 4 * 1024 * 1024;
+constexpr uint32_t		OBJ_WELD_CHUNK_FACE_VERTICES	= 1 << 20;
+constexpr uint32_t		OBJ_WELD_SHARD_BITS				= 6;
+constexpr uint32_t		OBJ_WELD_NUM_SHARDS				= 1 << OBJ_WELD_SHARD_BITS;
+constexpr uint32_t		OBJ_WELD_PREFETCH_DISTANCE		= 16;
+
 struct Vertex
 {
 	int m_v = -1;
@@ -23,10 +31,23 @@ struct Vertex
 	int m_vn = -1;
 };
 
+//------------------------------------------------------------------------------------------------
+// Packs the three indices into 96 bits and runs them through a 64-bit finalizer, so neighbouring
+// index triples land far apart in every bit of the hash, high and low.
+//------------------------------------------------------------------------------------------------
 struct VertexHash {
-	size_t operator()(const Vertex& vertex) const {
+	uint64_t operator()(const Vertex& vertex) const {
+
+		uint64_t hash = ((uint64_t)(uint32_t)vertex.m_v << 32) | (uint32_t)vertex.m_vt;
+		hash ^= (uint64_t)(uint32_t)vertex.m_vn * 0x9E3779B97F4A7C15ull;
+
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ull;
+		hash ^= hash >> 33;
 
-		return std::hash<int>()(vertex.m_v) ^ (std::hash<int>()(vertex.m_vt) << 1) ^ (std::hash<int>()(vertex.m_vn) << 2);
+		return hash;
 	}
 };
 
@@ -36,12 +57,63 @@ struct VertexEqual {
 	}
 };
 
+//------------------------------------------------------------------------------------------------
+// Open-addressing map from a face vertex to a uint32_t, for welding. Keys and values share one flat
+// array kept at most three quarters full and probed linearly from the low 32 bits of VertexHash.
+// Reserve up front and inserts never allocate; values must not be VERTEX_WELD_EMPTY.
+//------------------------------------------------------------------------------------------------
+constexpr uint32_t VERTEX_WELD_EMPTY = 0xFFFFFFFF;
+
+class VertexWeldTable
+{
+	struct Slot
+	{
+		Vertex						m_key;
+		uint32_t					m_value					= VERTEX_WELD_EMPTY;
+	};
+
+	std::vector<Slot>				m_slots;
+	size_t							m_maxEntries			= 0;
+	size_t							m_numEntries			= 0;
+
+	size_t							GetHomeSlot(Vertex const& key) const;
+public:
+									VertexWeldTable() = default;
+	explicit						VertexWeldTable(size_t numKeys);
+									~VertexWeldTable() = default;
+
+	void							Reserve(size_t numKeys);
+	void							Clear();
+
+	uint32_t						FindOrInsert(Vertex const& key, uint32_t value);
+	void							Prefetch(Vertex const& key) const;
+
+	size_t							GetNumEntries() const;
+	size_t							GetMemoryBytes() const;
+};
+
+//------------------------------------------------------------------------------------------------
+// A face is a run of m_numVertices entries in ObjData::m_faceVertices starting at m_firstVertex,
+// so parsing a face never allocates.
+//------------------------------------------------------------------------------------------------
 struct Face
 {
-	std::vector<Vertex> m_vertices;
+	uint32_t m_firstVertex = 0;
+	uint32_t m_numVertices = 0;
 	Rgba8 m_color;
 };
 
+struct ObjData
+{
+	std::vector<Vec3>	m_positions;
+	std::vector<Vec2>	m_uvs;
+	std::vector<Vec3>	m_normals;
+	std::vector<Vertex>	m_faceVertices;
+	std::vector<Face>	m_faces;
+	bool				m_hasNormals	= false;
+	bool				m_hasUVs		= false;
+};
+
 struct Triangle
 {
 	int m_vertexPositionIndex[3]{-1, -1, -1};
@@ -74,20 +146,21 @@ public:
 
 	static bool Load(std::string const& fileName, Mat44 const& transform, std::vector<Vertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs);
 
-	static void ParsingVertexPos(std::string line, std::vector<Vec3>& positions);
-	static void ParsingVertexUVs(std::string line, std::vector<Vec2>& uvs, bool& outHasUVs);
-	static void ParsingVertexNormals(std::string line, std::vector<Vec3>& normals, bool& outHasNormals);
-	static void ParsingFaces(std::string line, std::vector<Face>& outFaces, Rgba8 faceColor = Rgba8::WHITE);
-	static void ParsingMaterialFile(std::string line, std::unordered_map<std::string, Rgba8>& outMaterialLib);
-	static void GenerateVerticesAndIndices(std::vector<Face> inFaces, std::vector<Vec3> positions, std::vector<Vec2> uvs, std::vector<Vec3> normals, std::vector<Vertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices);
+	static void ParseObjText(std::string_view text, ObjData& outData);
+	static void ParseObjTextParallel(std::string_view text, ObjData& outData);
+	static void WeldFaceVertices(ObjData const& data, std::vector<uint32_t>& outUniqueFaceVertices, std::vector<uint32_t>& outFaceVertexRemap, bool useJobSystem = true);
+	static void GenerateWeldedIndices(ObjData const& data, std::vector<uint32_t> const& faceVertexRemap, std::vector<uint32_t>& outIndices);
+	static void GetFaceVertexAttributes(ObjData const& data, Vertex const& faceVertex, Vec3& outPosition, Vec2& outUV, Vec3& outNormal);
+	static void ParsingMaterialFile(std::string_view line, std::unordered_map<std::string, Rgba8>& outMaterialLib);
+	static void GenerateVerticesAndIndices(ObjData const& data, std::vector<Vertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices);
 
 #if DX12_RENDERER
 
 	static bool Load(std::string const& fileName, Mat44 const& transform, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs);
 	static bool Load(std::string const& fileName, Mat44 const& transform, std::vector<MeshVertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs);
 	static bool LoadXML(std::string const& fileName, Mat44 const& transform, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices, bool& outHasNormals, bool& outHasUVs);
-	static void GenerateVerticesAndIndices(std::vector<Face> inFaces, std::vector<Vec3> positions, std::vector<Vec2> uvs, std::vector<Vec3> normals, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices);
-	static void GenerateVerticesAndIndices(std::vector<Face> inFaces, std::vector<Vec3> positions, std::vector<Vec2> uvs, std::vector<Vec3> normals, std::vector<MeshVertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices);
+	static void GenerateVerticesAndIndices(ObjData const& data, std::vector<MeshVertex_PCU>& outVertices, std::vector<unsigned int>& outIndices);
+	static void GenerateVerticesAndIndices(ObjData const& data, std::vector<MeshVertex_PCUTBN>& outVertices, std::vector<unsigned int>& outIndices);
 
 
 #endif
@@ -2,7 +2,9 @@
 
 #include "Engine/Window/Window.hpp"
 #include "Engine/Core/Image.hpp"
+#include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
@@ -10,6 +12,9 @@
 #include "Engine/Math/Vec4.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Renderer/Model.hpp"
+#include "Engine/Renderer/MeshBenchmarks.hpp"
+#include "Engine/Renderer/MeshProcessing.hpp"
+#include "Engine/Renderer/ObjLoader.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
@@ -32,6 +37,8 @@
 
 Renderer::Renderer(RenderConfig const& config)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 	m_config = config;
 #if DX11_RENDERER
 	m_DX11Renderer = new DX11Renderer(m_config);
@@ -51,11 +58,23 @@ Renderer::~Renderer()
 
 void Renderer::StartUp()
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	m_DX11Renderer->StartUp();
 #elif DX12_RENDERER
 	m_DX12Renderer->StartUp();
 #endif
+
+	SubscribeEventCallbackFunction("MeshletBenchmark", Command_MeshletBenchmark);
+	SubscribeEventCallbackFunction("BuildMeshletCaches", Command_BuildMeshletCaches);
+	SubscribeEventCallbackFunction("ObjLoaderBenchmark", Command_ObjLoaderBenchmark);
+	SubscribeEventCallbackFunction("ObjParallelBenchmark", Command_ObjParallelBenchmark);
+	SubscribeEventCallbackFunction("VertexWeldBenchmark", Command_VertexWeldBenchmark);
+	SubscribeEventCallbackFunction("MeshLODBenchmark", Command_MeshLODBenchmark);
+	SubscribeEventCallbackFunction("MeshletCullTests", Command_MeshletCullTests);
+	SubscribeEventCallbackFunction("MeshletCullBenchmark", Command_MeshletCullBenchmark);
+	SubscribeEventCallbackFunction("VertexQuantizationBenchmark", Command_VertexQuantizationBenchmark);
 }
 
 void Renderer::BeginFrame()
@@ -87,6 +106,8 @@ void Renderer::ShutDown()
 
 Model* Renderer::LoadModel(char const* filePath, RootSig pipelineMode)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	UNUSED(filePath);
 	UNUSED(pipelineMode);
@@ -98,6 +119,8 @@ Model* Renderer::LoadModel(char const* filePath, RootSig pipelineMode)
 
 BitmapFont* Renderer::CreateOrGetBitmapFont(const char* bitmapFontFilePathWithNoExtension)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateOrGetBitmapFont(bitmapFontFilePathWithNoExtension);
 #elif DX12_RENDERER
@@ -116,6 +139,8 @@ BitmapFont* Renderer::GetFontForFileName(char const* imageFilePath)
 
 Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateOrGetTextureFromFile(imageFilePath);
 #elif DX12_RENDERER
@@ -125,6 +150,8 @@ Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
 
 Texture* Renderer::CreateTextureFromFile(char const* imageFilePath)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateTextureFromFile(imageFilePath);
 #elif DX12_RENDERER
@@ -134,6 +161,8 @@ Texture* Renderer::CreateTextureFromFile(char const* imageFilePath)
 
 Texture* Renderer::CreateTextureFromImage(Image const& image)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateTextureFromImage(image);
 #elif DX12_RENDERER
@@ -143,6 +172,8 @@ Texture* Renderer::CreateTextureFromImage(Image const& image)
 
 Texture* Renderer::CreateModifiableTexture(IntVec2 dimensions)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateModifiableTexture(dimensions);
 #elif DX12_RENDERER
@@ -152,6 +183,8 @@ Texture* Renderer::CreateModifiableTexture(IntVec2 dimensions)
 
 Texture* Renderer::CreateTextureFromData(char const* name, IntVec2 dimensions, int bytesPerTexel, uint8_t* texelData)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateTextureFromData(name, dimensions, bytesPerTexel, texelData);
 #elif DX12_RENDERER
@@ -170,6 +203,8 @@ Texture* Renderer::GetTextureForFileName(char const* imageFilePath)
 
 BitmapFont* Renderer::CreateBitmapFont(const char* bitmapFontFilePathWithNoExtension)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateBitmapFont(bitmapFontFilePathWithNoExtension);
 #elif DX12_RENDERER
@@ -189,6 +224,8 @@ void Renderer::BindTexture(int textureSlot, const Texture* texture)
 
 VertexBuffer* Renderer::CreateVertexBuffer(size_t const size, std::wstring bufferDebugName)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateVertexBuffer(size);
 #elif DX12_RENDERER
@@ -217,6 +254,8 @@ void Renderer::BindVertexBuffer(VertexBuffer* buffer, int stride, PrimitiveType
 
 IndexBuffer* Renderer::CreateIndexBuffer(size_t const size)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateIndexBuffer(size);
 #elif DX12_RENDERER
@@ -244,6 +283,8 @@ void Renderer::BindIndexBuffer(IndexBuffer* buffer)
 
 MeshBuffer* Renderer::CreateMeshBuffer(size_t const size, std::wstring bufferDebugName)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 	UNUSED(size);
 	UNUSED(bufferDebugName);
 #if DX12_RENDERER
@@ -272,6 +313,8 @@ void Renderer::BindMeshBuffer(Model* mbo)
 
 ConstantBuffer* Renderer::CreateConstantBuffer(size_t const size, std::wstring bufferDebugName)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateConstantBuffer(size);
 #elif DX12_RENDERER
@@ -300,6 +343,8 @@ void Renderer::BindConstantBuffer(int slot, ConstantBuffer* cbo, RootSig pipelin
 
 Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource, VertexType type)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateShader(shaderName, shaderSource, type);
 #elif DX12_RENDERER
@@ -309,6 +354,8 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 
 Shader* Renderer::CreateShader(char const* shaderName, VertexType type)
 {
+	ScopedMemoryTag memoryTag(MemoryTag::RENDERER);
+
 #if DX11_RENDERER
 	return m_DX11Renderer->CreateShader(shaderName, type);
 #elif DX12_RENDERER
@@ -377,14 +424,14 @@ void Renderer::SetDirectionalLightConstants(Vec3 sunDirection, float sunIntensit
 #endif
 }
 
-void Renderer::SetPointLightConstants(std::vector<Vec3> pointPosition, std::vector<Rgba8> pointColor)
+void Renderer::SetPointLightConstants(std::vector<Vec3> const& pointPosition, std::vector<Rgba8> const& pointColor)
 {
 #if DX11_RENDERER
 	m_DX11Renderer->SetPointLightConstants(pointPosition, pointColor);
 #endif
 }
 
-void Renderer::SetSpotLightConstants(std::vector<Vec3> spotLightPosition, std::vector<float> cutOff, std::vector<Vec3> spotLightDirection, std::vector<Rgba8> spotColor)
+void Renderer::SetSpotLightConstants(std::vector<Vec3> const& spotLightPosition, std::vector<float> const& cutOff, std::vector<Vec3> const& spotLightDirection, std::vector<Rgba8> const& spotColor)
 {
 #if DX11_RENDERER
 	m_DX11Renderer->SetSpotLightConstants(spotLightPosition, cutOff, spotLightDirection, spotColor);
@@ -546,6 +593,16 @@ void Renderer::DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vert
 	return m_DX12Renderer->DrawVertexArrayIndexed(numVertexes, vertexes, indices);
 #endif
 }
+
+void Renderer::DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+#if DX11_RENDERER
+	m_DX11Renderer->DrawVertexArrayIndexed(numVertexes, vertexes, numIndexes, indexes);
+#elif DX12_RENDERER
+	return m_DX12Renderer->DrawVertexArrayIndexed(numVertexes, vertexes, numIndexes, indexes);
+#endif
+}
+
 void Renderer::DrawMesh(int numOfMeshlets, uint32_t isSecondPass)
 {
 	UNUSED(numOfMeshlets);
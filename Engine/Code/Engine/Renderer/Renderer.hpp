@@ -168,8 +168,8 @@ public:
 	void			SetModelConstants(RootSig pipelineMode, Mat44 const& modelMatrix = Mat44(), Rgba8 const& modelColor = Rgba8::WHITE, ConstantBuffer* modelCBO = nullptr);
 	void			SetModelConstants(std::vector<Mat44> const& modelMatrix, std::vector<Rgba8> const& modelColor); // TODO
 	void			SetDirectionalLightConstants(Vec3 sunDirection, float sunIntensity, float ambientIntensity, Vec3 worldEyePosition = Vec3::ZERO, LightDebug lightDebugFlags = {}, float minFalloff = 0.0f, float maxFalloff = 0.0f, float minFalloffMultiplier = 0.0f, float maxFalloffMultiplier = 0.0f);
-	void			SetPointLightConstants(std::vector<Vec3> pointPosition, std::vector<Rgba8> pointColor);
-	void			SetSpotLightConstants(std::vector<Vec3> spotLightPosition, std::vector<float> cutOff, std::vector<Vec3> spotLightDirection, std::vector<Rgba8> spotColor);
+	void			SetPointLightConstants(std::vector<Vec3> const& pointPosition, std::vector<Rgba8> const& pointColor);
+	void			SetSpotLightConstants(std::vector<Vec3> const& spotLightPosition, std::vector<float> const& cutOff, std::vector<Vec3> const& spotLightDirection, std::vector<Rgba8> const& spotColor);
 
 	void			SetBlendMode( BlendMode blendMode );
 	void			SetBlendStatesIfChanged();
@@ -192,6 +192,7 @@ public:
 	void			DrawVertexArrayIndexed(int numVertexes, Vertex_PCU const* vertexes, std::vector<unsigned int> const& indices);
 	void			DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes);
 	void			DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, std::vector<unsigned int> const& indices);
+	void			DrawVertexArrayIndexed(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes);
 	void			DrawMesh(int numOfMeshlets, uint32_t isSecondPass);
 public:/*
 	ID3D11ComputeShader*			m_thresholdCSShader						= nullptr;
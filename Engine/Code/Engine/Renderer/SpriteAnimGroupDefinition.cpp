@@ -1,15 +1,140 @@
 #include "Engine/Renderer/SpriteAnimGroupDefinition.hpp"
 
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
+#include "Engine/Math/MathUtils.hpp"
 
 SpriteAnimGroupDefinition::SpriteAnimGroupDefinition()
 {
 	m_name = "";
 	m_scaleBySpeed = false;
 	m_secondsPerFrame = 0.0f;
-	m_playbackMode = "";
+	m_playbackType = SpriteAnimPlaybackType::LOOP;
 }
 
 SpriteAnimGroupDefinition::~SpriteAnimGroupDefinition()
 {
 }
+
+bool SpriteAnimGroupDefinition::LoadFromXmlElement(XmlElement const& element)
+{
+	m_name = ParseXmlAttribute(element, "name", m_name);
+	m_scaleBySpeed = ParseXmlAttribute(element, "scaleBySpeed", m_scaleBySpeed);
+	m_secondsPerFrame = ParseXmlAttribute(element, "secondsPerFrame", m_secondsPerFrame);
+
+	std::string playbackMode = ParseXmlAttribute(element, "playbackMode", "Loop");
+
+	if (playbackMode == "Once")
+	{
+		m_playbackType = SpriteAnimPlaybackType::ONCE;
+	}
+	else if (playbackMode == "PingPong")
+	{
+		m_playbackType = SpriteAnimPlaybackType::PINGPONG;
+	}
+	else
+	{
+		m_playbackType = SpriteAnimPlaybackType::LOOP;
+	}
+
+	XmlElement const* directionElement = element.FirstChildElement("Direction");
+
+	while (directionElement)
+	{
+		SpriteAnimDirection direction;
+		direction.m_direction = ParseXmlAttribute(*directionElement, "vector", Vec3::ZERO).GetNormalized();
+
+		XmlElement const* animElement = directionElement->FirstChildElement("Animation");
+
+		if (animElement)
+		{
+			direction.m_startFrame = ParseXmlAttribute(*animElement, "startFrame", -1);
+			direction.m_endFrame = ParseXmlAttribute(*animElement, "endFrame", -1);
+		}
+
+		if (direction.m_startFrame != -1 && direction.m_endFrame != -1)
+		{
+			m_directions.push_back(direction);
+		}
+
+		directionElement = directionElement->NextSiblingElement("Direction");
+	}
+
+	BuildDirectionLookup();
+
+	return !m_directions.empty();
+}
+
+void SpriteAnimGroupDefinition::BuildDirectionLookup()
+{
+	for (int octant = 0; octant < 8; octant++)
+	{
+		float octantYaw = GetOctantYawDegrees(octant);
+		Vec3 octantDir = Vec3(CosDegrees(octantYaw), SinDegrees(octantYaw), 0.0f);
+
+		int desiredDirIndex = 0;
+		float maxDot = 0.0f;
+
+		for (size_t j = 0; j < m_directions.size(); j++)
+		{
+			float dot = DotProduct3D(octantDir, m_directions[j].m_direction);
+
+			if (dot > maxDot)
+			{
+				maxDot = dot;
+				desiredDirIndex = (int)j;
+			}
+		}
+
+		m_octantLookup[octant] = static_cast<unsigned char>(desiredDirIndex);
+	}
+}
+
+int SpriteAnimGroupDefinition::GetDirectionIndexForOctant(int octant) const
+{
+	return m_octantLookup[octant & 7];
+}
+
+int SpriteAnimGroupDefinition::GetNumFrames(int directionIndex) const
+{
+	SpriteAnimDirection const& direction = m_directions[directionIndex];
+
+	return direction.m_endFrame - direction.m_startFrame + 1;
+}
+
+float SpriteAnimGroupDefinition::GetDuration(int directionIndex) const
+{
+	if (m_directions.empty())
+		return 0.0f;
+
+	return static_cast<float>(GetNumFrames(directionIndex)) * m_secondsPerFrame;
+}
+
+int SpriteAnimGroupDefinition::GetSpriteIndexAtTime(int directionIndex, float seconds) const
+{
+	int numFrames = GetNumFrames(directionIndex);
+	int frame = (m_secondsPerFrame > 0.0f) ? static_cast<int>(seconds / m_secondsPerFrame) : 0;
+
+	switch (m_playbackType)
+	{
+	case SpriteAnimPlaybackType::ONCE:
+		frame = (frame < numFrames) ? frame : numFrames - 1;
+		break;
+	case SpriteAnimPlaybackType::LOOP:
+		frame = frame % numFrames;
+		break;
+	case SpriteAnimPlaybackType::PINGPONG:
+		if (numFrames > 1)
+		{
+			int period = 2 * numFrames - 2;
+			frame = frame % period;
+			frame = (frame < numFrames) ? frame : period - frame;
+		}
+		else
+		{
+			frame = 0;
+		}
+		break;
+	}
+
+	return m_directions[directionIndex].m_startFrame + frame;
+}
@@ -1,22 +1,42 @@
 #pragma once
 
 #include "Engine/Math/Vec3.hpp"
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Renderer/SpriteAnimDefinition.hpp"
 
 #include <vector>
 #include <string>
 
-class SpriteAnimDefinition;
+struct SpriteAnimDirection
+{
+	Vec3								m_direction;
+	int									m_startFrame			= -1;
+	int									m_endFrame				= -1;
+};
 
+//----------------------------------------------------------------------------------------------------------------------------------------
+// Immutable once loaded, shared by every actor using the owning definition.
+// Per-direction frame ranges are stored flat and the direction for each of the
+// eight view octants is resolved once at load into m_octantLookup.
+//----------------------------------------------------------------------------------------------------------------------------------------
 class SpriteAnimGroupDefinition
 {
 public:
-	std::string m_name;
-	bool m_scaleBySpeed = false;
-	float m_secondsPerFrame;
-	std::string m_playbackMode;
-	std::vector<SpriteAnimDefinition*> m_spriteAnimDefs;
-	std::vector<Vec3> m_spriteDirection;
+	std::string							m_name;
+	bool								m_scaleBySpeed			= false;
+	float								m_secondsPerFrame		= 0.0f;
+	SpriteAnimPlaybackType				m_playbackType			= SpriteAnimPlaybackType::LOOP;
+	std::vector<SpriteAnimDirection>	m_directions;
+	unsigned char						m_octantLookup[8] = {};
 public:
 	SpriteAnimGroupDefinition();
 	~SpriteAnimGroupDefinition();
+
+	bool								LoadFromXmlElement(XmlElement const& element);
+	void								BuildDirectionLookup();
+
+	int									GetDirectionIndexForOctant(int octant) const;
+	int									GetNumFrames(int directionIndex) const;
+	float								GetDuration(int directionIndex = 0) const;
+	int									GetSpriteIndexAtTime(int directionIndex, float seconds) const;
 };
@@ -0,0 +1,312 @@
+#include "Engine/Renderer/VertexQuantization.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/MeshVertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+
+#include "ThirdParty/Meshoptimizer/src/meshoptimizer.h"
+
+#include <cfloat>
+#include <cmath>
+#include <string.h>
+
+constexpr float PACKED_POSITION_MAX		= 65535.0f;
+constexpr float PACKED_SNORM_MAX		= 32767.0f;
+
+//------------------------------------------------------------------------------------------------
+// Projects onto the octahedron |x| + |y| + |z| = 1 and folds the lower half over the diagonals,
+// giving a square map in [-1, 1] with far less error per bit than storing x and y. A zero vector
+// encodes as the centre of the map and decodes as +Z.
+//------------------------------------------------------------------------------------------------
+Vec2 EncodeOctahedral(Vec3 const& direction)
+{
+	float l1Norm = fabsf(direction.x) + fabsf(direction.y) + fabsf(direction.z);
+
+	if (l1Norm <= 0.0f)
+	{
+		return Vec2(0.0f, 0.0f);
+	}
+
+	Vec2 encoded(direction.x / l1Norm, direction.y / l1Norm);
+
+	if (direction.z < 0.0f)
+	{
+		float foldedX = (1.0f - fabsf(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f);
+		float foldedY = (1.0f - fabsf(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f);
+		encoded = Vec2(foldedX, foldedY);
+	}
+
+	return encoded;
+}
+
+//------------------------------------------------------------------------------------------------
+Vec3 DecodeOctahedral(Vec2 const& encoded)
+{
+	Vec3 direction(encoded.x, encoded.y, 1.0f - fabsf(encoded.x) - fabsf(encoded.y));
+
+	if (direction.z < 0.0f)
+	{
+		direction.x = (1.0f - fabsf(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f);
+		direction.y = (1.0f - fabsf(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	return direction.GetNormalized();
+}
+
+//------------------------------------------------------------------------------------------------
+static void PackOctahedral(Vec3 const& direction, int16_t(&outPacked)[2])
+{
+	Vec2 encoded = EncodeOctahedral(direction);
+
+	outPacked[0] = (int16_t)meshopt_quantizeSnorm(encoded.x, 16);
+	outPacked[1] = (int16_t)meshopt_quantizeSnorm(encoded.y, 16);
+}
+
+//------------------------------------------------------------------------------------------------
+static Vec3 UnpackOctahedral(int16_t const(&packed)[2])
+{
+	return DecodeOctahedral(Vec2(GetClamped((float)packed[0] / PACKED_SNORM_MAX, -1.0f, 1.0f), GetClamped((float)packed[1] / PACKED_SNORM_MAX, -1.0f, 1.0f)));
+}
+
+//------------------------------------------------------------------------------------------------
+static bool IsZeroVector(Vec3 const& vector)
+{
+	return vector.x == 0.0f && vector.y == 0.0f && vector.z == 0.0f;
+}
+
+//------------------------------------------------------------------------------------------------
+static void PackVertex(Vec3 const& position, uint8_t const(&color)[4], Vec2 const& uv, Vec3 const& tangent, Vec3 const& biTangent, Vec3 const& normal, AABB3 const& bounds, PackedVertex_PCUTBN& outPackedVertex)
+{
+	Vec3 extents = bounds.m_maxs - bounds.m_mins;
+	float const* positionComponents = &position.x;
+	float const* minsComponents = &bounds.m_mins.x;
+	float const* extentsComponents = &extents.x;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float normalized = extentsComponents[axis] > 0.0f ? (positionComponents[axis] - minsComponents[axis]) / extentsComponents[axis] : 0.0f;
+		outPackedVertex.m_position[axis] = (uint16_t)meshopt_quantizeUnorm(GetClamped(normalized, 0.0f, 1.0f), 16);
+	}
+
+	memcpy(outPackedVertex.m_color, color, sizeof(outPackedVertex.m_color));
+
+	outPackedVertex.m_uv[0] = meshopt_quantizeHalf(uv.x);
+	outPackedVertex.m_uv[1] = meshopt_quantizeHalf(uv.y);
+
+	PackOctahedral(normal, outPackedVertex.m_normal);
+	PackOctahedral(tangent, outPackedVertex.m_tangent);
+
+	if (IsZeroVector(tangent))
+	{
+		outPackedVertex.m_tangentSign = 0;
+	}
+	else
+	{
+		outPackedVertex.m_tangentSign = DotProduct3D(CrossProduct3D(normal, tangent), biTangent) >= 0.0f ? 1 : -1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+static void UnpackVertex(PackedVertex_PCUTBN const& packedVertex, AABB3 const& bounds, Vec3& outPosition, Vec2& outUV, Vec3& outTangent, Vec3& outBiTangent, Vec3& outNormal)
+{
+	Vec3 extents = bounds.m_maxs - bounds.m_mins;
+
+	outPosition.x = bounds.m_mins.x + extents.x * ((float)packedVertex.m_position[0] / PACKED_POSITION_MAX);
+	outPosition.y = bounds.m_mins.y + extents.y * ((float)packedVertex.m_position[1] / PACKED_POSITION_MAX);
+	outPosition.z = bounds.m_mins.z + extents.z * ((float)packedVertex.m_position[2] / PACKED_POSITION_MAX);
+
+	outUV = Vec2(meshopt_dequantizeHalf(packedVertex.m_uv[0]), meshopt_dequantizeHalf(packedVertex.m_uv[1]));
+
+	outNormal = UnpackOctahedral(packedVertex.m_normal);
+
+	if (packedVertex.m_tangentSign == 0)
+	{
+		outTangent = Vec3();
+		outBiTangent = Vec3();
+	}
+	else
+	{
+		outTangent = UnpackOctahedral(packedVertex.m_tangent);
+		outBiTangent = CrossProduct3D(outNormal, outTangent) * (float)packedVertex.m_tangentSign;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+template <typename VertexType>
+static AABB3 GetPositionBounds(VertexType const* vertices, size_t numVertices)
+{
+	if (numVertices == 0)
+	{
+		return AABB3(Vec3(), Vec3());
+	}
+
+	AABB3 bounds(Vec3(FLT_MAX, FLT_MAX, FLT_MAX), Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+
+	for (size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		Vec3 const& position = vertices[vertexIndex].m_position;
+
+		bounds.m_mins = Vec3(fminf(bounds.m_mins.x, position.x), fminf(bounds.m_mins.y, position.y), fminf(bounds.m_mins.z, position.z));
+		bounds.m_maxs = Vec3(fmaxf(bounds.m_maxs.x, position.x), fmaxf(bounds.m_maxs.y, position.y), fmaxf(bounds.m_maxs.z, position.z));
+	}
+
+	return bounds;
+}
+
+//------------------------------------------------------------------------------------------------
+AABB3 GetVertexPositionBounds(MeshVertex_PCUTBN const* vertices, size_t numVertices)
+{
+	return GetPositionBounds(vertices, numVertices);
+}
+
+//------------------------------------------------------------------------------------------------
+AABB3 GetVertexPositionBounds(Vertex_PCUTBN const* vertices, size_t numVertices)
+{
+	return GetPositionBounds(vertices, numVertices);
+}
+
+//------------------------------------------------------------------------------------------------
+// Worst-case per-axis error of a packed position: half a quantisation step across the bounds.
+//------------------------------------------------------------------------------------------------
+Vec3 GetPackedPositionMaxError(AABB3 const& bounds)
+{
+	Vec3 extents = bounds.m_maxs - bounds.m_mins;
+
+	return extents * (0.5f / PACKED_POSITION_MAX);
+}
+
+//------------------------------------------------------------------------------------------------
+void PackVertices(MeshVertex_PCUTBN const* vertices, size_t numVertices, AABB3 const& bounds, PackedVertex_PCUTBN* outPackedVertices)
+{
+	for (size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		MeshVertex_PCUTBN const& vertex = vertices[vertexIndex];
+
+		uint8_t color[4] =
+		{
+			(uint8_t)meshopt_quantizeUnorm(GetClamped(vertex.m_color.x, 0.0f, 1.0f), 8),
+			(uint8_t)meshopt_quantizeUnorm(GetClamped(vertex.m_color.y, 0.0f, 1.0f), 8),
+			(uint8_t)meshopt_quantizeUnorm(GetClamped(vertex.m_color.z, 0.0f, 1.0f), 8),
+			(uint8_t)meshopt_quantizeUnorm(GetClamped(vertex.m_color.w, 0.0f, 1.0f), 8),
+		};
+
+		PackVertex(vertex.m_position, color, vertex.m_uv, vertex.m_tangent, vertex.m_biTangent, vertex.m_normal, bounds, outPackedVertices[vertexIndex]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+void PackVertices(Vertex_PCUTBN const* vertices, size_t numVertices, AABB3 const& bounds, PackedVertex_PCUTBN* outPackedVertices)
+{
+	for (size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		Vertex_PCUTBN const& vertex = vertices[vertexIndex];
+
+		uint8_t color[4] = { vertex.m_color.r, vertex.m_color.g, vertex.m_color.b, vertex.m_color.a };
+
+		PackVertex(vertex.m_position, color, vertex.m_uvTexCoords, vertex.m_tangent, vertex.m_biTangent, vertex.m_normal, bounds, outPackedVertices[vertexIndex]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+void UnpackVertices(PackedVertex_PCUTBN const* packedVertices, size_t numVertices, AABB3 const& bounds, MeshVertex_PCUTBN* outVertices)
+{
+	for (size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		PackedVertex_PCUTBN const& packedVertex = packedVertices[vertexIndex];
+		MeshVertex_PCUTBN& vertex = outVertices[vertexIndex];
+
+		UnpackVertex(packedVertex, bounds, vertex.m_position, vertex.m_uv, vertex.m_tangent, vertex.m_biTangent, vertex.m_normal);
+
+		vertex.m_color = Vec4((float)packedVertex.m_color[0] / 255.0f, (float)packedVertex.m_color[1] / 255.0f, (float)packedVertex.m_color[2] / 255.0f, (float)packedVertex.m_color[3] / 255.0f);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+void UnpackVertices(PackedVertex_PCUTBN const* packedVertices, size_t numVertices, AABB3 const& bounds, Vertex_PCUTBN* outVertices)
+{
+	for (size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		PackedVertex_PCUTBN const& packedVertex = packedVertices[vertexIndex];
+		Vertex_PCUTBN& vertex = outVertices[vertexIndex];
+
+		UnpackVertex(packedVertex, bounds, vertex.m_position, vertex.m_uvTexCoords, vertex.m_tangent, vertex.m_biTangent, vertex.m_normal);
+
+		vertex.m_color = Rgba8(packedVertex.m_color[0], packedVertex.m_color[1], packedVertex.m_color[2], packedVertex.m_color[3]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// The vertex codec works byte-column-wise on deltas between consecutive vertices, so it compresses
+// best after the vertices have been reordered for fetch locality (meshopt_optimizeVertexFetch).
+//------------------------------------------------------------------------------------------------
+size_t EncodePackedVertices(PackedVertex_PCUTBN const* packedVertices, size_t numVertices, std::vector<unsigned char>& outEncoded)
+{
+	outEncoded.resize(meshopt_encodeVertexBufferBound(numVertices, sizeof(PackedVertex_PCUTBN)));
+
+	size_t encodedSize = meshopt_encodeVertexBuffer(outEncoded.data(), outEncoded.size(), packedVertices, numVertices, sizeof(PackedVertex_PCUTBN));
+	outEncoded.resize(encodedSize);
+
+	return encodedSize;
+}
+
+//------------------------------------------------------------------------------------------------
+bool DecodePackedVertices(unsigned char const* encoded, size_t encodedSize, size_t numVertices, PackedVertex_PCUTBN* outPackedVertices)
+{
+	return meshopt_decodeVertexBuffer(outPackedVertices, numVertices, sizeof(PackedVertex_PCUTBN), encoded, encodedSize) == 0;
+}
+
+//------------------------------------------------------------------------------------------------
+bool WritePackedVertexStream(std::string const& fileName, PackedVertex_PCUTBN const* packedVertices, size_t numVertices, AABB3 const& bounds)
+{
+	std::vector<unsigned char> encoded;
+	EncodePackedVertices(packedVertices, numVertices, encoded);
+
+	PackedVertexStreamHeader header;
+	header.m_numVertices = (uint32_t)numVertices;
+	header.m_boundsMins[0] = bounds.m_mins.x;
+	header.m_boundsMins[1] = bounds.m_mins.y;
+	header.m_boundsMins[2] = bounds.m_mins.z;
+	header.m_boundsMaxs[0] = bounds.m_maxs.x;
+	header.m_boundsMaxs[1] = bounds.m_maxs.y;
+	header.m_boundsMaxs[2] = bounds.m_maxs.z;
+	header.m_encodedSize = (uint64_t)encoded.size();
+
+	std::vector<unsigned char> buffer(sizeof(PackedVertexStreamHeader) + encoded.size());
+	memcpy(buffer.data(), &header, sizeof(PackedVertexStreamHeader));
+	memcpy(buffer.data() + sizeof(PackedVertexStreamHeader), encoded.data(), encoded.size());
+
+	std::string outFileName = fileName;
+	WriteBufferToFile(buffer, outFileName);
+
+	return FileExists(fileName);
+}
+
+//------------------------------------------------------------------------------------------------
+bool ReadPackedVertexStream(std::string const& fileName, std::vector<PackedVertex_PCUTBN>& outPackedVertices, AABB3& outBounds)
+{
+	MappedFile file;
+
+	if (!file.Open(fileName) || file.GetSize() < sizeof(PackedVertexStreamHeader))
+	{
+		return false;
+	}
+
+	PackedVertexStreamHeader header;
+	memcpy(&header, file.GetData(), sizeof(PackedVertexStreamHeader));
+
+	bool isValid = header.m_magic == PACKED_VERTEX_STREAM_MAGIC
+		&& header.m_version == PACKED_VERTEX_STREAM_VERSION
+		&& header.m_vertexSize == sizeof(PackedVertex_PCUTBN)
+		&& header.m_encodedSize <= file.GetSize() - sizeof(PackedVertexStreamHeader);
+
+	if (!isValid)
+	{
+		return false;
+	}
+
+	outPackedVertices.resize(header.m_numVertices);
+	outBounds = AABB3(Vec3(header.m_boundsMins[0], header.m_boundsMins[1], header.m_boundsMins[2]), Vec3(header.m_boundsMaxs[0], header.m_boundsMaxs[1], header.m_boundsMaxs[2]));
+
+	return DecodePackedVertices(file.GetData() + sizeof(PackedVertexStreamHeader), (size_t)header.m_encodedSize, header.m_numVertices, outPackedVertices.data());
+}
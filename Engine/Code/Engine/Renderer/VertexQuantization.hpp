@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct Vertex_PCUTBN;
+struct MeshVertex_PCUTBN;
+
+constexpr uint32_t PACKED_VERTEX_STREAM_MAGIC	= 0x58545650; // "PVTX"
+constexpr uint32_t PACKED_VERTEX_STREAM_VERSION	= 1;
+
+//------------------------------------------------------------------------------------------------
+// 24-byte vertex: unorm16 position inside the mesh bounds, unorm8 colour, half-float UVs, and
+// octahedral snorm16 normal and tangent. The bitangent is cross(normal, tangent) * m_tangentSign;
+// a sign of 0 marks a vertex with no tangent frame, which unpacks to zero tangent and bitangent.
+//------------------------------------------------------------------------------------------------
+struct PackedVertex_PCUTBN
+{
+	uint16_t						m_position[3];
+	int16_t							m_tangentSign;
+	uint8_t							m_color[4];
+	uint16_t						m_uv[2];
+	int16_t							m_normal[2];
+	int16_t							m_tangent[2];
+};
+
+static_assert(sizeof(PackedVertex_PCUTBN) == 24, "PackedVertex_PCUTBN must stay 24 bytes");
+
+//------------------------------------------------------------------------------------------------
+// On-disk header for a vertexcodec-compressed stream of PackedVertex_PCUTBN; the encoded bytes
+// follow it directly.
+//------------------------------------------------------------------------------------------------
+struct PackedVertexStreamHeader
+{
+	uint32_t						m_magic					= PACKED_VERTEX_STREAM_MAGIC;
+	uint32_t						m_version				= PACKED_VERTEX_STREAM_VERSION;
+	uint32_t						m_numVertices			= 0;
+	uint32_t						m_vertexSize			= sizeof(PackedVertex_PCUTBN);
+	float							m_boundsMins[3]			= {};
+	float							m_boundsMaxs[3]			= {};
+	uint64_t						m_encodedSize			= 0;
+};
+
+Vec2	EncodeOctahedral(Vec3 const& direction);
+Vec3	DecodeOctahedral(Vec2 const& encoded);
+
+AABB3	GetVertexPositionBounds(MeshVertex_PCUTBN const* vertices, size_t numVertices);
+AABB3	GetVertexPositionBounds(Vertex_PCUTBN const* vertices, size_t numVertices);
+Vec3	GetPackedPositionMaxError(AABB3 const& bounds);
+
+void	PackVertices(MeshVertex_PCUTBN const* vertices, size_t numVertices, AABB3 const& bounds, PackedVertex_PCUTBN* outPackedVertices);
+void	PackVertices(Vertex_PCUTBN const* vertices, size_t numVertices, AABB3 const& bounds, PackedVertex_PCUTBN* outPackedVertices);
+void	UnpackVertices(PackedVertex_PCUTBN const* packedVertices, size_t numVertices, AABB3 const& bounds, MeshVertex_PCUTBN* outVertices);
+void	UnpackVertices(PackedVertex_PCUTBN const* packedVertices, size_t numVertices, AABB3 const& bounds, Vertex_PCUTBN* outVertices);
+
+size_t	EncodePackedVertices(PackedVertex_PCUTBN const* packedVertices, size_t numVertices, std::vector<unsigned char>& outEncoded);
+bool	DecodePackedVertices(unsigned char const* encoded, size_t encodedSize, size_t numVertices, PackedVertex_PCUTBN* outPackedVertices);
+
+bool	WritePackedVertexStream(std::string const& fileName, PackedVertex_PCUTBN const* packedVertices, size_t numVertices, AABB3 const& bounds);
+bool	ReadPackedVertexStream(std::string const& fileName, std::vector<PackedVertex_PCUTBN>& outPackedVertices, AABB3& outBounds);
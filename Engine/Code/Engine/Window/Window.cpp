@@ -16,6 +16,11 @@
 
 Window* Window::s_mainWindow = nullptr;
 
+static constexpr EventName EVENT_QUIT("QUIT");
+static constexpr EventName EVENT_CHARINPUT("CHARINPUT");
+static constexpr EventName EVENT_KEYPRESSED("KEYPRESSED");
+static constexpr EventName EVENT_KEYRELEASED("KEYRELEASED");
+
 LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessageCode, WPARAM wParam, LPARAM lParam)
 {
 	extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -28,15 +33,15 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessa
 	case WM_CLOSE:
 	{
 		EventArgs args;
-		FireEvent("QUIT", args);
+		FireEvent(EVENT_QUIT, args);
 
 		return 0; // "Consumes" this message (tells Windows "okay, we handled it")
 	}
 	case WM_CHAR:
 	{
 		EventArgs args;
-		args.SetValue("KeyCode", Stringf("%d", (unsigned char)wParam));
-		FireEvent("CHARINPUT", args);
+		args.SetValue("KeyCode", (int)(unsigned char)wParam);
+		FireEvent(EVENT_CHARINPUT, args);
 
 		return 0;
 	}
@@ -44,8 +49,8 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessa
 	case WM_KEYDOWN:
 	{
 		EventArgs args;
-		args.SetValue("KeyCode", Stringf("%d", (unsigned char)wParam));
-		FireEvent("KEYPRESSED", args);
+		args.SetValue("KeyCode", (int)(unsigned char)wParam);
+		FireEvent(EVENT_KEYPRESSED, args);
 
 		return 0;
 	}
@@ -54,8 +59,8 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessa
 	case WM_KEYUP:
 	{
 		EventArgs args;
-		args.SetValue("KeyCode", Stringf("%d", (unsigned char)wParam));
-		FireEvent("KEYRELEASED", args);
+		args.SetValue("KeyCode", (int)(unsigned char)wParam);
+		FireEvent(EVENT_KEYRELEASED, args);
 
 		return 0;
 	}
@@ -64,8 +69,8 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessa
 	{
 		unsigned char asKey = KEYCODE_LEFT_MOUSE;
 		EventArgs args;
-		args.SetValue("KeyCode", Stringf("%d", asKey));
-		FireEvent("KEYPRESSED", args);
+		args.SetValue("KeyCode", (int)asKey);
+		FireEvent(EVENT_KEYPRESSED, args);
 
 		return 0;
 	}
@@ -74,8 +79,8 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessa
 	{
 		unsigned char asKey = KEYCODE_LEFT_MOUSE;
 		EventArgs args;
-		args.SetValue("KeyCode", Stringf("%d", asKey));
-		FireEvent("KEYRELEASED", args);
+		args.SetValue("KeyCode", (int)asKey);
+		FireEvent(EVENT_KEYRELEASED, args);
 
 		return 0;
 	}
@@ -84,8 +89,8 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessa
 	{
 		unsigned char asKey = KEYCODE_RIGHT_MOUSE;
 		EventArgs args;
-		args.SetValue("KeyCode", Stringf("%d", asKey));
-		FireEvent("KEYPRESSED", args);
+		args.SetValue("KeyCode", (int)asKey);
+		FireEvent(EVENT_KEYPRESSED, args);
 
 		return 0;
 	}
@@ -94,8 +99,8 @@ LRESULT CALLBACK WindowsMessageHandlingProcedure(HWND windowHandle, UINT wmMessa
 	{
 		unsigned char asKey = KEYCODE_RIGHT_MOUSE;
 		EventArgs args;
-		args.SetValue("KeyCode", Stringf("%d", asKey));
-		FireEvent("KEYRELEASED", args);
+		args.SetValue("KeyCode", (int)asKey);
+		FireEvent(EVENT_KEYRELEASED, args);
 
 		return 0;
 	}